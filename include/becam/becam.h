@@ -37,9 +37,28 @@
 #include <stddef.h>
 #include <stdint.h>
 
+// 由四个字符构建FOURCC格式码
+#define BECAM_FOURCC(a, b, c, d) ((uint32_t)(a) | ((uint32_t)(b) << 8) | ((uint32_t)(c) << 16) | ((uint32_t)(d) << 24))
+
+// 常用图像格式（与V4L2_PIX_FMT_*取值一致）
+#define BECAM_FORMAT_YUYV BECAM_FOURCC('Y', 'U', 'Y', 'V')	 // 打包YUV 4:2:2，字节顺序Y0、U、Y1、V（Windows下为YUY2）
+#define BECAM_FORMAT_UYVY BECAM_FOURCC('U', 'Y', 'V', 'Y')	 // 打包YUV 4:2:2，字节顺序U、Y0、V、Y1
+#define BECAM_FORMAT_NV12 BECAM_FOURCC('N', 'V', '1', '2')	 // 半平面YUV 4:2:0，Y平面后为U、V交织平面
+#define BECAM_FORMAT_NV21 BECAM_FOURCC('N', 'V', '2', '1')	 // 半平面YUV 4:2:0，Y平面后为V、U交织平面
+#define BECAM_FORMAT_I420 BECAM_FOURCC('Y', 'U', '1', '2')	 // 平面YUV 4:2:0，依次为Y、U、V平面（Windows下为I420/IYUV）
+#define BECAM_FORMAT_YV12 BECAM_FOURCC('Y', 'V', '1', '2')	 // 平面YUV 4:2:0，依次为Y、V、U平面
+#define BECAM_FORMAT_MJPG BECAM_FOURCC('M', 'J', 'P', 'G')	 // Motion-JPEG
+#define BECAM_FORMAT_RGB24 BECAM_FOURCC('R', 'G', 'B', '3')	 // 字节顺序R、G、B
+#define BECAM_FORMAT_BGR24 BECAM_FOURCC('B', 'G', 'R', '3')	 // 字节顺序B、G、R
+#define BECAM_FORMAT_RGBA32 BECAM_FOURCC('A', 'B', '2', '4') // 字节顺序R、G、B、A
+#define BECAM_FORMAT_BGRA32 BECAM_FOURCC('A', 'R', '2', '4') // 字节顺序B、G、R、A
+
 // Becam接口句柄
 typedef void* BecamHandle;
 
+// MJPEG解码器句柄
+typedef void* BecamMjpegDecoderHandle;
+
 // StatusCode 状态码定义
 typedef enum {
 	STATUS_CODE_SUCCESS, // 成功
@@ -97,6 +116,15 @@ typedef enum {
 	STATUS_CODE_V4L2_ERR_MMAP_BUF,	  // V4L2异常：映射内核缓冲区失败
 	STATUS_CODE_V4L2_ERR_LOCK_BUF,	  // V4L2异常：缓冲区加锁失败
 	STATUS_CODE_V4L2_ERR_UNLOCK_BUF,  // V4L2异常：缓冲区解锁失败
+	STATUS_CODE_V4L2_ERR_HOTPLUG,	  // V4L2异常：创建热插拔监听失败
+	/**
+	 * 追加的通用异常（新增状态码只能追加在末尾，保持已发布状态码的取值不变）
+	 */
+	STATUS_CODE_ERR_DEVICE_NO_BANDWIDTH, // 设备所在总线带宽不足
+	STATUS_CODE_ERR_NOT_SUPPORTED,		 // 当前平台不支持该功能
+	STATUS_CODE_ERR_CONTROL_NOT_FOUND,	 // 控制项未找到
+	STATUS_CODE_ERR_CONTROL_FAILED,		 // 控制项读取或设置失败
+	STATUS_CODE_ERR_DECODE_FAILED,		 // 视频帧解码失败
 } StatusCode;
 
 // VideoFrameInfo 视频帧信息
@@ -107,12 +135,324 @@ typedef struct {
 	uint32_t fps;	 // 分辨率帧率
 } VideoFrameInfo;
 
-// DeviceInfo 设备信息
+// CropMode 裁剪方式
+typedef enum {
+	CROP_MODE_NONE,		// 未裁剪
+	CROP_MODE_HARDWARE, // 由设备（驱动）裁剪
+	CROP_MODE_SOFTWARE, // 由Becam在拷贝视频帧时裁剪
+} CropMode;
+
+// CropRect 裁剪区域
+typedef struct {
+	uint32_t left;	 // 左上角横坐标
+	uint32_t top;	 // 左上角纵坐标
+	uint32_t width;	 // 宽度（为0表示不裁剪）
+	uint32_t height; // 高度（为0表示不裁剪）
+} CropRect;
+
+// VideoFrameMeta 视频帧元数据
+typedef struct {
+	uint32_t format;	   // 视频帧格式（FOURCC表示）
+	uint32_t width;		   // 视频帧宽度
+	uint32_t height;	   // 视频帧高度
+	uint32_t bytesPerLine; // 视频帧每行字节数（压缩格式为0）
+	uint32_t sequence;	   // 视频帧序号
+	uint64_t timestamp;	   // 视频帧采集时间戳（微秒）
+	CropMode cropMode;	   // 实际生效的裁剪方式
+	CropRect crop;		   // 实际生效的裁剪区域（相对于设备输出的完整画面）
+} VideoFrameMeta;
+
+// FrameFormat 已生效的视频帧格式（由驱动回写，可能与请求的配置不同）
+typedef struct {
+	uint32_t format;			  // 视频帧格式（FOURCC表示）
+	uint32_t width;				  // 视频帧宽度
+	uint32_t height;			  // 视频帧高度
+	uint32_t bytesPerLine;		  // 每行字节数（含行尾填充，平面格式为亮度平面，压缩格式为0）
+	uint32_t sizeImage;			  // 单帧缓冲区大小
+	uint32_t colorspace;		  // 色彩空间（V4L2下为V4L2_COLORSPACE_*）
+	uint32_t ycbcrEncoding;		  // YCbCr编码（V4L2下为V4L2_YCBCR_ENC_*，0表示由色彩空间决定）
+	uint32_t quantization;		  // 量化范围（V4L2下为V4L2_QUANTIZATION_*，0表示由色彩空间决定）
+	uint32_t intervalNumerator;	  // 帧间隔分子（单位秒）
+	uint32_t intervalDenominator; // 帧间隔分母
+} FrameFormat;
+
+// ImageBuffer 图像缓冲区描述（不持有内存）
+typedef struct {
+	uint32_t format;	// 图像格式（FOURCC表示）
+	uint32_t width;		// 图像宽度
+	uint32_t height;	// 图像高度
+	uint8_t* plane[3];	// 各平面首地址（打包格式只使用plane[0]，平面YUV总是依次为Y、U、V）
+	uint32_t stride[3]; // 各平面每行字节数（为0时按紧凑排列）
+} ImageBuffer;
+
+// LumaView 亮度视图（直接指向源图像的亮度采样，不持有内存）
+typedef struct {
+	const uint8_t* data;  // 第一个亮度采样的地址
+	uint32_t width;		  // 宽度
+	uint32_t height;	  // 高度
+	uint32_t stride;	  // 相邻两行的字节间距
+	uint32_t pixelStride; // 相邻两个亮度采样的字节间距（平面、半平面格式及GREY为1，打包YUV 4:2:2为2）
+} LumaView;
+
+// TensorLayout 张量内存布局（批大小固定为1）
+typedef enum {
+	TENSOR_LAYOUT_NCHW, // 通道优先（各通道平面依次排列）
+	TENSOR_LAYOUT_NHWC, // 通道交错（每个像素的各通道连续排列）
+} TensorLayout;
+
+// TensorDataType 张量元素类型
+typedef enum {
+	TENSOR_DATA_FLOAT32, // 32位浮点
+	TENSOR_DATA_FLOAT16, // 16位浮点（IEEE 754半精度，向最近偶数舍入）
+} TensorDataType;
+
+// TensorChannelOrder 张量通道顺序
+typedef enum {
+	TENSOR_CHANNEL_RGB, // R、G、B
+	TENSOR_CHANNEL_BGR, // B、G、R
+} TensorChannelOrder;
+
+// TensorResizeMode 张量缩放方式
+typedef enum {
+	TENSOR_RESIZE_STRETCH,	 // 拉伸到张量宽高（不保持比例）
+	TENSOR_RESIZE_LETTERBOX, // 保持比例缩放后居中，四周用填充值补齐
+} TensorResizeMode;
+
+// TensorConfig 图像转张量配置（各通道参数均按张量的通道顺序，归一化结果为(像素值 - mean) / std）
+typedef struct {
+	uint32_t width;					 // 张量宽度
+	uint32_t height;				 // 张量高度
+	TensorLayout layout;			 // 内存布局
+	TensorDataType dataType;		 // 元素类型
+	TensorChannelOrder channelOrder; // 通道顺序
+	TensorResizeMode resizeMode;	 // 缩放方式
+	float mean[3];					 // 各通道均值（像素值范围0~255）
+	float std[3];					 // 各通道标准差（不能为0，输出0~1时均值为0、标准差为255）
+	float padValue[3];				 // 保持比例缩放时的填充像素值（归一化之前）
+} TensorConfig;
+
+// TensorPlacement 图像在张量中的位置（用于把推理结果映射回源图像坐标）
+typedef struct {
+	uint32_t left;		// 图像区域左上角横坐标
+	uint32_t top;		// 图像区域左上角纵坐标
+	uint32_t width;		// 图像区域宽度
+	uint32_t height;	// 图像区域高度
+	float scaleX;		// 水平缩放比例（图像区域宽度 / 源图像宽度）
+	float scaleY;		// 垂直缩放比例（图像区域高度 / 源图像高度）
+} TensorPlacement;
+
+// ResizeFilter 缩放滤波方式
+typedef enum {
+	RESIZE_FILTER_BOX,		// 盒式滤波（等权平均映射区间内的源像素，放大时为最近邻）
+	RESIZE_FILTER_BILINEAR, // 双线性插值（像素中心对齐，适合小比例缩放及放大）
+	RESIZE_FILTER_AREA,		// 区域平均（按覆盖面积加权，大比例缩小时抗混叠效果最好）
+} ResizeFilter;
+
+// ResizeConfig 输出缩放配置
+typedef struct {
+	uint32_t width;		 // 目标宽度（宽高任一为0表示不缩放）
+	uint32_t height;	 // 目标高度
+	ResizeFilter filter; // 滤波方式
+} ResizeConfig;
+
+// HotplugAction 热插拔动作
+typedef enum {
+	HOTPLUG_ACTION_ADD,	   // 设备接入
+	HOTPLUG_ACTION_REMOVE, // 设备移除
+} HotplugAction;
+
+// HotplugEvent 热插拔事件
+typedef struct {
+	HotplugAction action;	// 热插拔动作
+	const char* devicePath; // 设备路径（仅在回调期间有效）
+} HotplugEvent;
+
+// BecamHotplugCallback 热插拔回调函数（在内部监听线程中调用，回调中不可调用BecamSetHotplugCallback和BecamFree）
+typedef void (*BecamHotplugCallback)(const HotplugEvent* event, void* userData);
+
+// ControlType 控制项类型
+typedef enum {
+	CONTROL_TYPE_INTEGER,	   // 整数
+	CONTROL_TYPE_BOOLEAN,	   // 布尔值
+	CONTROL_TYPE_MENU,		   // 菜单（取值为菜单项序号）
+	CONTROL_TYPE_BUTTON,	   // 按钮（写入任意值触发动作）
+	CONTROL_TYPE_INTEGER64,	   // 64位整数
+	CONTROL_TYPE_INTEGER_MENU, // 整数菜单（取值为菜单项序号）
+	CONTROL_TYPE_BITMASK,	   // 位掩码
+	CONTROL_TYPE_OTHER,		   // 其它类型（不支持读写）
+} ControlType;
+
+// ControlFlag 控制项标志（按位组合）
+typedef enum {
+	CONTROL_FLAG_READ_ONLY = 1 << 0,  // 只读
+	CONTROL_FLAG_WRITE_ONLY = 1 << 1, // 只写
+	CONTROL_FLAG_VOLATILE = 1 << 2,	  // 易变（由设备自行改变，读取时总是查询设备）
+	CONTROL_FLAG_INACTIVE = 1 << 3,	  // 暂不生效（例如自动曝光开启时的曝光时间）
+	CONTROL_FLAG_GRABBED = 1 << 4,	  // 取流期间不可修改
+	CONTROL_FLAG_UPDATE = 1 << 5,	  // 修改后可能影响其它控制项
+} ControlFlag;
+
+// ControlMenuItem 控制项菜单项
+typedef struct {
+	uint32_t index; // 菜单项序号
+	int64_t value;	// 菜单项数值（仅整数菜单有效）
+	char name[32];	// 菜单项名称（仅菜单有效）
+} ControlMenuItem;
+
+// ControlInfo 控制项信息
+typedef struct {
+	uint32_t id;					// 控制项标识（V4L2下为V4L2_CID_*）
+	ControlType type;				// 控制项类型
+	char name[32];					// 控制项名称
+	int64_t minimum;				// 最小值
+	int64_t maximum;				// 最大值
+	uint64_t step;					// 步长
+	int64_t defaultValue;			// 默认值
+	uint32_t flags;					// 控制项标志 @ref(ControlFlag)
+	size_t menuItemListSize;		// 菜单项数量
+	ControlMenuItem* menuItemList;	// 菜单项列表
+} ControlInfo;
+
+// GetControlListReply 获取控制项列表响应参数
+typedef struct {
+	size_t controlInfoListSize;	  // 控制项数量
+	ControlInfo* controlInfoList; // 控制项信息列表
+} GetControlListReply;
+
+// ControlValue 控制项取值
+typedef struct {
+	uint32_t id;   // 控制项标识
+	int64_t value; // 控制项取值
+} ControlValue;
+
+// ControlSnapshot 控制项快照（紧凑的二进制数据，可直接保存到文件，下次打开设备时恢复）
+typedef struct {
+	size_t dataSize; // 快照数据大小
+	uint8_t* data;	 // 快照数据
+} ControlSnapshot;
+
+// ExposureMode 采集配置中的曝光方式
+typedef enum {
+	EXPOSURE_MODE_KEEP,			// 保持设备当前曝光方式
+	EXPOSURE_MODE_MANUAL,		// 手动曝光（曝光时间不超过帧间隔）
+	EXPOSURE_MODE_AUTO_BOUNDED, // 自动曝光，但不允许为延长曝光而降低帧率
+} ExposureMode;
+
+// PowerLineFrequency 采集配置中的电源频率（抗工频闪烁）
+typedef enum {
+	POWER_LINE_FREQUENCY_KEEP,	   // 保持设备当前设置
+	POWER_LINE_FREQUENCY_DISABLED, // 关闭抗闪烁
+	POWER_LINE_FREQUENCY_50HZ,	   // 50Hz
+	POWER_LINE_FREQUENCY_60HZ,	   // 60Hz
+	POWER_LINE_FREQUENCY_AUTO,	   // 自动检测
+} PowerLineFrequency;
+
+// CaptureProfile 低延迟采集配置（在开始取流前应用，保证设备按协商的帧率输出）
+typedef struct {
+	ExposureMode exposureMode;				// 曝光方式
+	uint32_t exposureTime;					// 手动曝光时间（单位100微秒，为0时取帧间隔）
+	PowerLineFrequency powerLineFrequency;	// 电源频率
+	uint32_t verifyFrameCount;				// 用于校验实际帧率的帧数（为0时不校验）
+} CaptureProfile;
+
+// CaptureProfileControl 采集配置已生效的控制项（按位组合）
+typedef enum {
+	CAPTURE_PROFILE_CONTROL_EXPOSURE_PRIORITY = 1 << 0, // 已关闭帧率让位于曝光（exposure_auto_priority=0）
+	CAPTURE_PROFILE_CONTROL_EXPOSURE_MODE = 1 << 1,		// 已设置曝光方式
+	CAPTURE_PROFILE_CONTROL_EXPOSURE_TIME = 1 << 2,		// 已设置手动曝光时间
+	CAPTURE_PROFILE_CONTROL_POWER_LINE = 1 << 3,		// 已设置电源频率
+} CaptureProfileControl;
+
+// FrameRateCheck 帧率校验结果
+typedef enum {
+	FRAME_RATE_CHECK_DISABLED,	 // 未校验
+	FRAME_RATE_CHECK_PENDING,	 // 校验中（已取得的帧数不足）
+	FRAME_RATE_CHECK_MATCHED,	 // 实际帧率与协商帧率一致
+	FRAME_RATE_CHECK_MISMATCHED, // 实际帧率低于协商帧率
+} FrameRateCheck;
+
+// CaptureProfileReport 采集配置应用结果
+typedef struct {
+	uint32_t appliedControls;	   // 已生效的控制项 @ref(CaptureProfileControl)
+	uint32_t exposureTime;		   // 已设置的手动曝光时间（单位100微秒）
+	uint32_t negotiatedFrameRate;  // 协商的帧率（单位0.001帧/秒）
+	uint32_t measuredFrameRate;	   // 实际测得的帧率（单位0.001帧/秒，校验完成前为0）
+	uint32_t measuredFrameCount;   // 参与测量的设备帧数（含未被取走而丢弃的帧）
+	FrameRateCheck frameRateCheck; // 帧率校验结果
+} CaptureProfileReport;
+
+// AutoExposureConfig 软件自动曝光配置（由Becam根据视频帧亮度调整曝光时间和增益，保证帧率不下降）
+typedef struct {
+	uint32_t targetLow;		   // 目标平均亮度下限（0~255，上下限均为0时取默认范围）
+	uint32_t targetHigh;	   // 目标平均亮度上限（0~255）
+	uint32_t maxExposureTime;  // 曝光时间上限（单位100微秒，为0或超过帧间隔时取帧间隔）
+	int64_t maxGain;		   // 增益上限（为0时取设备最大值）
+	uint32_t sampleStep;	   // 亮度统计采样步长（每隔多少行、多少列采样一次，为0时取默认值）
+	uint32_t settleFrames;	   // 每次调整后等待生效的帧数（为0时取默认值）
+} AutoExposureConfig;
+
+// AutoExposureState 软件自动曝光状态
+typedef struct {
+	uint32_t active;	   // 是否正在调节（设备不支持手动曝光或视频帧为压缩格式时为0）
+	uint32_t meanLuma;	   // 最近一帧的平均亮度（0~255）
+	uint32_t exposureTime; // 当前曝光时间（单位100微秒）
+	int64_t gain;		   // 当前增益
+	uint32_t adjustCount;  // 累计调整次数
+} AutoExposureState;
+
+// DecodePipelineConfig 帧级并行解码配置（MJPEG设备解码输出时将相邻视频帧分发到多个线程解码，按采集顺序输出）
+typedef struct {
+	uint32_t threadCount; // 解码线程数（为0时取处理器核心数，为1时在取帧线程中串行解码）
+	uint32_t maxInFlight; // 在途帧数上限（为0时取解码线程数加1，额外延迟不超过该值减1个帧间隔）
+} DecodePipelineConfig;
+
+// DecodePipelineState 帧级并行解码状态
+typedef struct {
+	uint32_t threadCount;	 // 解码线程数（未启用并行解码时为0）
+	uint32_t maxInFlight;	 // 在途帧数上限
+	uint32_t inFlight;		 // 当前在途帧数
+	uint64_t frameCount;	 // 累计输出帧数
+	uint64_t averageLatency; // 从取得设备帧到输出的平均延迟（微秒）
+	uint64_t maxLatency;	 // 最大延迟（微秒）
+	uint64_t lastLatency;	 // 最近一帧延迟（微秒）
+} DecodePipelineState;
+
+// ParallelPolicy 单帧图像处理的并行策略（格式转换、缩放等逐像素阶段按行带切分到共享线程池执行，线程在多帧之间复用）
+typedef struct {
+	uint32_t threadCount; // 并行度（含取帧线程，为0时取处理器核心数，为1时串行处理）
+	uint32_t bandRows;	  // 每个行带的行数（为0时按并行度均分，4:2:0格式向上取偶数以免色度行跨行带）
+} ParallelPolicy;
+
+// StageTiming 单个处理阶段的耗时统计
+typedef struct {
+	uint64_t frameCount;  // 累计执行帧数
+	uint64_t averageTime; // 平均耗时（微秒）
+	uint64_t maxTime;	  // 最大耗时（微秒）
+	uint64_t lastTime;	  // 最近一帧耗时（微秒）
+} StageTiming;
+
+// StageTimings 取帧线程中各处理阶段的耗时统计（开始取流时清零）
+typedef struct {
+	uint32_t threadCount; // 生效的并行度
+	StageTiming decode;	  // MJPEG解码（帧级并行解码时在解码线程中执行，不计入）
+	StageTiming resize;	  // 缩放
+	StageTiming convert;  // 格式转换
+} StageTimings;
+
+// DeviceInfo 设备信息（作为列表元素返回，布局不可变更，新增信息通过DeviceInfoExtension查询）
 typedef struct {
 	char* name;		  // 设备友好名称
 	char* devicePath; // 设备唯一标识符
 } DeviceInfo;
 
+// DeviceInfoExtension 设备扩展信息（新增字段只能追加在末尾）
+typedef struct {
+	size_t structSize;			// 结构体大小（调用方填写sizeof(DeviceInfoExtension)，返回时为实际写入的大小）
+	char* deviceId;				// 设备稳定标识（由总线信息、USB VID:PID及序列号构成，重新插拔或重启后不变）
+	size_t siblingPathListSize; // 同一物理设备的其它节点数量
+	char** siblingPathList;		// 同一物理设备的其它节点路径（例如UVC元数据节点）
+} DeviceInfoExtension;
+
 // GetDeviceListReply 获取设备列表响应参数
 typedef struct {
 	size_t deviceInfoListSize;	// 设备数量
@@ -125,6 +465,38 @@ typedef struct {
 	VideoFrameInfo* videoFrameInfoList; // 视频帧信息列表
 } GetDeviceConfigListReply;
 
+// NegotiatePolicy 视频帧协商策略
+typedef struct {
+	const uint32_t* formatList; // 允许的格式列表（FOURCC表示，为空时仅允许期望格式，期望格式为0时不限制）
+	size_t formatListSize;		// 允许的格式数量
+	uint32_t outputFormat;		// 下游需要的格式（FOURCC表示，为0时不计算格式转换开销）
+	uint32_t bandwidthWeight;	// USB带宽开销权重
+	uint32_t decodeWeight;		// 解码开销权重（MJPEG等压缩格式）
+	uint32_t convertWeight;		// 格式转换开销权重
+} NegotiatePolicy;
+
+// BandwidthPlanRequest 带宽规划请求项
+typedef struct {
+	const char* devicePath;		   // 设备路径
+	VideoFrameInfo desired;		   // 期望的视频帧信息（宽、高、帧率为最低要求）
+	const NegotiatePolicy* policy; // 协商策略（可为空，仅使用其中的格式限制）
+} BandwidthPlanRequest;
+
+// BandwidthPlanItem 带宽规划结果项
+typedef struct {
+	VideoFrameInfo frameInfo; // 规划的视频帧信息（无可用配置时全为0）
+	uint32_t busNumber;		  // USB总线编号（非USB设备为0）
+	uint32_t linkSpeed;		  // 设备USB链路速率（Mbit/s，非USB设备为0）
+	uint64_t payloadRate;	  // 估算的载荷速率（bit/s）
+} BandwidthPlanItem;
+
+// BandwidthPlanReply 带宽规划响应参数
+typedef struct {
+	size_t planItemListSize;		 // 规划结果数量（与请求项一一对应）
+	BandwidthPlanItem* planItemList; // 规划结果列表
+	uint32_t fits;					 // 所有设备是否都在总线带宽预算内（1：是，0：否）
+} BandwidthPlanReply;
+
 #ifdef __cplusplus
 extern "C" {
 #endif /* __cplusplus */
@@ -151,10 +523,47 @@ BECAM_API StatusCode BecamGetDeviceList(const BecamHandle handle, GetDeviceListR
 
 /**
  * @brief 释放设备列表
- * @param input [in] 输入参数
+ * @param input [in] 由BecamGetDeviceList获取且尚未释放的设备列表
  */
 BECAM_API void BecamFreeDeviceList(GetDeviceListReply* input);
 
+/**
+ * @brief 获取设备扩展信息
+ *
+ * 只写入structSize以内的字段，旧版本调用方不会被新增字段越界写入；
+ * 返回的字符串归设备列表所有，调用BecamFreeDeviceList后失效
+ *
+ * @param reply [in] 由BecamGetDeviceList获取的设备列表
+ * @param index [in] 设备在列表中的序号
+ * @param extension [in && out] 设备扩展信息（调用前需填写structSize）
+ * @return 状态码 @ref(StatusCode)
+ */
+BECAM_API StatusCode BecamGetDeviceInfoExtension(const GetDeviceListReply* reply, size_t index, DeviceInfoExtension* extension);
+
+/**
+ * @brief 根据设备稳定标识查找当前的设备路径
+ * @param handle [in] Becam接口句柄
+ * @param deviceId [in] 设备稳定标识 @ref(DeviceInfoExtension.deviceId)
+ * @param devicePath [out] 设备路径（需调用BecamFreeDevicePath释放）
+ * @return 状态码 @ref(StatusCode)
+ */
+BECAM_API StatusCode BecamFindDevicePath(const BecamHandle handle, const char* deviceId, char** devicePath);
+
+/**
+ * @brief 释放设备路径
+ * @param devicePath [in] 设备路径
+ */
+BECAM_API void BecamFreeDevicePath(char** devicePath);
+
+/**
+ * @brief 设置热插拔回调（设备接入或移除时立即通知，无需轮询设备列表）
+ * @param handle [in] Becam接口句柄
+ * @param callback [in] 热插拔回调函数（为空时停止监听）
+ * @param userData [in] 透传给回调函数的用户数据
+ * @return 状态码 @ref(StatusCode)
+ */
+BECAM_API StatusCode BecamSetHotplugCallback(const BecamHandle handle, BecamHotplugCallback callback, void* userData);
+
 /**
  * @brief 获取设备配置列表
  * @param handle [in] Becam接口句柄
@@ -170,6 +579,35 @@ BECAM_API StatusCode BecamGetDeviceConfigList(const BecamHandle handle, const ch
  */
 BECAM_API void BecamFreeDeviceConfigList(GetDeviceConfigListReply* input);
 
+/**
+ * @brief 协商设备视频帧信息（选出满足最低要求且综合开销最小的配置）
+ * @param handle [in] Becam接口句柄
+ * @param devicePath [in] 设备路径
+ * @param desired [in] 期望的视频帧信息（宽、高、帧率为最低要求）
+ * @param policy [in] 协商策略（可为空，为空时各项开销等权重）
+ * @param chosen [out] 选中的视频帧信息
+ * @return 状态码 @ref(StatusCode)
+ */
+BECAM_API StatusCode BecamNegotiate(const BecamHandle handle, const char* devicePath, const VideoFrameInfo* desired,
+									const NegotiatePolicy* policy, VideoFrameInfo* chosen);
+
+/**
+ * @brief 规划多个设备共享USB总线时的视频帧信息（在总线带宽预算内使总像素吞吐最大）
+ * @param handle [in] Becam接口句柄
+ * @param requestList [in] 带宽规划请求列表
+ * @param requestListSize [in] 带宽规划请求数量
+ * @param reply [out] 输出参数
+ * @return 状态码 @ref(StatusCode)
+ */
+BECAM_API StatusCode BecamPlanBandwidth(const BecamHandle handle, const BandwidthPlanRequest* requestList, size_t requestListSize,
+										BandwidthPlanReply* reply);
+
+/**
+ * @brief 释放带宽规划结果
+ * @param input [in] 输入参数
+ */
+BECAM_API void BecamFreeBandwidthPlan(BandwidthPlanReply* input);
+
 /**
  * @brief 打开设备
  * @param handle [in] Becam接口句柄
@@ -194,6 +632,358 @@ BECAM_API void BecamCloseDevice(const BecamHandle handle);
  */
 BECAM_API StatusCode BecamGetFrame(const BecamHandle handle, uint8_t** data, size_t* size);
 
+/**
+ * @brief 获取视频帧及其元数据
+ * @param handle [in] Becam接口句柄
+ * @param data [out] 视频帧流
+ * @param size [out] 视频帧流大小
+ * @param meta [out] 视频帧元数据
+ * @return 状态码 @ref(StatusCode)
+ */
+BECAM_API StatusCode BecamGetFrameWithMeta(const BecamHandle handle, uint8_t** data, size_t* size, VideoFrameMeta* meta);
+
+/**
+ * @brief 获取已打开设备实际生效的视频帧格式（与BecamGetFrame返回的视频帧布局一致，软件裁剪时为裁剪后的布局）
+ * @param handle [in] Becam接口句柄
+ * @param format [out] 视频帧格式
+ * @return 状态码 @ref(StatusCode)
+ */
+BECAM_API StatusCode BecamGetCurrentFormat(const BecamHandle handle, FrameFormat* format);
+
+/**
+ * @brief 设置裁剪区域（打开设备前设置时在打开时生效，取流过程中设置时立即生效）
+ * @note 打开设备时优先使用设备裁剪（VIDIOC_S_SELECTION/VIDIOC_S_CROP）以节省总线带宽，设备不支持时对非压缩格式进行软件裁剪；
+ *       取流过程中只进行软件裁剪，当前为设备裁剪或格式无法软件裁剪时返回STATUS_CODE_ERR_NOT_SUPPORTED，裁剪区域在下次打开设备时生效
+ * @param handle [in] Becam接口句柄
+ * @param rect [in] 裁剪区域（为空或宽高为0时取消裁剪）
+ * @return 状态码 @ref(StatusCode)
+ */
+BECAM_API StatusCode BecamSetCropRect(const BecamHandle handle, const CropRect* rect);
+
+/**
+ * @brief 设置输出格式（打开设备前设置时在打开时生效，取流过程中设置时立即生效）
+ * @note 直接从驱动缓冲区转换（MJPEG设备解码为RGB或GREY，YUV设备输出GREY时只抽取亮度），BecamGetFrame返回紧凑排列的目标格式；设备格式不支持转换到目标格式时返回STATUS_CODE_ERR_NOT_SUPPORTED
+ * @param handle [in] Becam接口句柄
+ * @param format [in] 输出格式（FOURCC表示，为0时取消转换）
+ * @return 状态码 @ref(StatusCode)
+ */
+BECAM_API StatusCode BecamSetOutputFormat(const BecamHandle handle, uint32_t format);
+
+/**
+ * @brief 设置输出缩放（打开设备前设置时在打开时生效，取流过程中设置时立即生效）
+ * @note 非压缩格式在软件裁剪之后、格式转换之前直接从驱动缓冲区缩放（先缩小再转换开销最低），MJPEG设备在解码（含DCT域缩放）之后缩放；
+ * 直接输出MJPEG视频帧时不缩放
+ * @param handle [in] Becam接口句柄
+ * @param config [in] 缩放配置（为空或宽高为0时取消缩放）
+ * @return 状态码 @ref(StatusCode)
+ */
+BECAM_API StatusCode BecamSetOutputResize(const BecamHandle handle, const ResizeConfig* config);
+
+/**
+ * @brief 设置MJPEG解码缩放比例（打开设备前设置时在打开时生效，取流过程中设置时立即生效）
+ * @note 仅在设备输出MJPEG且通过BecamSetOutputFormat设置了输出格式时生效，缩放在DCT域完成，解码开销随比例下降
+ * @param handle [in] Becam接口句柄
+ * @param scaleDenom [in] 缩放分母（1、2、4、8，输出宽高为原始宽高除以该值后向上取整）
+ * @return 状态码 @ref(StatusCode)
+ */
+BECAM_API StatusCode BecamSetDecodeScale(const BecamHandle handle, uint32_t scaleDenom);
+
+/**
+ * @brief 设置帧内分条并行解码线程数（打开设备前设置时在打开时生效，取流过程中设置时立即生效）
+ * @note 仅对串行解码生效（帧级并行解码时不再切分），带重启标记的MJPEG帧在重启间隔边界处切分后多线程解码，降低单帧延迟；没有重启标记时串行解码
+ * @param handle [in] Becam接口句柄
+ * @param threadCount [in] 线程数（为0时取处理器核心数，为1时不切分）
+ * @return 状态码 @ref(StatusCode)
+ */
+BECAM_API StatusCode BecamSetDecodeStripThreads(const BecamHandle handle, uint32_t threadCount);
+
+/**
+ * @brief 设置帧级并行解码（打开设备前设置时在打开时生效，取流过程中设置时丢弃在途的视频帧后立即生效）
+ * @note 仅在设备输出MJPEG且通过BecamSetOutputFormat设置了输出格式时生效，吞吐量随线程数提升，代价是有上限的额外延迟
+ * @param handle [in] Becam接口句柄
+ * @param config [in] 并行解码配置（为空时恢复串行解码）
+ * @return 状态码 @ref(StatusCode)
+ */
+BECAM_API StatusCode BecamSetDecodePipeline(const BecamHandle handle, const DecodePipelineConfig* config);
+
+/**
+ * @brief 获取帧级并行解码状态（含实测的额外延迟）
+ * @param handle [in] Becam接口句柄
+ * @param state [out] 并行解码状态
+ * @return 状态码 @ref(StatusCode)
+ */
+BECAM_API StatusCode BecamGetDecodePipelineState(const BecamHandle handle, DecodePipelineState* state);
+
+/**
+ * @brief 设置单帧图像处理的并行策略（下一帧起生效，关闭设备后仍保留）
+ * @note 并行结果与串行逐字节一致；线程池在设置时创建并在多帧之间复用
+ * @param handle [in] Becam接口句柄
+ * @param policy [in] 并行策略（为空时恢复串行处理）
+ * @return 状态码 @ref(StatusCode)
+ */
+BECAM_API StatusCode BecamSetParallelPolicy(const BecamHandle handle, const ParallelPolicy* policy);
+
+/**
+ * @brief 获取取帧线程中各处理阶段的耗时统计
+ * @param handle [in] Becam接口句柄
+ * @param timings [out] 耗时统计
+ * @return 状态码 @ref(StatusCode)
+ */
+BECAM_API StatusCode BecamGetStageTimings(const BecamHandle handle, StageTimings* timings);
+
+/**
+ * @brief 设置是否为MJPEG视频帧补齐霍夫曼表（打开设备前设置时在打开时生效，取流过程中设置时立即生效）
+ * @note 仅在直接输出MJPEG视频帧时生效，缺少DHT段的帧在拷贝时插入标准霍夫曼表（不解码），BecamGetFrame返回可独立使用的JPEG文件
+ * @param handle [in] Becam接口句柄
+ * @param enable [in] 是否补齐（1：是，0：否）
+ * @return 状态码 @ref(StatusCode)
+ */
+BECAM_API StatusCode BecamSetInsertHuffmanTables(const BecamHandle handle, uint32_t enable);
+
+/**
+ * @brief 设置是否启用设备配置列表的持久化缓存（默认不启用，设置了环境变量BECAM_CACHE_DIR时默认启用）
+ * @note 启用后冷启动时命中缓存直接返回配置列表，并在后台线程中打开设备重新枚举校验；后台线程在BecamFree时等待结束
+ * @param handle [in] Becam接口句柄
+ * @param enable [in] 是否启用（1：是，0：否）
+ * @param cacheDir [in] 缓存目录（为空时依次使用BECAM_CACHE_DIR、$XDG_CACHE_HOME/becam、$HOME/.cache/becam）
+ * @return 状态码 @ref(StatusCode)
+ */
+BECAM_API StatusCode BecamSetCapabilityCache(const BecamHandle handle, uint32_t enable, const char* cacheDir);
+
+/**
+ * @brief 创建MJPEG解码器（多帧之间复用解压对象，同一个解码器不可并发使用）
+ * @return MJPEG解码器句柄（未启用libjpeg支持时为空）
+ */
+BECAM_API BecamMjpegDecoderHandle BecamNewMjpegDecoder();
+
+/**
+ * @brief 释放MJPEG解码器
+ * @param decoder [in] MJPEG解码器句柄
+ */
+BECAM_API void BecamFreeMjpegDecoder(BecamMjpegDecoderHandle* decoder);
+
+/**
+ * @brief 设置MJPEG解码器的分条并行解码线程数（带重启标记的帧切分后多线程解码，解码结果与串行解码一致）
+ * @param decoder [in] MJPEG解码器句柄
+ * @param threadCount [in] 线程数（为0时取处理器核心数，为1时不切分）
+ * @return 状态码 @ref(StatusCode)
+ */
+BECAM_API StatusCode BecamSetMjpegDecoderThreads(BecamMjpegDecoderHandle decoder, uint32_t threadCount);
+
+/**
+ * @brief 获取MJPEG帧按指定比例解码后的尺寸（用于分配目标缓冲区）
+ * @param decoder [in] MJPEG解码器句柄
+ * @param data [in] MJPEG帧数据
+ * @param size [in] MJPEG帧数据大小
+ * @param scaleDenom [in] 缩放分母（1、2、4、8）
+ * @param width [out] 解码后的宽度
+ * @param height [out] 解码后的高度
+ * @return 状态码 @ref(StatusCode)
+ */
+BECAM_API StatusCode BecamGetMjpegOutputSize(BecamMjpegDecoderHandle decoder, const uint8_t* data, size_t size, uint32_t scaleDenom, uint32_t* width,
+											 uint32_t* height);
+
+/**
+ * @brief 解码MJPEG帧（缺少霍夫曼表的UVC帧使用标准表解码）
+ * @param decoder [in] MJPEG解码器句柄
+ * @param data [in] MJPEG帧数据
+ * @param size [in] MJPEG帧数据大小
+ * @param scaleDenom [in] 缩放分母（1、2、4、8）
+ * @param dst [in && out] 目标图像（RGB24、BGR24、RGBA32、BGRA32或GREY，宽高需为缩放后的尺寸，缓冲区由调用方分配）
+ * @return 状态码 @ref(StatusCode)
+ */
+BECAM_API StatusCode BecamDecodeMjpeg(BecamMjpegDecoderHandle decoder, const uint8_t* data, size_t size, uint32_t scaleDenom, ImageBuffer* dst);
+
+/**
+ * @brief 计算MJPEG帧补齐霍夫曼表后的大小
+ * @param data [in] MJPEG帧数据
+ * @param size [in] MJPEG帧数据大小
+ * @return 补齐后的大小（帧内已有霍夫曼表时与原大小相同）
+ */
+BECAM_API size_t BecamGetCompleteJpegSize(const uint8_t* data, size_t size);
+
+/**
+ * @brief 拷贝MJPEG帧并补齐霍夫曼表（缺少DHT段时在SOS之前插入标准表，不解码）
+ * @param data [in] MJPEG帧数据
+ * @param size [in] MJPEG帧数据大小
+ * @param dst [out] 目标缓冲区（由调用方分配）
+ * @param dstSize [in] 目标缓冲区大小（不小于BecamGetCompleteJpegSize的返回值）
+ * @param outSize [out] 写入的字节数
+ * @return 状态码 @ref(StatusCode)
+ */
+BECAM_API StatusCode BecamCopyCompleteJpeg(const uint8_t* data, size_t size, uint8_t* dst, size_t dstSize, size_t* outSize);
+
+/**
+ * @brief 计算图像紧凑排列时所需的字节数
+ * @param format [in] 图像格式（FOURCC表示）
+ * @param width [in] 图像宽度
+ * @param height [in] 图像高度
+ * @return 字节数（不支持的格式为0）
+ */
+BECAM_API size_t BecamGetImageSize(uint32_t format, uint32_t width, uint32_t height);
+
+/**
+ * @brief 按连续内存填充图像缓冲区描述（与BecamGetFrame返回的视频帧配合使用）
+ * @param image [in && out] 图像缓冲区描述（需已填写格式、宽、高）
+ * @param data [in] 图像数据
+ * @param size [in] 图像数据大小
+ * @param bytesPerLine [in] 每行字节数（平面格式为第一个平面，为0时按紧凑排列）
+ * @return 状态码 @ref(StatusCode)
+ */
+BECAM_API StatusCode BecamFillImageBuffer(ImageBuffer* image, uint8_t* data, size_t size, uint32_t bytesPerLine);
+
+/**
+ * @brief 转换图像格式（按CPU支持的指令集选择SSE2/AVX2/NEON实现，与标量实现结果逐位一致）
+ * @note 支持打包YUV 4:2:2转RGB，YUYV、UYVY、NV12、NV21、I420、YV12之间的重排（4:2:2转4:2:0时色度垂直平均），以及以上YUV格式转GREY（只抽取亮度）
+ * @param src [in] 源图像
+ * @param dst [in && out] 目标图像（宽高需与源图像一致，缓冲区由调用方分配）
+ * @return 状态码 @ref(StatusCode)
+ */
+BECAM_API StatusCode BecamConvertImage(const ImageBuffer* src, ImageBuffer* dst);
+
+/**
+ * @brief 获取YUV图像的亮度视图（不拷贝数据，视图在源图像内存释放前有效）
+ * @note 支持打包YUV 4:2:2、NV12、NV21、I420、YV12及GREY；需要紧凑排列的灰度数据时使用BecamConvertImage转换为GREY
+ * @param image [in] 源图像
+ * @param view [out] 亮度视图
+ * @return 状态码 @ref(StatusCode)
+ */
+BECAM_API StatusCode BecamGetLumaView(const ImageBuffer* image, LumaView* view);
+
+/**
+ * @brief 缩放图像（按CPU支持的指令集选择SSE2/AVX2/NEON实现，与标量实现结果逐位一致）
+ * @note 支持打包YUV 4:2:2、NV12、NV21、I420、YV12、RGB及GREY，各平面每行字节数可不紧凑；盒式及区域滤波的1/2、1/3、1/4（双线性的1/2）走整数求和快速路径
+ * @param src [in] 源图像
+ * @param dst [in && out] 目标图像（格式需与源图像一致，宽高为缩放后的尺寸，缓冲区由调用方分配）
+ * @param filter [in] 滤波方式
+ * @return 状态码 @ref(StatusCode)
+ */
+BECAM_API StatusCode BecamResizeImage(const ImageBuffer* src, ImageBuffer* dst, ResizeFilter filter);
+
+/**
+ * @brief 计算张量所需的字节数
+ * @param config [in] 图像转张量配置
+ * @return 字节数（配置无效时为0）
+ */
+BECAM_API size_t BecamGetTensorSize(const TensorConfig* config);
+
+/**
+ * @brief 图像转张量（格式转换、双线性缩放、归一化及布局重排一次完成，源图像只读取一遍）
+ * @note 支持打包YUV 4:2:2、NV12、NV21、I420、YV12（BT.601有限范围，在YUV域插值后转RGB）、RGB及GREY（三个通道相同）；
+ * 按CPU支持的指令集选择SSE2/AVX2/NEON实现
+ * @param src [in] 源图像
+ * @param config [in] 图像转张量配置
+ * @param dst [out] 张量缓冲区（由调用方分配，大小见BecamGetTensorSize）
+ * @param dstSize [in] 张量缓冲区大小
+ * @param placement [out] 图像在张量中的位置（可为空）
+ * @return 状态码 @ref(StatusCode)
+ */
+BECAM_API StatusCode BecamImageToTensor(const ImageBuffer* src, const TensorConfig* config, void* dst, size_t dstSize, TensorPlacement* placement);
+
+/**
+ * @brief 视频帧转张量（按BecamGetCurrentFormat返回的格式、宽高及每行字节数解析BecamGetFrame返回的视频帧）
+ * @note MJPEG视频帧返回STATUS_CODE_ERR_NOT_SUPPORTED，可先通过BecamSetOutputFormat在取流时解码
+ * @param format [in] 当前视频帧格式
+ * @param data [in] 视频帧数据
+ * @param size [in] 视频帧数据大小
+ * @param config [in] 图像转张量配置
+ * @param dst [out] 张量缓冲区（由调用方分配，大小见BecamGetTensorSize）
+ * @param dstSize [in] 张量缓冲区大小
+ * @param placement [out] 图像在张量中的位置（可为空）
+ * @return 状态码 @ref(StatusCode)
+ */
+BECAM_API StatusCode BecamFrameToTensor(const FrameFormat* format, const uint8_t* data, size_t size, const TensorConfig* config, void* dst,
+										size_t dstSize, TensorPlacement* placement);
+
+/**
+ * @brief 获取已打开设备的控制项列表（结果缓存在句柄中，设备关闭后失效）
+ * @param handle [in] Becam接口句柄
+ * @param reply [out] 输出参数
+ * @return 状态码 @ref(StatusCode)
+ */
+BECAM_API StatusCode BecamGetControlList(const BecamHandle handle, GetControlListReply* reply);
+
+/**
+ * @brief 释放控制项列表
+ * @param input [in] 输入参数
+ */
+BECAM_API void BecamFreeControlList(GetControlListReply* input);
+
+/**
+ * @brief 批量读取已打开设备的控制项（优先使用句柄中缓存的取值，易变控制项总是查询设备）
+ * @param handle [in] Becam接口句柄
+ * @param valueList [in && out] 控制项取值列表（填写id，返回value）
+ * @param valueListSize [in] 控制项数量
+ * @return 状态码 @ref(StatusCode)
+ */
+BECAM_API StatusCode BecamGetControls(const BecamHandle handle, ControlValue* valueList, size_t valueListSize);
+
+/**
+ * @brief 批量设置已打开设备的控制项（按给定顺序一次调用写入，旧驱动按控制项类别分组；全部校验通过后才会写入）
+ * @param handle [in] Becam接口句柄
+ * @param valueList [in] 控制项取值列表
+ * @param valueListSize [in] 控制项数量
+ * @return 状态码 @ref(StatusCode)
+ */
+BECAM_API StatusCode BecamSetControls(const BecamHandle handle, const ControlValue* valueList, size_t valueListSize);
+
+/**
+ * @brief 保存已打开设备当前的控制项快照（仅包含可读写且当前生效的控制项）
+ * @param handle [in] Becam接口句柄
+ * @param snapshot [out] 控制项快照
+ * @return 状态码 @ref(StatusCode)
+ */
+BECAM_API StatusCode BecamSaveControlSnapshot(const BecamHandle handle, ControlSnapshot* snapshot);
+
+/**
+ * @brief 释放控制项快照
+ * @param snapshot [in] 控制项快照
+ */
+BECAM_API void BecamFreeControlSnapshot(ControlSnapshot* snapshot);
+
+/**
+ * @brief 设置打开设备时恢复的控制项快照（在开始取流前一次调用写入，取流过程中设置时立即写入）
+ * @note 快照数据会被拷贝，设备不支持的控制项会被跳过；采集配置及软件自动曝光在快照之后应用
+ * @param handle [in] Becam接口句柄
+ * @param snapshot [in] 控制项快照（为空时取消）
+ * @return 状态码 @ref(StatusCode)
+ */
+BECAM_API StatusCode BecamSetControlSnapshot(const BecamHandle handle, const ControlSnapshot* snapshot);
+
+/**
+ * @brief 设置低延迟采集配置（打开设备前设置时在打开时生效，取流过程中设置时立即生效）
+ * @note 总是关闭帧率让位于曝光（V4L2_CID_EXPOSURE_AUTO_PRIORITY=0），设备不支持的控制项会被跳过
+ * @param handle [in] Becam接口句柄
+ * @param profile [in] 采集配置（为空时取消，已修改的控制项不会恢复）
+ * @return 状态码 @ref(StatusCode)
+ */
+BECAM_API StatusCode BecamSetCaptureProfile(const BecamHandle handle, const CaptureProfile* profile);
+
+/**
+ * @brief 获取采集配置应用结果（帧率根据取走的视频帧的序号及时间戳测量）
+ * @param handle [in] Becam接口句柄
+ * @param report [out] 应用结果
+ * @return 状态码 @ref(StatusCode)
+ */
+BECAM_API StatusCode BecamGetCaptureProfileReport(const BecamHandle handle, CaptureProfileReport* report);
+
+/**
+ * @brief 设置软件自动曝光（打开设备前设置时在打开时生效，取流过程中设置时立即生效）
+ * @note 开启后设备切换为手动曝光，每次获取视频帧时统计亮度直方图，按需调整曝光时间（不超过帧间隔）及增益
+ * @param handle [in] Becam接口句柄
+ * @param config [in] 自动曝光配置（为空时停止调节，曝光时间和增益保持当前值）
+ * @return 状态码 @ref(StatusCode)
+ */
+BECAM_API StatusCode BecamSetAutoExposure(const BecamHandle handle, const AutoExposureConfig* config);
+
+/**
+ * @brief 获取软件自动曝光状态
+ * @param handle [in] Becam接口句柄
+ * @param state [out] 自动曝光状态
+ * @return 状态码 @ref(StatusCode)
+ */
+BECAM_API StatusCode BecamGetAutoExposureState(const BecamHandle handle, AutoExposureState* state);
+
 /**
  * @brief 释放视频帧
  * @param data [in] 视频帧流
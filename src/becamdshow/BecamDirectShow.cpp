@@ -2,6 +2,8 @@
 #include "BecamAmMediaType.hpp"
 #include "BecamDeviceEnum.hpp"
 #include "BecamMonikerPropReader.hpp"
+#include <pkg/DeviceListArena.hpp>
+#include <pkg/FrameNegotiate.hpp>
 #include <pkg/LogOutput.hpp>
 #include <pkg/StringConvert.hpp>
 #include <vector>
@@ -31,7 +33,7 @@ StatusCode BecamDirectShow::GetDeviceList(GetDeviceListReply& reply) {
 	reply.deviceInfoList = nullptr;
 
 	// 声明vector来储存设备列表
-	std::vector<DeviceInfo> deviceVec;
+	std::vector<DeviceListArenaEntry> deviceVec;
 	// 初始化设备枚举类
 	auto deviceEnum = BecamDeviceEnum(true);
 	// 开始枚举设备
@@ -53,17 +55,11 @@ StatusCode BecamDirectShow::GetDeviceList(GetDeviceListReply& reply) {
 		}
 
 		// 构建设备信息
-		DeviceInfo deviceInfo = {0};
-		// 转换为C字符串
-		if (friendlyName.size() > 0) {
-			deviceInfo.name = new char[friendlyName.size() + 1];
-			memcpy(deviceInfo.name, friendlyName.c_str(), friendlyName.size() + 1);
-		}
-		// 转换为C字符串
-		if (devicePath.size() > 0) {
-			deviceInfo.devicePath = new char[devicePath.size() + 1];
-			memcpy(deviceInfo.devicePath, devicePath.c_str(), devicePath.size() + 1);
-		}
+		DeviceListArenaEntry deviceInfo;
+		deviceInfo.name = friendlyName;
+		deviceInfo.devicePath = devicePath;
+		// 设备路径（符号链接）中已包含VID、PID及实例路径，重新插拔后不变，直接作为稳定标识
+		deviceInfo.deviceId = devicePath;
 
 		// 追加到结果中
 		deviceVec.insert(deviceVec.end(), deviceInfo);
@@ -76,13 +72,8 @@ StatusCode BecamDirectShow::GetDeviceList(GetDeviceListReply& reply) {
 		DEBUG_LOG("BecamDirectShow::GetDeviceList -> EnumVideoDevices failed, CODE: " << code);
 		return code;
 	}
-	// 是否有枚举到设备
-	if (deviceVec.size() > 0) {
-		// 拷贝设备列表
-		reply.deviceInfoListSize = deviceVec.size();
-		reply.deviceInfoList = new DeviceInfo[reply.deviceInfoListSize];
-		memcpy(reply.deviceInfoList, deviceVec.data(), reply.deviceInfoListSize * sizeof(DeviceInfo));
-	}
+	// 拷贝设备列表（设备信息及字符串位于同一内存块）
+	BuildDeviceListArena(deviceVec, reply.deviceInfoList, reply.deviceInfoListSize);
 
 	// OK
 	return StatusCode::STATUS_CODE_SUCCESS;
@@ -92,31 +83,8 @@ StatusCode BecamDirectShow::GetDeviceList(GetDeviceListReply& reply) {
  * @implements 实现释放设备列表
  */
 void BecamDirectShow::FreeDeviceList(GetDeviceListReply& input) {
-	// 检查
-	if (input.deviceInfoListSize <= 0 || input.deviceInfoList == nullptr) {
-		return;
-	}
-
-	// 遍历，执行释放操作
-	for (size_t i = 0; i < input.deviceInfoListSize; i++) {
-		// 获取引用
-		auto item = input.deviceInfoList[i];
-		// 释放友好名称
-		if (item.name != nullptr) {
-			delete[] item.name;
-			item.name = nullptr;
-		}
-		// 释放设备路径
-		if (item.devicePath != nullptr) {
-			delete[] item.devicePath;
-			item.devicePath = nullptr;
-		}
-	}
-
-	// 释放整个列表
-	delete[] input.deviceInfoList;
-	input.deviceInfoListSize = 0;
-	input.deviceInfoList = nullptr;
+	// 整块释放
+	FreeDeviceListArena(input.deviceInfoList, input.deviceInfoListSize);
 }
 
 /**
@@ -175,6 +143,61 @@ void BecamDirectShow::FreeDeviceConfigList(GetDeviceConfigListReply& input) {
 	input.videoFrameInfoList = nullptr;
 }
 
+/**
+ * @implements 实现根据设备稳定标识查找设备路径
+ */
+StatusCode BecamDirectShow::FindDevicePath(const std::string& deviceId, std::string& devicePath) {
+	// 检查入参
+	if (deviceId.empty()) {
+		return StatusCode::STATUS_CODE_ERR_INPUT_PARAM;
+	}
+	// 获取设备列表
+	GetDeviceListReply reply = {0};
+	auto code = this->GetDeviceList(reply);
+	if (code != StatusCode::STATUS_CODE_SUCCESS) {
+		return code;
+	}
+	// 查找
+	code = StatusCode::STATUS_CODE_ERR_DEVICE_NOT_FOUND;
+	for (size_t i = 0; i < reply.deviceInfoListSize; i++) {
+		DeviceInfoExtension extension = {0};
+		extension.structSize = sizeof(extension);
+		if (GetDeviceListArenaExtension(reply.deviceInfoList, reply.deviceInfoListSize, i, extension) == StatusCode::STATUS_CODE_SUCCESS &&
+			extension.deviceId != nullptr && deviceId == extension.deviceId) {
+			devicePath = reply.deviceInfoList[i].devicePath;
+			code = StatusCode::STATUS_CODE_SUCCESS;
+			break;
+		}
+	}
+	BecamDirectShow::FreeDeviceList(reply);
+	return code;
+}
+
+/**
+ * @implements 实现协商设备视频帧信息
+ */
+StatusCode BecamDirectShow::Negotiate(const std::string& devicePath, const VideoFrameInfo& desired, const NegotiatePolicy* policy,
+									  VideoFrameInfo& chosen) {
+	// 获取设备支持的配置列表
+	GetDeviceConfigListReply reply = {0};
+	auto code = this->GetDeviceConfigList(devicePath, reply);
+	if (code != StatusCode::STATUS_CODE_SUCCESS) {
+		return code;
+	}
+	// 按开销排序
+	auto ranked = RankFrameInfoList(reply.videoFrameInfoList, reply.videoFrameInfoListSize, desired, policy);
+	BecamDirectShow::FreeDeviceConfigList(reply);
+
+	// 没有满足条件的配置
+	if (ranked.empty()) {
+		return StatusCode::STATUS_CODE_ERR_DEVICE_FRAME_FMT_NOT_FOUND;
+	}
+
+	// 选中开销最小的配置
+	chosen = ranked[0];
+	return StatusCode::STATUS_CODE_SUCCESS;
+}
+
 /**
  * @implements 实现打开指定设备
  */
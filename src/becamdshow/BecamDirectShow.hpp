@@ -62,6 +62,26 @@ public:
 	 */
 	static void FreeDeviceConfigList(GetDeviceConfigListReply& input);
 
+	/**
+	 * @brief 根据设备稳定标识查找设备路径
+	 *
+	 * @param deviceId [in] 设备稳定标识
+	 * @param devicePath [out] 设备路径
+	 * @return 状态码
+	 */
+	StatusCode FindDevicePath(const std::string& deviceId, std::string& devicePath);
+
+	/**
+	 * @brief 协商设备视频帧信息
+	 *
+	 * @param devicePath [in] 设备路径
+	 * @param desired [in] 期望的视频帧信息（宽、高、帧率为最低要求）
+	 * @param policy [in] 协商策略（可为空）
+	 * @param chosen [out] 选中的视频帧信息
+	 * @return 状态码
+	 */
+	StatusCode Negotiate(const std::string& devicePath, const VideoFrameInfo& desired, const NegotiatePolicy* policy, VideoFrameInfo& chosen);
+
 	/**
 	 * @brief 打开指定设备
 	 *
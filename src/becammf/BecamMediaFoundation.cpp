@@ -1,6 +1,8 @@
 #include "BecamMediaFoundation.hpp"
 #include <mfapi.h>
 #include <mfidl.h>
+#include <pkg/DeviceListArena.hpp>
+#include <pkg/FrameNegotiate.hpp>
 #include <pkg/LogOutput.hpp>
 #include <pkg/SafeRelease.hpp>
 #include <pkg/StringConvert.hpp>
@@ -74,6 +76,61 @@ void BecamMediaFoundation::FreeDeviceConfigList(GetDeviceConfigListReply& input)
 	BecammfDeviceHelper::FreeDeviceConfigList(input.videoFrameInfoList, input.videoFrameInfoListSize);
 }
 
+/**
+ * @implements 实现根据设备稳定标识查找设备路径
+ */
+StatusCode BecamMediaFoundation::FindDevicePath(const std::string& deviceId, std::string& devicePath) {
+	// 检查入参
+	if (deviceId.empty()) {
+		return StatusCode::STATUS_CODE_ERR_INPUT_PARAM;
+	}
+	// 获取设备列表
+	GetDeviceListReply reply = {0};
+	auto code = this->GetDeviceList(reply);
+	if (code != StatusCode::STATUS_CODE_SUCCESS) {
+		return code;
+	}
+	// 查找
+	code = StatusCode::STATUS_CODE_ERR_DEVICE_NOT_FOUND;
+	for (size_t i = 0; i < reply.deviceInfoListSize; i++) {
+		DeviceInfoExtension extension = {0};
+		extension.structSize = sizeof(extension);
+		if (GetDeviceListArenaExtension(reply.deviceInfoList, reply.deviceInfoListSize, i, extension) == StatusCode::STATUS_CODE_SUCCESS &&
+			extension.deviceId != nullptr && deviceId == extension.deviceId) {
+			devicePath = reply.deviceInfoList[i].devicePath;
+			code = StatusCode::STATUS_CODE_SUCCESS;
+			break;
+		}
+	}
+	BecamMediaFoundation::FreeDeviceList(reply);
+	return code;
+}
+
+/**
+ * @implements 实现协商设备视频帧信息
+ */
+StatusCode BecamMediaFoundation::Negotiate(const std::string& devicePath, const VideoFrameInfo& desired, const NegotiatePolicy* policy,
+										   VideoFrameInfo& chosen) {
+	// 获取设备支持的配置列表
+	GetDeviceConfigListReply reply = {0};
+	auto code = this->GetDeviceConfigList(devicePath, reply);
+	if (code != StatusCode::STATUS_CODE_SUCCESS) {
+		return code;
+	}
+	// 按开销排序
+	auto ranked = RankFrameInfoList(reply.videoFrameInfoList, reply.videoFrameInfoListSize, desired, policy);
+	BecamMediaFoundation::FreeDeviceConfigList(reply);
+
+	// 没有满足条件的配置
+	if (ranked.empty()) {
+		return StatusCode::STATUS_CODE_ERR_DEVICE_FRAME_FMT_NOT_FOUND;
+	}
+
+	// 选中开销最小的配置
+	chosen = ranked[0];
+	return StatusCode::STATUS_CODE_SUCCESS;
+}
+
 /**
  * @implements 实现打开指定设备
  */
@@ -2,6 +2,7 @@
 #include "BecammfAttributesHelper.hpp"
 #include "BecammfDeviceConfigHelper.hpp"
 #include <mfapi.h>
+#include <pkg/DeviceListArena.hpp>
 #include <pkg/LogOutput.hpp>
 #include <pkg/StringConvert.hpp>
 #include <vector>
@@ -92,7 +93,7 @@ StatusCode BecammfDeviceHelper::GetDeviceList(DeviceInfo*& reply, size_t& replyS
 	}
 
 	// 构建临时设备列表
-	std::vector<DeviceInfo> deviceList;
+	std::vector<DeviceListArenaEntry> deviceList;
 	// 遍历设备列表
 	for (size_t i = 0; i < count; i++) {
 		// 提取设备
@@ -123,17 +124,11 @@ StatusCode BecammfDeviceHelper::GetDeviceList(DeviceInfo*& reply, size_t& replyS
 		}
 
 		// 构建设备信息
-		DeviceInfo deviceInfo = {0};
-		// 转换为C字符串
-		if (friendlyName.size() > 0) {
-			deviceInfo.name = new char[friendlyName.size() + 1];
-			memcpy(deviceInfo.name, friendlyName.c_str(), friendlyName.size() + 1);
-		}
-		// 转换为C字符串
-		if (symbolicLink.size() > 0) {
-			deviceInfo.devicePath = new char[symbolicLink.size() + 1];
-			memcpy(deviceInfo.devicePath, symbolicLink.c_str(), symbolicLink.size() + 1);
-		}
+		DeviceListArenaEntry deviceInfo;
+		deviceInfo.name = friendlyName;
+		deviceInfo.devicePath = symbolicLink;
+		// 设备路径（符号链接）中已包含VID、PID及实例路径，重新插拔后不变，直接作为稳定标识
+		deviceInfo.deviceId = symbolicLink;
 
 		// 添加设备信息到临时列表
 		deviceList.push_back(deviceInfo);
@@ -144,12 +139,8 @@ StatusCode BecammfDeviceHelper::GetDeviceList(DeviceInfo*& reply, size_t& replyS
 	CoTaskMemFree(ppDevices);
 	ppDevices = nullptr;
 
-	// 拷贝零时列表到响应结果
-	if (deviceList.size() > 0) {
-		replySize = deviceList.size();
-		reply = new DeviceInfo[replySize];
-		memcpy(reply, deviceList.data(), replySize * sizeof(DeviceInfo));
-	}
+	// 拷贝临时列表到响应结果（设备信息及字符串位于同一内存块）
+	BuildDeviceListArena(deviceList, reply, replySize);
 
 	// OK
 	return StatusCode::STATUS_CODE_SUCCESS;
@@ -159,31 +150,8 @@ StatusCode BecammfDeviceHelper::GetDeviceList(DeviceInfo*& reply, size_t& replyS
  * @implements 实现释放设备列表
  */
 void BecammfDeviceHelper::FreeDeviceList(DeviceInfo*& input, size_t& inputSize) {
-	// 检查
-	if (inputSize <= 0 || input == nullptr) {
-		return;
-	}
-
-	// 遍历，执行释放操作
-	for (size_t i = 0; i < inputSize; i++) {
-		// 获取引用
-		auto item = input[i];
-		// 释放友好名称
-		if (item.name != nullptr) {
-			delete[] item.name;
-			item.name = nullptr;
-		}
-		// 释放设备路径
-		if (item.devicePath != nullptr) {
-			delete[] item.devicePath;
-			item.devicePath = nullptr;
-		}
-	}
-
-	// 释放整个列表
-	delete[] input;
-	inputSize = 0;
-	input = nullptr;
+	// 整块释放
+	FreeDeviceListArena(input, inputSize);
 }
 
 /**
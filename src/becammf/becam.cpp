@@ -1,5 +1,12 @@
 #include "BecamMediaFoundation.hpp"
 #include <becam/becam.h>
+#include <pkg/DeviceListArena.hpp>
+#include <pkg/ImageResize.hpp>
+#include <pkg/ImageTensor.hpp>
+#include <pkg/JpegMarker.hpp>
+#include <pkg/MjpegDecoder.hpp>
+#include <pkg/PixelConvert.hpp>
+#include <string.h>
 
 /**
  * @implements 实现初始化Becam接口句柄
@@ -57,6 +64,72 @@ void BecamFreeDeviceList(GetDeviceListReply* input) {
 	BecamMediaFoundation::FreeDeviceList(*input);
 }
 
+/**
+ * @implements 实现获取设备扩展信息
+ */
+StatusCode BecamGetDeviceInfoExtension(const GetDeviceListReply* reply, size_t index, DeviceInfoExtension* extension) {
+	// 检查参数
+	if (reply == nullptr || extension == nullptr) {
+		return StatusCode::STATUS_CODE_ERR_INPUT_PARAM;
+	}
+	// 从设备列表内存块中读取
+	return GetDeviceListArenaExtension(reply->deviceInfoList, reply->deviceInfoListSize, index, *extension);
+}
+
+/**
+ * @implements 实现根据设备稳定标识查找设备路径
+ */
+StatusCode BecamFindDevicePath(const BecamHandle handle, const char* deviceId, char** devicePath) {
+	// 检查句柄
+	if (handle == nullptr) {
+		return StatusCode::STATUS_CODE_ERR_HANDLE_EMPTY;
+	}
+	// 检查参数
+	if (deviceId == nullptr || devicePath == nullptr) {
+		return StatusCode::STATUS_CODE_ERR_INPUT_PARAM;
+	}
+	*devicePath = nullptr;
+	// 转换句柄类型
+	BecamMediaFoundation* becamHandle = static_cast<BecamMediaFoundation*>(handle);
+	// 执行查找
+	std::string path;
+	auto code = becamHandle->FindDevicePath(deviceId, path);
+	if (code != StatusCode::STATUS_CODE_SUCCESS) {
+		return code;
+	}
+	// 拷贝设备路径
+	*devicePath = new char[path.length() + 1];
+	memcpy(*devicePath, path.c_str(), path.length() + 1);
+	return StatusCode::STATUS_CODE_SUCCESS;
+}
+
+/**
+ * @implements 实现释放设备路径
+ */
+void BecamFreeDevicePath(char** devicePath) {
+	// 检查参数
+	if (devicePath == nullptr || *devicePath == nullptr) {
+		return;
+	}
+	delete[] *devicePath;
+	*devicePath = nullptr;
+}
+
+/**
+ * @implements 实现设置热插拔回调
+ */
+StatusCode BecamSetHotplugCallback(const BecamHandle handle, BecamHotplugCallback callback, void* userData) {
+	// 检查句柄
+	if (handle == nullptr) {
+		return StatusCode::STATUS_CODE_ERR_HANDLE_EMPTY;
+	}
+	// 暂未实现设备通知，停止监听总是成功
+	if (callback == nullptr) {
+		return StatusCode::STATUS_CODE_SUCCESS;
+	}
+	return StatusCode::STATUS_CODE_ERR_NOT_SUPPORTED;
+}
+
 /**
  * @implements 实现获取设备配置列表
  */
@@ -87,6 +160,61 @@ void BecamFreeDeviceConfigList(GetDeviceConfigListReply* input) {
 	BecamMediaFoundation::FreeDeviceConfigList(*input);
 }
 
+/**
+ * @implements 实现协商设备视频帧信息
+ */
+StatusCode BecamNegotiate(const BecamHandle handle, const char* devicePath, const VideoFrameInfo* desired, const NegotiatePolicy* policy,
+						  VideoFrameInfo* chosen) {
+	// 检查句柄
+	if (handle == nullptr) {
+		return StatusCode::STATUS_CODE_ERR_HANDLE_EMPTY;
+	}
+	// 检查参数
+	if (devicePath == nullptr || desired == nullptr || chosen == nullptr) {
+		return StatusCode::STATUS_CODE_ERR_INPUT_PARAM;
+	}
+	// 转换句柄类型
+	BecamMediaFoundation* becamHandle = static_cast<BecamMediaFoundation*>(handle);
+	// 执行协商
+	return becamHandle->Negotiate(devicePath, *desired, policy, *chosen);
+}
+
+/**
+ * @implements 实现规划多个设备共享USB总线时的视频帧信息
+ */
+StatusCode BecamPlanBandwidth(const BecamHandle handle, const BandwidthPlanRequest* requestList, size_t requestListSize,
+							  BandwidthPlanReply* reply) {
+	// 检查句柄
+	if (handle == nullptr) {
+		return StatusCode::STATUS_CODE_ERR_HANDLE_EMPTY;
+	}
+	// 检查参数
+	if (requestList == nullptr || requestListSize == 0 || reply == nullptr) {
+		return StatusCode::STATUS_CODE_ERR_INPUT_PARAM;
+	}
+	// 重置
+	reply->planItemList = nullptr;
+	reply->planItemListSize = 0;
+	reply->fits = 0;
+	// 当前平台无法读取USB总线拓扑
+	return StatusCode::STATUS_CODE_ERR_NOT_SUPPORTED;
+}
+
+/**
+ * @implements 实现释放带宽规划结果
+ */
+void BecamFreeBandwidthPlan(BandwidthPlanReply* input) {
+	// 检查参数
+	if (input == nullptr || input->planItemList == nullptr) {
+		return;
+	}
+	// 执行释放
+	delete[] input->planItemList;
+	input->planItemList = nullptr;
+	input->planItemListSize = 0;
+	input->fits = 0;
+}
+
 /**
  * @implements 实现打开设备
  */
@@ -137,6 +265,508 @@ StatusCode BecamGetFrame(const BecamHandle handle, uint8_t** data, size_t* size)
 	return becamHandle->GetFrame(*data, *size);
 }
 
+/**
+ * @implements 实现获取视频帧及其元数据
+ */
+StatusCode BecamGetFrameWithMeta(const BecamHandle handle, uint8_t** data, size_t* size, VideoFrameMeta* meta) {
+	// 检查句柄
+	if (handle == nullptr) {
+		return StatusCode::STATUS_CODE_ERR_HANDLE_EMPTY;
+	}
+	// 检查参数
+	if (data == nullptr || size == nullptr || meta == nullptr) {
+		return StatusCode::STATUS_CODE_ERR_INPUT_PARAM;
+	}
+	// 当前平台暂不支持
+	return StatusCode::STATUS_CODE_ERR_NOT_SUPPORTED;
+}
+
+/**
+ * @implements 实现获取已打开设备实际生效的视频帧格式
+ */
+StatusCode BecamGetCurrentFormat(const BecamHandle handle, FrameFormat* format) {
+	// 检查句柄
+	if (handle == nullptr) {
+		return StatusCode::STATUS_CODE_ERR_HANDLE_EMPTY;
+	}
+	// 当前平台暂不支持
+	return StatusCode::STATUS_CODE_ERR_NOT_SUPPORTED;
+}
+
+/**
+ * @implements 实现设置裁剪区域
+ */
+StatusCode BecamSetCropRect(const BecamHandle handle, const CropRect* rect) {
+	// 检查句柄
+	if (handle == nullptr) {
+		return StatusCode::STATUS_CODE_ERR_HANDLE_EMPTY;
+	}
+	// 当前平台暂不支持
+	return StatusCode::STATUS_CODE_ERR_NOT_SUPPORTED;
+}
+
+/**
+ * @implements 实现设置输出格式
+ */
+StatusCode BecamSetOutputFormat(const BecamHandle handle, uint32_t format) {
+	// 检查句柄
+	if (handle == nullptr) {
+		return StatusCode::STATUS_CODE_ERR_HANDLE_EMPTY;
+	}
+	// 当前平台暂不支持
+	return StatusCode::STATUS_CODE_ERR_NOT_SUPPORTED;
+}
+
+/**
+ * @implements 实现设置输出缩放
+ */
+StatusCode BecamSetOutputResize(const BecamHandle handle, const ResizeConfig* config) {
+	// 检查句柄
+	if (handle == nullptr) {
+		return StatusCode::STATUS_CODE_ERR_HANDLE_EMPTY;
+	}
+	// 当前平台暂不支持
+	return StatusCode::STATUS_CODE_ERR_NOT_SUPPORTED;
+}
+
+/**
+ * @implements 实现设置MJPEG解码缩放比例
+ */
+StatusCode BecamSetDecodeScale(const BecamHandle handle, uint32_t scaleDenom) {
+	// 检查句柄
+	if (handle == nullptr) {
+		return StatusCode::STATUS_CODE_ERR_HANDLE_EMPTY;
+	}
+	// 当前平台暂不支持
+	return StatusCode::STATUS_CODE_ERR_NOT_SUPPORTED;
+}
+
+/**
+ * @implements 实现设置帧内分条并行解码线程数
+ */
+StatusCode BecamSetDecodeStripThreads(const BecamHandle handle, uint32_t threadCount) {
+	// 检查句柄
+	if (handle == nullptr) {
+		return StatusCode::STATUS_CODE_ERR_HANDLE_EMPTY;
+	}
+	// 当前平台暂不支持
+	return StatusCode::STATUS_CODE_ERR_NOT_SUPPORTED;
+}
+
+/**
+ * @implements 实现设置帧级并行解码
+ */
+StatusCode BecamSetDecodePipeline(const BecamHandle handle, const DecodePipelineConfig* config) {
+	// 检查句柄
+	if (handle == nullptr) {
+		return StatusCode::STATUS_CODE_ERR_HANDLE_EMPTY;
+	}
+	// 当前平台暂不支持
+	return StatusCode::STATUS_CODE_ERR_NOT_SUPPORTED;
+}
+
+/**
+ * @implements 实现获取帧级并行解码状态
+ */
+StatusCode BecamGetDecodePipelineState(const BecamHandle handle, DecodePipelineState* state) {
+	// 检查句柄
+	if (handle == nullptr) {
+		return StatusCode::STATUS_CODE_ERR_HANDLE_EMPTY;
+	}
+	// 当前平台暂不支持
+	return StatusCode::STATUS_CODE_ERR_NOT_SUPPORTED;
+}
+
+/**
+ * @implements 实现设置单帧图像处理的并行策略
+ */
+StatusCode BecamSetParallelPolicy(const BecamHandle handle, const ParallelPolicy* policy) {
+	// 检查句柄
+	if (handle == nullptr) {
+		return StatusCode::STATUS_CODE_ERR_HANDLE_EMPTY;
+	}
+	// 当前平台暂不支持
+	return StatusCode::STATUS_CODE_ERR_NOT_SUPPORTED;
+}
+
+/**
+ * @implements 实现获取各处理阶段的耗时统计
+ */
+StatusCode BecamGetStageTimings(const BecamHandle handle, StageTimings* timings) {
+	// 检查句柄
+	if (handle == nullptr) {
+		return StatusCode::STATUS_CODE_ERR_HANDLE_EMPTY;
+	}
+	// 当前平台暂不支持
+	return StatusCode::STATUS_CODE_ERR_NOT_SUPPORTED;
+}
+
+/**
+ * @implements 实现设置是否为MJPEG视频帧补齐霍夫曼表
+ */
+StatusCode BecamSetInsertHuffmanTables(const BecamHandle handle, uint32_t enable) {
+	// 检查句柄
+	if (handle == nullptr) {
+		return StatusCode::STATUS_CODE_ERR_HANDLE_EMPTY;
+	}
+	// 当前平台暂不支持
+	return StatusCode::STATUS_CODE_ERR_NOT_SUPPORTED;
+}
+
+/**
+ * @implements 实现设置是否启用设备配置列表的持久化缓存
+ */
+StatusCode BecamSetCapabilityCache(const BecamHandle handle, uint32_t enable, const char* cacheDir) {
+	// 检查句柄
+	if (handle == nullptr) {
+		return StatusCode::STATUS_CODE_ERR_HANDLE_EMPTY;
+	}
+	// 当前平台暂不支持
+	return StatusCode::STATUS_CODE_ERR_NOT_SUPPORTED;
+}
+
+/**
+ * @implements 实现计算图像紧凑排列时所需的字节数
+ */
+size_t BecamGetImageSize(uint32_t format, uint32_t width, uint32_t height) {
+	// 执行计算
+	return GetImageSize(format, width, height);
+}
+
+/**
+ * @implements 实现按连续内存填充图像缓冲区描述
+ */
+StatusCode BecamFillImageBuffer(ImageBuffer* image, uint8_t* data, size_t size, uint32_t bytesPerLine) {
+	// 检查参数
+	if (image == nullptr || data == nullptr) {
+		return StatusCode::STATUS_CODE_ERR_INPUT_PARAM;
+	}
+	// 检查格式
+	if (GetImagePlaneCount(image->format) == 0) {
+		return StatusCode::STATUS_CODE_ERR_NOT_SUPPORTED;
+	}
+	// 执行填充
+	return FillImageBuffer(*image, data, size, bytesPerLine) ? StatusCode::STATUS_CODE_SUCCESS : StatusCode::STATUS_CODE_ERR_INPUT_PARAM;
+}
+
+/**
+ * @implements 实现转换图像格式
+ */
+StatusCode BecamConvertImage(const ImageBuffer* src, ImageBuffer* dst) {
+	// 检查参数
+	if (src == nullptr || dst == nullptr) {
+		return StatusCode::STATUS_CODE_ERR_INPUT_PARAM;
+	}
+	// 执行转换
+	return ConvertImage(*src, *dst);
+}
+
+/**
+ * @implements 实现获取亮度视图
+ */
+StatusCode BecamGetLumaView(const ImageBuffer* image, LumaView* view) {
+	// 检查参数
+	if (image == nullptr || view == nullptr || image->plane[0] == nullptr || image->width == 0 || image->height == 0) {
+		return StatusCode::STATUS_CODE_ERR_INPUT_PARAM;
+	}
+	// 获取视图
+	return GetLumaView(*image, *view) ? StatusCode::STATUS_CODE_SUCCESS : StatusCode::STATUS_CODE_ERR_NOT_SUPPORTED;
+}
+
+/**
+ * @implements 实现缩放图像
+ */
+StatusCode BecamResizeImage(const ImageBuffer* src, ImageBuffer* dst, ResizeFilter filter) {
+	// 检查参数
+	if (src == nullptr || dst == nullptr) {
+		return StatusCode::STATUS_CODE_ERR_INPUT_PARAM;
+	}
+	// 执行缩放
+	return ResizeImage(*src, *dst, filter);
+}
+
+/**
+ * @implements 实现计算张量所需的字节数
+ */
+size_t BecamGetTensorSize(const TensorConfig* config) {
+	return config == nullptr ? 0 : GetTensorSize(*config);
+}
+
+/**
+ * @implements 实现图像转张量
+ */
+StatusCode BecamImageToTensor(const ImageBuffer* src, const TensorConfig* config, void* dst, size_t dstSize, TensorPlacement* placement) {
+	// 检查参数
+	if (src == nullptr || config == nullptr) {
+		return StatusCode::STATUS_CODE_ERR_INPUT_PARAM;
+	}
+	// 执行转换
+	TensorPlacement result;
+	auto code = ImageToTensor(*src, *config, dst, dstSize, result);
+	if (code == StatusCode::STATUS_CODE_SUCCESS && placement != nullptr) {
+		*placement = result;
+	}
+	return code;
+}
+
+/**
+ * @implements 实现视频帧转张量
+ */
+StatusCode BecamFrameToTensor(const FrameFormat* format, const uint8_t* data, size_t size, const TensorConfig* config, void* dst, size_t dstSize,
+							  TensorPlacement* placement) {
+	// 检查参数
+	if (format == nullptr || data == nullptr) {
+		return StatusCode::STATUS_CODE_ERR_INPUT_PARAM;
+	}
+	if (GetImagePlaneCount(format->format) == 0) {
+		return StatusCode::STATUS_CODE_ERR_NOT_SUPPORTED;
+	}
+	// 按视频帧格式描述图像（只读取，不会修改视频帧数据）
+	ImageBuffer image = {0};
+	image.format = format->format;
+	image.width = format->width;
+	image.height = format->height;
+	if (!FillImageBuffer(image, const_cast<uint8_t*>(data), size, format->bytesPerLine)) {
+		return StatusCode::STATUS_CODE_ERR_INPUT_PARAM;
+	}
+	return BecamImageToTensor(&image, config, dst, dstSize, placement);
+}
+
+/**
+ * @implements 实现创建MJPEG解码器
+ */
+BecamMjpegDecoderHandle BecamNewMjpegDecoder() {
+	// 创建MJPEG解码器
+	return CreateMjpegDecoder();
+}
+
+/**
+ * @implements 实现释放MJPEG解码器
+ */
+void BecamFreeMjpegDecoder(BecamMjpegDecoderHandle* decoder) {
+	// 检查参数
+	if (decoder == nullptr || *decoder == nullptr) {
+		return;
+	}
+	// 释放MJPEG解码器
+	auto mjpegDecoder = static_cast<MjpegDecoder*>(*decoder);
+	DestroyMjpegDecoder(mjpegDecoder);
+	// 置空
+	*decoder = nullptr;
+}
+
+/**
+ * @implements 实现设置MJPEG解码器的分条并行解码线程数
+ */
+StatusCode BecamSetMjpegDecoderThreads(BecamMjpegDecoderHandle decoder, uint32_t threadCount) {
+	// 检查句柄
+	if (decoder == nullptr) {
+		return StatusCode::STATUS_CODE_ERR_HANDLE_EMPTY;
+	}
+	// 执行设置线程数
+	return SetMjpegDecoderThreads(static_cast<MjpegDecoder*>(decoder), threadCount);
+}
+
+/**
+ * @implements 实现获取MJPEG帧按指定比例解码后的尺寸
+ */
+StatusCode BecamGetMjpegOutputSize(BecamMjpegDecoderHandle decoder, const uint8_t* data, size_t size, uint32_t scaleDenom, uint32_t* width,
+								   uint32_t* height) {
+	// 检查句柄
+	if (decoder == nullptr) {
+		return StatusCode::STATUS_CODE_ERR_HANDLE_EMPTY;
+	}
+	// 检查参数
+	if (width == nullptr || height == nullptr) {
+		return StatusCode::STATUS_CODE_ERR_INPUT_PARAM;
+	}
+	// 只读取帧头
+	auto mjpegDecoder = static_cast<MjpegDecoder*>(decoder);
+	auto code = StartMjpegDecode(mjpegDecoder, data, size, scaleDenom, BECAM_FORMAT_RGB24, *width, *height);
+	AbortMjpegDecode(mjpegDecoder);
+	return code;
+}
+
+/**
+ * @implements 实现解码MJPEG帧
+ */
+StatusCode BecamDecodeMjpeg(BecamMjpegDecoderHandle decoder, const uint8_t* data, size_t size, uint32_t scaleDenom, ImageBuffer* dst) {
+	// 检查句柄
+	if (decoder == nullptr) {
+		return StatusCode::STATUS_CODE_ERR_HANDLE_EMPTY;
+	}
+	// 检查参数
+	if (dst == nullptr) {
+		return StatusCode::STATUS_CODE_ERR_INPUT_PARAM;
+	}
+	// 执行解码
+	return DecodeMjpeg(static_cast<MjpegDecoder*>(decoder), data, size, scaleDenom, *dst);
+}
+
+/**
+ * @implements 实现计算MJPEG帧补齐霍夫曼表后的大小
+ */
+size_t BecamGetCompleteJpegSize(const uint8_t* data, size_t size) {
+	// 执行计算
+	return GetCompleteJpegSize(data, size);
+}
+
+/**
+ * @implements 实现拷贝MJPEG帧并补齐霍夫曼表
+ */
+StatusCode BecamCopyCompleteJpeg(const uint8_t* data, size_t size, uint8_t* dst, size_t dstSize, size_t* outSize) {
+	// 检查参数
+	if (data == nullptr || size == 0 || dst == nullptr || outSize == nullptr) {
+		return StatusCode::STATUS_CODE_ERR_INPUT_PARAM;
+	}
+	*outSize = 0;
+	if (dstSize < GetCompleteJpegSize(data, size)) {
+		return StatusCode::STATUS_CODE_ERR_INPUT_PARAM;
+	}
+	// 执行拷贝
+	*outSize = CopyCompleteJpeg(data, size, dst);
+	return StatusCode::STATUS_CODE_SUCCESS;
+}
+
+/**
+ * @implements 实现获取已打开设备的控制项列表
+ */
+StatusCode BecamGetControlList(const BecamHandle handle, GetControlListReply* reply) {
+	// 检查句柄
+	if (handle == nullptr) {
+		return StatusCode::STATUS_CODE_ERR_HANDLE_EMPTY;
+	}
+	// 检查参数
+	if (reply == nullptr) {
+		return StatusCode::STATUS_CODE_ERR_INPUT_PARAM;
+	}
+	reply->controlInfoList = nullptr;
+	reply->controlInfoListSize = 0;
+	// 暂未实现
+	return StatusCode::STATUS_CODE_ERR_NOT_SUPPORTED;
+}
+
+/**
+ * @implements 实现释放控制项列表
+ */
+void BecamFreeControlList(GetControlListReply* input) {
+	// 检查参数
+	if (input == nullptr) {
+		return;
+	}
+	input->controlInfoList = nullptr;
+	input->controlInfoListSize = 0;
+}
+
+/**
+ * @implements 实现批量读取已打开设备的控制项
+ */
+StatusCode BecamGetControls(const BecamHandle handle, ControlValue* valueList, size_t valueListSize) {
+	// 检查句柄
+	if (handle == nullptr) {
+		return StatusCode::STATUS_CODE_ERR_HANDLE_EMPTY;
+	}
+	// 暂未实现
+	return StatusCode::STATUS_CODE_ERR_NOT_SUPPORTED;
+}
+
+/**
+ * @implements 实现批量设置已打开设备的控制项
+ */
+StatusCode BecamSetControls(const BecamHandle handle, const ControlValue* valueList, size_t valueListSize) {
+	// 检查句柄
+	if (handle == nullptr) {
+		return StatusCode::STATUS_CODE_ERR_HANDLE_EMPTY;
+	}
+	// 暂未实现
+	return StatusCode::STATUS_CODE_ERR_NOT_SUPPORTED;
+}
+
+/**
+ * @implements 实现保存已打开设备当前的控制项快照
+ */
+StatusCode BecamSaveControlSnapshot(const BecamHandle handle, ControlSnapshot* snapshot) {
+	// 检查句柄
+	if (handle == nullptr) {
+		return StatusCode::STATUS_CODE_ERR_HANDLE_EMPTY;
+	}
+	// 当前平台暂不支持
+	return StatusCode::STATUS_CODE_ERR_NOT_SUPPORTED;
+}
+
+/**
+ * @implements 实现释放控制项快照
+ */
+void BecamFreeControlSnapshot(ControlSnapshot* snapshot) {
+	// 检查参数
+	if (snapshot == nullptr) {
+		return;
+	}
+	// 当前平台不会分配快照，直接置空
+	snapshot->dataSize = 0;
+	snapshot->data = nullptr;
+}
+
+/**
+ * @implements 实现设置打开设备时恢复的控制项快照
+ */
+StatusCode BecamSetControlSnapshot(const BecamHandle handle, const ControlSnapshot* snapshot) {
+	// 检查句柄
+	if (handle == nullptr) {
+		return StatusCode::STATUS_CODE_ERR_HANDLE_EMPTY;
+	}
+	// 当前平台暂不支持
+	return StatusCode::STATUS_CODE_ERR_NOT_SUPPORTED;
+}
+
+/**
+ * @implements 实现设置低延迟采集配置
+ */
+StatusCode BecamSetCaptureProfile(const BecamHandle handle, const CaptureProfile* profile) {
+	// 检查句柄
+	if (handle == nullptr) {
+		return StatusCode::STATUS_CODE_ERR_HANDLE_EMPTY;
+	}
+	// 当前平台暂不支持
+	return StatusCode::STATUS_CODE_ERR_NOT_SUPPORTED;
+}
+
+/**
+ * @implements 实现获取采集配置应用结果
+ */
+StatusCode BecamGetCaptureProfileReport(const BecamHandle handle, CaptureProfileReport* report) {
+	// 检查句柄
+	if (handle == nullptr) {
+		return StatusCode::STATUS_CODE_ERR_HANDLE_EMPTY;
+	}
+	// 当前平台暂不支持
+	return StatusCode::STATUS_CODE_ERR_NOT_SUPPORTED;
+}
+
+/**
+ * @implements 实现设置软件自动曝光
+ */
+StatusCode BecamSetAutoExposure(const BecamHandle handle, const AutoExposureConfig* config) {
+	// 检查句柄
+	if (handle == nullptr) {
+		return StatusCode::STATUS_CODE_ERR_HANDLE_EMPTY;
+	}
+	// 当前平台暂不支持
+	return StatusCode::STATUS_CODE_ERR_NOT_SUPPORTED;
+}
+
+/**
+ * @implements 实现获取软件自动曝光状态
+ */
+StatusCode BecamGetAutoExposureState(const BecamHandle handle, AutoExposureState* state) {
+	// 检查句柄
+	if (handle == nullptr) {
+		return StatusCode::STATUS_CODE_ERR_HANDLE_EMPTY;
+	}
+	// 当前平台暂不支持
+	return StatusCode::STATUS_CODE_ERR_NOT_SUPPORTED;
+}
+
 /**
  * @implements 实现释放视频帧
  */
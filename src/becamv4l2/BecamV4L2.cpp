@@ -1,4 +1,8 @@
 #include "BecamV4L2.hpp"
+#include "Becamv4l2BandwidthPlanner.hpp"
+#include "Becamv4l2SysfsHelper.hpp"
+#include <pkg/FrameNegotiate.hpp>
+#include <string.h>
 
 /**
  * @implements 实现构造函数
@@ -17,14 +21,66 @@ BecamV4L2::~BecamV4L2() {
 		delete this->openedDevice;
 		this->openedDevice = nullptr;
 	}
+
+	// 取消并等待后台校验线程（校验线程会打开设备，不能在句柄释放后继续运行）
+	this->capabilityStore->Shutdown();
+}
+
+/**
+ * @implements 实现设置是否启用设备配置列表的持久化缓存
+ */
+StatusCode BecamV4L2::SetCapabilityCache(const bool enable, const std::string& cacheDir) {
+	// 加个锁先
+	std::unique_lock<std::mutex> lock(this->mtx);
+
+	// 无可用目录时无法启用
+	auto filePath = enable ? Becamv4l2CapabilityStore::ResolveFilePath(cacheDir) : std::string();
+	if (enable && filePath.empty()) {
+		return StatusCode::STATUS_CODE_ERR_INPUT_PARAM;
+	}
+	this->capabilityStore->SetFilePath(filePath);
+	return StatusCode::STATUS_CODE_SUCCESS;
+}
+
+/**
+ * @implements 实现加载设备列表
+ */
+StatusCode BecamV4L2::LoadDeviceList(std::vector<Becamv4l2DeviceEntry>& devices) {
+	// 优先使用缓存，未命中时重新枚举
+	uint64_t generation = 0;
+	if (this->deviceCache.GetDeviceList(devices, generation)) {
+		return StatusCode::STATUS_CODE_SUCCESS;
+	}
+	bool timedOut = false;
+	auto code = Becamv4l2DeviceHelper::EnumDevices(devices, &timedOut);
+	if (code != StatusCode::STATUS_CODE_SUCCESS) {
+		return code;
+	}
+	// 有节点探测超时时列表不完整，不写入缓存，下次重新枚举
+	if (!timedOut) {
+		this->deviceCache.SetDeviceList(devices, generation);
+	}
+	return StatusCode::STATUS_CODE_SUCCESS;
 }
 
 /**
  * @implements 实现获取设备列表
  */
 StatusCode BecamV4L2::GetDeviceList(GetDeviceListReply& reply) {
-	// 执行设备列表获取
-	return Becamv4l2DeviceHelper::GetDeviceList(reply.deviceInfoList, reply.deviceInfoListSize);
+	// 重置
+	reply.deviceInfoList = nullptr;
+	reply.deviceInfoListSize = 0;
+
+	// 加载设备列表
+	std::vector<Becamv4l2DeviceEntry> devices;
+	auto code = this->LoadDeviceList(devices);
+	if (code != StatusCode::STATUS_CODE_SUCCESS) {
+		return code;
+	}
+
+	// 转换为响应数据
+	Becamv4l2DeviceHelper::BuildDeviceList(devices, reply.deviceInfoList, reply.deviceInfoListSize);
+	return StatusCode::STATUS_CODE_SUCCESS;
 }
 
 /**
@@ -35,6 +91,46 @@ void BecamV4L2::FreeDeviceList(GetDeviceListReply& input) {
 	Becamv4l2DeviceHelper::FreeDeviceList(input.deviceInfoList, input.deviceInfoListSize);
 }
 
+/**
+ * @implements 实现根据设备稳定标识查找设备路径
+ */
+StatusCode BecamV4L2::FindDevicePath(const std::string& deviceId, std::string& devicePath) {
+	// 检查入参
+	if (deviceId.empty()) {
+		return StatusCode::STATUS_CODE_ERR_INPUT_PARAM;
+	}
+
+	// 加载设备列表（通常命中缓存，无需重新枚举）
+	std::vector<Becamv4l2DeviceEntry> devices;
+	auto code = this->LoadDeviceList(devices);
+	if (code != StatusCode::STATUS_CODE_SUCCESS) {
+		return code;
+	}
+
+	// 查找
+	if (!Becamv4l2DeviceHelper::FindDevicePath(devices, deviceId, devicePath)) {
+		return StatusCode::STATUS_CODE_ERR_DEVICE_NOT_FOUND;
+	}
+	return StatusCode::STATUS_CODE_SUCCESS;
+}
+
+/**
+ * @implements 实现设置热插拔回调
+ */
+StatusCode BecamV4L2::SetHotplugCallback(BecamHotplugCallback callback, void* userData) {
+	// 回调为空时停止监听
+	if (callback == nullptr) {
+		this->hotplugMonitor.Stop();
+		return StatusCode::STATUS_CODE_SUCCESS;
+	}
+	// 设备变化时先使枚举缓存失效，保证回调中重新获取的设备列表是最新的
+	return this->hotplugMonitor.Start([this, callback, userData](HotplugAction action, const std::string& devicePath) {
+		this->deviceCache.Invalidate();
+		HotplugEvent event = {action, devicePath.c_str()};
+		callback(&event, userData);
+	});
+}
+
 /**
  * @implements 实现获取设备配置列表
  */
@@ -47,6 +143,38 @@ StatusCode BecamV4L2::GetDeviceConfigList(const std::string& devicePath, GetDevi
 		return StatusCode::STATUS_CODE_ERR_INPUT_PARAM;
 	}
 
+	// 后台校验发现持久化缓存有变化时，内存中的缓存也需要丢弃
+	auto revision = this->capabilityStore->GetRevision();
+	if (revision != this->capabilityRevision) {
+		this->capabilityRevision = revision;
+		this->deviceCache.Invalidate();
+	}
+
+	// 优先使用内存中的缓存
+	std::vector<VideoFrameInfo> configList;
+	uint64_t generation = 0;
+	bool cached = this->deviceCache.GetConfigList(devicePath, configList, generation);
+
+	// 其次使用持久化缓存（命中后在后台重新枚举校验）
+	std::string deviceId, fingerprint;
+	bool identified = !cached && Becamv4l2SysfsHelper::GetNodeIdentity(devicePath, deviceId, fingerprint);
+	if (identified && this->capabilityStore->Load(deviceId, fingerprint, configList)) {
+		this->capabilityStore->RevalidateAsync(devicePath, deviceId, fingerprint, configList);
+		this->deviceCache.SetConfigList(devicePath, configList, generation);
+		cached = true;
+	}
+
+	if (cached) {
+		// 拷贝配置列表
+		reply.videoFrameInfoListSize = configList.size();
+		reply.videoFrameInfoList = nullptr;
+		if (!configList.empty()) {
+			reply.videoFrameInfoList = new VideoFrameInfo[configList.size()];
+			memcpy(reply.videoFrameInfoList, configList.data(), configList.size() * sizeof(VideoFrameInfo));
+		}
+		return StatusCode::STATUS_CODE_SUCCESS;
+	}
+
 	// 初始化设备助手类
 	Becamv4l2DeviceHelper deviceHelper;
 	// 激活指定设备（激活的设备会随着设备助手类作用域自动关闭）
@@ -56,7 +184,18 @@ StatusCode BecamV4L2::GetDeviceConfigList(const std::string& devicePath, GetDevi
 	}
 
 	// 获取该设备支持的配置
-	return deviceHelper.GetCurrentDeviceConfigList(reply.videoFrameInfoList, reply.videoFrameInfoListSize);
+	code = deviceHelper.GetCurrentDeviceConfigList(reply.videoFrameInfoList, reply.videoFrameInfoListSize);
+	if (code != StatusCode::STATUS_CODE_SUCCESS) {
+		return code;
+	}
+
+	// 更新缓存
+	configList.assign(reply.videoFrameInfoList, reply.videoFrameInfoList + reply.videoFrameInfoListSize);
+	this->deviceCache.SetConfigList(devicePath, configList, generation);
+	if (identified) {
+		this->capabilityStore->Save(deviceId, fingerprint, configList);
+	}
+	return StatusCode::STATUS_CODE_SUCCESS;
 }
 
 /**
@@ -67,6 +206,108 @@ void BecamV4L2::FreeDeviceConfigList(GetDeviceConfigListReply& input) {
 	Becamv4l2DeviceHelper::FreeDeviceConfigList(input.videoFrameInfoList, input.videoFrameInfoListSize);
 }
 
+/**
+ * @implements 实现协商设备视频帧信息
+ */
+StatusCode BecamV4L2::Negotiate(const std::string& devicePath, const VideoFrameInfo& desired, const NegotiatePolicy* policy,
+								VideoFrameInfo& chosen) {
+	// 加个锁先
+	std::unique_lock<std::mutex> lock(this->mtx);
+
+	// 检查入参
+	if (devicePath.empty()) {
+		return StatusCode::STATUS_CODE_ERR_INPUT_PARAM;
+	}
+
+	// 初始化设备助手类
+	Becamv4l2DeviceHelper deviceHelper;
+	// 激活指定设备（激活的设备会随着设备助手类作用域自动关闭）
+	auto code = deviceHelper.ActivateDevice(devicePath);
+	if (code != StatusCode::STATUS_CODE_SUCCESS) {
+		return code;
+	}
+
+	// 协商视频帧信息
+	return deviceHelper.NegotiateCurrentDeviceConfig(desired, policy, chosen);
+}
+
+/**
+ * @implements 实现规划多个设备共享USB总线时的视频帧信息
+ */
+StatusCode BecamV4L2::PlanBandwidth(const BandwidthPlanRequest* requestList, const size_t requestListSize, BandwidthPlanReply& reply) {
+	// 重置
+	reply.planItemList = nullptr;
+	reply.planItemListSize = 0;
+	reply.fits = 0;
+
+	// 加个锁先
+	std::unique_lock<std::mutex> lock(this->mtx);
+
+	// 收集每个设备的USB拓扑和候选配置
+	std::vector<Becamv4l2PlannedCamera> cameras(requestListSize);
+	for (size_t i = 0; i < requestListSize; i++) {
+		// 检查入参
+		auto& request = requestList[i];
+		if (request.devicePath == nullptr || request.devicePath[0] == '\0') {
+			return StatusCode::STATUS_CODE_ERR_INPUT_PARAM;
+		}
+		// 读取USB拓扑（非USB设备不参与总线预算）
+		Becamv4l2SysfsHelper::GetUsbTopology(request.devicePath, cameras[i].topology);
+
+		// 初始化设备助手类
+		Becamv4l2DeviceHelper deviceHelper;
+		// 激活指定设备（激活的设备会随着设备助手类作用域自动关闭）
+		auto code = deviceHelper.ActivateDevice(request.devicePath);
+		if (code != StatusCode::STATUS_CODE_SUCCESS) {
+			return code;
+		}
+		// 获取该设备支持的配置
+		VideoFrameInfo* list = nullptr;
+		size_t listSize = 0;
+		code = deviceHelper.GetCurrentDeviceConfigList(list, listSize);
+		if (code != StatusCode::STATUS_CODE_SUCCESS) {
+			return code;
+		}
+		// 仅保留满足最低要求的配置
+		cameras[i].candidates = RankFrameInfoList(list, listSize, request.desired, request.policy);
+		Becamv4l2DeviceHelper::FreeDeviceConfigList(list, listSize);
+	}
+
+	// 执行规划
+	std::vector<VideoFrameInfo> chosen;
+	auto fits = Becamv4l2BandwidthPlanner::Plan(cameras, chosen);
+
+	// 拷贝规划结果
+	reply.planItemListSize = requestListSize;
+	reply.planItemList = new BandwidthPlanItem[requestListSize];
+	for (size_t i = 0; i < requestListSize; i++) {
+		auto& item = reply.planItemList[i];
+		item.frameInfo = chosen[i];
+		item.busNumber = cameras[i].topology.busNumber;
+		item.linkSpeed = cameras[i].topology.deviceSpeed;
+		item.payloadRate = chosen[i].fps > 0 ? Becamv4l2BandwidthPlanner::EstimatePayloadRate(chosen[i]) : 0;
+	}
+	reply.fits = fits ? 1 : 0;
+
+	// OK
+	return StatusCode::STATUS_CODE_SUCCESS;
+}
+
+/**
+ * @implements 实现释放带宽规划结果
+ */
+void BecamV4L2::FreeBandwidthPlan(BandwidthPlanReply& input) {
+	// 检查
+	if (input.planItemList == nullptr) {
+		return;
+	}
+	// 释放
+	delete[] input.planItemList;
+	input.planItemList = nullptr;
+	input.planItemListSize = 0;
+	input.fits = 0;
+}
+
 /**
  * @implements 实现打开指定设备
  */
@@ -115,6 +356,274 @@ StatusCode BecamV4L2::GetFrame(uint8_t*& data, size_t& size) {
 	return this->openedDevice->GetFrame(data, size);
 }
 
+/**
+ * @implements 实现获取视频帧及其元数据
+ */
+StatusCode BecamV4L2::GetFrameWithMeta(uint8_t*& data, size_t& size, VideoFrameMeta& meta) {
+	// 加个锁先
+	std::unique_lock<std::mutex> lock(this->mtx);
+
+	// 获取视频帧
+	return this->openedDevice->GetFrame(data, size, &meta);
+}
+
+/**
+ * @implements 实现获取已打开设备实际生效的视频帧格式
+ */
+StatusCode BecamV4L2::GetCurrentFormat(FrameFormat& format) {
+	// 加个锁先
+	std::unique_lock<std::mutex> lock(this->mtx);
+
+	// 获取视频帧格式
+	return this->openedDevice->GetCurrentDeviceFormat(format);
+}
+
+/**
+ * @implements 实现设置裁剪区域
+ */
+StatusCode BecamV4L2::SetCropRect(const CropRect& rect) {
+	// 加个锁先
+	std::unique_lock<std::mutex> lock(this->mtx);
+
+	// 设置裁剪区域
+	return this->openedDevice->SetCropRect(rect);
+}
+
+/**
+ * @implements 实现设置输出格式
+ */
+StatusCode BecamV4L2::SetOutputFormat(const uint32_t format) {
+	// 加个锁先
+	std::unique_lock<std::mutex> lock(this->mtx);
+
+	// 设置输出格式
+	return this->openedDevice->SetOutputFormat(format);
+}
+
+/**
+ * @implements 实现设置输出缩放
+ */
+StatusCode BecamV4L2::SetOutputResize(const ResizeConfig* config) {
+	// 加个锁先
+	std::unique_lock<std::mutex> lock(this->mtx);
+
+	// 设置输出缩放
+	return this->openedDevice->SetOutputResize(config);
+}
+
+/**
+ * @implements 实现设置MJPEG解码缩放比例
+ */
+StatusCode BecamV4L2::SetDecodeScale(const uint32_t scaleDenom) {
+	// 加个锁先
+	std::unique_lock<std::mutex> lock(this->mtx);
+
+	// 设置缩放比例
+	return this->openedDevice->SetDecodeScale(scaleDenom);
+}
+
+/**
+ * @implements 实现设置帧内分条并行解码线程数
+ */
+StatusCode BecamV4L2::SetDecodeStripThreads(const uint32_t threadCount) {
+	// 加个锁先
+	std::unique_lock<std::mutex> lock(this->mtx);
+
+	// 设置线程数
+	return this->openedDevice->SetDecodeStripThreads(threadCount);
+}
+
+/**
+ * @implements 实现设置帧级并行解码
+ */
+StatusCode BecamV4L2::SetDecodePipeline(const DecodePipelineConfig* config) {
+	// 加个锁先
+	std::unique_lock<std::mutex> lock(this->mtx);
+
+	// 设置并行解码
+	return this->openedDevice->SetDecodePipeline(config);
+}
+
+/**
+ * @implements 实现获取帧级并行解码状态
+ */
+StatusCode BecamV4L2::GetDecodePipelineState(DecodePipelineState& state) {
+	// 加个锁先
+	std::unique_lock<std::mutex> lock(this->mtx);
+
+	// 获取并行解码状态
+	return this->openedDevice->GetDecodePipelineState(state);
+}
+
+/**
+ * @implements 实现设置单帧图像处理的并行策略
+ */
+StatusCode BecamV4L2::SetParallelPolicy(const ParallelPolicy* policy) {
+	// 加个锁先
+	std::unique_lock<std::mutex> lock(this->mtx);
+
+	// 设置并行策略
+	return this->openedDevice->SetParallelPolicy(policy);
+}
+
+/**
+ * @implements 实现获取各处理阶段的耗时统计
+ */
+StatusCode BecamV4L2::GetStageTimings(StageTimings& timings) {
+	// 加个锁先
+	std::unique_lock<std::mutex> lock(this->mtx);
+
+	// 获取耗时统计
+	return this->openedDevice->GetStageTimings(timings);
+}
+
+/**
+ * @implements 实现设置是否为MJPEG视频帧补齐霍夫曼表
+ */
+StatusCode BecamV4L2::SetInsertHuffmanTables(const bool enable) {
+	// 加个锁先
+	std::unique_lock<std::mutex> lock(this->mtx);
+
+	// 设置是否补齐
+	return this->openedDevice->SetInsertHuffmanTables(enable);
+}
+
+/**
+ * @implements 实现保存已打开设备当前的控制项快照
+ */
+StatusCode BecamV4L2::SaveControlSnapshot(ControlSnapshot& snapshot) {
+	// 加个锁先
+	std::unique_lock<std::mutex> lock(this->mtx);
+
+	// 重置
+	snapshot.dataSize = 0;
+	snapshot.data = nullptr;
+	// 生成快照
+	std::vector<uint8_t> blob;
+	auto code = this->openedDevice->SaveCurrentDeviceControlSnapshot(blob);
+	if (code != StatusCode::STATUS_CODE_SUCCESS) {
+		return code;
+	}
+	// 拷贝快照数据
+	snapshot.dataSize = blob.size();
+	snapshot.data = new uint8_t[blob.size()];
+	memcpy(snapshot.data, blob.data(), blob.size());
+	return StatusCode::STATUS_CODE_SUCCESS;
+}
+
+/**
+ * @implements 实现释放控制项快照
+ */
+void BecamV4L2::FreeControlSnapshot(ControlSnapshot& snapshot) {
+	if (snapshot.data != nullptr) {
+		delete[] snapshot.data;
+	}
+	snapshot.dataSize = 0;
+	snapshot.data = nullptr;
+}
+
+/**
+ * @implements 实现设置打开设备时恢复的控制项快照
+ */
+StatusCode BecamV4L2::SetControlSnapshot(const ControlSnapshot* snapshot) {
+	// 加个锁先
+	std::unique_lock<std::mutex> lock(this->mtx);
+
+	// 设置快照（为空时取消）
+	if (snapshot == nullptr) {
+		return this->openedDevice->SetControlSnapshot(nullptr, 0);
+	}
+	if (snapshot->data == nullptr) {
+		return StatusCode::STATUS_CODE_ERR_INPUT_PARAM;
+	}
+	return this->openedDevice->SetControlSnapshot(snapshot->data, snapshot->dataSize);
+}
+
+/**
+ * @implements 实现设置低延迟采集配置
+ */
+StatusCode BecamV4L2::SetCaptureProfile(const CaptureProfile* profile) {
+	// 加个锁先
+	std::unique_lock<std::mutex> lock(this->mtx);
+
+	// 设置采集配置
+	return this->openedDevice->SetCaptureProfile(profile);
+}
+
+/**
+ * @implements 实现获取采集配置应用结果
+ */
+StatusCode BecamV4L2::GetCaptureProfileReport(CaptureProfileReport& report) {
+	// 加个锁先
+	std::unique_lock<std::mutex> lock(this->mtx);
+
+	// 获取应用结果
+	return this->openedDevice->GetCaptureProfileReport(report);
+}
+
+/**
+ * @implements 实现设置软件自动曝光
+ */
+StatusCode BecamV4L2::SetAutoExposure(const AutoExposureConfig* config) {
+	// 加个锁先
+	std::unique_lock<std::mutex> lock(this->mtx);
+
+	// 设置自动曝光
+	return this->openedDevice->SetAutoExposure(config);
+}
+
+/**
+ * @implements 实现获取软件自动曝光状态
+ */
+StatusCode BecamV4L2::GetAutoExposureState(AutoExposureState& state) {
+	// 加个锁先
+	std::unique_lock<std::mutex> lock(this->mtx);
+
+	// 获取自动曝光状态
+	return this->openedDevice->GetAutoExposureState(state);
+}
+
+/**
+ * @implements 实现获取已打开设备的控制项列表
+ */
+StatusCode BecamV4L2::GetControlList(GetControlListReply& reply) {
+	// 加个锁先
+	std::unique_lock<std::mutex> lock(this->mtx);
+
+	// 获取控制项列表
+	return this->openedDevice->GetCurrentDeviceControlList(reply.controlInfoList, reply.controlInfoListSize);
+}
+
+/**
+ * @implements 实现释放控制项列表
+ */
+void BecamV4L2::FreeControlList(GetControlListReply& input) {
+	// 执行释放
+	Becamv4l2DeviceHelper::FreeControlList(input.controlInfoList, input.controlInfoListSize);
+}
+
+/**
+ * @implements 实现批量读取已打开设备的控制项
+ */
+StatusCode BecamV4L2::GetControls(ControlValue* valueList, const size_t valueListSize) {
+	// 加个锁先
+	std::unique_lock<std::mutex> lock(this->mtx);
+
+	// 批量读取
+	return this->openedDevice->GetCurrentDeviceControls(valueList, valueListSize);
+}
+
+/**
+ * @implements 实现批量设置已打开设备的控制项
+ */
+StatusCode BecamV4L2::SetControls(const ControlValue* valueList, const size_t valueListSize) {
+	// 加个锁先
+	std::unique_lock<std::mutex> lock(this->mtx);
+
+	// 批量设置
+	return this->openedDevice->SetCurrentDeviceControls(valueList, valueListSize);
+}
+
 /**
  * @implements 实现释放视频帧
  */
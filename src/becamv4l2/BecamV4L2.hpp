@@ -3,7 +3,10 @@
 #ifndef _BECAM_MV4L2_H_
 #define _BECAM_MV4L2_H_
 
+#include "Becamv4l2CapabilityStore.hpp"
+#include "Becamv4l2DeviceCache.hpp"
 #include "Becamv4l2DeviceHelper.hpp"
+#include "Becamv4l2HotplugMonitor.hpp"
 #include <becam/becam.h>
 #include <mutex>
 
@@ -17,6 +20,23 @@ private:
 	std::mutex mtx;
 	// 已打开设备实例
 	Becamv4l2DeviceHelper* openedDevice = new Becamv4l2DeviceHelper();
+	// 设备及配置枚举结果缓存
+	Becamv4l2DeviceCache deviceCache;
+	// 设备配置列表的持久化缓存（默认不启用，析构时等待后台校验线程结束）
+	std::shared_ptr<Becamv4l2CapabilityStore> capabilityStore =
+		std::make_shared<Becamv4l2CapabilityStore>(Becamv4l2CapabilityStore::GetDefaultFilePath());
+	// 已同步的持久化缓存校验变化次数
+	uint64_t capabilityRevision = 0;
+	// 热插拔监听（需在缓存之后声明，保证先于缓存析构）
+	Becamv4l2HotplugMonitor hotplugMonitor;
+
+	/**
+	 * @brief 加载设备列表（优先使用缓存）
+	 *
+	 * @param devices [out] 设备列表
+	 * @return 状态码
+	 */
+	StatusCode LoadDeviceList(std::vector<Becamv4l2DeviceEntry>& devices);
 
 public:
 	/**
@@ -29,6 +49,15 @@ public:
 	 */
 	~BecamV4L2();
 
+	/**
+	 * @brief 设置是否启用设备配置列表的持久化缓存
+	 *
+	 * @param enable [in] 是否启用
+	 * @param cacheDir [in] 缓存目录（为空时使用默认目录）
+	 * @return 状态码
+	 */
+	StatusCode SetCapabilityCache(const bool enable, const std::string& cacheDir);
+
 	/**
 	 * @brief 获取设备列表
 	 *
@@ -44,6 +73,24 @@ public:
 	 */
 	static void FreeDeviceList(GetDeviceListReply& input);
 
+	/**
+	 * @brief 根据设备稳定标识查找设备路径
+	 *
+	 * @param deviceId [in] 设备稳定标识
+	 * @param devicePath [out] 设备路径
+	 * @return 状态码
+	 */
+	StatusCode FindDevicePath(const std::string& deviceId, std::string& devicePath);
+
+	/**
+	 * @brief 设置热插拔回调
+	 *
+	 * @param callback [in] 热插拔回调函数（为空时停止监听）
+	 * @param userData [in] 透传给回调函数的用户数据
+	 * @return 状态码
+	 */
+	StatusCode SetHotplugCallback(BecamHotplugCallback callback, void* userData);
+
 	/**
 	 * @brief 获取设备配置列表
 	 *
@@ -60,6 +107,34 @@ public:
 	 */
 	static void FreeDeviceConfigList(GetDeviceConfigListReply& input);
 
+	/**
+	 * @brief 协商设备视频帧信息
+	 *
+	 * @param devicePath [in] 设备路径
+	 * @param desired [in] 期望的视频帧信息（宽、高、帧率为最低要求）
+	 * @param policy [in] 协商策略（可为空）
+	 * @param chosen [out] 选中的视频帧信息
+	 * @return 状态码
+	 */
+	StatusCode Negotiate(const std::string& devicePath, const VideoFrameInfo& desired, const NegotiatePolicy* policy, VideoFrameInfo& chosen);
+
+	/**
+	 * @brief 规划多个设备共享USB总线时的视频帧信息
+	 *
+	 * @param requestList [in] 带宽规划请求列表
+	 * @param requestListSize [in] 带宽规划请求数量
+	 * @param reply [out] 输出参数
+	 * @return 状态码
+	 */
+	StatusCode PlanBandwidth(const BandwidthPlanRequest* requestList, const size_t requestListSize, BandwidthPlanReply& reply);
+
+	/**
+	 * @brief 释放带宽规划结果
+	 *
+	 * @param input [in] 输入参数
+	 */
+	static void FreeBandwidthPlan(BandwidthPlanReply& input);
+
 	/**
 	 * @brief 打开指定设备
 	 *
@@ -83,6 +158,192 @@ public:
 	 */
 	StatusCode GetFrame(uint8_t*& data, size_t& size);
 
+	/**
+	 * @brief 获取视频帧及其元数据
+	 *
+	 * @param data [out] 视频帧流
+	 * @param size [out] 视频帧流大小
+	 * @param meta [out] 视频帧元数据
+	 * @return 状态码
+	 */
+	StatusCode GetFrameWithMeta(uint8_t*& data, size_t& size, VideoFrameMeta& meta);
+
+	/**
+	 * @brief 获取已打开设备实际生效的视频帧格式
+	 *
+	 * @param format [out] 视频帧格式
+	 * @return 状态码
+	 */
+	StatusCode GetCurrentFormat(FrameFormat& format);
+
+	/**
+	 * @brief 设置裁剪区域
+	 *
+	 * @param rect [in] 裁剪区域（宽高为0时取消裁剪）
+	 * @return 状态码
+	 */
+	StatusCode SetCropRect(const CropRect& rect);
+
+	/**
+	 * @brief 设置输出格式
+	 *
+	 * @param format [in] 输出格式（为0时取消转换）
+	 * @return 状态码
+	 */
+	StatusCode SetOutputFormat(const uint32_t format);
+
+	/**
+	 * @brief 设置输出缩放
+	 *
+	 * @param config [in] 缩放配置（为空或宽高为0时取消缩放）
+	 * @return 状态码
+	 */
+	StatusCode SetOutputResize(const ResizeConfig* config);
+
+	/**
+	 * @brief 设置MJPEG解码缩放比例
+	 *
+	 * @param scaleDenom [in] 缩放分母（1、2、4、8）
+	 * @return 状态码
+	 */
+	StatusCode SetDecodeScale(const uint32_t scaleDenom);
+
+	/**
+	 * @brief 设置帧内分条并行解码线程数
+	 *
+	 * @param threadCount [in] 线程数（为0时取处理器核心数，为1时不切分）
+	 * @return 状态码
+	 */
+	StatusCode SetDecodeStripThreads(const uint32_t threadCount);
+
+	/**
+	 * @brief 设置帧级并行解码
+	 *
+	 * @param config [in] 并行解码配置（为空时恢复串行解码）
+	 * @return 状态码
+	 */
+	StatusCode SetDecodePipeline(const DecodePipelineConfig* config);
+
+	/**
+	 * @brief 获取帧级并行解码状态
+	 *
+	 * @param state [out] 并行解码状态
+	 * @return 状态码
+	 */
+	StatusCode GetDecodePipelineState(DecodePipelineState& state);
+
+	/**
+	 * @brief 设置单帧图像处理的并行策略
+	 *
+	 * @param policy [in] 并行策略（为空时恢复串行处理）
+	 * @return 状态码
+	 */
+	StatusCode SetParallelPolicy(const ParallelPolicy* policy);
+
+	/**
+	 * @brief 获取各处理阶段的耗时统计
+	 *
+	 * @param timings [out] 耗时统计
+	 * @return 状态码
+	 */
+	StatusCode GetStageTimings(StageTimings& timings);
+
+	/**
+	 * @brief 设置是否为MJPEG视频帧补齐霍夫曼表
+	 *
+	 * @param enable [in] 是否补齐
+	 * @return 状态码
+	 */
+	StatusCode SetInsertHuffmanTables(const bool enable);
+
+	/**
+	 * @brief 保存已打开设备当前的控制项快照
+	 *
+	 * @param snapshot [out] 控制项快照
+	 * @return 状态码
+	 */
+	StatusCode SaveControlSnapshot(ControlSnapshot& snapshot);
+
+	/**
+	 * @brief 释放控制项快照
+	 *
+	 * @param snapshot [in] 控制项快照
+	 */
+	static void FreeControlSnapshot(ControlSnapshot& snapshot);
+
+	/**
+	 * @brief 设置打开设备时恢复的控制项快照
+	 *
+	 * @param snapshot [in] 控制项快照（为空时取消）
+	 * @return 状态码
+	 */
+	StatusCode SetControlSnapshot(const ControlSnapshot* snapshot);
+
+	/**
+	 * @brief 设置低延迟采集配置
+	 *
+	 * @param profile [in] 采集配置（为空时取消）
+	 * @return 状态码
+	 */
+	StatusCode SetCaptureProfile(const CaptureProfile* profile);
+
+	/**
+	 * @brief 获取采集配置应用结果
+	 *
+	 * @param report [out] 应用结果
+	 * @return 状态码
+	 */
+	StatusCode GetCaptureProfileReport(CaptureProfileReport& report);
+
+	/**
+	 * @brief 设置软件自动曝光
+	 *
+	 * @param config [in] 自动曝光配置（为空时停止调节）
+	 * @return 状态码
+	 */
+	StatusCode SetAutoExposure(const AutoExposureConfig* config);
+
+	/**
+	 * @brief 获取软件自动曝光状态
+	 *
+	 * @param state [out] 自动曝光状态
+	 * @return 状态码
+	 */
+	StatusCode GetAutoExposureState(AutoExposureState& state);
+
+	/**
+	 * @brief 获取已打开设备的控制项列表
+	 *
+	 * @param reply [out] 输出参数
+	 * @return 状态码
+	 */
+	StatusCode GetControlList(GetControlListReply& reply);
+
+	/**
+	 * @brief 释放控制项列表
+	 *
+	 * @param input [in] 输入参数
+	 */
+	static void FreeControlList(GetControlListReply& input);
+
+	/**
+	 * @brief 批量读取已打开设备的控制项
+	 *
+	 * @param valueList [in && out] 控制项取值列表
+	 * @param valueListSize [in] 控制项数量
+	 * @return 状态码
+	 */
+	StatusCode GetControls(ControlValue* valueList, const size_t valueListSize);
+
+	/**
+	 * @brief 批量设置已打开设备的控制项
+	 *
+	 * @param valueList [in] 控制项取值列表
+	 * @param valueListSize [in] 控制项数量
+	 * @return 状态码
+	 */
+	StatusCode SetControls(const ControlValue* valueList, const size_t valueListSize);
+
 	/**
 	 * @brief 释放视频帧
 	 *
@@ -0,0 +1,155 @@
+#include "Becamv4l2BandwidthPlanner.hpp"
+#include <map>
+#include <pkg/FrameNegotiate.hpp>
+
+/**
+ * @implements 实现获取总线可用于等时传输的带宽预算
+ */
+uint64_t Becamv4l2BandwidthPlanner::GetBusBudget(const uint32_t speed) {
+	// USB 2.0及以下最多80%的微帧可用于周期传输，USB 3.x为90%
+	if (speed <= 480) {
+		return uint64_t(speed) * 1000000 * 8 / 10;
+	}
+	return uint64_t(speed) * 1000000 * 9 / 10;
+}
+
+/**
+ * @implements 实现获取单个设备等时端点的带宽上限
+ */
+uint64_t Becamv4l2BandwidthPlanner::GetDeviceBudget(const uint32_t speed) {
+	if (speed < 12) {
+		// 低速设备不支持等时传输
+		return 0;
+	} else if (speed < 480) {
+		// 全速：每帧（1ms）最多1023字节
+		return uint64_t(1023) * 8 * 1000;
+	} else if (speed < 5000) {
+		// 高速：每微帧（125us）最多3x1024字节
+		return uint64_t(3 * 1024) * 8 * 8000;
+	}
+	// 超高速：每微帧最多48x1024字节
+	return uint64_t(48 * 1024) * 8 * 8000;
+}
+
+/**
+ * @implements 实现估算视频帧信息的载荷速率
+ */
+uint64_t Becamv4l2BandwidthPlanner::EstimatePayloadRate(const VideoFrameInfo& frameInfo) {
+	// 每秒像素数 x 每像素比特数
+	double rate = double(frameInfo.width) * double(frameInfo.height) * double(frameInfo.fps) * FourccBitsPerPixel(frameInfo.format);
+	// UVC负载头约占2%
+	return uint64_t(rate * 1.02);
+}
+
+/**
+ * @implements 实现规划视频帧信息
+ */
+bool Becamv4l2BandwidthPlanner::Plan(const std::vector<Becamv4l2PlannedCamera>& cameras, std::vector<VideoFrameInfo>& chosen) {
+	// 每个候选的像素吞吐和载荷速率
+	struct Option {
+		VideoFrameInfo frameInfo;
+		uint64_t pixelRate;
+		uint64_t payloadRate;
+	};
+	std::vector<std::vector<Option>> options(cameras.size());
+	// 每个相机当前选中的候选下标（-1表示无候选）
+	std::vector<int> current(cameras.size(), -1);
+
+	// 初始选择：设备自身带宽上限内像素吞吐最大的候选
+	for (size_t i = 0; i < cameras.size(); i++) {
+		auto& camera = cameras[i];
+		auto deviceBudget = Becamv4l2BandwidthPlanner::GetDeviceBudget(camera.topology.deviceSpeed);
+		for (auto& item : camera.candidates) {
+			Option option = {item, uint64_t(item.width) * item.height * item.fps, Becamv4l2BandwidthPlanner::EstimatePayloadRate(item)};
+			options[i].push_back(option);
+		}
+		for (size_t j = 0; j < options[i].size(); j++) {
+			auto& option = options[i][j];
+			// 非USB设备不受限制
+			bool fitsDevice = camera.topology.busNumber == 0 || option.payloadRate <= deviceBudget;
+			if (current[i] == -1) {
+				current[i] = int(j);
+				continue;
+			}
+			auto& selected = options[i][current[i]];
+			bool selectedFitsDevice = camera.topology.busNumber == 0 || selected.payloadRate <= deviceBudget;
+			if (fitsDevice && !selectedFitsDevice) {
+				current[i] = int(j);
+			} else if (fitsDevice == selectedFitsDevice) {
+				// 同为可用时取像素吞吐最大的，同为不可用时取载荷最小的
+				if (fitsDevice ? option.pixelRate > selected.pixelRate : option.payloadRate < selected.payloadRate) {
+					current[i] = int(j);
+				}
+			}
+		}
+	}
+
+	// 按总线分组（非USB设备不参与）
+	std::map<uint32_t, std::vector<size_t>> buses;
+	for (size_t i = 0; i < cameras.size(); i++) {
+		if (cameras[i].topology.busNumber != 0 && current[i] != -1) {
+			buses[cameras[i].topology.busNumber].push_back(i);
+		}
+	}
+
+	// 逐条总线降档，直到总载荷不超过预算
+	bool fits = true;
+	for (auto& bus : buses) {
+		auto busBudget = Becamv4l2BandwidthPlanner::GetBusBudget(cameras[bus.second[0]].topology.busSpeed);
+		while (true) {
+			// 统计当前总载荷
+			uint64_t total = 0;
+			for (auto i : bus.second) {
+				total += options[i][current[i]].payloadRate;
+			}
+			if (total <= busBudget) {
+				break;
+			}
+
+			// 找出每节省1bit带宽损失像素最少的降档
+			int bestCamera = -1;
+			int bestOption = -1;
+			double bestScore = 0;
+			for (auto i : bus.second) {
+				auto& selected = options[i][current[i]];
+				for (size_t j = 0; j < options[i].size(); j++) {
+					auto& option = options[i][j];
+					if (option.payloadRate >= selected.payloadRate) {
+						continue;
+					}
+					double lost = double(selected.pixelRate) - double(option.pixelRate);
+					double saved = double(selected.payloadRate - option.payloadRate);
+					double score = lost / saved;
+					if (bestCamera == -1 || score < bestScore) {
+						bestCamera = int(i);
+						bestOption = int(j);
+						bestScore = score;
+					}
+				}
+			}
+
+			// 已无法继续降档
+			if (bestCamera == -1) {
+				fits = false;
+				break;
+			}
+			current[bestCamera] = bestOption;
+		}
+	}
+
+	// 输出规划结果（无候选或超出设备自身上限的也视为无法满足）
+	chosen.assign(cameras.size(), VideoFrameInfo{0});
+	for (size_t i = 0; i < cameras.size(); i++) {
+		if (current[i] == -1) {
+			fits = false;
+			continue;
+		}
+		auto& selected = options[i][current[i]];
+		if (cameras[i].topology.busNumber != 0 &&
+			selected.payloadRate > Becamv4l2BandwidthPlanner::GetDeviceBudget(cameras[i].topology.deviceSpeed)) {
+			fits = false;
+		}
+		chosen[i] = selected.frameInfo;
+	}
+	return fits;
+}
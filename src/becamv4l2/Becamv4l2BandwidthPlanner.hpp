@@ -0,0 +1,60 @@
+#pragma once
+
+#include "Becamv4l2SysfsHelper.hpp"
+#include <becam/becam.h>
+#include <vector>
+
+#ifndef _BECAMV4L2_BANDWIDTH_PLANNER_H_
+#define _BECAMV4L2_BANDWIDTH_PLANNER_H_
+
+/**
+ * @brief 带宽规划中的单个相机
+ */
+struct Becamv4l2PlannedCamera {
+	// USB拓扑信息
+	Becamv4l2UsbTopology topology;
+	// 满足最低要求的候选视频帧信息
+	std::vector<VideoFrameInfo> candidates;
+};
+
+/**
+ * @brief V4L2 USB带宽规划器
+ */
+class Becamv4l2BandwidthPlanner {
+private:
+	/**
+	 * @brief 获取总线可用于等时传输的带宽预算
+	 *
+	 * @param speed [in] 链路速率（Mbit/s）
+	 * @return 带宽预算（bit/s）
+	 */
+	static uint64_t GetBusBudget(const uint32_t speed);
+
+	/**
+	 * @brief 获取单个设备等时端点的带宽上限
+	 *
+	 * @param speed [in] 链路速率（Mbit/s）
+	 * @return 带宽上限（bit/s）
+	 */
+	static uint64_t GetDeviceBudget(const uint32_t speed);
+
+public:
+	/**
+	 * @brief 估算视频帧信息的载荷速率（含UVC负载头开销）
+	 *
+	 * @param frameInfo [in] 视频帧信息
+	 * @return 载荷速率（bit/s）
+	 */
+	static uint64_t EstimatePayloadRate(const VideoFrameInfo& frameInfo);
+
+	/**
+	 * @brief 规划视频帧信息
+	 *
+	 * @param cameras [in] 参与规划的相机列表
+	 * @param chosen [out] 每个相机规划的视频帧信息（无候选时全为0）
+	 * @return 是否所有总线都在带宽预算内
+	 */
+	static bool Plan(const std::vector<Becamv4l2PlannedCamera>& cameras, std::vector<VideoFrameInfo>& chosen);
+};
+
+#endif
@@ -0,0 +1,362 @@
+#include "Becamv4l2CapabilityStore.hpp"
+#include "Becamv4l2DeviceHelper.hpp"
+#include <fcntl.h>
+#include <pkg/LogOutput.hpp>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <system_error>
+#include <thread>
+#include <unistd.h>
+
+/**
+ * @brief 缓存文件头
+ */
+struct Becamv4l2CapabilityFileHeader {
+	// 魔数
+	uint32_t magic;
+	// 格式版本
+	uint32_t version;
+	// 条目数量
+	uint32_t entryCount;
+	// 保留
+	uint32_t reserved;
+};
+
+/**
+ * @brief 缓存条目头（其后依次为设备稳定标识、驱动指纹、4字节对齐填充及配置列表）
+ *
+ * 配置列表直接保存VideoFrameInfo的内存表示，VideoFrameInfo的字段或布局有任何变化都必须递增FILE_VERSION
+ */
+struct Becamv4l2CapabilityEntryHeader {
+	// 设备稳定标识长度
+	uint16_t deviceIdLength;
+	// 驱动指纹长度
+	uint16_t fingerprintLength;
+	// 配置数量
+	uint32_t configCount;
+};
+
+/**
+ * @brief 计算4字节对齐后的长度
+ */
+static size_t AlignCapabilityLength(const size_t length) {
+	return (length + 3) & ~size_t(3);
+}
+
+/**
+ * @implements 实现构造函数
+ */
+Becamv4l2CapabilityStore::Becamv4l2CapabilityStore(const std::string& filePath) : filePath(filePath) {}
+
+/**
+ * @implements 实现析构函数
+ */
+Becamv4l2CapabilityStore::~Becamv4l2CapabilityStore() {
+	// 等待后台校验线程结束
+	this->Shutdown();
+	// 加个锁先
+	std::unique_lock<std::mutex> lock(this->mtx);
+	// 取消映射
+	this->UnmapLocked();
+}
+
+/**
+ * @implements 实现获取默认缓存文件路径
+ */
+std::string Becamv4l2CapabilityStore::GetDefaultFilePath() {
+	// 设置了缓存目录视为显式开启
+	auto cacheDir = getenv("BECAM_CACHE_DIR");
+	if (cacheDir == nullptr || cacheDir[0] == '\0') {
+		return "";
+	}
+	return Becamv4l2CapabilityStore::ResolveFilePath(cacheDir);
+}
+
+/**
+ * @implements 实现获取缓存目录中的缓存文件路径
+ */
+std::string Becamv4l2CapabilityStore::ResolveFilePath(const std::string& cacheDir) {
+	if (!cacheDir.empty()) {
+		return cacheDir + "/v4l2-capabilities.bin";
+	}
+	auto envCacheDir = getenv("BECAM_CACHE_DIR");
+	if (envCacheDir != nullptr && envCacheDir[0] != '\0') {
+		return std::string(envCacheDir) + "/v4l2-capabilities.bin";
+	}
+	auto xdgCacheHome = getenv("XDG_CACHE_HOME");
+	if (xdgCacheHome != nullptr && xdgCacheHome[0] != '\0') {
+		return std::string(xdgCacheHome) + "/becam/v4l2-capabilities.bin";
+	}
+	auto home = getenv("HOME");
+	if (home != nullptr && home[0] != '\0') {
+		return std::string(home) + "/.cache/becam/v4l2-capabilities.bin";
+	}
+	return "";
+}
+
+/**
+ * @implements 实现更换缓存文件
+ */
+void Becamv4l2CapabilityStore::SetFilePath(const std::string& filePath) {
+	// 加个锁先
+	std::unique_lock<std::mutex> lock(this->mtx);
+	if (this->filePath == filePath) {
+		return;
+	}
+	this->UnmapLocked();
+	this->filePath = filePath;
+	this->mapAttempted = false;
+	this->revalidated.clear();
+}
+
+/**
+ * @implements 实现取消并等待后台校验线程结束
+ */
+void Becamv4l2CapabilityStore::Shutdown() {
+	// 取出全部线程（校验线程保存结果时需要加锁，不能持有锁等待）
+	std::vector<std::thread> pending;
+	{
+		std::unique_lock<std::mutex> lock(this->mtx);
+		this->stopping = true;
+		pending.swap(this->workers);
+	}
+	for (auto& worker : pending) {
+		worker.join();
+	}
+}
+
+/**
+ * @implements 实现取消映射
+ */
+void Becamv4l2CapabilityStore::UnmapLocked() {
+	if (this->mapped != nullptr) {
+		munmap(this->mapped, this->mappedSize);
+		this->mapped = nullptr;
+		this->mappedSize = 0;
+	}
+}
+
+/**
+ * @implements 实现重新映射缓存文件
+ */
+void Becamv4l2CapabilityStore::RemapLocked() {
+	this->UnmapLocked();
+	this->mapAttempted = true;
+	if (this->filePath.empty()) {
+		return;
+	}
+
+	// 只读映射（文件总是整体替换，已映射的旧文件内容不会被修改）
+	auto fd = open(this->filePath.c_str(), O_RDONLY | O_CLOEXEC);
+	if (fd == -1) {
+		return;
+	}
+	struct stat st;
+	if (fstat(fd, &st) == 0 && size_t(st.st_size) >= sizeof(Becamv4l2CapabilityFileHeader)) {
+		auto addr = mmap(nullptr, size_t(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+		if (addr != MAP_FAILED) {
+			this->mapped = addr;
+			this->mappedSize = size_t(st.st_size);
+		}
+	}
+	close(fd);
+}
+
+/**
+ * @implements 实现遍历已映射的缓存条目
+ */
+template <typename Visitor> bool Becamv4l2CapabilityStore::VisitLocked(Visitor visitor) const {
+	if (this->mapped == nullptr) {
+		return false;
+	}
+	auto base = static_cast<const uint8_t*>(this->mapped);
+	auto header = reinterpret_cast<const Becamv4l2CapabilityFileHeader*>(base);
+	if (header->magic != FILE_MAGIC || header->version != FILE_VERSION) {
+		return false;
+	}
+
+	// 逐个校验边界后访问
+	size_t offset = sizeof(Becamv4l2CapabilityFileHeader);
+	for (uint32_t i = 0; i < header->entryCount; i++) {
+		if (offset + sizeof(Becamv4l2CapabilityEntryHeader) > this->mappedSize) {
+			return false;
+		}
+		auto entry = reinterpret_cast<const Becamv4l2CapabilityEntryHeader*>(base + offset);
+		offset += sizeof(Becamv4l2CapabilityEntryHeader);
+		auto stringsLength = AlignCapabilityLength(size_t(entry->deviceIdLength) + entry->fingerprintLength);
+		auto configLength = size_t(entry->configCount) * sizeof(VideoFrameInfo);
+		if (offset + stringsLength + configLength > this->mappedSize) {
+			return false;
+		}
+		std::string deviceId(reinterpret_cast<const char*>(base + offset), entry->deviceIdLength);
+		std::string fingerprint(reinterpret_cast<const char*>(base + offset + entry->deviceIdLength), entry->fingerprintLength);
+		auto configList = reinterpret_cast<const VideoFrameInfo*>(base + offset + stringsLength);
+		offset += stringsLength + configLength;
+		if (!visitor(deviceId, fingerprint, configList, size_t(entry->configCount))) {
+			break;
+		}
+	}
+	return true;
+}
+
+/**
+ * @implements 实现读取缓存的设备配置列表
+ */
+bool Becamv4l2CapabilityStore::Load(const std::string& deviceId, const std::string& fingerprint, std::vector<VideoFrameInfo>& configList) {
+	// 加个锁先
+	std::unique_lock<std::mutex> lock(this->mtx);
+
+	// 首次使用时映射
+	if (!this->mapAttempted) {
+		this->RemapLocked();
+	}
+
+	// 查找稳定标识和驱动指纹都一致的条目
+	bool found = false;
+	this->VisitLocked([&](const std::string& id, const std::string& fp, const VideoFrameInfo* list, const size_t listSize) {
+		if (id != deviceId || fp != fingerprint) {
+			return true;
+		}
+		configList.assign(list, list + listSize);
+		found = true;
+		return false;
+	});
+	return found;
+}
+
+/**
+ * @implements 实现保存设备配置列表
+ */
+void Becamv4l2CapabilityStore::Save(const std::string& deviceId, const std::string& fingerprint,
+									const std::vector<VideoFrameInfo>& configList) {
+	// 加个锁先
+	std::unique_lock<std::mutex> lock(this->mtx);
+
+	// 检查
+	if (this->filePath.empty() || deviceId.size() > UINT16_MAX || fingerprint.size() > UINT16_MAX) {
+		return;
+	}
+
+	// 重新映射，合并其它进程写入的条目（同一设备只保留最新的一条）
+	this->RemapLocked();
+	std::vector<uint8_t> content(sizeof(Becamv4l2CapabilityFileHeader), 0);
+	uint32_t entryCount = 0;
+	auto appendEntry = [&](const std::string& id, const std::string& fp, const VideoFrameInfo* list, const size_t listSize) {
+		Becamv4l2CapabilityEntryHeader entry = {uint16_t(id.size()), uint16_t(fp.size()), uint32_t(listSize)};
+		auto offset = content.size();
+		auto stringsLength = AlignCapabilityLength(id.size() + fp.size());
+		content.resize(offset + sizeof(entry) + stringsLength + listSize * sizeof(VideoFrameInfo), 0);
+		memcpy(content.data() + offset, &entry, sizeof(entry));
+		offset += sizeof(entry);
+		memcpy(content.data() + offset, id.data(), id.size());
+		memcpy(content.data() + offset + id.size(), fp.data(), fp.size());
+		if (listSize > 0) {
+			memcpy(content.data() + offset + stringsLength, list, listSize * sizeof(VideoFrameInfo));
+		}
+		entryCount++;
+	};
+	appendEntry(deviceId, fingerprint, configList.data(), configList.size());
+	this->VisitLocked([&](const std::string& id, const std::string& fp, const VideoFrameInfo* list, const size_t listSize) {
+		if (id != deviceId) {
+			appendEntry(id, fp, list, listSize);
+		}
+		return entryCount < MAX_CAPABILITY_ENTRIES;
+	});
+	Becamv4l2CapabilityFileHeader header = {FILE_MAGIC, FILE_VERSION, entryCount, 0};
+	memcpy(content.data(), &header, sizeof(header));
+
+	// 逐级创建缓存目录
+	auto dir = this->filePath.substr(0, this->filePath.find_last_of('/'));
+	for (size_t pos = 1; pos != std::string::npos && !dir.empty();) {
+		pos = dir.find('/', pos);
+		mkdir(dir.substr(0, pos).c_str(), 0755);
+		if (pos != std::string::npos) {
+			pos++;
+		}
+	}
+
+	// 写入临时文件后原子替换，避免其它进程读到不完整的内容
+	auto tempPath = this->filePath + ".tmp." + std::to_string(getpid());
+	auto fd = open(tempPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+	if (fd == -1) {
+		DEBUG_LOG("Becamv4l2CapabilityStore::Save -> open(" << tempPath << ") Failed");
+		return;
+	}
+	auto written = write(fd, content.data(), content.size());
+	close(fd);
+	if (written != ssize_t(content.size()) || rename(tempPath.c_str(), this->filePath.c_str()) != 0) {
+		DEBUG_LOG("Becamv4l2CapabilityStore::Save -> Write " << this->filePath << " Failed");
+		unlink(tempPath.c_str());
+		return;
+	}
+
+	// 映射新文件
+	this->RemapLocked();
+}
+
+/**
+ * @implements 实现在后台线程中校验缓存
+ */
+void Becamv4l2CapabilityStore::RevalidateAsync(const std::string& devicePath, const std::string& deviceId, const std::string& fingerprint,
+											   const std::vector<VideoFrameInfo>& cached) {
+	{
+		// 加个锁先
+		std::unique_lock<std::mutex> lock(this->mtx);
+		// 停止后不再校验，每个设备只校验一次
+		if (this->stopping || !this->revalidated.insert(deviceId).second) {
+			return;
+		}
+	}
+
+	// 后台线程在析构时被等待结束，可以直接使用缓存实例
+	auto revalidate = [this, devicePath, deviceId, fingerprint, cached]() {
+		// 重新枚举设备配置
+		if (this->stopping) {
+			return;
+		}
+		Becamv4l2DeviceHelper deviceHelper;
+		if (deviceHelper.ActivateDevice(devicePath) != StatusCode::STATUS_CODE_SUCCESS) {
+			return;
+		}
+		VideoFrameInfo* list = nullptr;
+		size_t listSize = 0;
+		if (deviceHelper.GetCurrentDeviceConfigList(list, listSize) != StatusCode::STATUS_CODE_SUCCESS) {
+			return;
+		}
+		std::vector<VideoFrameInfo> fresh(list, list + listSize);
+		Becamv4l2DeviceHelper::FreeDeviceConfigList(list, listSize);
+		if (this->stopping) {
+			return;
+		}
+
+		// 有变化时更新缓存文件并通知调用方
+		if (fresh.size() != cached.size() || (!fresh.empty() && memcmp(fresh.data(), cached.data(), fresh.size() * sizeof(VideoFrameInfo)) != 0)) {
+			DEBUG_LOG("Becamv4l2CapabilityStore::RevalidateAsync -> " << devicePath << " Capabilities Changed");
+			this->Save(deviceId, fingerprint, fresh);
+			this->revision++;
+		}
+	};
+	try {
+		std::thread worker(revalidate);
+		// 加个锁先
+		std::unique_lock<std::mutex> lock(this->mtx);
+		if (!this->stopping) {
+			this->workers.push_back(std::move(worker));
+			return;
+		}
+		// 创建期间已开始停止，由当前线程等待结束
+		lock.unlock();
+		worker.join();
+	} catch (const std::system_error&) {
+		DEBUG_LOG("Becamv4l2CapabilityStore::RevalidateAsync -> std::thread Failed");
+	}
+}
+
+/**
+ * @implements 实现获取后台校验发现变化的次数
+ */
+uint64_t Becamv4l2CapabilityStore::GetRevision() const {
+	return this->revision.load();
+}
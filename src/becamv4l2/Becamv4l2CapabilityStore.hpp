@@ -0,0 +1,146 @@
+#pragma once
+
+#include <atomic>
+#include <becam/becam.h>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifndef _BECAMV4L2_CAPABILITY_STORE_H_
+#define _BECAMV4L2_CAPABILITY_STORE_H_
+
+/**
+ * @brief V4L2 设备配置列表的持久化缓存
+ *
+ * 以设备稳定标识和驱动指纹为键，将设备配置列表保存在紧凑的二进制文件中，通过mmap只读映射后直接查找；
+ * 冷启动命中缓存时无需逐个枚举格式、分辨率和帧率，之后在后台线程中重新枚举校验；
+ * 默认不启用（仅设置了环境变量BECAM_CACHE_DIR或调用方显式开启时读写缓存文件），后台线程在析构时取消并等待结束
+ */
+class Becamv4l2CapabilityStore {
+private:
+	// 互斥锁
+	std::mutex mtx;
+	// 缓存文件路径（为空表示不可用）
+	std::string filePath;
+	// 已映射的文件内容
+	void* mapped = nullptr;
+	// 已映射的文件大小
+	size_t mappedSize = 0;
+	// 是否已尝试映射
+	bool mapAttempted = false;
+	// 后台校验发现变化的次数
+	std::atomic<uint64_t> revision{0};
+	// 已发起后台校验的设备稳定标识
+	std::set<std::string> revalidated;
+	// 后台校验线程
+	std::vector<std::thread> workers;
+	// 是否正在停止（停止后不再发起后台校验，进行中的校验尽早退出）
+	std::atomic<bool> stopping{false};
+
+	/**
+	 * @brief 重新映射缓存文件（调用方需持有锁）
+	 */
+	void RemapLocked();
+
+	/**
+	 * @brief 取消映射（调用方需持有锁）
+	 */
+	void UnmapLocked();
+
+	/**
+	 * @brief 遍历已映射的缓存条目（调用方需持有锁）
+	 *
+	 * @param visitor [in] 访问函数（参数依次为设备稳定标识、驱动指纹、配置列表及数量，返回false时停止遍历）
+	 * @return 文件格式是否有效
+	 */
+	template <typename Visitor> bool VisitLocked(Visitor visitor) const;
+
+public:
+	// 缓存文件魔数
+	static constexpr uint32_t FILE_MAGIC = 0x50414342; // "BCAP"
+	// 缓存文件格式版本（条目中直接保存VideoFrameInfo的内存表示，其结构有任何变化都必须递增）
+	static constexpr uint32_t FILE_VERSION = 1;
+	// 缓存文件最多保存的条目数量（超出时丢弃最早写入的条目）
+	static constexpr size_t MAX_CAPABILITY_ENTRIES = 256;
+
+	/**
+	 * @brief 构造函数
+	 *
+	 * @param filePath [in] 缓存文件路径（为空时不缓存）
+	 */
+	explicit Becamv4l2CapabilityStore(const std::string& filePath);
+
+	/**
+	 * @brief 析构函数
+	 */
+	~Becamv4l2CapabilityStore();
+
+	/**
+	 * @brief 获取默认缓存文件路径（仅在设置了环境变量BECAM_CACHE_DIR时启用）
+	 *
+	 * @return 缓存文件路径（未启用时为空）
+	 */
+	static std::string GetDefaultFilePath();
+
+	/**
+	 * @brief 获取缓存目录中的缓存文件路径
+	 *
+	 * @param cacheDir [in] 缓存目录（为空时依次使用环境变量BECAM_CACHE_DIR、XDG_CACHE_HOME、HOME）
+	 * @return 缓存文件路径（无可用目录时为空）
+	 */
+	static std::string ResolveFilePath(const std::string& cacheDir);
+
+	/**
+	 * @brief 更换缓存文件（已映射的文件随即取消映射）
+	 *
+	 * @param filePath [in] 缓存文件路径（为空时不缓存）
+	 */
+	void SetFilePath(const std::string& filePath);
+
+	/**
+	 * @brief 取消并等待全部后台校验线程结束（之后不再发起后台校验）
+	 */
+	void Shutdown();
+
+	/**
+	 * @brief 读取缓存的设备配置列表
+	 *
+	 * @param deviceId [in] 设备稳定标识
+	 * @param fingerprint [in] 驱动指纹
+	 * @param configList [out] 设备配置列表
+	 * @return 是否命中
+	 */
+	bool Load(const std::string& deviceId, const std::string& fingerprint, std::vector<VideoFrameInfo>& configList);
+
+	/**
+	 * @brief 保存设备配置列表（合并其它进程已写入的条目，整体写入临时文件后原子替换）
+	 *
+	 * @param deviceId [in] 设备稳定标识
+	 * @param fingerprint [in] 驱动指纹
+	 * @param configList [in] 设备配置列表
+	 */
+	void Save(const std::string& deviceId, const std::string& fingerprint, const std::vector<VideoFrameInfo>& configList);
+
+	/**
+	 * @brief 在后台线程中重新枚举设备配置并校验缓存（每个设备只校验一次）
+	 *
+	 * @param devicePath [in] 设备路径
+	 * @param deviceId [in] 设备稳定标识
+	 * @param fingerprint [in] 驱动指纹
+	 * @param cached [in] 已缓存的设备配置列表
+	 */
+	void RevalidateAsync(const std::string& devicePath, const std::string& deviceId, const std::string& fingerprint,
+						 const std::vector<VideoFrameInfo>& cached);
+
+	/**
+	 * @brief 获取后台校验发现变化的次数（变化时调用方需丢弃内存中的缓存）
+	 *
+	 * @return 变化次数
+	 */
+	uint64_t GetRevision() const;
+};
+
+#endif
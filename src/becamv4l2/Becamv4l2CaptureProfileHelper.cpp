@@ -0,0 +1,182 @@
+#include "Becamv4l2CaptureProfileHelper.hpp"
+#include <pkg/LogOutput.hpp>
+
+/**
+ * @implements 实现设置单个控制项
+ */
+bool Becamv4l2CaptureProfileHelper::SetControl(Becamv4l2ControlHelper& controlHelper, const uint32_t id, const int64_t value) {
+	ControlValue control = {id, value};
+	auto code = controlHelper.SetControls(&control, 1);
+	if (code != StatusCode::STATUS_CODE_SUCCESS) {
+		DEBUG_LOG("Becamv4l2CaptureProfileHelper::SetControl -> SetControls(0x" << std::hex << id << std::dec << ") failed, CODE: " << code);
+		return false;
+	}
+	return true;
+}
+
+/**
+ * @implements 实现检查菜单控制项是否包含指定菜单项
+ */
+bool Becamv4l2CaptureProfileHelper::HasMenuItem(const Becamv4l2ControlEntry& entry, const uint32_t index) {
+	for (auto& item : entry.menuItems) {
+		if (item.index == index) {
+			return true;
+		}
+	}
+	return false;
+}
+
+/**
+ * @implements 实现设置采集配置
+ */
+void Becamv4l2CaptureProfileHelper::SetProfile(const CaptureProfile* input) {
+	this->enabled = input != nullptr;
+	this->profile = input != nullptr ? *input : CaptureProfile{};
+	// 取消时同时清空应用结果
+	if (!this->enabled) {
+		this->report = {};
+		this->measuring = false;
+	}
+}
+
+/**
+ * @implements 实现是否启用了采集配置
+ */
+bool Becamv4l2CaptureProfileHelper::IsEnabled() const {
+	return this->enabled;
+}
+
+/**
+ * @implements 实现对当前设备应用采集配置
+ */
+void Becamv4l2CaptureProfileHelper::Apply(Becamv4l2ControlHelper& controlHelper, const v4l2_fract& timePerFrame) {
+	// 重置应用结果
+	this->report = {};
+	this->measuring = false;
+	if (!this->enabled) {
+		return;
+	}
+	if (timePerFrame.numerator > 0) {
+		this->report.negotiatedFrameRate = uint32_t(uint64_t(timePerFrame.denominator) * 1000 / timePerFrame.numerator);
+	}
+	this->report.frameRateCheck =
+		this->profile.verifyFrameCount > 0 ? FrameRateCheck::FRAME_RATE_CHECK_PENDING : FrameRateCheck::FRAME_RATE_CHECK_DISABLED;
+
+	// 不允许设备为延长曝光而降低帧率（先于曝光方式设置，部分设备切换曝光方式时会参考该值）
+	Becamv4l2ControlEntry entry;
+	if (controlHelper.GetControlEntry(V4L2_CID_EXPOSURE_AUTO_PRIORITY, entry) &&
+		Becamv4l2CaptureProfileHelper::SetControl(controlHelper, V4L2_CID_EXPOSURE_AUTO_PRIORITY, 0)) {
+		this->report.appliedControls |= CaptureProfileControl::CAPTURE_PROFILE_CONTROL_EXPOSURE_PRIORITY;
+	}
+
+	// 曝光方式（UVC设备通常仅支持手动和光圈优先两种）
+	int64_t exposureMode = -1;
+	if (controlHelper.GetControlEntry(V4L2_CID_EXPOSURE_AUTO, entry)) {
+		if (this->profile.exposureMode == ExposureMode::EXPOSURE_MODE_MANUAL &&
+			Becamv4l2CaptureProfileHelper::HasMenuItem(entry, V4L2_EXPOSURE_MANUAL)) {
+			exposureMode = V4L2_EXPOSURE_MANUAL;
+		} else if (this->profile.exposureMode == ExposureMode::EXPOSURE_MODE_AUTO_BOUNDED) {
+			if (Becamv4l2CaptureProfileHelper::HasMenuItem(entry, V4L2_EXPOSURE_APERTURE_PRIORITY)) {
+				exposureMode = V4L2_EXPOSURE_APERTURE_PRIORITY;
+			} else if (Becamv4l2CaptureProfileHelper::HasMenuItem(entry, V4L2_EXPOSURE_AUTO)) {
+				exposureMode = V4L2_EXPOSURE_AUTO;
+			}
+		}
+	}
+	if (exposureMode != -1 && Becamv4l2CaptureProfileHelper::SetControl(controlHelper, V4L2_CID_EXPOSURE_AUTO, exposureMode)) {
+		this->report.appliedControls |= CaptureProfileControl::CAPTURE_PROFILE_CONTROL_EXPOSURE_MODE;
+	}
+
+	// 电源频率
+	int64_t powerLine = -1;
+	switch (this->profile.powerLineFrequency) {
+	case PowerLineFrequency::POWER_LINE_FREQUENCY_DISABLED:
+		powerLine = V4L2_CID_POWER_LINE_FREQUENCY_DISABLED;
+		break;
+	case PowerLineFrequency::POWER_LINE_FREQUENCY_50HZ:
+		powerLine = V4L2_CID_POWER_LINE_FREQUENCY_50HZ;
+		break;
+	case PowerLineFrequency::POWER_LINE_FREQUENCY_60HZ:
+		powerLine = V4L2_CID_POWER_LINE_FREQUENCY_60HZ;
+		break;
+	case PowerLineFrequency::POWER_LINE_FREQUENCY_AUTO:
+		powerLine = V4L2_CID_POWER_LINE_FREQUENCY_AUTO;
+		break;
+	default:
+		break;
+	}
+	if (powerLine != -1 && controlHelper.GetControlEntry(V4L2_CID_POWER_LINE_FREQUENCY, entry) &&
+		Becamv4l2CaptureProfileHelper::HasMenuItem(entry, uint32_t(powerLine)) &&
+		Becamv4l2CaptureProfileHelper::SetControl(controlHelper, V4L2_CID_POWER_LINE_FREQUENCY, powerLine)) {
+		this->report.appliedControls |= CaptureProfileControl::CAPTURE_PROFILE_CONTROL_POWER_LINE;
+	}
+
+	// 手动曝光时间（需在切换为手动曝光后设置，自动曝光时该控制项不生效）
+	if (exposureMode != V4L2_EXPOSURE_MANUAL || !controlHelper.GetControlEntry(V4L2_CID_EXPOSURE_ABSOLUTE, entry)) {
+		return;
+	}
+	// 曝光时间不超过帧间隔（单位均为100微秒）
+	int64_t frameInterval = 0;
+	if (timePerFrame.denominator > 0) {
+		frameInterval = int64_t(timePerFrame.numerator) * 10000 / timePerFrame.denominator;
+	}
+	int64_t exposureTime = this->profile.exposureTime;
+	if (exposureTime == 0 || (frameInterval > 0 && exposureTime > frameInterval)) {
+		exposureTime = frameInterval;
+	}
+	// 按设备范围及步长修正
+	if (exposureTime > entry.info.maximum) {
+		exposureTime = entry.info.maximum;
+	}
+	if (exposureTime < entry.info.minimum) {
+		exposureTime = entry.info.minimum;
+	}
+	if (entry.info.step > 1) {
+		exposureTime = entry.info.minimum + (exposureTime - entry.info.minimum) / int64_t(entry.info.step) * int64_t(entry.info.step);
+	}
+	if (Becamv4l2CaptureProfileHelper::SetControl(controlHelper, V4L2_CID_EXPOSURE_ABSOLUTE, exposureTime)) {
+		this->report.appliedControls |= CaptureProfileControl::CAPTURE_PROFILE_CONTROL_EXPOSURE_TIME;
+		this->report.exposureTime = uint32_t(exposureTime);
+	}
+}
+
+/**
+ * @implements 实现记录取走的视频帧
+ */
+void Becamv4l2CaptureProfileHelper::OnFrame(const uint32_t sequence, const uint64_t timestamp) {
+	// 仅在校验中时测量
+	if (this->report.frameRateCheck != FrameRateCheck::FRAME_RATE_CHECK_PENDING) {
+		return;
+	}
+	// 记录测量起点（取流启动耗时不计入帧间隔）
+	if (!this->measuring || timestamp <= this->firstTimestamp) {
+		this->measuring = true;
+		this->firstSequence = sequence;
+		this->firstTimestamp = timestamp;
+		return;
+	}
+
+	// 按序号计算设备输出的帧数，调用方取帧较慢导致的丢帧不影响结果
+	auto frames = sequence - this->firstSequence;
+	if (frames < this->profile.verifyFrameCount) {
+		return;
+	}
+	auto elapsed = timestamp - this->firstTimestamp;
+	this->report.measuredFrameCount = frames;
+	this->report.measuredFrameRate = uint32_t(uint64_t(frames) * 1000000000 / elapsed);
+	// 实际帧率不低于协商帧率（允许一定抖动）
+	auto matched = uint64_t(this->report.measuredFrameRate) * 100 >=
+				   uint64_t(this->report.negotiatedFrameRate) * (100 - Becamv4l2CaptureProfileHelper::FRAME_RATE_TOLERANCE_PERCENT);
+	this->report.frameRateCheck = matched ? FrameRateCheck::FRAME_RATE_CHECK_MATCHED : FrameRateCheck::FRAME_RATE_CHECK_MISMATCHED;
+	if (!matched) {
+		DEBUG_LOG("Becamv4l2CaptureProfileHelper::OnFrame -> frame rate mismatched, negotiated: " << this->report.negotiatedFrameRate
+																								  << ", measured: " << this->report.measuredFrameRate);
+	}
+}
+
+/**
+ * @implements 实现获取应用结果
+ */
+void Becamv4l2CaptureProfileHelper::GetReport(CaptureProfileReport& output) const {
+	output = this->report;
+}
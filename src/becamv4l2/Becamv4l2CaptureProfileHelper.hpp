@@ -0,0 +1,90 @@
+#pragma once
+
+#include "Becamv4l2ControlHelper.hpp"
+#include <becam/becam.h>
+#include <linux/videodev2.h>
+
+#ifndef _BECAMV4L2_CAPTURE_PROFILE_HELPER_H_
+#define _BECAMV4L2_CAPTURE_PROFILE_HELPER_H_
+
+/**
+ * @brief V4L2 低延迟采集配置助手类
+ *
+ * UVC设备在自动曝光且exposure_auto_priority=1时，光线不足会自行延长帧间隔（30帧可降至7~15帧），
+ * 因此在开始取流前固定相关控制项，并根据取走的视频帧校验实际帧率；
+ * 本身不加锁，由持有设备句柄的调用方保证互斥
+ */
+class Becamv4l2CaptureProfileHelper {
+private:
+	// 实际帧率允许低于协商帧率的比例（百分比，容忍时间戳抖动）
+	static const uint32_t FRAME_RATE_TOLERANCE_PERCENT = 10;
+	// 是否启用采集配置
+	bool enabled = false;
+	// 采集配置（设备关闭后仍保留，下次激活取流时生效）
+	CaptureProfile profile = {};
+	// 应用结果
+	CaptureProfileReport report = {};
+	// 是否已记录测量起点
+	bool measuring = false;
+	// 测量起点的视频帧序号
+	uint32_t firstSequence = 0;
+	// 测量起点的视频帧时间戳（微秒）
+	uint64_t firstTimestamp = 0;
+
+	/**
+	 * @brief 设置单个控制项（设备不支持或只读时跳过）
+	 *
+	 * @param controlHelper [in] 控制项助手
+	 * @param id [in] 控制项标识
+	 * @param value [in] 控制项取值
+	 * @return 是否设置成功
+	 */
+	static bool SetControl(Becamv4l2ControlHelper& controlHelper, const uint32_t id, const int64_t value);
+
+	/**
+	 * @brief 检查菜单控制项是否包含指定菜单项
+	 *
+	 * @param entry [in] 控制项信息
+	 * @param index [in] 菜单项序号
+	 * @return 是否包含
+	 */
+	static bool HasMenuItem(const Becamv4l2ControlEntry& entry, const uint32_t index);
+
+public:
+	/**
+	 * @brief 设置采集配置
+	 *
+	 * @param input [in] 采集配置（为空时取消）
+	 */
+	void SetProfile(const CaptureProfile* input);
+
+	/**
+	 * @brief 是否启用了采集配置
+	 */
+	bool IsEnabled() const;
+
+	/**
+	 * @brief 对当前设备应用采集配置，并重新开始帧率校验
+	 *
+	 * @param controlHelper [in] 当前设备的控制项助手
+	 * @param timePerFrame [in] 驱动实际生效的帧间隔
+	 */
+	void Apply(Becamv4l2ControlHelper& controlHelper, const v4l2_fract& timePerFrame);
+
+	/**
+	 * @brief 记录取走的视频帧，用于测量实际帧率
+	 *
+	 * @param sequence [in] 视频帧序号（驱动对未被取走而丢弃的帧同样计数）
+	 * @param timestamp [in] 视频帧采集时间戳（微秒）
+	 */
+	void OnFrame(const uint32_t sequence, const uint64_t timestamp);
+
+	/**
+	 * @brief 获取应用结果
+	 *
+	 * @param output [out] 应用结果
+	 */
+	void GetReport(CaptureProfileReport& output) const;
+};
+
+#endif
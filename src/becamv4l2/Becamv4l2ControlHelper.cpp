@@ -0,0 +1,404 @@
+#include "Becamv4l2ControlHelper.hpp"
+#include "xioctl.hpp"
+#include <errno.h>
+#include <new>
+#include <pkg/LogOutput.hpp>
+#include <string.h>
+
+/**
+ * @implements 实现关联设备
+ */
+void Becamv4l2ControlHelper::Attach(const int fd) {
+	this->deviceFdHandle = fd;
+	this->enumerated = false;
+	this->controls.clear();
+	this->controlIndexes.clear();
+	this->values.clear();
+}
+
+/**
+ * @implements 实现转换控制项类型
+ */
+ControlType Becamv4l2ControlHelper::ConvertType(const uint32_t type) {
+	switch (type) {
+		case V4L2_CTRL_TYPE_INTEGER:
+			return ControlType::CONTROL_TYPE_INTEGER;
+		case V4L2_CTRL_TYPE_BOOLEAN:
+			return ControlType::CONTROL_TYPE_BOOLEAN;
+		case V4L2_CTRL_TYPE_MENU:
+			return ControlType::CONTROL_TYPE_MENU;
+		case V4L2_CTRL_TYPE_BUTTON:
+			return ControlType::CONTROL_TYPE_BUTTON;
+		case V4L2_CTRL_TYPE_INTEGER64:
+			return ControlType::CONTROL_TYPE_INTEGER64;
+		case V4L2_CTRL_TYPE_INTEGER_MENU:
+			return ControlType::CONTROL_TYPE_INTEGER_MENU;
+		case V4L2_CTRL_TYPE_BITMASK:
+			return ControlType::CONTROL_TYPE_BITMASK;
+		default:
+			return ControlType::CONTROL_TYPE_OTHER;
+	}
+}
+
+/**
+ * @implements 实现转换控制项标志
+ */
+uint32_t Becamv4l2ControlHelper::ConvertFlags(const uint32_t flags) {
+	uint32_t result = 0;
+	if (flags & V4L2_CTRL_FLAG_READ_ONLY) {
+		result |= ControlFlag::CONTROL_FLAG_READ_ONLY;
+	}
+	if (flags & V4L2_CTRL_FLAG_WRITE_ONLY) {
+		result |= ControlFlag::CONTROL_FLAG_WRITE_ONLY;
+	}
+	if (flags & V4L2_CTRL_FLAG_VOLATILE) {
+		result |= ControlFlag::CONTROL_FLAG_VOLATILE;
+	}
+	if (flags & V4L2_CTRL_FLAG_INACTIVE) {
+		result |= ControlFlag::CONTROL_FLAG_INACTIVE;
+	}
+	if (flags & V4L2_CTRL_FLAG_GRABBED) {
+		result |= ControlFlag::CONTROL_FLAG_GRABBED;
+	}
+	if (flags & V4L2_CTRL_FLAG_UPDATE) {
+		result |= ControlFlag::CONTROL_FLAG_UPDATE;
+	}
+	return result;
+}
+
+/**
+ * @implements 实现查询单个控制项
+ */
+bool Becamv4l2ControlHelper::QueryControl(v4l2_query_ext_ctrl& query) {
+	// 优先使用扩展查询（支持64位取值范围）
+	if (xioctl(this->deviceFdHandle, VIDIOC_QUERY_EXT_CTRL, &query) == 0) {
+		return true;
+	}
+	if (errno != ENOTTY) {
+		return false;
+	}
+
+	// 旧内核退化为普通查询
+	v4l2_queryctrl legacy = {0};
+	legacy.id = query.id;
+	if (xioctl(this->deviceFdHandle, VIDIOC_QUERYCTRL, &legacy) != 0) {
+		return false;
+	}
+	memset(&query, 0, sizeof(query));
+	query.id = legacy.id;
+	query.type = legacy.type;
+	memcpy(query.name, legacy.name, sizeof(legacy.name));
+	query.minimum = legacy.minimum;
+	query.maximum = legacy.maximum;
+	query.step = uint64_t(legacy.step);
+	query.default_value = legacy.default_value;
+	query.flags = legacy.flags;
+	query.elems = 1;
+	return true;
+}
+
+/**
+ * @implements 实现枚举控制项
+ */
+StatusCode Becamv4l2ControlHelper::Enumerate() {
+	// 检查设备
+	if (this->deviceFdHandle == -1) {
+		return StatusCode::STATUS_CODE_ERR_DEVICE_NOT_OPEN;
+	}
+	if (this->enumerated) {
+		return StatusCode::STATUS_CODE_SUCCESS;
+	}
+	this->controls.clear();
+	this->controlIndexes.clear();
+
+	// 依次查询下一个控制项
+	v4l2_query_ext_ctrl query = {0};
+	query.id = V4L2_CTRL_FLAG_NEXT_CTRL;
+	while (this->QueryControl(query)) {
+		auto id = query.id;
+		// 跳过已禁用的控制项、类别标题及复合类型
+		if (!(query.flags & V4L2_CTRL_FLAG_DISABLED) && query.type != V4L2_CTRL_TYPE_CTRL_CLASS && query.type < V4L2_CTRL_COMPOUND_TYPES) {
+			Becamv4l2ControlEntry entry;
+			memset(&entry.info, 0, sizeof(entry.info));
+			entry.info.id = id;
+			entry.info.type = Becamv4l2ControlHelper::ConvertType(query.type);
+			strncpy(entry.info.name, query.name, sizeof(entry.info.name) - 1);
+			entry.info.minimum = query.minimum;
+			entry.info.maximum = query.maximum;
+			entry.info.step = query.step;
+			entry.info.defaultValue = query.default_value;
+			entry.info.flags = Becamv4l2ControlHelper::ConvertFlags(query.flags);
+
+			// 菜单类型需要逐项查询（中间可能有空缺）
+			if (query.type == V4L2_CTRL_TYPE_MENU || query.type == V4L2_CTRL_TYPE_INTEGER_MENU) {
+				for (int64_t index = query.minimum; index <= query.maximum; index++) {
+					v4l2_querymenu menu = {0};
+					menu.id = id;
+					menu.index = uint32_t(index);
+					if (xioctl(this->deviceFdHandle, VIDIOC_QUERYMENU, &menu) != 0) {
+						continue;
+					}
+					ControlMenuItem item = {0};
+					item.index = menu.index;
+					if (query.type == V4L2_CTRL_TYPE_MENU) {
+						strncpy(item.name, reinterpret_cast<const char*>(menu.name), sizeof(item.name) - 1);
+					} else {
+						item.value = menu.value;
+					}
+					entry.menuItems.push_back(item);
+				}
+			}
+			this->controlIndexes[id] = this->controls.size();
+			this->controls.push_back(entry);
+		}
+		// 查询下一个
+		memset(&query, 0, sizeof(query));
+		query.id = id | V4L2_CTRL_FLAG_NEXT_CTRL;
+	}
+
+	this->enumerated = true;
+	return StatusCode::STATUS_CODE_SUCCESS;
+}
+
+/**
+ * @implements 实现查找控制项
+ */
+const Becamv4l2ControlEntry* Becamv4l2ControlHelper::Find(const uint32_t id) const {
+	auto it = this->controlIndexes.find(id);
+	if (it == this->controlIndexes.end()) {
+		return nullptr;
+	}
+	return &this->controls[it->second];
+}
+
+/**
+ * @implements 实现执行扩展控制项ioctl
+ */
+bool Becamv4l2ControlHelper::ExecuteGrouped(const unsigned long request, std::vector<v4l2_ext_control>& controlList) {
+	// 同一类别的控制项放在一次调用中（旧驱动要求同一次调用中的控制项属于同一类别）
+	std::map<uint32_t, std::vector<size_t>> groups;
+	for (size_t i = 0; i < controlList.size(); i++) {
+		groups[V4L2_CTRL_ID2WHICH(controlList[i].id)].push_back(i);
+	}
+
+	// 新驱动支持以V4L2_CTRL_WHICH_CUR_VAL在一次调用中混合多个类别，同时保证写入顺序
+	if (groups.size() > 1) {
+		auto batch = controlList;
+		v4l2_ext_controls ctrls = {0};
+		ctrls.which = V4L2_CTRL_WHICH_CUR_VAL;
+		ctrls.count = uint32_t(batch.size());
+		ctrls.controls = batch.data();
+		if (xioctl(this->deviceFdHandle, request, &ctrls) == 0) {
+			controlList = batch;
+			return true;
+		}
+		// error_idx等于count表示尚未写入任何控制项，此时才能退化为分组调用
+		if (ctrls.error_idx != ctrls.count) {
+			DEBUG_LOG("Becamv4l2ControlHelper::ExecuteGrouped -> ioctl(" << request << ") Failed, ERROR_IDX: " << ctrls.error_idx);
+			return false;
+		}
+	}
+
+	for (auto& group : groups) {
+		std::vector<v4l2_ext_control> batch;
+		for (auto index : group.second) {
+			batch.push_back(controlList[index]);
+		}
+		v4l2_ext_controls ctrls = {0};
+		ctrls.which = group.first;
+		ctrls.count = uint32_t(batch.size());
+		ctrls.controls = batch.data();
+		if (xioctl(this->deviceFdHandle, request, &ctrls) != 0) {
+			DEBUG_LOG("Becamv4l2ControlHelper::ExecuteGrouped -> ioctl(" << request << ") Failed, CLASS: " << group.first
+																		 << ", ERROR_IDX: " << ctrls.error_idx);
+			return false;
+		}
+		// 写回驱动返回的取值
+		for (size_t i = 0; i < batch.size(); i++) {
+			controlList[group.second[i]] = batch[i];
+		}
+	}
+	return true;
+}
+
+/**
+ * @implements 实现获取控制项列表
+ */
+StatusCode Becamv4l2ControlHelper::GetControlList(ControlInfo*& reply, size_t& replySize) {
+	// 重置
+	reply = nullptr;
+	replySize = 0;
+
+	// 枚举（已缓存时直接使用）
+	auto code = this->Enumerate();
+	if (code != StatusCode::STATUS_CODE_SUCCESS) {
+		return code;
+	}
+	if (this->controls.empty()) {
+		return StatusCode::STATUS_CODE_SUCCESS;
+	}
+
+	// 控制项及菜单项一次性分配
+	size_t menuItemCount = 0;
+	for (auto& entry : this->controls) {
+		menuItemCount += entry.menuItems.size();
+	}
+	auto block = static_cast<uint8_t*>(::operator new(this->controls.size() * sizeof(ControlInfo) + menuItemCount * sizeof(ControlMenuItem)));
+	auto infos = reinterpret_cast<ControlInfo*>(block);
+	auto menuItems = reinterpret_cast<ControlMenuItem*>(block + this->controls.size() * sizeof(ControlInfo));
+	for (size_t i = 0; i < this->controls.size(); i++) {
+		auto& entry = this->controls[i];
+		infos[i] = entry.info;
+		infos[i].menuItemListSize = entry.menuItems.size();
+		infos[i].menuItemList = nullptr;
+		if (!entry.menuItems.empty()) {
+			memcpy(menuItems, entry.menuItems.data(), entry.menuItems.size() * sizeof(ControlMenuItem));
+			infos[i].menuItemList = menuItems;
+			menuItems += entry.menuItems.size();
+		}
+	}
+
+	reply = infos;
+	replySize = this->controls.size();
+	return StatusCode::STATUS_CODE_SUCCESS;
+}
+
+/**
+ * @implements 实现释放控制项列表
+ */
+void Becamv4l2ControlHelper::FreeControlList(ControlInfo*& input, size_t& inputSize) {
+	if (input != nullptr) {
+		::operator delete(input);
+	}
+	input = nullptr;
+	inputSize = 0;
+}
+
+/**
+ * @implements 实现批量读取控制项
+ */
+StatusCode Becamv4l2ControlHelper::GetControls(ControlValue* valueList, const size_t valueListSize) {
+	// 枚举（已缓存时直接使用）
+	auto code = this->Enumerate();
+	if (code != StatusCode::STATUS_CODE_SUCCESS) {
+		return code;
+	}
+
+	// 命中缓存的直接返回，其余的批量查询
+	std::vector<v4l2_ext_control> pending;
+	std::vector<size_t> pendingIndexes;
+	for (size_t i = 0; i < valueListSize; i++) {
+		auto entry = this->Find(valueList[i].id);
+		if (entry == nullptr) {
+			return StatusCode::STATUS_CODE_ERR_CONTROL_NOT_FOUND;
+		}
+		if (entry->info.type == ControlType::CONTROL_TYPE_OTHER) {
+			return StatusCode::STATUS_CODE_ERR_INPUT_PARAM;
+		}
+		// 按钮和只写控制项无法读取，返回最后写入的值
+		bool unreadable = entry->info.type == ControlType::CONTROL_TYPE_BUTTON || (entry->info.flags & ControlFlag::CONTROL_FLAG_WRITE_ONLY);
+		auto cached = this->values.find(valueList[i].id);
+		if (unreadable || (cached != this->values.end() && !(entry->info.flags & ControlFlag::CONTROL_FLAG_VOLATILE))) {
+			valueList[i].value = cached != this->values.end() ? cached->second : 0;
+			continue;
+		}
+		v4l2_ext_control ctrl = {0};
+		ctrl.id = valueList[i].id;
+		pending.push_back(ctrl);
+		pendingIndexes.push_back(i);
+	}
+	if (pending.empty()) {
+		return StatusCode::STATUS_CODE_SUCCESS;
+	}
+	if (!this->ExecuteGrouped(VIDIOC_G_EXT_CTRLS, pending)) {
+		return StatusCode::STATUS_CODE_ERR_CONTROL_FAILED;
+	}
+
+	// 返回并缓存（易变控制项不缓存）
+	for (size_t i = 0; i < pending.size(); i++) {
+		auto entry = this->Find(pending[i].id);
+		int64_t value = entry->info.type == ControlType::CONTROL_TYPE_INTEGER64 ? pending[i].value64 : pending[i].value;
+		valueList[pendingIndexes[i]].value = value;
+		if (!(entry->info.flags & ControlFlag::CONTROL_FLAG_VOLATILE)) {
+			this->values[pending[i].id] = value;
+		}
+	}
+	return StatusCode::STATUS_CODE_SUCCESS;
+}
+
+/**
+ * @implements 实现批量设置控制项
+ */
+StatusCode Becamv4l2ControlHelper::SetControls(const ControlValue* valueList, const size_t valueListSize) {
+	// 枚举（已缓存时直接使用）
+	auto code = this->Enumerate();
+	if (code != StatusCode::STATUS_CODE_SUCCESS) {
+		return code;
+	}
+
+	// 检查并构建请求
+	std::vector<v4l2_ext_control> request;
+	bool affectsOthers = false;
+	for (size_t i = 0; i < valueListSize; i++) {
+		auto entry = this->Find(valueList[i].id);
+		if (entry == nullptr) {
+			return StatusCode::STATUS_CODE_ERR_CONTROL_NOT_FOUND;
+		}
+		if (entry->info.type == ControlType::CONTROL_TYPE_OTHER || (entry->info.flags & ControlFlag::CONTROL_FLAG_READ_ONLY)) {
+			return StatusCode::STATUS_CODE_ERR_INPUT_PARAM;
+		}
+		affectsOthers = affectsOthers || (entry->info.flags & ControlFlag::CONTROL_FLAG_UPDATE);
+		v4l2_ext_control ctrl = {0};
+		ctrl.id = valueList[i].id;
+		if (entry->info.type == ControlType::CONTROL_TYPE_INTEGER64) {
+			ctrl.value64 = valueList[i].value;
+		} else {
+			ctrl.value = int32_t(valueList[i].value);
+		}
+		request.push_back(ctrl);
+	}
+	if (request.empty()) {
+		return StatusCode::STATUS_CODE_SUCCESS;
+	}
+
+	// 先整体校验，任一类别不通过时都不写入（校验会按驱动规则修正取值）
+	if (!this->ExecuteGrouped(VIDIOC_TRY_EXT_CTRLS, request)) {
+		return StatusCode::STATUS_CODE_ERR_CONTROL_FAILED;
+	}
+	auto applied = this->ExecuteGrouped(VIDIOC_S_EXT_CTRLS, request);
+
+	// 部分写入失败或影响其它控制项时，缓存的取值及标志均不再可信
+	if (!applied || affectsOthers) {
+		this->values.clear();
+		this->enumerated = false;
+	}
+	if (!applied) {
+		return StatusCode::STATUS_CODE_ERR_CONTROL_FAILED;
+	}
+	if (!affectsOthers) {
+		for (auto& ctrl : request) {
+			auto entry = this->Find(ctrl.id);
+			if (!(entry->info.flags & ControlFlag::CONTROL_FLAG_VOLATILE)) {
+				this->values[ctrl.id] = entry->info.type == ControlType::CONTROL_TYPE_INTEGER64 ? ctrl.value64 : ctrl.value;
+			}
+		}
+	}
+	return StatusCode::STATUS_CODE_SUCCESS;
+}
+
+/**
+ * @implements 实现获取单个控制项信息
+ */
+bool Becamv4l2ControlHelper::GetControlEntry(const uint32_t id, Becamv4l2ControlEntry& entry) {
+	// 枚举（已缓存时直接使用）
+	if (this->Enumerate() != StatusCode::STATUS_CODE_SUCCESS) {
+		return false;
+	}
+	auto found = this->Find(id);
+	if (found == nullptr) {
+		return false;
+	}
+	// 返回副本，设置控制项后缓存可能被重建
+	entry = *found;
+	return true;
+}
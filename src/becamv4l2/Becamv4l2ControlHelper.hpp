@@ -0,0 +1,135 @@
+#pragma once
+
+#include <becam/becam.h>
+#include <linux/videodev2.h>
+#include <map>
+#include <vector>
+
+#ifndef _BECAMV4L2_CONTROL_HELPER_H_
+#define _BECAMV4L2_CONTROL_HELPER_H_
+
+/**
+ * @brief V4L2 控制项枚举结果
+ */
+struct Becamv4l2ControlEntry {
+	// 控制项信息（menuItemList在构建响应数据时赋值）
+	ControlInfo info;
+	// 菜单项列表
+	std::vector<ControlMenuItem> menuItems;
+};
+
+/**
+ * @brief V4L2 控制项助手类
+ *
+ * 控制项信息及非易变控制项的取值缓存在实例中，批量读写时优先一次ioctl完成，旧驱动按控制项类别分组，每组一次ioctl；
+ * 本身不加锁，由持有设备句柄的调用方保证互斥
+ */
+class Becamv4l2ControlHelper {
+private:
+	// 设备文件描述句柄（外部管理，-1表示未关联设备）
+	int deviceFdHandle = -1;
+	// 控制项信息是否已枚举
+	bool enumerated = false;
+	// 控制项列表
+	std::vector<Becamv4l2ControlEntry> controls;
+	// 控制项标识到列表下标的映射
+	std::map<uint32_t, size_t> controlIndexes;
+	// 缓存的控制项取值
+	std::map<uint32_t, int64_t> values;
+
+	/**
+	 * @brief 枚举控制项（已枚举时直接返回）
+	 *
+	 * @return 状态码
+	 */
+	StatusCode Enumerate();
+
+	/**
+	 * @brief 查询单个控制项（优先VIDIOC_QUERY_EXT_CTRL，不支持时退化为VIDIOC_QUERYCTRL）
+	 *
+	 * @param query [in && out] 查询参数
+	 * @return 是否成功
+	 */
+	bool QueryControl(v4l2_query_ext_ctrl& query);
+
+	/**
+	 * @brief 查找控制项
+	 *
+	 * @param id [in] 控制项标识
+	 * @return 控制项（未找到时为空）
+	 */
+	const Becamv4l2ControlEntry* Find(const uint32_t id) const;
+
+	/**
+	 * @brief 执行扩展控制项ioctl（优先一次调用完成，驱动不支持混合类别时按类别分组）
+	 *
+	 * @param request [in] VIDIOC_G_EXT_CTRLS、VIDIOC_TRY_EXT_CTRLS 或 VIDIOC_S_EXT_CTRLS
+	 * @param controlList [in && out] 扩展控制项列表
+	 * @return 是否全部成功
+	 */
+	bool ExecuteGrouped(const unsigned long request, std::vector<v4l2_ext_control>& controlList);
+
+	/**
+	 * @brief 转换控制项类型
+	 */
+	static ControlType ConvertType(const uint32_t type);
+
+	/**
+	 * @brief 转换控制项标志
+	 */
+	static uint32_t ConvertFlags(const uint32_t flags);
+
+public:
+	/**
+	 * @brief 关联设备（清空缓存）
+	 *
+	 * @param fd [in] 设备文件描述句柄（-1表示取消关联）
+	 */
+	void Attach(const int fd);
+
+	/**
+	 * @brief 获取控制项列表
+	 *
+	 * @param reply [out] 控制项信息列表引用（控制项及菜单项位于同一内存块）
+	 * @param replySize [out] 控制项信息列表大小引用
+	 * @return 状态码
+	 */
+	StatusCode GetControlList(ControlInfo*& reply, size_t& replySize);
+
+	/**
+	 * @brief 释放控制项列表
+	 *
+	 * @param input [in && out] 控制项信息列表引用
+	 * @param inputSize [in && out] 控制项信息列表大小引用
+	 */
+	static void FreeControlList(ControlInfo*& input, size_t& inputSize);
+
+	/**
+	 * @brief 批量读取控制项
+	 *
+	 * @param valueList [in && out] 控制项取值列表
+	 * @param valueListSize [in] 控制项数量
+	 * @return 状态码
+	 */
+	StatusCode GetControls(ControlValue* valueList, const size_t valueListSize);
+
+	/**
+	 * @brief 批量设置控制项（先整体校验再写入）
+	 *
+	 * @param valueList [in] 控制项取值列表
+	 * @param valueListSize [in] 控制项数量
+	 * @return 状态码
+	 */
+	StatusCode SetControls(const ControlValue* valueList, const size_t valueListSize);
+
+	/**
+	 * @brief 获取单个控制项信息
+	 *
+	 * @param id [in] 控制项标识
+	 * @param entry [out] 控制项信息（含菜单项）
+	 * @return 设备是否支持该控制项
+	 */
+	bool GetControlEntry(const uint32_t id, Becamv4l2ControlEntry& entry);
+};
+
+#endif
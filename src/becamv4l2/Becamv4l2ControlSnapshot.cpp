@@ -0,0 +1,128 @@
+#include "Becamv4l2ControlSnapshot.hpp"
+#include <pkg/LogOutput.hpp>
+#include <string.h>
+
+/**
+ * @implements 实现计算控制项数据的校验和
+ */
+uint32_t Becamv4l2ControlSnapshot::Checksum(const uint8_t* data, const size_t size) {
+	uint32_t hash = 2166136261u;
+	for (size_t i = 0; i < size; i++) {
+		hash ^= data[i];
+		hash *= 16777619u;
+	}
+	return hash;
+}
+
+/**
+ * @implements 实现读取设备当前的控制项并生成快照
+ */
+StatusCode Becamv4l2ControlSnapshot::Capture(Becamv4l2ControlHelper& controlHelper, std::vector<uint8_t>& blob) {
+	blob.clear();
+
+	// 获取控制项列表
+	ControlInfo* infos = nullptr;
+	size_t infoCount = 0;
+	auto code = controlHelper.GetControlList(infos, infoCount);
+	if (code != StatusCode::STATUS_CODE_SUCCESS) {
+		return code;
+	}
+	// 筛选可保存的控制项，影响其它控制项的排在前面
+	std::vector<ControlValue> values;
+	std::vector<ControlValue> dependents;
+	for (size_t i = 0; i < infoCount; i++) {
+		auto& info = infos[i];
+		if (info.type == ControlType::CONTROL_TYPE_BUTTON || info.type == ControlType::CONTROL_TYPE_OTHER) {
+			continue;
+		}
+		uint32_t skipFlags = ControlFlag::CONTROL_FLAG_READ_ONLY | ControlFlag::CONTROL_FLAG_WRITE_ONLY | ControlFlag::CONTROL_FLAG_VOLATILE |
+							 ControlFlag::CONTROL_FLAG_INACTIVE;
+		if (info.flags & skipFlags) {
+			continue;
+		}
+		if (info.flags & ControlFlag::CONTROL_FLAG_UPDATE) {
+			values.push_back({info.id, 0});
+		} else {
+			dependents.push_back({info.id, 0});
+		}
+	}
+	Becamv4l2ControlHelper::FreeControlList(infos, infoCount);
+	values.insert(values.end(), dependents.begin(), dependents.end());
+	if (values.size() > UINT16_MAX) {
+		values.resize(UINT16_MAX);
+	}
+
+	// 批量读取
+	code = controlHelper.GetControls(values.data(), values.size());
+	if (code != StatusCode::STATUS_CODE_SUCCESS) {
+		return code;
+	}
+
+	// 序列化
+	blob.resize(HEADER_SIZE + values.size() * ENTRY_SIZE);
+	auto entries = blob.data() + HEADER_SIZE;
+	for (size_t i = 0; i < values.size(); i++) {
+		memcpy(entries + i * ENTRY_SIZE, &values[i].id, sizeof(uint32_t));
+		memcpy(entries + i * ENTRY_SIZE + sizeof(uint32_t), &values[i].value, sizeof(int64_t));
+	}
+	auto magic = SNAPSHOT_MAGIC;
+	auto version = SNAPSHOT_VERSION;
+	auto count = uint16_t(values.size());
+	auto checksum = Becamv4l2ControlSnapshot::Checksum(entries, values.size() * ENTRY_SIZE);
+	memcpy(blob.data(), &magic, sizeof(magic));
+	memcpy(blob.data() + 4, &version, sizeof(version));
+	memcpy(blob.data() + 6, &count, sizeof(count));
+	memcpy(blob.data() + 8, &checksum, sizeof(checksum));
+	return StatusCode::STATUS_CODE_SUCCESS;
+}
+
+/**
+ * @implements 实现解析快照
+ */
+bool Becamv4l2ControlSnapshot::Parse(const uint8_t* data, const size_t size, std::vector<ControlValue>& values) {
+	values.clear();
+	if (data == nullptr || size < HEADER_SIZE) {
+		return false;
+	}
+	uint32_t magic = 0;
+	uint16_t version = 0;
+	uint16_t count = 0;
+	uint32_t checksum = 0;
+	memcpy(&magic, data, sizeof(magic));
+	memcpy(&version, data + 4, sizeof(version));
+	memcpy(&count, data + 6, sizeof(count));
+	memcpy(&checksum, data + 8, sizeof(checksum));
+	if (magic != SNAPSHOT_MAGIC || version != SNAPSHOT_VERSION || size != HEADER_SIZE + size_t(count) * ENTRY_SIZE) {
+		return false;
+	}
+	auto entries = data + HEADER_SIZE;
+	if (Becamv4l2ControlSnapshot::Checksum(entries, size_t(count) * ENTRY_SIZE) != checksum) {
+		return false;
+	}
+	values.resize(count);
+	for (size_t i = 0; i < count; i++) {
+		memcpy(&values[i].id, entries + i * ENTRY_SIZE, sizeof(uint32_t));
+		memcpy(&values[i].value, entries + i * ENTRY_SIZE + sizeof(uint32_t), sizeof(int64_t));
+	}
+	return true;
+}
+
+/**
+ * @implements 实现将快照一次性写入设备
+ */
+StatusCode Becamv4l2ControlSnapshot::Restore(Becamv4l2ControlHelper& controlHelper, const std::vector<ControlValue>& values) {
+	// 快照可能来自其它型号或固件版本的设备，跳过当前设备没有的控制项
+	std::vector<ControlValue> applicable;
+	Becamv4l2ControlEntry entry;
+	for (auto& value : values) {
+		if (!controlHelper.GetControlEntry(value.id, entry) || (entry.info.flags & ControlFlag::CONTROL_FLAG_READ_ONLY)) {
+			continue;
+		}
+		applicable.push_back(value);
+	}
+	auto code = controlHelper.SetControls(applicable.data(), applicable.size());
+	if (code != StatusCode::STATUS_CODE_SUCCESS) {
+		DEBUG_LOG("Becamv4l2ControlSnapshot::Restore -> SetControls failed, CODE: " << code);
+	}
+	return code;
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "Becamv4l2ControlHelper.hpp"
+#include <becam/becam.h>
+#include <stdint.h>
+#include <vector>
+
+#ifndef _BECAMV4L2_CONTROL_SNAPSHOT_H_
+#define _BECAMV4L2_CONTROL_SNAPSHOT_H_
+
+/**
+ * @brief V4L2 控制项快照
+ *
+ * 快照布局（小端）：魔数"BCTL" | 版本(u16) | 控制项数量(u16) | 校验和(u32) | 控制项数量 * {标识(u32), 取值(i64)}；
+ * 影响其它控制项的控制项（例如自动曝光开关）排在前面，恢复时一次调用按顺序写入
+ */
+class Becamv4l2ControlSnapshot {
+private:
+	// 快照魔数
+	static const uint32_t SNAPSHOT_MAGIC = 0x4C544342; // "BCTL"
+	// 快照版本
+	static const uint16_t SNAPSHOT_VERSION = 1;
+	// 快照头大小
+	static const size_t HEADER_SIZE = 12;
+	// 单个控制项大小
+	static const size_t ENTRY_SIZE = 12;
+
+	/**
+	 * @brief 计算控制项数据的校验和（FNV-1a）
+	 */
+	static uint32_t Checksum(const uint8_t* data, const size_t size);
+
+public:
+	/**
+	 * @brief 读取设备当前的控制项并生成快照
+	 *
+	 * 仅包含可读写的非易变控制项，暂不生效的控制项（例如自动曝光时的曝光时间）不保存
+	 *
+	 * @param controlHelper [in] 当前设备的控制项助手
+	 * @param blob [out] 快照数据
+	 * @return 状态码
+	 */
+	static StatusCode Capture(Becamv4l2ControlHelper& controlHelper, std::vector<uint8_t>& blob);
+
+	/**
+	 * @brief 解析快照
+	 *
+	 * @param data [in] 快照数据
+	 * @param size [in] 快照数据大小
+	 * @param values [out] 控制项取值列表
+	 * @return 快照是否有效
+	 */
+	static bool Parse(const uint8_t* data, const size_t size, std::vector<ControlValue>& values);
+
+	/**
+	 * @brief 将快照一次性写入设备（跳过设备不支持或只读的控制项）
+	 *
+	 * @param controlHelper [in] 当前设备的控制项助手
+	 * @param values [in] 控制项取值列表
+	 * @return 状态码
+	 */
+	static StatusCode Restore(Becamv4l2ControlHelper& controlHelper, const std::vector<ControlValue>& values);
+};
+
+#endif
@@ -0,0 +1,207 @@
+#include "Becamv4l2CropHelper.hpp"
+#include "xioctl.hpp"
+#include <string.h>
+
+/**
+ * @implements 实现获取软件裁剪时的像素布局
+ */
+bool Becamv4l2CropHelper::GetSoftwareCropLayout(const uint32_t pixelformat, uint32_t& alignX, uint32_t& alignY, uint32_t& bytesPerPixel) {
+	// 默认无对齐要求
+	alignX = 1;
+	alignY = 1;
+	switch (pixelformat) {
+		case V4L2_PIX_FMT_GREY:
+			bytesPerPixel = 1;
+			return true;
+		case V4L2_PIX_FMT_RGB565:
+			bytesPerPixel = 2;
+			return true;
+		case V4L2_PIX_FMT_RGB24:
+		case V4L2_PIX_FMT_BGR24:
+			bytesPerPixel = 3;
+			return true;
+		case V4L2_PIX_FMT_ABGR32:
+		case V4L2_PIX_FMT_ARGB32:
+		case V4L2_PIX_FMT_XBGR32:
+		case V4L2_PIX_FMT_XRGB32:
+			bytesPerPixel = 4;
+			return true;
+		case V4L2_PIX_FMT_YUYV:
+		case V4L2_PIX_FMT_UYVY:
+		case V4L2_PIX_FMT_YVYU:
+		case V4L2_PIX_FMT_VYUY:
+			// 4:2:2 两个像素共用一组色度
+			alignX = 2;
+			bytesPerPixel = 2;
+			return true;
+		case V4L2_PIX_FMT_NV12:
+		case V4L2_PIX_FMT_NV21:
+		case V4L2_PIX_FMT_YUV420:
+		case V4L2_PIX_FMT_YVU420:
+			// 4:2:0 2x2个像素共用一组色度
+			alignX = 2;
+			alignY = 2;
+			bytesPerPixel = 1;
+			return true;
+		default:
+			// 压缩格式无法在不解码的情况下裁剪
+			return false;
+	}
+}
+
+/**
+ * @implements 实现设置设备裁剪区域
+ */
+bool Becamv4l2CropHelper::SetHardwareCrop(const int fd, const CropRect& rect, CropRect& applied) {
+	// 优先使用选择接口
+	v4l2_selection sel = {0};
+	sel.type = v4l2_buf_type::V4L2_BUF_TYPE_VIDEO_CAPTURE;
+	sel.target = V4L2_SEL_TGT_CROP;
+	sel.r.left = int32_t(rect.left);
+	sel.r.top = int32_t(rect.top);
+	sel.r.width = rect.width;
+	sel.r.height = rect.height;
+	if (xioctl(fd, VIDIOC_S_SELECTION, &sel) == 0) {
+		// 驱动会回写实际生效的区域
+		applied.left = uint32_t(sel.r.left);
+		applied.top = uint32_t(sel.r.top);
+		applied.width = sel.r.width;
+		applied.height = sel.r.height;
+		return true;
+	}
+
+	// 旧驱动仅支持裁剪接口
+	v4l2_crop crop = {};
+	crop.type = v4l2_buf_type::V4L2_BUF_TYPE_VIDEO_CAPTURE;
+	crop.c.left = int32_t(rect.left);
+	crop.c.top = int32_t(rect.top);
+	crop.c.width = rect.width;
+	crop.c.height = rect.height;
+	if (xioctl(fd, VIDIOC_S_CROP, &crop) == -1) {
+		return false;
+	}
+	// 回读实际生效的区域
+	if (xioctl(fd, VIDIOC_G_CROP, &crop) == -1) {
+		applied = rect;
+		return true;
+	}
+	applied.left = uint32_t(crop.c.left);
+	applied.top = uint32_t(crop.c.top);
+	applied.width = crop.c.width;
+	applied.height = crop.c.height;
+	return true;
+}
+
+/**
+ * @implements 实现恢复设备默认裁剪区域
+ */
+void Becamv4l2CropHelper::ResetHardwareCrop(const int fd) {
+	// 优先使用选择接口
+	v4l2_selection sel = {0};
+	sel.type = v4l2_buf_type::V4L2_BUF_TYPE_VIDEO_CAPTURE;
+	sel.target = V4L2_SEL_TGT_CROP_DEFAULT;
+	if (xioctl(fd, VIDIOC_G_SELECTION, &sel) == 0) {
+		sel.target = V4L2_SEL_TGT_CROP;
+		xioctl(fd, VIDIOC_S_SELECTION, &sel);
+		return;
+	}
+
+	// 旧驱动仅支持裁剪接口
+	v4l2_cropcap cropcap = {};
+	cropcap.type = v4l2_buf_type::V4L2_BUF_TYPE_VIDEO_CAPTURE;
+	if (xioctl(fd, VIDIOC_CROPCAP, &cropcap) == 0) {
+		v4l2_crop crop = {};
+		crop.type = v4l2_buf_type::V4L2_BUF_TYPE_VIDEO_CAPTURE;
+		crop.c = cropcap.defrect;
+		xioctl(fd, VIDIOC_S_CROP, &crop);
+	}
+}
+
+/**
+ * @implements 实现将裁剪区域限制在画面内并按格式要求对齐
+ */
+bool Becamv4l2CropHelper::AlignSoftwareCrop(const v4l2_pix_format& pix, const CropRect& rect, CropRect& aligned) {
+	// 检查格式是否支持软件裁剪
+	uint32_t alignX = 1;
+	uint32_t alignY = 1;
+	uint32_t bytesPerPixel = 1;
+	if (!Becamv4l2CropHelper::GetSoftwareCropLayout(pix.pixelformat, alignX, alignY, bytesPerPixel)) {
+		return false;
+	}
+	// 起点向下对齐，并限制在画面内
+	aligned.left = rect.left / alignX * alignX;
+	aligned.top = rect.top / alignY * alignY;
+	if (aligned.left >= pix.width || aligned.top >= pix.height) {
+		return false;
+	}
+	// 终点向上对齐，并限制在画面内
+	uint32_t right = (rect.left + rect.width + alignX - 1) / alignX * alignX;
+	uint32_t bottom = (rect.top + rect.height + alignY - 1) / alignY * alignY;
+	aligned.width = (right > pix.width ? pix.width : right) - aligned.left;
+	aligned.height = (bottom > pix.height ? pix.height : bottom) - aligned.top;
+	return aligned.width > 0 && aligned.height > 0;
+}
+
+/**
+ * @implements 实现获取软件裁剪后的视频帧大小和每行字节数
+ */
+size_t Becamv4l2CropHelper::GetSoftwareCropSize(const v4l2_pix_format& pix, const CropRect& rect, uint32_t& bytesPerLine) {
+	// 获取像素布局
+	uint32_t alignX = 1;
+	uint32_t alignY = 1;
+	uint32_t bytesPerPixel = 1;
+	if (!Becamv4l2CropHelper::GetSoftwareCropLayout(pix.pixelformat, alignX, alignY, bytesPerPixel)) {
+		bytesPerLine = 0;
+		return 0;
+	}
+	bytesPerLine = rect.width * bytesPerPixel;
+	// 4:2:0 平面格式额外包含1/2大小的色度平面
+	if (alignY == 2) {
+		return size_t(bytesPerLine) * rect.height * 3 / 2;
+	}
+	return size_t(bytesPerLine) * rect.height;
+}
+
+/**
+ * @implements 实现从完整视频帧中拷贝裁剪区域
+ */
+bool Becamv4l2CropHelper::CopySoftwareCrop(const uint8_t* src, const size_t srcSize, const v4l2_pix_format& pix, const CropRect& rect,
+										   uint8_t* dst) {
+	// 计算裁剪后的每行字节数
+	uint32_t dstBytesPerLine = 0;
+	Becamv4l2CropHelper::GetSoftwareCropSize(pix, rect, dstBytesPerLine);
+	// 逐行拷贝指定平面
+	auto copyPlane = [&](const size_t planeOffset, const uint32_t planeBytesPerLine, const uint32_t offsetX, const uint32_t offsetY,
+						 const uint32_t rowBytes, const uint32_t rows, uint8_t*& out) {
+		// 检查源缓冲区是否足够
+		if (planeOffset + size_t(offsetY + rows - 1) * planeBytesPerLine + offsetX + rowBytes > srcSize) {
+			return false;
+		}
+		auto in = src + planeOffset + size_t(offsetY) * planeBytesPerLine + offsetX;
+		for (uint32_t y = 0; y < rows; y++) {
+			memcpy(out, in, rowBytes);
+			in += planeBytesPerLine;
+			out += rowBytes;
+		}
+		return true;
+	};
+
+	uint8_t* out = dst;
+	size_t lumaSize = size_t(pix.bytesperline) * pix.height;
+	switch (pix.pixelformat) {
+		case V4L2_PIX_FMT_NV12:
+		case V4L2_PIX_FMT_NV21:
+			// 亮度平面 + 交错的色度平面
+			return copyPlane(0, pix.bytesperline, rect.left, rect.top, rect.width, rect.height, out) &&
+				   copyPlane(lumaSize, pix.bytesperline, rect.left, rect.top / 2, rect.width, rect.height / 2, out);
+		case V4L2_PIX_FMT_YUV420:
+		case V4L2_PIX_FMT_YVU420:
+			// 亮度平面 + 两个独立的色度平面
+			return copyPlane(0, pix.bytesperline, rect.left, rect.top, rect.width, rect.height, out) &&
+				   copyPlane(lumaSize, pix.bytesperline / 2, rect.left / 2, rect.top / 2, rect.width / 2, rect.height / 2, out) &&
+				   copyPlane(lumaSize + lumaSize / 4, pix.bytesperline / 2, rect.left / 2, rect.top / 2, rect.width / 2, rect.height / 2, out);
+		default:
+			// 打包格式
+			return copyPlane(0, pix.bytesperline, rect.left * (dstBytesPerLine / rect.width), rect.top, dstBytesPerLine, rect.height, out);
+	}
+}
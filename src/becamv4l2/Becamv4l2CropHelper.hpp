@@ -0,0 +1,76 @@
+#pragma once
+
+#include <becam/becam.h>
+#include <linux/videodev2.h>
+
+#ifndef _BECAMV4L2_CROP_HELPER_H_
+#define _BECAMV4L2_CROP_HELPER_H_
+
+/**
+ * @brief V4L2 裁剪助手类
+ */
+class Becamv4l2CropHelper {
+private:
+	/**
+	 * @brief 获取软件裁剪时的像素布局
+	 *
+	 * @param pixelformat [in] 视频帧格式
+	 * @param alignX [out] 横向对齐像素数
+	 * @param alignY [out] 纵向对齐像素数
+	 * @param bytesPerPixel [out] 每像素字节数（平面格式为亮度平面）
+	 * @return 是否支持软件裁剪
+	 */
+	static bool GetSoftwareCropLayout(const uint32_t pixelformat, uint32_t& alignX, uint32_t& alignY, uint32_t& bytesPerPixel);
+
+public:
+	/**
+	 * @brief 设置设备裁剪区域（优先VIDIOC_S_SELECTION，其次VIDIOC_S_CROP）
+	 *
+	 * @param fd [in] 设备文件描述句柄
+	 * @param rect [in] 期望的裁剪区域
+	 * @param applied [out] 驱动实际生效的裁剪区域
+	 * @return 设备是否支持裁剪
+	 */
+	static bool SetHardwareCrop(const int fd, const CropRect& rect, CropRect& applied);
+
+	/**
+	 * @brief 恢复设备默认裁剪区域
+	 *
+	 * @param fd [in] 设备文件描述句柄
+	 */
+	static void ResetHardwareCrop(const int fd);
+
+	/**
+	 * @brief 将裁剪区域限制在画面内并按格式要求对齐
+	 *
+	 * @param pix [in] 当前视频帧格式
+	 * @param rect [in] 期望的裁剪区域
+	 * @param aligned [out] 对齐后的裁剪区域
+	 * @return 是否支持软件裁剪
+	 */
+	static bool AlignSoftwareCrop(const v4l2_pix_format& pix, const CropRect& rect, CropRect& aligned);
+
+	/**
+	 * @brief 获取软件裁剪后的视频帧大小和每行字节数
+	 *
+	 * @param pix [in] 当前视频帧格式
+	 * @param rect [in] 已对齐的裁剪区域
+	 * @param bytesPerLine [out] 裁剪后每行字节数（平面格式为亮度平面）
+	 * @return 裁剪后的视频帧大小
+	 */
+	static size_t GetSoftwareCropSize(const v4l2_pix_format& pix, const CropRect& rect, uint32_t& bytesPerLine);
+
+	/**
+	 * @brief 从完整视频帧中拷贝裁剪区域（紧凑排列）
+	 *
+	 * @param src [in] 完整视频帧
+	 * @param srcSize [in] 完整视频帧大小
+	 * @param pix [in] 当前视频帧格式
+	 * @param rect [in] 已对齐的裁剪区域
+	 * @param dst [out] 裁剪后的视频帧（大小由GetSoftwareCropSize获取）
+	 * @return 是否拷贝成功
+	 */
+	static bool CopySoftwareCrop(const uint8_t* src, const size_t srcSize, const v4l2_pix_format& pix, const CropRect& rect, uint8_t* dst);
+};
+
+#endif
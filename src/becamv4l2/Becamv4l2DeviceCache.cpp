@@ -0,0 +1,161 @@
+#include "Becamv4l2DeviceCache.hpp"
+#include <pkg/LogOutput.hpp>
+#include <string.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+/**
+ * @implements 实现构造函数
+ */
+Becamv4l2DeviceCache::Becamv4l2DeviceCache() {
+	// 非阻塞方式监听`/dev`，仅在查询缓存时读取事件
+	this->inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	if (this->inotifyFd == -1) {
+		DEBUG_LOG("Becamv4l2DeviceCache::Becamv4l2DeviceCache -> inotify_init1() Failed");
+		return;
+	}
+	// 节点创建、删除、重命名以及权限变更（udev在创建后才会设置权限）
+	auto mask = IN_CREATE | IN_DELETE | IN_ATTRIB | IN_MOVED_FROM | IN_MOVED_TO;
+	if (inotify_add_watch(this->inotifyFd, "/dev", mask) == -1) {
+		DEBUG_LOG("Becamv4l2DeviceCache::Becamv4l2DeviceCache -> inotify_add_watch(/dev) Failed");
+		close(this->inotifyFd);
+		this->inotifyFd = -1;
+	}
+}
+
+/**
+ * @implements 实现析构函数
+ */
+Becamv4l2DeviceCache::~Becamv4l2DeviceCache() {
+	if (this->inotifyFd != -1) {
+		close(this->inotifyFd);
+		this->inotifyFd = -1;
+	}
+}
+
+/**
+ * @implements 实现使缓存失效
+ */
+void Becamv4l2DeviceCache::ClearLocked() {
+	this->generation++;
+	this->deviceListValid = false;
+	this->deviceList.clear();
+	this->configLists.clear();
+}
+
+/**
+ * @implements 实现读取inotify事件
+ */
+void Becamv4l2DeviceCache::PollChanges() {
+	// 按inotify事件的对齐要求声明缓冲区
+	alignas(inotify_event) char buffer[4096];
+	while (true) {
+		auto length = read(this->inotifyFd, buffer, sizeof(buffer));
+		if (length <= 0) {
+			// 无更多事件（EAGAIN）
+			return;
+		}
+		// 遍历事件
+		for (ssize_t offset = 0; offset < length;) {
+			auto event = reinterpret_cast<const inotify_event*>(buffer + offset);
+			// 事件队列溢出或video节点有变化
+			if ((event->mask & IN_Q_OVERFLOW) || (event->len > 0 && strncmp(event->name, "video", 5) == 0)) {
+				this->ClearLocked();
+			}
+			offset += sizeof(inotify_event) + event->len;
+		}
+	}
+}
+
+/**
+ * @implements 实现使全部缓存失效
+ */
+void Becamv4l2DeviceCache::Invalidate() {
+	// 加个锁先
+	std::unique_lock<std::mutex> lock(this->mtx);
+	// 清空缓存
+	this->ClearLocked();
+}
+
+/**
+ * @implements 实现获取缓存的设备列表
+ */
+bool Becamv4l2DeviceCache::GetDeviceList(std::vector<Becamv4l2DeviceEntry>& devices, uint64_t& generation) {
+	// 加个锁先
+	std::unique_lock<std::mutex> lock(this->mtx);
+
+	// 监听不可用时不缓存
+	if (this->inotifyFd == -1) {
+		return false;
+	}
+	// 消费变化事件
+	this->PollChanges();
+	generation = this->generation;
+	if (!this->deviceListValid) {
+		return false;
+	}
+	devices = this->deviceList;
+	return true;
+}
+
+/**
+ * @implements 实现更新缓存的设备列表
+ */
+void Becamv4l2DeviceCache::SetDeviceList(const std::vector<Becamv4l2DeviceEntry>& devices, const uint64_t generation) {
+	// 加个锁先
+	std::unique_lock<std::mutex> lock(this->mtx);
+
+	// 监听不可用时不缓存
+	if (this->inotifyFd == -1) {
+		return;
+	}
+	// 枚举期间节点有变化时，结果可能已过期
+	this->PollChanges();
+	if (generation != this->generation) {
+		return;
+	}
+	this->deviceList = devices;
+	this->deviceListValid = true;
+}
+
+/**
+ * @implements 实现获取缓存的设备配置列表
+ */
+bool Becamv4l2DeviceCache::GetConfigList(const std::string& devicePath, std::vector<VideoFrameInfo>& configList, uint64_t& generation) {
+	// 加个锁先
+	std::unique_lock<std::mutex> lock(this->mtx);
+
+	// 监听不可用时不缓存
+	if (this->inotifyFd == -1) {
+		return false;
+	}
+	// 消费变化事件
+	this->PollChanges();
+	generation = this->generation;
+	auto it = this->configLists.find(devicePath);
+	if (it == this->configLists.end()) {
+		return false;
+	}
+	configList = it->second;
+	return true;
+}
+
+/**
+ * @implements 实现更新缓存的设备配置列表
+ */
+void Becamv4l2DeviceCache::SetConfigList(const std::string& devicePath, const std::vector<VideoFrameInfo>& configList,
+										 const uint64_t generation) {
+	// 加个锁先
+	std::unique_lock<std::mutex> lock(this->mtx);
+
+	// 监听不可用时不缓存
+	if (this->inotifyFd == -1) {
+		return;
+	}
+	// 枚举期间节点有变化时，结果可能已过期
+	this->PollChanges();
+	if (generation != this->generation) {
+		return;
+	}
+	this->configLists[devicePath] = configList;
+}
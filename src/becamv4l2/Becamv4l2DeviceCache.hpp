@@ -0,0 +1,96 @@
+#pragma once
+
+#include "Becamv4l2DeviceHelper.hpp"
+#include <becam/becam.h>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#ifndef _BECAMV4L2_DEVICE_CACHE_H_
+#define _BECAMV4L2_DEVICE_CACHE_H_
+
+/**
+ * @brief V4L2 设备及配置枚举结果缓存
+ *
+ * 通过inotify监听`/dev`下video节点的增删，有变化时整体失效；监听不可用时不缓存
+ */
+class Becamv4l2DeviceCache {
+private:
+	// 互斥锁
+	std::mutex mtx;
+	// inotify句柄（-1表示不可用）
+	int inotifyFd = -1;
+	// 缓存代数（每次失效时递增，用于丢弃跨越变化的枚举结果）
+	uint64_t generation = 0;
+	// 设备列表是否有效
+	bool deviceListValid = false;
+	// 缓存的设备列表
+	std::vector<Becamv4l2DeviceEntry> deviceList;
+	// 缓存的设备配置列表（键为设备路径）
+	std::map<std::string, std::vector<VideoFrameInfo>> configLists;
+
+	/**
+	 * @brief 读取inotify事件，video节点有变化时使缓存失效
+	 */
+	void PollChanges();
+
+	/**
+	 * @brief 使缓存失效（调用方需持有锁）
+	 */
+	void ClearLocked();
+
+public:
+	/**
+	 * @brief 构造函数
+	 */
+	Becamv4l2DeviceCache();
+
+	/**
+	 * @brief 析构函数
+	 */
+	~Becamv4l2DeviceCache();
+
+	/**
+	 * @brief 使全部缓存失效
+	 */
+	void Invalidate();
+
+	/**
+	 * @brief 获取缓存的设备列表
+	 *
+	 * @param devices [out] 设备列表
+	 * @param generation [out] 当前缓存代数（未命中时用于更新缓存）
+	 * @return 是否命中缓存
+	 */
+	bool GetDeviceList(std::vector<Becamv4l2DeviceEntry>& devices, uint64_t& generation);
+
+	/**
+	 * @brief 更新缓存的设备列表（枚举期间缓存已失效时丢弃）
+	 *
+	 * @param devices [in] 设备列表
+	 * @param generation [in] 枚举前获取的缓存代数
+	 */
+	void SetDeviceList(const std::vector<Becamv4l2DeviceEntry>& devices, const uint64_t generation);
+
+	/**
+	 * @brief 获取缓存的设备配置列表
+	 *
+	 * @param devicePath [in] 设备路径
+	 * @param configList [out] 设备配置列表
+	 * @param generation [out] 当前缓存代数（未命中时用于更新缓存）
+	 * @return 是否命中缓存
+	 */
+	bool GetConfigList(const std::string& devicePath, std::vector<VideoFrameInfo>& configList, uint64_t& generation);
+
+	/**
+	 * @brief 更新缓存的设备配置列表（枚举期间缓存已失效时丢弃）
+	 *
+	 * @param devicePath [in] 设备路径
+	 * @param configList [in] 设备配置列表
+	 * @param generation [in] 枚举前获取的缓存代数
+	 */
+	void SetConfigList(const std::string& devicePath, const std::vector<VideoFrameInfo>& configList, const uint64_t generation);
+};
+
+#endif
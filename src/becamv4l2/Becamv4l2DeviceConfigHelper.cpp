@@ -1,5 +1,6 @@
 #include "Becamv4l2DeviceConfigHelper.hpp"
 #include "xioctl.hpp"
+#include <errno.h>
 #include <linux/videodev2.h>
 #include <string.h>
 #include <vector>
@@ -93,3 +94,23 @@ void Becamv4l2DeviceConfigHelper::FreeDeviceConfigList(VideoFrameInfo*& input, s
 	input = nullptr;
 	inputSize = 0;
 }
+
+/**
+ * @implements 实现试探设备是否接受指定的视频帧信息
+ */
+bool Becamv4l2DeviceConfigHelper::TryDeviceConfig(const VideoFrameInfo& frameInfo) {
+	// 声明试探的格式和分辨率
+	v4l2_format fmt = {0};
+	fmt.type = v4l2_buf_type::V4L2_BUF_TYPE_VIDEO_CAPTURE; // 固定流类型为视频捕获流
+	fmt.fmt.pix.width = frameInfo.width;				   // 指定帧分辨率
+	fmt.fmt.pix.height = frameInfo.height;				   // 指定帧分辨率
+	fmt.fmt.pix.pixelformat = frameInfo.format;			   // 指定帧格式
+	fmt.fmt.pix.field = v4l2_field::V4L2_FIELD_NONE;	   // 指定场模式，通常为：V4L2_FIELD_NONE
+	if (xioctl(this->deviceFdHandle, VIDIOC_TRY_FMT, &fmt) == -1) {
+		// 驱动未实现VIDIOC_TRY_FMT时无法试探，以枚举结果为准
+		return errno == ENOTTY;
+	}
+
+	// 驱动会将无法满足的参数调整为最接近的值，调整过则视为不接受
+	return fmt.fmt.pix.width == frameInfo.width && fmt.fmt.pix.height == frameInfo.height && fmt.fmt.pix.pixelformat == frameInfo.format;
+}
@@ -40,6 +40,14 @@ public:
 	 * @param inputSize [in && out] 已获取的视频帧信息列表大小引用
 	 */
 	static void FreeDeviceConfigList(VideoFrameInfo*& input, size_t& inputSize);
+
+	/**
+	 * @brief 试探设备是否接受指定的视频帧信息（VIDIOC_TRY_FMT，不改变设备状态）
+	 *
+	 * @param frameInfo [in] 视频帧信息
+	 * @return 设备是否原样接受
+	 */
+	bool TryDeviceConfig(const VideoFrameInfo& frameInfo);
 };
 
 #endif
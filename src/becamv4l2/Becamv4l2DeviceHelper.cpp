@@ -1,12 +1,19 @@
 #include "Becamv4l2DeviceHelper.hpp"
 #include "Becamv4l2DeviceConfigHelper.hpp"
+#include "Becamv4l2DeviceProber.hpp"
+#include "Becamv4l2SysfsHelper.hpp"
+#include "Becamv4l2CropHelper.hpp"
 #include "xioctl.hpp"
 #include <algorithm>
 #include <fcntl.h>
 #include <glob.h>
 #include <iostream>
 #include <linux/videodev2.h>
+#include <pkg/DeviceListArena.hpp>
+#include <pkg/FrameNegotiate.hpp>
+#include <pkg/ImageResize.hpp>
 #include <pkg/LogOutput.hpp>
+#include <pkg/PixelConvert.hpp>
 #include <pkg/StringConvert.hpp>
 #include <sstream>
 #include <sys/mman.h>
@@ -24,6 +31,8 @@ Becamv4l2DeviceHelper::Becamv4l2DeviceHelper() {}
 Becamv4l2DeviceHelper::~Becamv4l2DeviceHelper() {
 	// 释放当前设备
 	this->CloseCurrentDevice();
+	// 释放图像处理线程池
+	DestroyWorkerPool(this->imagePool);
 }
 
 /**
@@ -34,16 +43,31 @@ void Becamv4l2DeviceHelper::CloseCurrentDevice() {
 	this->StopCurrentDeviceStreaming();
 	// 已打开的设备需要关闭设备
 	if (this->activatedDevice != -1) {
+		// 恢复设备裁剪，避免下次打开时仍停留在上次的裁剪区域
+		if (this->activeCropMode == CropMode::CROP_MODE_HARDWARE) {
+			Becamv4l2CropHelper::ResetHardwareCrop(this->activatedDevice);
+		}
 		// 关闭设备
 		close(this->activatedDevice);
 		this->activatedDevice = -1;
 	}
+	// 清空控制项缓存
+	this->controlHelper.Attach(-1);
+	// 重置已生效的格式和裁剪
+	this->activeFormat = {0};
+	this->activeCrop = {0};
+	this->activeCropMode = CropMode::CROP_MODE_NONE;
+	// 释放MJPEG解码器及缩放中间缓冲区
+	DestroyMjpegDecoder(this->mjpegDecoder);
+	std::vector<uint8_t>().swap(this->resizeBuffer);
 }
 
 /**
  * @implements 实现停止当前设备取流
  */
 void Becamv4l2DeviceHelper::StopCurrentDeviceStreaming() {
+	// 丢弃并行解码中的视频帧
+	DestroyMjpegDecodePipeline(this->decodePipeline);
 	// 正在取流的需要先停止
 	if (this->streamON) {
 		// 停止取流
@@ -63,6 +87,153 @@ void Becamv4l2DeviceHelper::StopCurrentDeviceStreaming() {
 	}
 }
 
+/**
+ * @implements 实现从驱动回读当前设备已生效的视频帧格式
+ */
+void Becamv4l2DeviceHelper::RefreshCurrentDeviceFormat() {
+	v4l2_format fmt = {0};
+	fmt.type = v4l2_buf_type::V4L2_BUF_TYPE_VIDEO_CAPTURE;
+	if (xioctl(this->activatedDevice, VIDIOC_G_FMT, &fmt) == 0) {
+		this->activeFormat = fmt.fmt.pix;
+	}
+}
+
+/**
+ * @implements 实现对当前设备应用期望的裁剪区域
+ */
+StatusCode Becamv4l2DeviceHelper::ApplyCurrentDeviceCrop() {
+	// 之前由设备裁剪的需要先恢复，软件裁剪以完整画面为准
+	if (this->activeCropMode == CropMode::CROP_MODE_HARDWARE) {
+		Becamv4l2CropHelper::ResetHardwareCrop(this->activatedDevice);
+		this->RefreshCurrentDeviceFormat();
+	}
+	this->activeCropMode = CropMode::CROP_MODE_NONE;
+	this->activeCrop = {0, 0, this->activeFormat.width, this->activeFormat.height};
+
+	// 取消裁剪
+	if (this->requestedCrop.width == 0 || this->requestedCrop.height == 0) {
+		return StatusCode::STATUS_CODE_SUCCESS;
+	}
+
+	// 优先由设备裁剪，可同时节省总线带宽和拷贝开销
+	CropRect applied = {0};
+	if (Becamv4l2CropHelper::SetHardwareCrop(this->activatedDevice, this->requestedCrop, applied)) {
+		this->activeCropMode = CropMode::CROP_MODE_HARDWARE;
+		this->activeCrop = applied;
+		// 裁剪可能改变输出分辨率
+		this->RefreshCurrentDeviceFormat();
+		return StatusCode::STATUS_CODE_SUCCESS;
+	}
+
+	// 设备不支持时，在拷贝视频帧时裁剪
+	if (Becamv4l2CropHelper::AlignSoftwareCrop(this->activeFormat, this->requestedCrop, applied)) {
+		this->activeCropMode = CropMode::CROP_MODE_SOFTWARE;
+		this->activeCrop = applied;
+		return StatusCode::STATUS_CODE_SUCCESS;
+	}
+
+	// 压缩格式且设备不支持裁剪
+	return StatusCode::STATUS_CODE_ERR_NOT_SUPPORTED;
+}
+
+/**
+ * @implements 实现取流过程中应用期望的裁剪区域
+ */
+StatusCode Becamv4l2DeviceHelper::ApplyStreamingSoftwareCrop() {
+	// 设备裁剪生效时输出画面已是裁剪后的区域，恢复或更换设备裁剪会改变已映射缓冲区的布局，需在下次激活取流时生效
+	if (this->activeCropMode == CropMode::CROP_MODE_HARDWARE) {
+		DEBUG_LOG("Becamv4l2DeviceHelper::ApplyStreamingSoftwareCrop -> Hardware Crop Active, Deferred To Next Activation");
+		return StatusCode::STATUS_CODE_ERR_NOT_SUPPORTED;
+	}
+
+	// 取消裁剪
+	if (this->requestedCrop.width == 0 || this->requestedCrop.height == 0) {
+		this->activeCropMode = CropMode::CROP_MODE_NONE;
+		this->activeCrop = {0, 0, this->activeFormat.width, this->activeFormat.height};
+		return StatusCode::STATUS_CODE_SUCCESS;
+	}
+
+	// 在拷贝视频帧时裁剪（无法软件裁剪时保持当前裁剪区域）
+	CropRect applied = {0};
+	if (!Becamv4l2CropHelper::AlignSoftwareCrop(this->activeFormat, this->requestedCrop, applied)) {
+		return StatusCode::STATUS_CODE_ERR_NOT_SUPPORTED;
+	}
+	this->activeCropMode = CropMode::CROP_MODE_SOFTWARE;
+	this->activeCrop = applied;
+	return StatusCode::STATUS_CODE_SUCCESS;
+}
+
+/**
+ * @implements 实现判断当前是否需要将视频帧转换为输出格式
+ */
+bool Becamv4l2DeviceHelper::IsOutputConverting() const {
+	return this->outputFormat != 0 && this->outputFormat != this->activeFormat.pixelformat;
+}
+
+/**
+ * @implements 实现判断当前是否需要缩放视频帧
+ */
+bool Becamv4l2DeviceHelper::IsOutputResizing() const {
+	if (this->outputResize.width == 0 || this->outputResize.height == 0) {
+		return false;
+	}
+	// MJPEG在解码之后缩放，直接输出压缩帧时不缩放
+	if (IsMjpegFormat(this->activeFormat.pixelformat)) {
+		return this->IsOutputConverting() && CanResizeImage(this->outputFormat);
+	}
+	return CanResizeImage(this->activeFormat.pixelformat);
+}
+
+/**
+ * @implements 实现获取当前生效的行带并行策略
+ */
+RowBandPolicy Becamv4l2DeviceHelper::GetRowBandPolicy() const {
+	RowBandPolicy policy = {this->imagePool, this->parallelPolicy.bandRows};
+	return policy;
+}
+
+/**
+ * @implements 实现缩放已解码的视频帧
+ */
+void Becamv4l2DeviceHelper::ResizeDecodedFrame(uint8_t*& reply, size_t& replySize, const uint32_t format, uint32_t& width, uint32_t& height,
+											   uint32_t& bytesPerLine) {
+	ImageBuffer src = {0};
+	src.format = format;
+	src.width = width;
+	src.height = height;
+	ImageBuffer dst = {0};
+	dst.format = format;
+	dst.width = this->outputResize.width;
+	dst.height = this->outputResize.height;
+	auto size = GetImageSize(dst.format, dst.width, dst.height);
+	auto scaled = new uint8_t[size];
+	FillImageBuffer(dst, scaled, size, 0);
+	auto start = std::chrono::steady_clock::now();
+	if (!FillImageBuffer(src, reply, replySize, bytesPerLine) ||
+		ResizeImage(src, dst, this->outputResize.filter, this->GetRowBandPolicy()) != StatusCode::STATUS_CODE_SUCCESS) {
+		DEBUG_LOG("Becamv4l2DeviceHelper::ResizeDecodedFrame -> ResizeImage Failed");
+		delete[] scaled;
+		scaled = nullptr;
+		size = 0;
+	} else {
+		RecordStageTiming(this->resizeTiming, start);
+	}
+	// 替换为缩放结果
+	delete[] reply;
+	reply = scaled;
+	replySize = size;
+	width = dst.width;
+	height = dst.height;
+	bytesPerLine = dst.stride[0];
+}
+
+/**
+ * @implements 实现判断当前是否需要帧级并行解码
+ */
+bool Becamv4l2DeviceHelper::IsDecodePipelined() const {
+	return this->pipelineConfig.threadCount > 1 && this->IsOutputConverting() && IsMjpegFormat(this->activeFormat.pixelformat);
+}
+
 /**
  * @implements 实现处理设备名称
  */
@@ -93,9 +264,9 @@ std::string Becamv4l2DeviceHelper::TrimDeviceName(const std::string& deviceName)
 /**
  * @implements 实现检查设备是否支持视频捕获能力
  */
-bool Becamv4l2DeviceHelper::IsVideoCaptureDevice(const std::string& devicePath, std::string& deviceName) {
-	// 只读方式打开设备句柄
-	auto fd = open(devicePath.c_str(), O_RDONLY);
+bool Becamv4l2DeviceHelper::IsVideoCaptureDevice(const std::string& devicePath, std::string& deviceName, std::string* busInfo) {
+	// 只读方式打开设备句柄（非阻塞，避免探测期间被设备阻塞）
+	auto fd = open(devicePath.c_str(), O_RDONLY | O_NONBLOCK | O_CLOEXEC);
 	if (fd == -1) {
 		DEBUG_LOG("Becamv4l2DeviceHelper::IsVideoCaptureDevice -> open(" << devicePath << ") Failed");
 		return false;
@@ -118,6 +289,10 @@ bool Becamv4l2DeviceHelper::IsVideoCaptureDevice(const std::string& devicePath,
 	) {
 		// 复制设备名称
 		deviceName = Becamv4l2DeviceHelper::TrimDeviceName(reinterpret_cast<char*>(cap.card));
+		// 复制总线信息
+		if (busInfo != nullptr) {
+			*busInfo = reinterpret_cast<char*>(cap.bus_info);
+		}
 		return true;
 	}
 
@@ -126,12 +301,64 @@ bool Becamv4l2DeviceHelper::IsVideoCaptureDevice(const std::string& devicePath,
 }
 
 /**
- * @implements 实现获取设备列表
+ * @implements 实现枚举支持视频捕获的设备
  */
-StatusCode Becamv4l2DeviceHelper::GetDeviceList(DeviceInfo*& reply, size_t& replySize) {
+StatusCode Becamv4l2DeviceHelper::EnumDevices(std::vector<Becamv4l2DeviceEntry>& devices, bool* timedOut) {
 	// 重置
-	reply = nullptr;
-	replySize = 0;
+	devices.clear();
+	if (timedOut != nullptr) {
+		*timedOut = false;
+	}
+
+	// 优先从sysfs枚举，避免打开设备节点（可能唤醒设备或与正在取流的进程争用）
+	std::vector<Becamv4l2SysfsNode> nodes;
+	if (Becamv4l2SysfsHelper::EnumVideoNodes(nodes)) {
+		// 无法由sysfs推断能力的节点需打开查询
+		std::vector<std::string> probePaths;
+		std::vector<bool> inferred(nodes.size(), false);
+		std::vector<bool> captures(nodes.size(), false);
+		for (size_t i = 0; i < nodes.size(); i++) {
+			bool capture = false;
+			inferred[i] = Becamv4l2SysfsHelper::InferVideoCapture(nodes[i], nodes, capture);
+			captures[i] = capture;
+			if (!inferred[i]) {
+				probePaths.push_back(nodes[i].devicePath);
+			}
+		}
+		std::vector<Becamv4l2DeviceEntry> probed;
+		auto probeTimedOut = Becamv4l2DeviceProber::Probe(probePaths, probed);
+		if (timedOut != nullptr) {
+			*timedOut = probeTimedOut;
+		}
+
+		// 按节点顺序合并结果
+		auto probedIt = probed.begin();
+		for (size_t i = 0; i < nodes.size(); i++) {
+			auto& node = nodes[i];
+			Becamv4l2DeviceEntry entry;
+			if (inferred[i]) {
+				if (!captures[i]) {
+					continue;
+				}
+				entry.name = Becamv4l2DeviceHelper::TrimDeviceName(node.name);
+				entry.devicePath = node.devicePath;
+			} else if (probedIt != probed.end() && probedIt->devicePath == node.devicePath) {
+				entry = *probedIt++;
+			} else {
+				continue;
+			}
+			// 稳定标识缺失时（例如sysfs中没有device链接）退化为设备路径
+			entry.deviceId = node.deviceId.empty() ? node.devicePath : node.deviceId;
+			// 同一物理设备的其它节点（包括元数据节点）
+			for (auto& sibling : nodes) {
+				if (sibling.devicePath != node.devicePath && !node.physicalDir.empty() && sibling.physicalDir == node.physicalDir) {
+					entry.siblingPaths.push_back(sibling.devicePath);
+				}
+			}
+			devices.push_back(entry);
+		}
+		return StatusCode::STATUS_CODE_SUCCESS;
+	}
 
 	// 查找符合`/dev/video*`的设备
 	glob_t globResult;
@@ -141,43 +368,66 @@ StatusCode Becamv4l2DeviceHelper::GetDeviceList(DeviceInfo*& reply, size_t& repl
 		if (res == GLOB_NOMATCH) {
 			return StatusCode::STATUS_CODE_SUCCESS;
 		}
-		DEBUG_LOG("Becamv4l2DeviceHelper::GetDeviceList -> lob(/dev/video*, GLOB_TILDE) Failed, RESULT:" << res);
+		DEBUG_LOG("Becamv4l2DeviceHelper::EnumDevices -> glob(/dev/video*, GLOB_TILDE) Failed, RESULT:" << res);
 		return StatusCode::STATUS_CODE_ERR_DEVICE_ENUM_FAILED;
 	}
 
-	// 临时设备列表
-	std::vector<DeviceInfo> deviceList;
-	// 遍历匹配结果
-	for (size_t i = 0; i < globResult.gl_pathc; i++) {
-		// 待提取的设备名称
-		std::string deviceName = "";
-		// 提取设备路径
-		std::string devicePath = globResult.gl_pathv[i];
-		if (Becamv4l2DeviceHelper::IsVideoCaptureDevice(devicePath, deviceName)) {
-			// 构建设备信息
-			DeviceInfo deviceInfo = {0};
-			// 拷贝设备名称
-			deviceInfo.name = new char[deviceName.length() + 1];
-			memcpy(deviceInfo.name, deviceName.c_str(), deviceName.length() + 1);
-			// 拷贝设备路径
-			deviceInfo.devicePath = new char[devicePath.length() + 1];
-			memcpy(deviceInfo.devicePath, devicePath.c_str(), devicePath.length() + 1);
-			// 添加到临时列表
-			deviceList.push_back(deviceInfo);
+	// 并行探测匹配结果（按匹配顺序返回）
+	std::vector<std::string> devicePaths(globResult.gl_pathv, globResult.gl_pathv + globResult.gl_pathc);
+	auto probeTimedOut = Becamv4l2DeviceProber::Probe(devicePaths, devices);
+	if (timedOut != nullptr) {
+		*timedOut = probeTimedOut;
+	}
+
+	// 没有sysfs时只能以总线信息及其下捕获节点的序号作为稳定标识，并以此关联同一设备的节点
+	for (size_t i = 0; i < devices.size(); i++) {
+		size_t ordinal = 0;
+		for (size_t j = 0; j < devices.size(); j++) {
+			if (j == i || devices[j].busInfo.empty() || devices[j].busInfo != devices[i].busInfo) {
+				continue;
+			}
+			if (j < i) {
+				ordinal++;
+			}
+			devices[i].siblingPaths.push_back(devices[j].devicePath);
 		}
+		devices[i].deviceId =
+			devices[i].busInfo.empty() ? devices[i].devicePath : "bus-" + devices[i].busInfo + "-" + std::to_string(ordinal);
 	}
 
 	// 释放泛匹配结果
 	globfree(&globResult);
 
-	// 是否需要赋值响应数据
-	if (deviceList.size() > 0) {
-		// 拷贝设备列表
-		replySize = deviceList.size();
-		reply = new DeviceInfo[replySize];
-		memcpy(reply, deviceList.data(), replySize * sizeof(DeviceInfo));
+	// OK
+	return StatusCode::STATUS_CODE_SUCCESS;
+}
+
+/**
+ * @implements 实现将设备列表转换为响应数据
+ */
+void Becamv4l2DeviceHelper::BuildDeviceList(const std::vector<Becamv4l2DeviceEntry>& devices, DeviceInfo*& reply, size_t& replySize) {
+	// 设备信息及字符串位于同一内存块
+	BuildDeviceListArena(devices, reply, replySize);
+}
+
+/**
+ * @implements 实现获取设备列表
+ */
+StatusCode Becamv4l2DeviceHelper::GetDeviceList(DeviceInfo*& reply, size_t& replySize) {
+	// 重置
+	reply = nullptr;
+	replySize = 0;
+
+	// 枚举设备
+	std::vector<Becamv4l2DeviceEntry> devices;
+	auto code = Becamv4l2DeviceHelper::EnumDevices(devices);
+	if (code != StatusCode::STATUS_CODE_SUCCESS) {
+		return code;
 	}
 
+	// 转换为响应数据
+	Becamv4l2DeviceHelper::BuildDeviceList(devices, reply, replySize);
+
 	// OK
 	return StatusCode::STATUS_CODE_SUCCESS;
 }
@@ -186,31 +436,22 @@ StatusCode Becamv4l2DeviceHelper::GetDeviceList(DeviceInfo*& reply, size_t& repl
  * @implements 实现释放设备列表
  */
 void Becamv4l2DeviceHelper::FreeDeviceList(DeviceInfo*& input, size_t& inputSize) {
-	// 检查
-	if (inputSize <= 0 || input == nullptr) {
-		return;
-	}
+	// 整块释放
+	FreeDeviceListArena(input, inputSize);
+}
 
-	// 遍历，执行释放操作
-	for (size_t i = 0; i < inputSize; i++) {
-		// 获取引用
-		auto item = input[i];
-		// 释放友好名称
-		if (item.name != nullptr) {
-			delete[] item.name;
-			item.name = nullptr;
-		}
-		// 释放设备路径
-		if (item.devicePath != nullptr) {
-			delete[] item.devicePath;
-			item.devicePath = nullptr;
+/**
+ * @implements 实现在设备列表中查找稳定标识对应的设备路径
+ */
+bool Becamv4l2DeviceHelper::FindDevicePath(const std::vector<Becamv4l2DeviceEntry>& devices, const std::string& deviceId,
+										   std::string& devicePath) {
+	for (auto& device : devices) {
+		if (device.deviceId == deviceId) {
+			devicePath = device.devicePath;
+			return true;
 		}
 	}
-
-	// 释放整个列表
-	delete[] input;
-	inputSize = 0;
-	input = nullptr;
+	return false;
 }
 
 /**
@@ -239,6 +480,8 @@ StatusCode Becamv4l2DeviceHelper::ActivateDevice(const std::string& devicePath,
 		DEBUG_LOG("Becamv4l2DeviceHelper::ActivateDevice -> open(" << devicePath << ") Failed");
 		return StatusCode::STATUS_CODE_ERR_DEVICE_OPEN_FAILED;
 	}
+	// 控制项缓存随设备更换
+	this->controlHelper.Attach(this->activatedDevice);
 
 	// OK
 	return StatusCode::STATUS_CODE_SUCCESS;
@@ -270,6 +513,44 @@ void Becamv4l2DeviceHelper::FreeDeviceConfigList(VideoFrameInfo*& input, size_t&
 	Becamv4l2DeviceConfigHelper::FreeDeviceConfigList(input, inputSize);
 }
 
+/**
+ * @implements 实现协商当前设备的视频帧信息
+ */
+StatusCode Becamv4l2DeviceHelper::NegotiateCurrentDeviceConfig(const VideoFrameInfo& desired, const NegotiatePolicy* policy,
+															   VideoFrameInfo& chosen) {
+	// 加个锁先
+	std::unique_lock<std::mutex> lock(this->mtx);
+
+	// 检查设备是否已激活
+	if (this->activatedDevice == -1) {
+		return StatusCode::STATUS_CODE_ERR_DEVICE_NOT_OPEN;
+	}
+
+	// 初始化设备配置助手类
+	auto configHelper = Becamv4l2DeviceConfigHelper(this->activatedDevice);
+	// 查询设备支持的配置列表
+	VideoFrameInfo* list = nullptr;
+	size_t listSize = 0;
+	auto code = configHelper.GetDeviceConfigList(list, listSize);
+	if (code != StatusCode::STATUS_CODE_SUCCESS) {
+		return code;
+	}
+	// 按开销排序
+	auto ranked = RankFrameInfoList(list, listSize, desired, policy);
+	Becamv4l2DeviceConfigHelper::FreeDeviceConfigList(list, listSize);
+
+	// 按开销由低到高试探，选出第一个驱动原样接受的配置，避免调用方逐个试开设备
+	for (auto& item : ranked) {
+		if (configHelper.TryDeviceConfig(item)) {
+			chosen = item;
+			return StatusCode::STATUS_CODE_SUCCESS;
+		}
+	}
+
+	// 没有满足条件的配置
+	return StatusCode::STATUS_CODE_ERR_DEVICE_FRAME_FMT_NOT_FOUND;
+}
+
 /**
  * @implements 实现激活设备取流
  */
@@ -297,6 +578,13 @@ StatusCode Becamv4l2DeviceHelper::ActivateDeviceStreaming(const VideoFrameInfo&
 		DEBUG_LOG("Becamv4l2DeviceHelper::ActivateDeviceRender -> xioctl(VIDIOC_S_FMT) Failed");
 		return StatusCode::STATUS_CODE_ERR_DEVICE_FRAME_FMT_SET_FAILED;
 	}
+	// 记录驱动实际生效的格式
+	this->activeFormat = fmt.fmt.pix;
+	// 检查驱动生效的格式能否转换为输出格式
+	if (this->IsOutputConverting() && !CanConvertFrame(this->activeFormat.pixelformat, this->outputFormat)) {
+		DEBUG_LOG("Becamv4l2DeviceHelper::ActivateDeviceRender -> CanConvertFrame Failed");
+		return StatusCode::STATUS_CODE_ERR_NOT_SUPPORTED;
+	}
 
 	// 声明输出帧率
 	v4l2_streamparm streamparm = {0};
@@ -334,6 +622,27 @@ StatusCode Becamv4l2DeviceHelper::ActivateDeviceStreaming(const VideoFrameInfo&
 		DEBUG_LOG("Becamv4l2DeviceHelper::ActivateDeviceRender -> xioctl(VIDIOC_S_PARM) Failed");
 		return StatusCode::STATUS_CODE_ERR_DEVICE_FRAME_FMT_SET_FAILED;
 	}
+	// 记录驱动实际生效的帧间隔
+	this->activeTimePerFrame = streamparm.parm.capture.timeperframe;
+
+	// 在申请缓冲区前应用裁剪区域（设备裁剪可能改变缓冲区大小，未请求裁剪时同步为完整画面，裁剪失败不影响取流）
+	auto cropCode = this->ApplyCurrentDeviceCrop();
+	if (cropCode != StatusCode::STATUS_CODE_SUCCESS) {
+		DEBUG_LOG("Becamv4l2DeviceHelper::ActivateDeviceRender -> ApplyCurrentDeviceCrop Failed, Code:" << cropCode);
+	}
+
+	// 在开始取流前一次性恢复控制项快照，避免取流后逐个设置导致丢帧及画面收敛（失败不影响取流）
+	if (!this->snapshotControls.empty()) {
+		Becamv4l2ControlSnapshot::Restore(this->controlHelper, this->snapshotControls);
+	}
+	// 在开始取流前应用采集配置（控制项设置失败不影响取流，结果记录在应用结果中）
+	if (this->captureProfileHelper.IsEnabled()) {
+		this->captureProfileHelper.Apply(this->controlHelper, this->activeTimePerFrame);
+	}
+	// 软件自动曝光在采集配置之后开始，以其切换的手动曝光为准
+	if (this->exposureController.IsEnabled()) {
+		this->exposureController.Start(this->controlHelper, this->activeTimePerFrame);
+	}
 
 	// 请求缓冲区
 	v4l2_requestbuffers reqBuf = {0};
@@ -381,9 +690,18 @@ StatusCode Becamv4l2DeviceHelper::ActivateDeviceStreaming(const VideoFrameInfo&
 	// 启动视频流
 	auto bufType = v4l2_buf_type::V4L2_BUF_TYPE_VIDEO_CAPTURE;
 	if (xioctl(this->activatedDevice, VIDIOC_STREAMON, &bufType) == -1) {
-		DEBUG_LOG("Becamv4l2DeviceHelper::ActivateDeviceRender -> xioctl(VIDIOC_STREAMON) Failed");
+		auto err = errno;
+		DEBUG_LOG("Becamv4l2DeviceHelper::ActivateDeviceRender -> xioctl(VIDIOC_STREAMON) Failed, ERRNO:" << err);
+		// 同一USB总线上的其它设备已占满等时带宽
+		if (err == ENOSPC) {
+			return StatusCode::STATUS_CODE_ERR_DEVICE_NO_BANDWIDTH;
+		}
 		return StatusCode::STATUS_CODE_ERR_DEVICE_RUN_FAILED;
 	}
+	// 清零各处理阶段的耗时统计
+	this->decodeTiming = {0};
+	this->resizeTiming = {0};
+	this->convertTiming = {0};
 	// 标记已经开始取流
 	this->streamON = true;
 
@@ -402,10 +720,408 @@ void Becamv4l2DeviceHelper::CloseDevice() {
 	this->CloseCurrentDevice();
 }
 
+/**
+ * @implements 实现设置裁剪区域
+ */
+StatusCode Becamv4l2DeviceHelper::SetCropRect(const CropRect& rect) {
+	// 加个锁先
+	std::unique_lock<std::mutex> lock(this->mtx);
+
+	// 记录期望的裁剪区域
+	this->requestedCrop = rect;
+	// 未取流时在下次激活取流时生效
+	if (this->activatedDevice == -1 || !this->streamON) {
+		return StatusCode::STATUS_CODE_SUCCESS;
+	}
+	// 取流过程中立即生效（只进行软件裁剪）
+	return this->ApplyStreamingSoftwareCrop();
+}
+
+/**
+ * @implements 实现设置输出格式
+ */
+StatusCode Becamv4l2DeviceHelper::SetOutputFormat(const uint32_t format) {
+	// 加个锁先
+	std::unique_lock<std::mutex> lock(this->mtx);
+
+	// 检查是否为可输出的格式
+	if (format != 0 && GetImagePlaneCount(format) == 0) {
+		return StatusCode::STATUS_CODE_ERR_NOT_SUPPORTED;
+	}
+	// 取流过程中检查当前格式能否转换
+	if (this->activatedDevice != -1 && this->streamON && format != 0 && format != this->activeFormat.pixelformat &&
+		!CanConvertFrame(this->activeFormat.pixelformat, format)) {
+		return StatusCode::STATUS_CODE_ERR_NOT_SUPPORTED;
+	}
+	// 记录输出格式（下一帧起生效）
+	this->outputFormat = format;
+	return StatusCode::STATUS_CODE_SUCCESS;
+}
+
+/**
+ * @implements 实现设置输出缩放
+ */
+StatusCode Becamv4l2DeviceHelper::SetOutputResize(const ResizeConfig* config) {
+	// 加个锁先
+	std::unique_lock<std::mutex> lock(this->mtx);
+
+	// 取消缩放
+	if (config == nullptr || config->width == 0 || config->height == 0) {
+		this->outputResize = {0};
+		return StatusCode::STATUS_CODE_SUCCESS;
+	}
+	// 检查参数
+	if (!IsResizeFilterValid(config->filter)) {
+		return StatusCode::STATUS_CODE_ERR_INPUT_PARAM;
+	}
+	// 记录缩放配置（下一帧起生效）
+	this->outputResize = *config;
+	return StatusCode::STATUS_CODE_SUCCESS;
+}
+
+/**
+ * @implements 实现设置MJPEG解码缩放比例
+ */
+StatusCode Becamv4l2DeviceHelper::SetDecodeScale(const uint32_t scaleDenom) {
+	// 加个锁先
+	std::unique_lock<std::mutex> lock(this->mtx);
+
+	// 检查参数
+	if (!IsMjpegScaleValid(scaleDenom)) {
+		return StatusCode::STATUS_CODE_ERR_INPUT_PARAM;
+	}
+	// 记录缩放比例（下一帧起生效）
+	this->decodeScale = scaleDenom;
+	return StatusCode::STATUS_CODE_SUCCESS;
+}
+
+/**
+ * @implements 实现设置帧内分条并行解码线程数
+ */
+StatusCode Becamv4l2DeviceHelper::SetDecodeStripThreads(const uint32_t threadCount) {
+	// 加个锁先
+	std::unique_lock<std::mutex> lock(this->mtx);
+
+	// 记录线程数（下一帧起生效）
+	this->stripThreads = threadCount;
+	return StatusCode::STATUS_CODE_SUCCESS;
+}
+
+/**
+ * @implements 实现设置帧级并行解码
+ */
+StatusCode Becamv4l2DeviceHelper::SetDecodePipeline(const DecodePipelineConfig* config) {
+	// 加个锁先
+	std::unique_lock<std::mutex> lock(this->mtx);
+
+	// 丢弃在途的视频帧（下一次取帧时按新配置创建流水线）
+	DestroyMjpegDecodePipeline(this->decodePipeline);
+	if (config == nullptr) {
+		this->pipelineConfig = {0};
+		return StatusCode::STATUS_CODE_SUCCESS;
+	}
+	// 记录配置（线程数为0时取处理器核心数）
+	this->pipelineConfig = *config;
+	if (this->pipelineConfig.threadCount == 0) {
+		this->pipelineConfig.threadCount = std::max(1u, std::thread::hardware_concurrency());
+	}
+	if (this->pipelineConfig.maxInFlight == 0) {
+		this->pipelineConfig.maxInFlight = this->pipelineConfig.threadCount + 1;
+	}
+	return StatusCode::STATUS_CODE_SUCCESS;
+}
+
+/**
+ * @implements 实现获取帧级并行解码状态
+ */
+StatusCode Becamv4l2DeviceHelper::GetDecodePipelineState(DecodePipelineState& state) {
+	// 加个锁先
+	std::unique_lock<std::mutex> lock(this->mtx);
+
+	// 重置
+	state = {0};
+	// 流水线尚未创建时只返回配置
+	if (this->decodePipeline == nullptr) {
+		if (this->pipelineConfig.threadCount > 1) {
+			state.threadCount = this->pipelineConfig.threadCount;
+			state.maxInFlight = this->pipelineConfig.maxInFlight;
+		}
+		return StatusCode::STATUS_CODE_SUCCESS;
+	}
+	GetMjpegPipelineState(this->decodePipeline, state);
+	return StatusCode::STATUS_CODE_SUCCESS;
+}
+
+/**
+ * @implements 实现设置单帧图像处理的并行策略
+ */
+StatusCode Becamv4l2DeviceHelper::SetParallelPolicy(const ParallelPolicy* policy) {
+	// 加个锁先
+	std::unique_lock<std::mutex> lock(this->mtx);
+
+	// 记录策略（并行度为0时取处理器核心数）
+	this->parallelPolicy = {0};
+	if (policy != nullptr) {
+		this->parallelPolicy = *policy;
+		if (this->parallelPolicy.threadCount == 0) {
+			this->parallelPolicy.threadCount = std::max(1u, std::thread::hardware_concurrency());
+		}
+	}
+	// 并行度变化时重建线程池（取帧持有同一把锁，不会与正在执行的行带并发）
+	auto threadCount = std::max(1u, this->parallelPolicy.threadCount);
+	if (GetWorkerPoolSize(this->imagePool) != threadCount) {
+		DestroyWorkerPool(this->imagePool);
+		if (threadCount > 1) {
+			this->imagePool = CreateWorkerPool(threadCount);
+		}
+	}
+	return StatusCode::STATUS_CODE_SUCCESS;
+}
+
+/**
+ * @implements 实现获取各处理阶段的耗时统计
+ */
+StatusCode Becamv4l2DeviceHelper::GetStageTimings(StageTimings& timings) {
+	// 加个锁先
+	std::unique_lock<std::mutex> lock(this->mtx);
+
+	// 导出统计
+	timings = {0};
+	timings.threadCount = GetWorkerPoolSize(this->imagePool);
+	GetStageTiming(this->decodeTiming, timings.decode);
+	GetStageTiming(this->resizeTiming, timings.resize);
+	GetStageTiming(this->convertTiming, timings.convert);
+	return StatusCode::STATUS_CODE_SUCCESS;
+}
+
+/**
+ * @implements 实现设置是否为直接输出的MJPEG视频帧补齐霍夫曼表
+ */
+StatusCode Becamv4l2DeviceHelper::SetInsertHuffmanTables(const bool enable) {
+	// 加个锁先
+	std::unique_lock<std::mutex> lock(this->mtx);
+
+	// 记录设置（下一帧起生效）
+	this->insertHuffmanTables = enable;
+	return StatusCode::STATUS_CODE_SUCCESS;
+}
+
+/**
+ * @implements 实现获取当前设备实际生效的视频帧格式
+ */
+StatusCode Becamv4l2DeviceHelper::GetCurrentDeviceFormat(FrameFormat& format) {
+	// 加个锁先
+	std::unique_lock<std::mutex> lock(this->mtx);
+
+	// 重置
+	format = {0};
+
+	// 检查设备是否已激活
+	if (this->activatedDevice == -1) {
+		return StatusCode::STATUS_CODE_ERR_DEVICE_NOT_OPEN;
+	}
+	if (!this->streamON) {
+		return StatusCode::STATUS_CODE_ERR_DEVICE_NOT_RUN;
+	}
+
+	// 驱动回写的格式（设备裁剪后已重新读取）
+	format.format = this->activeFormat.pixelformat;
+	format.width = this->activeFormat.width;
+	format.height = this->activeFormat.height;
+	format.bytesPerLine = this->activeFormat.bytesperline;
+	format.sizeImage = this->activeFormat.sizeimage;
+	format.colorspace = this->activeFormat.colorspace;
+	// 驱动填充了扩展字段时才有效
+	if (this->activeFormat.priv == V4L2_PIX_FMT_PRIV_MAGIC) {
+		format.ycbcrEncoding = this->activeFormat.ycbcr_enc;
+		format.quantization = this->activeFormat.quantization;
+	}
+	format.intervalNumerator = this->activeTimePerFrame.numerator;
+	format.intervalDenominator = this->activeTimePerFrame.denominator;
+	// 软件裁剪时返回拷贝后的紧凑布局
+	if (this->activeCropMode == CropMode::CROP_MODE_SOFTWARE) {
+		uint32_t bytesPerLine = 0;
+		format.sizeImage = uint32_t(Becamv4l2CropHelper::GetSoftwareCropSize(this->activeFormat, this->activeCrop, bytesPerLine));
+		format.width = this->activeCrop.width;
+		format.height = this->activeCrop.height;
+		format.bytesPerLine = bytesPerLine;
+	}
+	// 转换输出时返回目标格式的紧凑布局
+	if (this->IsOutputConverting()) {
+		// MJPEG按缩放比例解码
+		if (IsMjpegFormat(this->activeFormat.pixelformat)) {
+			format.width = GetMjpegScaledLength(format.width, this->decodeScale);
+			format.height = GetMjpegScaledLength(format.height, this->decodeScale);
+		}
+		format.format = this->outputFormat;
+		format.bytesPerLine = GetDefaultImageStride(this->outputFormat, format.width, 0);
+		format.sizeImage = uint32_t(GetImageSize(this->outputFormat, format.width, format.height));
+	}
+	// 缩放输出时返回缩放后的紧凑布局
+	if (this->IsOutputResizing()) {
+		format.width = this->outputResize.width;
+		format.height = this->outputResize.height;
+		format.bytesPerLine = GetDefaultImageStride(format.format, format.width, 0);
+		format.sizeImage = uint32_t(GetImageSize(format.format, format.width, format.height));
+	}
+	return StatusCode::STATUS_CODE_SUCCESS;
+}
+
+/**
+ * @implements 实现保存当前设备的控制项快照
+ */
+StatusCode Becamv4l2DeviceHelper::SaveCurrentDeviceControlSnapshot(std::vector<uint8_t>& blob) {
+	// 加个锁先
+	std::unique_lock<std::mutex> lock(this->mtx);
+
+	// 检查设备是否已激活
+	if (this->activatedDevice == -1) {
+		return StatusCode::STATUS_CODE_ERR_DEVICE_NOT_OPEN;
+	}
+	return Becamv4l2ControlSnapshot::Capture(this->controlHelper, blob);
+}
+
+/**
+ * @implements 实现设置激活取流时恢复的控制项快照
+ */
+StatusCode Becamv4l2DeviceHelper::SetControlSnapshot(const uint8_t* data, const size_t size) {
+	// 加个锁先
+	std::unique_lock<std::mutex> lock(this->mtx);
+
+	// 取消
+	if (data == nullptr) {
+		this->snapshotControls.clear();
+		return StatusCode::STATUS_CODE_SUCCESS;
+	}
+	// 解析快照
+	std::vector<ControlValue> values;
+	if (!Becamv4l2ControlSnapshot::Parse(data, size, values)) {
+		return StatusCode::STATUS_CODE_ERR_INPUT_PARAM;
+	}
+	this->snapshotControls = values;
+	// 未取流时在下次激活取流时生效
+	if (this->activatedDevice == -1 || !this->streamON) {
+		return StatusCode::STATUS_CODE_SUCCESS;
+	}
+	// 取流过程中立即写入
+	return Becamv4l2ControlSnapshot::Restore(this->controlHelper, this->snapshotControls);
+}
+
+/**
+ * @implements 实现设置低延迟采集配置
+ */
+StatusCode Becamv4l2DeviceHelper::SetCaptureProfile(const CaptureProfile* profile) {
+	// 加个锁先
+	std::unique_lock<std::mutex> lock(this->mtx);
+
+	// 记录采集配置
+	this->captureProfileHelper.SetProfile(profile);
+	// 未取流时在下次激活取流时生效
+	if (profile == nullptr || this->activatedDevice == -1 || !this->streamON) {
+		return StatusCode::STATUS_CODE_SUCCESS;
+	}
+	// 取流过程中立即生效
+	this->captureProfileHelper.Apply(this->controlHelper, this->activeTimePerFrame);
+	return StatusCode::STATUS_CODE_SUCCESS;
+}
+
+/**
+ * @implements 实现获取采集配置应用结果
+ */
+StatusCode Becamv4l2DeviceHelper::GetCaptureProfileReport(CaptureProfileReport& report) {
+	// 加个锁先
+	std::unique_lock<std::mutex> lock(this->mtx);
+
+	// 获取应用结果
+	this->captureProfileHelper.GetReport(report);
+	return StatusCode::STATUS_CODE_SUCCESS;
+}
+
+/**
+ * @implements 实现设置软件自动曝光
+ */
+StatusCode Becamv4l2DeviceHelper::SetAutoExposure(const AutoExposureConfig* config) {
+	// 加个锁先
+	std::unique_lock<std::mutex> lock(this->mtx);
+
+	// 记录自动曝光配置
+	this->exposureController.SetConfig(config);
+	// 未取流时在下次激活取流时生效
+	if (config == nullptr || this->activatedDevice == -1 || !this->streamON) {
+		return StatusCode::STATUS_CODE_SUCCESS;
+	}
+	// 取流过程中立即开始
+	this->exposureController.Start(this->controlHelper, this->activeTimePerFrame);
+	return StatusCode::STATUS_CODE_SUCCESS;
+}
+
+/**
+ * @implements 实现获取软件自动曝光状态
+ */
+StatusCode Becamv4l2DeviceHelper::GetAutoExposureState(AutoExposureState& state) {
+	// 加个锁先
+	std::unique_lock<std::mutex> lock(this->mtx);
+
+	// 获取自动曝光状态
+	this->exposureController.GetState(state);
+	return StatusCode::STATUS_CODE_SUCCESS;
+}
+
+/**
+ * @implements 实现获取当前设备的控制项列表
+ */
+StatusCode Becamv4l2DeviceHelper::GetCurrentDeviceControlList(ControlInfo*& reply, size_t& replySize) {
+	// 加个锁先
+	std::unique_lock<std::mutex> lock(this->mtx);
+
+	// 检查设备是否已激活
+	if (this->activatedDevice == -1) {
+		reply = nullptr;
+		replySize = 0;
+		return StatusCode::STATUS_CODE_ERR_DEVICE_NOT_OPEN;
+	}
+	return this->controlHelper.GetControlList(reply, replySize);
+}
+
+/**
+ * @implements 实现释放控制项列表
+ */
+void Becamv4l2DeviceHelper::FreeControlList(ControlInfo*& input, size_t& inputSize) {
+	Becamv4l2ControlHelper::FreeControlList(input, inputSize);
+}
+
+/**
+ * @implements 实现批量读取当前设备的控制项
+ */
+StatusCode Becamv4l2DeviceHelper::GetCurrentDeviceControls(ControlValue* valueList, const size_t valueListSize) {
+	// 加个锁先
+	std::unique_lock<std::mutex> lock(this->mtx);
+
+	// 检查设备是否已激活
+	if (this->activatedDevice == -1) {
+		return StatusCode::STATUS_CODE_ERR_DEVICE_NOT_OPEN;
+	}
+	return this->controlHelper.GetControls(valueList, valueListSize);
+}
+
+/**
+ * @implements 实现批量设置当前设备的控制项
+ */
+StatusCode Becamv4l2DeviceHelper::SetCurrentDeviceControls(const ControlValue* valueList, const size_t valueListSize) {
+	// 加个锁先
+	std::unique_lock<std::mutex> lock(this->mtx);
+
+	// 检查设备是否已激活
+	if (this->activatedDevice == -1) {
+		return StatusCode::STATUS_CODE_ERR_DEVICE_NOT_OPEN;
+	}
+	return this->controlHelper.SetControls(valueList, valueListSize);
+}
+
 /**
  * @implements 实现获取视频帧
  */
-StatusCode Becamv4l2DeviceHelper::GetFrame(uint8_t*& reply, size_t& replySize) {
+StatusCode Becamv4l2DeviceHelper::GetFrame(uint8_t*& reply, size_t& replySize, VideoFrameMeta* meta) {
 	// 加个锁先
 	std::unique_lock<std::mutex> lock(this->mtx);
 
@@ -421,6 +1137,12 @@ StatusCode Becamv4l2DeviceHelper::GetFrame(uint8_t*& reply, size_t& replySize) {
 		return StatusCode::STATUS_CODE_ERR_DEVICE_NOT_RUN;
 	}
 
+	// 帧级并行解码（输出格式变化后丢弃流水线中的视频帧，恢复串行解码）
+	if (this->IsDecodePipelined()) {
+		return this->GetPipelinedFrame(reply, replySize, meta);
+	}
+	DestroyMjpegDecodePipeline(this->decodePipeline);
+
 	// 声明缓冲区队列查询参数
 	v4l2_buffer buf = {0};
 	buf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
@@ -431,14 +1153,162 @@ StatusCode Becamv4l2DeviceHelper::GetFrame(uint8_t*& reply, size_t& replySize) {
 		return StatusCode::STATUS_CODE_V4L2_ERR_LOCK_BUF;
 	}
 
+	// 记录视频帧用于校验实际帧率
+	auto timestamp = uint64_t(buf.timestamp.tv_sec) * 1000000 + uint64_t(buf.timestamp.tv_usec);
+	this->captureProfileHelper.OnFrame(buf.sequence, timestamp);
+
 	// 是否读取到有效帧
-	if (buf.bytesused > 0) {
+	uint32_t bytesPerLine = this->activeFormat.bytesperline;
+	uint32_t frameWidth = this->activeCropMode == CropMode::CROP_MODE_SOFTWARE ? this->activeCrop.width : this->activeFormat.width;
+	uint32_t frameHeight = this->activeCropMode == CropMode::CROP_MODE_SOFTWARE ? this->activeCrop.height : this->activeFormat.height;
+	if (buf.bytesused > 0 && this->IsOutputConverting() && IsMjpegFormat(this->activeFormat.pixelformat)) {
+		// 直接从驱动缓冲区解码（同一路视频流复用解码器）
+		if (this->mjpegDecoder == nullptr) {
+			this->mjpegDecoder = CreateMjpegDecoder();
+		}
+		SetMjpegDecoderThreads(this->mjpegDecoder, this->stripThreads);
+		ImageBuffer dst = {0};
+		dst.format = this->outputFormat;
+		auto src = reinterpret_cast<const uint8_t*>(this->userBuffers[buf.index]);
+		auto start = std::chrono::steady_clock::now();
+		if (StartMjpegDecode(this->mjpegDecoder, src, buf.bytesused, this->decodeScale, dst.format, dst.width, dst.height) ==
+			StatusCode::STATUS_CODE_SUCCESS) {
+			replySize = GetImageSize(dst.format, dst.width, dst.height);
+			reply = new uint8_t[replySize];
+			FillImageBuffer(dst, reply, replySize, 0);
+			bytesPerLine = dst.stride[0];
+			frameWidth = dst.width;
+			frameHeight = dst.height;
+			if (FinishMjpegDecode(this->mjpegDecoder, dst) != StatusCode::STATUS_CODE_SUCCESS) {
+				DEBUG_LOG("Becamv4l2DeviceHelper::GetFrame -> FinishMjpegDecode Failed");
+				delete[] reply;
+				reply = nullptr;
+				replySize = 0;
+			} else {
+				RecordStageTiming(this->decodeTiming, start);
+				if (this->IsOutputResizing()) {
+					// 解码后缩放
+					this->ResizeDecodedFrame(reply, replySize, dst.format, frameWidth, frameHeight, bytesPerLine);
+				}
+			}
+		}
+	} else if (buf.bytesused > 0 && this->IsOutputResizing()) {
+		// 直接从驱动缓冲区缩放（软件裁剪时只缩放裁剪区域），需要转换时缩放后再转换（先缩小再转换开销最低）
+		ImageBuffer src = {0};
+		src.format = this->activeFormat.pixelformat;
+		src.width = this->activeFormat.width;
+		src.height = this->activeFormat.height;
+		auto valid = FillImageBuffer(src, reinterpret_cast<uint8_t*>(this->userBuffers[buf.index]), buf.bytesused, this->activeFormat.bytesperline);
+		if (valid && this->activeCropMode == CropMode::CROP_MODE_SOFTWARE) {
+			valid = CropImageBuffer(src, this->activeCrop.left, this->activeCrop.top, this->activeCrop.width, this->activeCrop.height);
+		}
+		if (valid) {
+			ImageBuffer scaled = {0};
+			scaled.format = src.format;
+			scaled.width = this->outputResize.width;
+			scaled.height = this->outputResize.height;
+			ImageBuffer dst = scaled;
+			dst.format = this->IsOutputConverting() ? this->outputFormat : src.format;
+			replySize = GetImageSize(dst.format, dst.width, dst.height);
+			reply = new uint8_t[replySize];
+			FillImageBuffer(dst, reply, replySize, 0);
+			if (this->IsOutputConverting()) {
+				this->resizeBuffer.resize(GetImageSize(scaled.format, scaled.width, scaled.height));
+				FillImageBuffer(scaled, this->resizeBuffer.data(), this->resizeBuffer.size(), 0);
+			} else {
+				scaled = dst;
+			}
+			bytesPerLine = dst.stride[0];
+			frameWidth = dst.width;
+			frameHeight = dst.height;
+			auto policy = this->GetRowBandPolicy();
+			auto start = std::chrono::steady_clock::now();
+			auto code = ResizeImage(src, scaled, this->outputResize.filter, policy);
+			if (code == StatusCode::STATUS_CODE_SUCCESS) {
+				RecordStageTiming(this->resizeTiming, start);
+			}
+			if (code == StatusCode::STATUS_CODE_SUCCESS && this->IsOutputConverting()) {
+				start = std::chrono::steady_clock::now();
+				code = ConvertImage(scaled, dst, policy);
+				if (code == StatusCode::STATUS_CODE_SUCCESS) {
+					RecordStageTiming(this->convertTiming, start);
+				}
+			}
+			if (code != StatusCode::STATUS_CODE_SUCCESS) {
+				delete[] reply;
+				reply = nullptr;
+				replySize = 0;
+			}
+		}
+	} else if (buf.bytesused > 0 && this->IsOutputConverting()) {
+		// 直接从驱动缓冲区转换（软件裁剪时只转换裁剪区域）
+		ImageBuffer src = {0};
+		src.format = this->activeFormat.pixelformat;
+		src.width = this->activeFormat.width;
+		src.height = this->activeFormat.height;
+		auto valid = FillImageBuffer(src, reinterpret_cast<uint8_t*>(this->userBuffers[buf.index]), buf.bytesused, this->activeFormat.bytesperline);
+		if (valid && this->activeCropMode == CropMode::CROP_MODE_SOFTWARE) {
+			valid = CropImageBuffer(src, this->activeCrop.left, this->activeCrop.top, this->activeCrop.width, this->activeCrop.height);
+		}
+		if (valid) {
+			ImageBuffer dst = {0};
+			dst.format = this->outputFormat;
+			dst.width = src.width;
+			dst.height = src.height;
+			replySize = GetImageSize(dst.format, dst.width, dst.height);
+			reply = new uint8_t[replySize];
+			FillImageBuffer(dst, reply, replySize, 0);
+			bytesPerLine = dst.stride[0];
+			auto start = std::chrono::steady_clock::now();
+			if (ConvertImage(src, dst, this->GetRowBandPolicy()) != StatusCode::STATUS_CODE_SUCCESS) {
+				delete[] reply;
+				reply = nullptr;
+				replySize = 0;
+			} else {
+				RecordStageTiming(this->convertTiming, start);
+			}
+		}
+	} else if (buf.bytesused > 0 && this->activeCropMode == CropMode::CROP_MODE_SOFTWARE) {
+		// 仅拷贝裁剪区域
+		replySize = Becamv4l2CropHelper::GetSoftwareCropSize(this->activeFormat, this->activeCrop, bytesPerLine);
+		reply = new uint8_t[replySize];
+		auto src = reinterpret_cast<const uint8_t*>(this->userBuffers[buf.index]);
+		if (!Becamv4l2CropHelper::CopySoftwareCrop(src, buf.bytesused, this->activeFormat, this->activeCrop, reply)) {
+			delete[] reply;
+			reply = nullptr;
+			replySize = 0;
+		}
+	} else if (buf.bytesused > 0 && this->insertHuffmanTables && IsMjpegFormat(this->activeFormat.pixelformat)) {
+		// 拷贝帧的同时补齐霍夫曼表
+		auto src = reinterpret_cast<const uint8_t*>(this->userBuffers[buf.index]);
+		replySize = GetCompleteJpegSize(src, buf.bytesused);
+		reply = new uint8_t[replySize];
+		replySize = CopyCompleteJpeg(src, buf.bytesused, reply);
+	} else if (buf.bytesused > 0) {
 		// 拷贝帧
 		replySize = buf.bytesused;
 		reply = new uint8_t[replySize];
 		memcpy(reply, this->userBuffers[buf.index], replySize);
 	}
 
+	// 填充视频帧元数据
+	if (meta != nullptr) {
+		meta->format = this->IsOutputConverting() ? this->outputFormat : this->activeFormat.pixelformat;
+		meta->width = frameWidth;
+		meta->height = frameHeight;
+		meta->bytesPerLine = bytesPerLine;
+		meta->sequence = buf.sequence;
+		meta->timestamp = timestamp;
+		meta->cropMode = this->activeCropMode;
+		meta->crop = this->activeCrop;
+	}
+
+	// 在归还缓冲区前统计完整画面的亮度，按需调整曝光
+	if (buf.bytesused > 0) {
+		auto src = reinterpret_cast<const uint8_t*>(this->userBuffers[buf.index]);
+		this->exposureController.OnFrame(this->controlHelper, src, buf.bytesused, this->activeFormat);
+	}
+
 	// 重新将缓冲区加入队列（就是缓冲区解锁）
 	if (xioctl(this->activatedDevice, VIDIOC_QBUF, &buf) == -1) {
 		DEBUG_LOG("Becamv4l2DeviceHelper::GetFrame -> xioctl(VIDIOC_QBUF) Failed");
@@ -454,6 +1324,71 @@ StatusCode Becamv4l2DeviceHelper::GetFrame(uint8_t*& reply, size_t& replySize) {
 	return StatusCode::STATUS_CODE_SUCCESS;
 }
 
+/**
+ * @implements 实现经帧级并行解码流水线获取视频帧
+ */
+StatusCode Becamv4l2DeviceHelper::GetPipelinedFrame(uint8_t*& reply, size_t& replySize, VideoFrameMeta* meta) {
+	// 按需创建流水线
+	if (this->decodePipeline == nullptr) {
+		this->decodePipeline = CreateMjpegDecodePipeline(this->pipelineConfig.threadCount, this->pipelineConfig.maxInFlight);
+	}
+
+	// 补满在途窗口（每次至少从设备取一帧，输出节奏与设备一致）
+	do {
+		// 声明缓冲区队列查询参数
+		v4l2_buffer buf = {0};
+		buf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+		buf.memory = V4L2_MEMORY_MMAP;
+		// 消费队列中的缓冲区（就是缓冲区加锁）
+		if (xioctl(this->activatedDevice, VIDIOC_DQBUF, &buf) == -1) {
+			DEBUG_LOG("Becamv4l2DeviceHelper::GetPipelinedFrame -> xioctl(VIDIOC_DQBUF) Failed");
+			return StatusCode::STATUS_CODE_V4L2_ERR_LOCK_BUF;
+		}
+
+		// 记录视频帧用于校验实际帧率
+		auto timestamp = uint64_t(buf.timestamp.tv_sec) * 1000000 + uint64_t(buf.timestamp.tv_usec);
+		this->captureProfileHelper.OnFrame(buf.sequence, timestamp);
+
+		// 拷贝压缩数据后提交解码（宽高在解码完成后填充）
+		if (buf.bytesused > 0) {
+			VideoFrameMeta frameMeta = {0};
+			frameMeta.format = this->outputFormat;
+			frameMeta.sequence = buf.sequence;
+			frameMeta.timestamp = timestamp;
+			frameMeta.cropMode = this->activeCropMode;
+			frameMeta.crop = this->activeCrop;
+			auto src = reinterpret_cast<const uint8_t*>(this->userBuffers[buf.index]);
+			SubmitMjpegPipelineFrame(this->decodePipeline, src, buf.bytesused, this->outputFormat, this->decodeScale, frameMeta);
+		}
+
+		// 重新将缓冲区加入队列（就是缓冲区解锁）
+		if (xioctl(this->activatedDevice, VIDIOC_QBUF, &buf) == -1) {
+			DEBUG_LOG("Becamv4l2DeviceHelper::GetPipelinedFrame -> xioctl(VIDIOC_QBUF) Failed");
+			return StatusCode::STATUS_CODE_V4L2_ERR_UNLOCK_BUF;
+		}
+	} while (GetMjpegPipelineInFlight(this->decodePipeline) < this->pipelineConfig.maxInFlight);
+
+	// 按采集顺序取出最早的一帧
+	VideoFrameMeta frameMeta = {0};
+	auto code = ReceiveMjpegPipelineFrame(this->decodePipeline, reply, replySize, frameMeta);
+	// 解码后缩放（在取帧线程中进行）
+	if (code == StatusCode::STATUS_CODE_SUCCESS && reply != nullptr && this->IsOutputResizing()) {
+		this->ResizeDecodedFrame(reply, replySize, frameMeta.format, frameMeta.width, frameMeta.height, frameMeta.bytesPerLine);
+	}
+	if (meta != nullptr) {
+		*meta = frameMeta;
+	}
+	if (code != StatusCode::STATUS_CODE_SUCCESS || replySize <= 0) {
+		DEBUG_LOG("Becamv4l2DeviceHelper::GetPipelinedFrame -> ReceiveMjpegPipelineFrame Failed");
+		FreeFrame(reply);
+		replySize = 0;
+		return StatusCode::STATUS_CODE_ERR_GET_FRAME_EMPTY;
+	}
+
+	// OK
+	return StatusCode::STATUS_CODE_SUCCESS;
+}
+
 /**
  * @implements 实现释放已获取的视频帧
  */
@@ -1,14 +1,42 @@
 #pragma once
 
+#include "Becamv4l2CaptureProfileHelper.hpp"
+#include "Becamv4l2ControlHelper.hpp"
+#include "Becamv4l2ControlSnapshot.hpp"
+#include "Becamv4l2ExposureController.hpp"
 #include <becam/becam.h>
 #include <fcntl.h>
+#include <linux/videodev2.h>
 #include <mutex>
+#include <pkg/JpegMarker.hpp>
+#include <pkg/MjpegDecodePipeline.hpp>
+#include <pkg/MjpegDecoder.hpp>
+#include <pkg/StageTiming.hpp>
+#include <pkg/WorkerPool.hpp>
 #include <stddef.h>
 #include <string.h>
+#include <string>
+#include <vector>
 
 #ifndef _BECAMV4L2_DEVICE_HELPER_H_
 #define _BECAMV4L2_DEVICE_HELPER_H_
 
+/**
+ * @brief V4L2 设备枚举结果
+ */
+struct Becamv4l2DeviceEntry {
+	// 设备友好名称
+	std::string name;
+	// 设备路径
+	std::string devicePath;
+	// 设备稳定标识
+	std::string deviceId;
+	// 同一物理设备的其它节点路径
+	std::vector<std::string> siblingPaths;
+	// 总线信息（仅在打开节点查询能力时获取）
+	std::string busInfo;
+};
+
 /**
  * @brief V4L2 设备助手类
  */
@@ -26,7 +54,133 @@ private:
 	uint32_t userBufferLengths[Becamv4l2DeviceHelper::USER_BUFFER_COUNT] = {0};
 	// 是否已经开始取流
 	bool streamON = false;
+	// 已生效的视频帧格式（由驱动回写）
+	v4l2_pix_format activeFormat = {0};
+	// 期望的裁剪区域（宽高为0表示不裁剪，关闭设备后仍保留，下次激活取流时生效）
+	CropRect requestedCrop = {0};
+	// 已生效的裁剪区域
+	CropRect activeCrop = {0};
+	// 已生效的裁剪方式
+	CropMode activeCropMode = CropMode::CROP_MODE_NONE;
+	// 控制项助手（缓存控制项信息及取值，设备关闭时清空）
+	Becamv4l2ControlHelper controlHelper;
+	// 激活取流时恢复的控制项（设备关闭后仍保留，下次激活取流时生效）
+	std::vector<ControlValue> snapshotControls;
+	// 已生效的帧间隔（由驱动回写）
+	v4l2_fract activeTimePerFrame = {0};
+	// 低延迟采集配置助手（配置在设备关闭后仍保留，下次激活取流时生效）
+	Becamv4l2CaptureProfileHelper captureProfileHelper;
+	// 软件自动曝光控制器（配置在设备关闭后仍保留，下次激活取流时生效）
+	Becamv4l2ExposureController exposureController;
+	// 期望的输出格式（为0表示不转换，关闭设备后仍保留，下次激活取流时生效）
+	uint32_t outputFormat = 0;
+	// MJPEG解码缩放分母（关闭设备后仍保留）
+	uint32_t decodeScale = 1;
+	// MJPEG解码器（首次解码时创建，设备关闭时释放）
+	MjpegDecoder* mjpegDecoder = nullptr;
+	// 帧内分条并行解码线程数（1表示不切分，关闭设备后仍保留）
+	uint32_t stripThreads = 1;
+	// 帧级并行解码配置（关闭设备后仍保留）
+	DecodePipelineConfig pipelineConfig = {0};
+	// 帧级并行解码流水线（首次并行解码时创建，停止取流时释放）
+	MjpegDecodePipeline* decodePipeline = nullptr;
+	// 是否为直接输出的MJPEG视频帧补齐霍夫曼表（关闭设备后仍保留）
+	bool insertHuffmanTables = false;
+	// 输出缩放配置（宽高为0表示不缩放，关闭设备后仍保留）
+	ResizeConfig outputResize = {0};
+	// 缩放后再转换格式时的中间缓冲区（按需扩容）
+	std::vector<uint8_t> resizeBuffer;
+	// 单帧图像处理的并行策略（关闭设备后仍保留）
+	ParallelPolicy parallelPolicy = {0};
+	// 单帧图像处理的共享线程池（设置并行策略时创建，多帧之间复用，串行处理时为空）
+	WorkerPool* imagePool = nullptr;
+	// MJPEG解码耗时（开始取流时清零）
+	StageTimingRecord decodeTiming = {0};
+	// 缩放耗时（开始取流时清零）
+	StageTimingRecord resizeTiming = {0};
+	// 格式转换耗时（开始取流时清零）
+	StageTimingRecord convertTiming = {0};
+
+	/**
+	 * @brief 关闭当前设备
+	 */
+	void CloseCurrentDevice();
+
+	/**
+	 * @brief 停止当前设备取流
+	 */
+	void StopCurrentDeviceStreaming();
+
+	/**
+	 * @brief 从驱动回读当前设备已生效的视频帧格式
+	 */
+	void RefreshCurrentDeviceFormat();
+
+	/**
+	 * @brief 对当前设备应用期望的裁剪区域（优先设备裁剪，其次软件裁剪；可能改变输出格式，只能在申请缓冲区前调用）
+	 *
+	 * @return 状态码
+	 */
+	StatusCode ApplyCurrentDeviceCrop();
+
+	/**
+	 * @brief 取流过程中对当前设备应用期望的裁剪区域（只进行软件裁剪，缓冲区已按当前格式映射，不能改变设备裁剪）
+	 *
+	 * @return 状态码
+	 */
+	StatusCode ApplyStreamingSoftwareCrop();
+
+	/**
+	 * @brief 当前是否需要将视频帧转换为输出格式
+	 *
+	 * @return 是否需要转换
+	 */
+	bool IsOutputConverting() const;
+
+	/**
+	 * @brief 当前是否需要帧级并行解码
+	 *
+	 * @return 是否需要并行解码
+	 */
+	bool IsDecodePipelined() const;
+
+	/**
+	 * @brief 当前是否需要缩放视频帧
+	 *
+	 * @return 是否需要缩放
+	 */
+	bool IsOutputResizing() const;
+
+	/**
+	 * @brief 获取当前生效的行带并行策略
+	 *
+	 * @return 行带并行策略
+	 */
+	RowBandPolicy GetRowBandPolicy() const;
+
+	/**
+	 * @brief 缩放已解码的视频帧（替换为新分配的缩放结果，失败时释放视频帧）
+	 *
+	 * @param reply [in && out] 视频帧数据引用
+	 * @param replySize [in && out] 视频帧数据大小引用
+	 * @param format [in] 视频帧格式
+	 * @param width [in && out] 视频帧宽度
+	 * @param height [in && out] 视频帧高度
+	 * @param bytesPerLine [in && out] 视频帧每行字节数
+	 */
+	void ResizeDecodedFrame(uint8_t*& reply, size_t& replySize, const uint32_t format, uint32_t& width, uint32_t& height, uint32_t& bytesPerLine);
 
+	/**
+	 * @brief 经帧级并行解码流水线获取视频帧（补满在途窗口后按采集顺序取出最早的一帧）
+	 *
+	 * @param reply [out] 视频帧数据引用
+	 * @param replySize [out] 视频帧数据大小引用
+	 * @param meta [out] 视频帧元数据（可为空）
+	 * @return 状态码
+	 */
+	StatusCode GetPipelinedFrame(uint8_t*& reply, size_t& replySize, VideoFrameMeta* meta);
+
+public:
 	/**
 	 * @brief 处理设备名称
 	 *
@@ -40,30 +194,38 @@ private:
 	 *
 	 * @param devicePath [in] 设备路径
 	 * @param deviceName [out] 设备名称（仅在设备支持视频捕获能力时返回）
+	 * @param busInfo [out] 总线信息（可为空，仅在设备支持视频捕获能力时返回）
 	 * @return 是否支持视频捕获能力
 	 */
-	static bool IsVideoCaptureDevice(const std::string& devicePath, std::string& deviceName);
+	static bool IsVideoCaptureDevice(const std::string& devicePath, std::string& deviceName, std::string* busInfo = nullptr);
 
 	/**
-	 * @brief 关闭当前设备
+	 * @brief 构造函数
 	 */
-	void CloseCurrentDevice();
+	Becamv4l2DeviceHelper();
 
 	/**
-	 * @brief 停止当前设备取流
+	 * @brief 析构函数
 	 */
-	void StopCurrentDeviceStreaming();
+	~Becamv4l2DeviceHelper();
 
-public:
 	/**
-	 * @brief 构造函数
+	 * @brief 枚举支持视频捕获的设备
+	 *
+	 * @param devices [out] 设备列表
+	 * @param timedOut [out] 是否有设备节点探测超时（超时的节点不在设备列表中，可为空）
+	 * @return 状态码
 	 */
-	Becamv4l2DeviceHelper();
+	static StatusCode EnumDevices(std::vector<Becamv4l2DeviceEntry>& devices, bool* timedOut = nullptr);
 
 	/**
-	 * @brief 析构函数
+	 * @brief 将设备列表转换为响应数据
+	 *
+	 * @param devices [in] 设备列表
+	 * @param reply [out] 设备信息列表引用
+	 * @param replySize [out] 设备信息列表大小引用
 	 */
-	~Becamv4l2DeviceHelper();
+	static void BuildDeviceList(const std::vector<Becamv4l2DeviceEntry>& devices, DeviceInfo*& reply, size_t& replySize);
 
 	/**
 	 * @brief 获取设备列表
@@ -82,6 +244,16 @@ public:
 	 */
 	static void FreeDeviceList(DeviceInfo*& input, size_t& inputSize);
 
+	/**
+	 * @brief 在设备列表中查找稳定标识对应的设备路径
+	 *
+	 * @param devices [in] 设备列表
+	 * @param deviceId [in] 设备稳定标识
+	 * @param devicePath [out] 设备路径
+	 * @return 是否找到
+	 */
+	static bool FindDevicePath(const std::vector<Becamv4l2DeviceEntry>& devices, const std::string& deviceId, std::string& devicePath);
+
 	/**
 	 * @brief 激活指定设备
 	 *
@@ -108,6 +280,16 @@ public:
 	 */
 	static void FreeDeviceConfigList(VideoFrameInfo*& input, size_t& inputSize);
 
+	/**
+	 * @brief 协商当前设备的视频帧信息
+	 *
+	 * @param desired [in] 期望的视频帧信息（宽、高、帧率为最低要求）
+	 * @param policy [in] 协商策略（可为空）
+	 * @param chosen [out] 选中的视频帧信息
+	 * @return 状态码
+	 */
+	StatusCode NegotiateCurrentDeviceConfig(const VideoFrameInfo& desired, const NegotiatePolicy* policy, VideoFrameInfo& chosen);
+
 	/**
 	 * @brief 激活设备取流
 	 *
@@ -121,14 +303,187 @@ public:
 	 */
 	void CloseDevice();
 
+	/**
+	 * @brief 获取当前设备实际生效的视频帧格式
+	 *
+	 * @param format [out] 视频帧格式
+	 * @return 状态码
+	 */
+	StatusCode GetCurrentDeviceFormat(FrameFormat& format);
+
+	/**
+	 * @brief 设置裁剪区域（未取流时在下次激活取流时生效，取流过程中只进行软件裁剪）
+	 *
+	 * @param rect [in] 裁剪区域（宽高为0时取消裁剪）
+	 * @return 状态码
+	 */
+	StatusCode SetCropRect(const CropRect& rect);
+
+	/**
+	 * @brief 设置输出格式（未取流时在下次激活取流时生效）
+	 *
+	 * @param format [in] 输出格式（为0时取消转换）
+	 * @return 状态码
+	 */
+	StatusCode SetOutputFormat(const uint32_t format);
+
+	/**
+	 * @brief 设置输出缩放（未取流时在下次激活取流时生效）
+	 *
+	 * @param config [in] 缩放配置（为空或宽高为0时取消缩放）
+	 * @return 状态码
+	 */
+	StatusCode SetOutputResize(const ResizeConfig* config);
+
+	/**
+	 * @brief 设置MJPEG解码缩放比例（未取流时在下次激活取流时生效）
+	 *
+	 * @param scaleDenom [in] 缩放分母（1、2、4、8）
+	 * @return 状态码
+	 */
+	StatusCode SetDecodeScale(const uint32_t scaleDenom);
+
+	/**
+	 * @brief 设置帧内分条并行解码线程数（下一帧起生效）
+	 *
+	 * @param threadCount [in] 线程数（为0时取处理器核心数，为1时不切分）
+	 * @return 状态码
+	 */
+	StatusCode SetDecodeStripThreads(const uint32_t threadCount);
+
+	/**
+	 * @brief 设置帧级并行解码（取流过程中设置时丢弃在途的视频帧）
+	 *
+	 * @param config [in] 并行解码配置（为空时恢复串行解码）
+	 * @return 状态码
+	 */
+	StatusCode SetDecodePipeline(const DecodePipelineConfig* config);
+
+	/**
+	 * @brief 获取帧级并行解码状态
+	 *
+	 * @param state [out] 并行解码状态
+	 * @return 状态码
+	 */
+	StatusCode GetDecodePipelineState(DecodePipelineState& state);
+
+	/**
+	 * @brief 设置单帧图像处理的并行策略（下一帧起生效）
+	 *
+	 * @param policy [in] 并行策略（为空时恢复串行处理）
+	 * @return 状态码
+	 */
+	StatusCode SetParallelPolicy(const ParallelPolicy* policy);
+
+	/**
+	 * @brief 获取取帧线程中各处理阶段的耗时统计
+	 *
+	 * @param timings [out] 耗时统计
+	 * @return 状态码
+	 */
+	StatusCode GetStageTimings(StageTimings& timings);
+
+	/**
+	 * @brief 设置是否为直接输出的MJPEG视频帧补齐霍夫曼表（下一帧起生效）
+	 *
+	 * @param enable [in] 是否补齐
+	 * @return 状态码
+	 */
+	StatusCode SetInsertHuffmanTables(const bool enable);
+
+	/**
+	 * @brief 保存当前设备的控制项快照
+	 *
+	 * @param blob [out] 快照数据
+	 * @return 状态码
+	 */
+	StatusCode SaveCurrentDeviceControlSnapshot(std::vector<uint8_t>& blob);
+
+	/**
+	 * @brief 设置激活取流时恢复的控制项快照（取流过程中设置时立即写入）
+	 *
+	 * @param data [in] 快照数据（为空时取消）
+	 * @param size [in] 快照数据大小
+	 * @return 状态码
+	 */
+	StatusCode SetControlSnapshot(const uint8_t* data, const size_t size);
+
+	/**
+	 * @brief 设置低延迟采集配置（未取流时在下次激活取流时生效）
+	 *
+	 * @param profile [in] 采集配置（为空时取消）
+	 * @return 状态码
+	 */
+	StatusCode SetCaptureProfile(const CaptureProfile* profile);
+
+	/**
+	 * @brief 获取采集配置应用结果
+	 *
+	 * @param report [out] 应用结果
+	 * @return 状态码
+	 */
+	StatusCode GetCaptureProfileReport(CaptureProfileReport& report);
+
+	/**
+	 * @brief 设置软件自动曝光（未取流时在下次激活取流时生效）
+	 *
+	 * @param config [in] 自动曝光配置（为空时停止调节）
+	 * @return 状态码
+	 */
+	StatusCode SetAutoExposure(const AutoExposureConfig* config);
+
+	/**
+	 * @brief 获取软件自动曝光状态
+	 *
+	 * @param state [out] 自动曝光状态
+	 * @return 状态码
+	 */
+	StatusCode GetAutoExposureState(AutoExposureState& state);
+
+	/**
+	 * @brief 获取当前设备的控制项列表
+	 *
+	 * @param reply [out] 控制项信息列表引用
+	 * @param replySize [out] 控制项信息列表大小引用
+	 * @return 状态码
+	 */
+	StatusCode GetCurrentDeviceControlList(ControlInfo*& reply, size_t& replySize);
+
+	/**
+	 * @brief 释放控制项列表
+	 *
+	 * @param input [in && out] 控制项信息列表引用
+	 * @param inputSize [in && out] 控制项信息列表大小引用
+	 */
+	static void FreeControlList(ControlInfo*& input, size_t& inputSize);
+
+	/**
+	 * @brief 批量读取当前设备的控制项
+	 *
+	 * @param valueList [in && out] 控制项取值列表
+	 * @param valueListSize [in] 控制项数量
+	 * @return 状态码
+	 */
+	StatusCode GetCurrentDeviceControls(ControlValue* valueList, const size_t valueListSize);
+
+	/**
+	 * @brief 批量设置当前设备的控制项
+	 *
+	 * @param valueList [in] 控制项取值列表
+	 * @param valueListSize [in] 控制项数量
+	 * @return 状态码
+	 */
+	StatusCode SetCurrentDeviceControls(const ControlValue* valueList, const size_t valueListSize);
+
 	/**
 	 * @brief 获取视频帧
 	 *
 	 * @param reply [out] 视频帧数据引用
 	 * @param replySize [out] 视频帧数据大小引用
+	 * @param meta [out] 视频帧元数据（可为空）
 	 * @return 状态码
 	 */
-	StatusCode GetFrame(uint8_t*& reply, size_t& replySize);
+	StatusCode GetFrame(uint8_t*& reply, size_t& replySize, VideoFrameMeta* meta = nullptr);
 
 	/**
 	 * @brief 释放已获取的视频帧
@@ -0,0 +1,147 @@
+#include "Becamv4l2DeviceProber.hpp"
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <pkg/LogOutput.hpp>
+#include <system_error>
+#include <thread>
+
+/**
+ * @brief 单个设备节点的探测任务（探测线程与等待方共享，由最后一个持有者释放）
+ */
+struct Becamv4l2ProbeTask {
+	// 探测是否完成
+	bool finished = false;
+	// 是否支持视频捕获
+	bool capture = false;
+	// 设备名称
+	std::string name;
+	// 总线信息
+	std::string busInfo;
+};
+
+/**
+ * @brief 进行中的探测任务表
+ */
+struct Becamv4l2ProbeTable {
+	// 互斥锁（同时保护全部探测任务的结果）
+	std::mutex mtx;
+	// 探测完成通知
+	std::condition_variable cv;
+	// 设备路径 -> 进行中的探测任务
+	std::map<std::string, std::shared_ptr<Becamv4l2ProbeTask>> inflight;
+};
+
+/**
+ * @brief 获取进行中的探测任务表
+ *
+ * 分离的探测线程可能在进程退出时仍在运行，任务表不随静态对象析构释放
+ *
+ * @return 探测任务表
+ */
+static Becamv4l2ProbeTable& GetProbeTable() {
+	static auto table = new Becamv4l2ProbeTable();
+	return *table;
+}
+
+/**
+ * @brief 执行探测并记录结果
+ *
+ * @param devicePath [in] 设备路径
+ * @param task [in] 探测任务
+ */
+static void RunProbeTask(const std::string devicePath, const std::shared_ptr<Becamv4l2ProbeTask> task) {
+	std::string name, busInfo;
+	auto capture = Becamv4l2DeviceHelper::IsVideoCaptureDevice(devicePath, name, &busInfo);
+	// 加个锁先
+	auto& table = GetProbeTable();
+	std::unique_lock<std::mutex> lock(table.mtx);
+	task->finished = true;
+	task->capture = capture;
+	task->name = name;
+	task->busInfo = busInfo;
+	// 探测结束，后续调用重新发起探测
+	auto it = table.inflight.find(devicePath);
+	if (it != table.inflight.end() && it->second == task) {
+		table.inflight.erase(it);
+	}
+	table.cv.notify_all();
+}
+
+/**
+ * @implements 实现并行探测设备节点
+ */
+bool Becamv4l2DeviceProber::Probe(const std::vector<std::string>& devicePaths, std::vector<Becamv4l2DeviceEntry>& devices,
+								  const int timeoutMs) {
+	// 重置
+	devices.clear();
+
+	// 单个设备同样需要在独立线程中探测，避免卡死的设备阻塞调用方
+	if (devicePaths.empty()) {
+		return false;
+	}
+
+	// 复用进行中的探测，其余节点新建探测任务
+	auto& table = GetProbeTable();
+	std::vector<std::shared_ptr<Becamv4l2ProbeTask>> tasks(devicePaths.size());
+	std::vector<size_t> startIndexes;
+	{
+		// 加个锁先
+		std::unique_lock<std::mutex> lock(table.mtx);
+		for (size_t i = 0; i < devicePaths.size(); i++) {
+			auto it = table.inflight.find(devicePaths[i]);
+			if (it != table.inflight.end()) {
+				DEBUG_LOG("Becamv4l2DeviceProber::Probe -> " << devicePaths[i] << " Already In Flight, Wait");
+				tasks[i] = it->second;
+				continue;
+			}
+			tasks[i] = std::make_shared<Becamv4l2ProbeTask>();
+			table.inflight[devicePaths[i]] = tasks[i];
+			startIndexes.push_back(i);
+		}
+	}
+
+	// 每个新建任务一个探测线程
+	for (auto i : startIndexes) {
+		try {
+			std::thread(RunProbeTask, devicePaths[i], tasks[i]).detach();
+		} catch (const std::system_error&) {
+			// 无法创建线程时退化为在当前线程探测
+			DEBUG_LOG("Becamv4l2DeviceProber::Probe -> std::thread Failed, Probe " << devicePaths[i] << " Inline");
+			RunProbeTask(devicePaths[i], tasks[i]);
+		}
+	}
+
+	// 等待全部完成或超时
+	std::unique_lock<std::mutex> lock(table.mtx);
+	auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+	table.cv.wait_until(lock, deadline, [&]() {
+		for (auto& task : tasks) {
+			if (!task->finished) {
+				return false;
+			}
+		}
+		return true;
+	});
+
+	// 按输入顺序合并结果，保证输出稳定
+	bool timedOut = false;
+	for (size_t i = 0; i < devicePaths.size(); i++) {
+		auto& task = tasks[i];
+		if (!task->finished) {
+			DEBUG_LOG("Becamv4l2DeviceProber::Probe -> " << devicePaths[i] << " Timed Out");
+			timedOut = true;
+			continue;
+		}
+		if (task->capture) {
+			Becamv4l2DeviceEntry entry;
+			entry.name = task->name;
+			entry.busInfo = task->busInfo;
+			entry.devicePath = devicePaths[i];
+			devices.push_back(entry);
+		}
+	}
+	return timedOut;
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "Becamv4l2DeviceHelper.hpp"
+#include <string>
+#include <vector>
+
+#ifndef _BECAMV4L2_DEVICE_PROBER_H_
+#define _BECAMV4L2_DEVICE_PROBER_H_
+
+/**
+ * @brief V4L2 设备并行探测
+ *
+ * 每个设备节点在独立线程中探测，整体耗时取决于最慢的单个设备且不超过超时时间；
+ * 超时的探测线程会被分离，结束后自行释放资源。同一节点的探测结束前不会重复发起，
+ * 后续调用等待已有的探测，卡死的节点最多占用一个线程及一个句柄
+ */
+class Becamv4l2DeviceProber {
+public:
+	// 单个设备的探测超时时间（毫秒）
+	static constexpr int PROBE_TIMEOUT_MS = 1000;
+
+	/**
+	 * @brief 并行探测设备节点是否支持视频捕获
+	 *
+	 * @param devicePaths [in] 待探测的设备路径列表
+	 * @param devices [out] 支持视频捕获的设备列表（与输入顺序一致，超时的设备被跳过）
+	 * @param timeoutMs [in] 探测超时时间（毫秒）
+	 * @return 是否有设备探测超时（超时时结果不完整，不应缓存）
+	 */
+	static bool Probe(const std::vector<std::string>& devicePaths, std::vector<Becamv4l2DeviceEntry>& devices,
+					  const int timeoutMs = PROBE_TIMEOUT_MS);
+};
+
+#endif
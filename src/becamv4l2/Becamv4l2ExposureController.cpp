@@ -0,0 +1,328 @@
+#include "Becamv4l2ExposureController.hpp"
+#include <algorithm>
+#include <cmath>
+#include <pkg/LogOutput.hpp>
+#include <pkg/LumaHistogram.hpp>
+#include <vector>
+
+/**
+ * @implements 实现将取值按范围及步长修正
+ */
+int64_t Becamv4l2ExposureController::Clamp(const int64_t value, const int64_t minimum, const int64_t maximum, const int64_t step) {
+	auto result = value;
+	if (result > maximum) {
+		result = maximum;
+	}
+	if (result < minimum) {
+		result = minimum;
+	}
+	if (step > 1) {
+		result = minimum + (result - minimum) / step * step;
+	}
+	return result;
+}
+
+/**
+ * @implements 实现增益对应的亮度倍数
+ */
+double Becamv4l2ExposureController::GainToMultiplier(const int64_t gain) const {
+	if (!this->range.hasGain || this->range.gainMax <= this->range.gainMin) {
+		return 1.0;
+	}
+	return 1.0 + double(gain - this->range.gainMin) / double(this->range.gainMax - this->range.gainMin) * (GAIN_RANGE_MULTIPLIER - 1.0);
+}
+
+/**
+ * @implements 实现亮度倍数对应的增益
+ */
+int64_t Becamv4l2ExposureController::MultiplierToGain(const double multiplier) const {
+	if (!this->range.hasGain || this->range.gainMax <= this->range.gainMin) {
+		return this->state.gain;
+	}
+	auto& range = this->range;
+	auto gain = range.gainMin + std::llround((multiplier - 1.0) / (GAIN_RANGE_MULTIPLIER - 1.0) * double(range.gainMax - range.gainMin));
+	return Becamv4l2ExposureController::Clamp(gain, range.gainMin, range.gainMax, range.gainStep);
+}
+
+/**
+ * @implements 实现按亮度比例计算新的曝光时间及增益
+ */
+void Becamv4l2ExposureController::Plan(const double ratio, int64_t& exposureTime, int64_t& gain) const {
+	exposureTime = this->state.exposureTime;
+	gain = this->state.gain;
+	auto& range = this->range;
+	if (ratio > 1.0) {
+		// 变亮：优先延长曝光（噪声更小），到达上限后再提高增益
+		auto desired = double(exposureTime) * ratio;
+		if (desired <= double(range.exposureMax)) {
+			exposureTime = std::llround(desired);
+		} else {
+			auto residual = desired / double(std::max<int64_t>(range.exposureMax, 1));
+			exposureTime = range.exposureMax;
+			gain = this->MultiplierToGain(this->GainToMultiplier(gain) * residual);
+		}
+		exposureTime = Becamv4l2ExposureController::Clamp(exposureTime, range.exposureMin, range.exposureMax, range.exposureStep);
+		// 按步长取整后没有变化时至少前进一个步长（先曝光后增益）
+		if (exposureTime == int64_t(this->state.exposureTime) && gain == this->state.gain) {
+			auto longer = Becamv4l2ExposureController::Clamp(exposureTime + range.exposureStep, range.exposureMin, range.exposureMax,
+															  range.exposureStep);
+			if (longer > exposureTime) {
+				exposureTime = longer;
+			} else if (range.hasGain) {
+				gain = Becamv4l2ExposureController::Clamp(gain + range.gainStep, range.gainMin, range.gainMax, range.gainStep);
+			}
+		}
+	} else {
+		// 变暗：优先降低增益，降到最低后再缩短曝光
+		auto desired = this->GainToMultiplier(gain) * ratio;
+		if (range.hasGain && desired >= 1.0) {
+			gain = this->MultiplierToGain(desired);
+		} else {
+			// 不支持增益时倍数恒为1，剩余比例即为曝光比例
+			gain = range.hasGain ? range.gainMin : gain;
+			exposureTime = std::llround(double(exposureTime) * desired);
+		}
+		exposureTime = Becamv4l2ExposureController::Clamp(exposureTime, range.exposureMin, range.exposureMax, range.exposureStep);
+		// 按步长取整后没有变化时至少后退一个步长（先增益后曝光）
+		if (exposureTime == int64_t(this->state.exposureTime) && gain == this->state.gain) {
+			if (range.hasGain && gain > range.gainMin) {
+				gain = Becamv4l2ExposureController::Clamp(gain - range.gainStep, range.gainMin, range.gainMax, range.gainStep);
+			} else {
+				exposureTime = Becamv4l2ExposureController::Clamp(exposureTime - range.exposureStep, range.exposureMin, range.exposureMax,
+																  range.exposureStep);
+			}
+		}
+	}
+}
+
+/**
+ * @implements 实现设置自动曝光配置
+ */
+void Becamv4l2ExposureController::SetConfig(const AutoExposureConfig* input) {
+	this->enabled = input != nullptr;
+	this->config = input != nullptr ? *input : AutoExposureConfig{};
+	// 补全默认值
+	if (this->config.targetLow == 0 && this->config.targetHigh == 0) {
+		this->config.targetLow = DEFAULT_TARGET_LOW;
+		this->config.targetHigh = DEFAULT_TARGET_HIGH;
+	}
+	if (this->config.targetHigh < this->config.targetLow) {
+		this->config.targetHigh = this->config.targetLow;
+	}
+	if (this->config.sampleStep == 0) {
+		this->config.sampleStep = DEFAULT_SAMPLE_STEP;
+	}
+	if (this->config.settleFrames == 0) {
+		this->config.settleFrames = DEFAULT_SETTLE_FRAMES;
+	}
+	// 停止调节
+	if (!this->enabled) {
+		this->state.active = 0;
+	}
+}
+
+/**
+ * @implements 实现是否启用了自动曝光
+ */
+bool Becamv4l2ExposureController::IsEnabled() const {
+	return this->enabled;
+}
+
+/**
+ * @implements 实现对当前设备开始自动曝光
+ */
+void Becamv4l2ExposureController::Start(Becamv4l2ControlHelper& controlHelper, const v4l2_fract& timePerFrame) {
+	// 重置状态
+	this->state = {};
+	this->settleCountdown = 0;
+	if (!this->enabled) {
+		return;
+	}
+
+	// 切换为手动曝光，并禁止设备为延长曝光而降低帧率
+	Becamv4l2ControlEntry entry;
+	std::vector<ControlValue> modes;
+	if (controlHelper.GetControlEntry(V4L2_CID_EXPOSURE_AUTO, entry)) {
+		modes.push_back({V4L2_CID_EXPOSURE_AUTO, V4L2_EXPOSURE_MANUAL});
+	}
+	if (controlHelper.GetControlEntry(V4L2_CID_EXPOSURE_AUTO_PRIORITY, entry)) {
+		modes.push_back({V4L2_CID_EXPOSURE_AUTO_PRIORITY, 0});
+	}
+	if (controlHelper.SetControls(modes.data(), modes.size()) != StatusCode::STATUS_CODE_SUCCESS) {
+		DEBUG_LOG("Becamv4l2ExposureController::Start -> switch to manual exposure failed");
+		return;
+	}
+
+	// 曝光时间范围
+	Becamv4l2ExposureRange input;
+	if (!controlHelper.GetControlEntry(V4L2_CID_EXPOSURE_ABSOLUTE, entry) || (entry.info.flags & ControlFlag::CONTROL_FLAG_READ_ONLY)) {
+		DEBUG_LOG("Becamv4l2ExposureController::Start -> V4L2_CID_EXPOSURE_ABSOLUTE not supported");
+		return;
+	}
+	input.exposureMin = entry.info.minimum;
+	input.exposureMax = entry.info.maximum;
+	input.exposureStep = entry.info.step;
+
+	// 增益（可选）
+	input.hasGain = controlHelper.GetControlEntry(V4L2_CID_GAIN, entry) && !(entry.info.flags & ControlFlag::CONTROL_FLAG_READ_ONLY);
+	if (input.hasGain) {
+		input.gainMin = entry.info.minimum;
+		input.gainMax = entry.info.maximum;
+		input.gainStep = entry.info.step;
+	}
+
+	// 读取当前值，修正到允许范围内后写回
+	ControlValue values[2] = {{V4L2_CID_EXPOSURE_ABSOLUTE, 0}, {V4L2_CID_GAIN, 0}};
+	if (controlHelper.GetControls(values, input.hasGain ? 2 : 1) != StatusCode::STATUS_CODE_SUCCESS) {
+		DEBUG_LOG("Becamv4l2ExposureController::Start -> GetControls failed");
+		return;
+	}
+	this->Start(input, timePerFrame, values[0].value, values[1].value);
+	if (controlHelper.SetControls(values, input.hasGain ? 2 : 1) != StatusCode::STATUS_CODE_SUCCESS) {
+		DEBUG_LOG("Becamv4l2ExposureController::Start -> SetControls failed");
+		this->state.active = 0;
+	}
+}
+
+/**
+ * @implements 实现按调节范围及当前值开始自动曝光
+ */
+void Becamv4l2ExposureController::Start(const Becamv4l2ExposureRange& input, const v4l2_fract& timePerFrame, int64_t& exposureTime,
+										int64_t& gain) {
+	// 重置状态
+	this->state = {};
+	this->settleCountdown = 0;
+	if (!this->enabled) {
+		return;
+	}
+
+	// 曝光时间上限不超过帧间隔（单位均为100微秒）
+	this->range = input;
+	this->range.exposureStep = std::max<int64_t>(input.exposureStep, 1);
+	this->range.gainStep = std::max<int64_t>(input.gainStep, 1);
+	if (timePerFrame.denominator > 0) {
+		auto frameInterval = int64_t(timePerFrame.numerator) * 10000 / timePerFrame.denominator;
+		this->range.exposureMax = std::min(this->range.exposureMax, frameInterval);
+	}
+	if (this->config.maxExposureTime > 0) {
+		this->range.exposureMax = std::min<int64_t>(this->range.exposureMax, this->config.maxExposureTime);
+	}
+	this->range.exposureMax = std::max(this->range.exposureMax, this->range.exposureMin);
+	if (this->range.hasGain && this->config.maxGain > 0) {
+		this->range.gainMax = std::max(std::min(this->range.gainMax, this->config.maxGain), this->range.gainMin);
+	}
+
+	// 当前值修正到允许范围内
+	auto& range = this->range;
+	exposureTime = Becamv4l2ExposureController::Clamp(exposureTime, range.exposureMin, range.exposureMax, range.exposureStep);
+	gain = range.hasGain ? Becamv4l2ExposureController::Clamp(gain, range.gainMin, range.gainMax, range.gainStep) : 0;
+	this->state.exposureTime = uint32_t(exposureTime);
+	this->state.gain = gain;
+	this->state.active = 1;
+	this->settleCountdown = this->config.settleFrames;
+}
+
+/**
+ * @implements 实现根据亮度直方图计算新的曝光时间及增益
+ */
+bool Becamv4l2ExposureController::Update(const LumaHistogram& histogram, int64_t& exposureTime, int64_t& gain) {
+	exposureTime = this->state.exposureTime;
+	gain = this->state.gain;
+	if (!this->enabled || this->state.active == 0 || histogram.sampleCount == 0) {
+		return false;
+	}
+	auto mean = uint32_t(histogram.sum / histogram.sampleCount);
+	this->state.meanLuma = mean;
+
+	// 等待上次调整生效
+	if (this->settleCountdown > 0) {
+		this->settleCountdown--;
+		return false;
+	}
+
+	// 亮度在目标范围内且没有明显过曝时不调整
+	uint32_t highlights = 0;
+	for (uint32_t i = HIGHLIGHT_LEVEL; i < 256; i++) {
+		highlights += histogram.bins[i];
+	}
+	auto overexposed = uint64_t(highlights) * 100 > uint64_t(histogram.sampleCount) * HIGHLIGHT_PERCENT_LIMIT;
+	if (mean >= this->config.targetLow && mean <= this->config.targetHigh && !overexposed) {
+		return false;
+	}
+
+	// 以目标范围中点为目标，开方阻尼避免来回振荡
+	auto target = double(this->config.targetLow + this->config.targetHigh) / 2.0;
+	auto ratio = target / double(std::max<uint32_t>(mean, 1));
+	if (overexposed && ratio > 0.9) {
+		ratio = 0.9;
+	}
+	ratio = std::sqrt(std::min(std::max(ratio, 0.25), 4.0));
+
+	// 计算新的曝光时间及增益（已到达调节范围的边界时无需写入）
+	this->Plan(ratio, exposureTime, gain);
+	return exposureTime != int64_t(this->state.exposureTime) || (this->range.hasGain && gain != this->state.gain);
+}
+
+/**
+ * @implements 实现记录写入设备的结果
+ */
+void Becamv4l2ExposureController::Commit(const bool success, const int64_t exposureTime, const int64_t gain) {
+	// 写入失败时同样等待，避免每帧重复写入
+	this->settleCountdown = this->config.settleFrames;
+	if (!success) {
+		return;
+	}
+	this->state.exposureTime = uint32_t(exposureTime);
+	this->state.gain = this->range.hasGain ? gain : 0;
+	this->state.adjustCount++;
+}
+
+/**
+ * @implements 实现根据视频帧亮度调整曝光
+ */
+void Becamv4l2ExposureController::OnFrame(Becamv4l2ControlHelper& controlHelper, const uint8_t* data, const size_t size,
+										  const v4l2_pix_format& format) {
+	if (!this->enabled || this->state.active == 0) {
+		return;
+	}
+
+	// 统计亮度（压缩格式无法统计，停止调节）
+	uint32_t offset = 0;
+	uint32_t pitch = 0;
+	if (!GetLumaLayout(format.pixelformat, offset, pitch)) {
+		DEBUG_LOG("Becamv4l2ExposureController::OnFrame -> unsupported format: " << format.pixelformat);
+		this->state.active = 0;
+		return;
+	}
+	LumaHistogram histogram;
+	if (!ComputeLumaHistogram(data, size, format.pixelformat, format.width, format.height, format.bytesperline, this->config.sampleStep,
+							  histogram, this->histogramScratch, GetSimdLevel())) {
+		return;
+	}
+
+	// 计算并写入新的曝光时间及增益
+	int64_t exposureTime = 0;
+	int64_t gain = 0;
+	if (!this->Update(histogram, exposureTime, gain)) {
+		return;
+	}
+	std::vector<ControlValue> values;
+	if (exposureTime != int64_t(this->state.exposureTime)) {
+		values.push_back({V4L2_CID_EXPOSURE_ABSOLUTE, exposureTime});
+	}
+	if (this->range.hasGain && gain != this->state.gain) {
+		values.push_back({V4L2_CID_GAIN, gain});
+	}
+	auto success = controlHelper.SetControls(values.data(), values.size()) == StatusCode::STATUS_CODE_SUCCESS;
+	if (!success) {
+		DEBUG_LOG("Becamv4l2ExposureController::OnFrame -> SetControls failed");
+	}
+	this->Commit(success, exposureTime, gain);
+}
+
+/**
+ * @implements 实现获取自动曝光状态
+ */
+void Becamv4l2ExposureController::GetState(AutoExposureState& output) const {
+	output = this->state;
+}
@@ -0,0 +1,156 @@
+#pragma once
+
+#include "Becamv4l2ControlHelper.hpp"
+#include <becam/becam.h>
+#include <linux/videodev2.h>
+#include <pkg/LumaHistogram.hpp>
+
+#ifndef _BECAMV4L2_EXPOSURE_CONTROLLER_H_
+#define _BECAMV4L2_EXPOSURE_CONTROLLER_H_
+
+/**
+ * @brief 自动曝光的调节范围（取自设备控制项）
+ */
+struct Becamv4l2ExposureRange {
+	// 曝光时间范围及步长（单位100微秒）
+	int64_t exposureMin = 0;
+	int64_t exposureMax = 0;
+	int64_t exposureStep = 1;
+	// 设备是否支持调整增益
+	bool hasGain = false;
+	// 增益范围及步长
+	int64_t gainMin = 0;
+	int64_t gainMax = 0;
+	int64_t gainStep = 1;
+};
+
+/**
+ * @brief V4L2 软件自动曝光控制器
+ *
+ * 设备固件自动曝光收敛慢且常以降低帧率换取曝光，改为由Becam统计每帧的亮度直方图，
+ * 在帧间隔以内调整曝光时间，不足部分再由增益补偿；
+ * 本身不加锁，由持有设备句柄的调用方保证互斥
+ */
+class Becamv4l2ExposureController {
+private:
+	// 默认目标平均亮度下限
+	static const uint32_t DEFAULT_TARGET_LOW = 100;
+	// 默认目标平均亮度上限
+	static const uint32_t DEFAULT_TARGET_HIGH = 140;
+	// 默认采样步长
+	static const uint32_t DEFAULT_SAMPLE_STEP = 4;
+	// 默认每次调整后等待生效的帧数（UVC设备通常在2~3帧后生效）
+	static const uint32_t DEFAULT_SETTLE_FRAMES = 3;
+	// 视为过曝的亮度级别
+	static const uint32_t HIGHLIGHT_LEVEL = 250;
+	// 过曝采样占比上限（百分比）
+	static const uint32_t HIGHLIGHT_PERCENT_LIMIT = 5;
+	// 增益范围对应的亮度倍数（UVC未规定增益单位，按线性估算，闭环调节可吸收误差）
+	static constexpr double GAIN_RANGE_MULTIPLIER = 8.0;
+
+	// 是否启用
+	bool enabled = false;
+	// 自动曝光配置（设备关闭后仍保留，下次激活取流时生效）
+	AutoExposureConfig config = {};
+	// 自动曝光状态
+	AutoExposureState state = {};
+	// 调节范围（曝光时间上限已按帧间隔修正）
+	Becamv4l2ExposureRange range;
+	// 距离下次允许调整的帧数
+	uint32_t settleCountdown = 0;
+	// 亮度直方图统计的临时缓冲（每帧复用）
+	LumaHistogramScratch histogramScratch;
+
+	/**
+	 * @brief 将取值按范围及步长修正
+	 */
+	static int64_t Clamp(const int64_t value, const int64_t minimum, const int64_t maximum, const int64_t step);
+
+	/**
+	 * @brief 增益对应的亮度倍数
+	 */
+	double GainToMultiplier(const int64_t gain) const;
+
+	/**
+	 * @brief 亮度倍数对应的增益
+	 */
+	int64_t MultiplierToGain(const double multiplier) const;
+
+	/**
+	 * @brief 按亮度比例计算新的曝光时间及增益
+	 *
+	 * @param ratio [in] 期望亮度与当前亮度的比例
+	 * @param exposureTime [out] 新的曝光时间
+	 * @param gain [out] 新的增益
+	 */
+	void Plan(const double ratio, int64_t& exposureTime, int64_t& gain) const;
+
+public:
+	/**
+	 * @brief 设置自动曝光配置
+	 *
+	 * @param input [in] 自动曝光配置（为空时停止调节）
+	 */
+	void SetConfig(const AutoExposureConfig* input);
+
+	/**
+	 * @brief 是否启用了自动曝光
+	 */
+	bool IsEnabled() const;
+
+	/**
+	 * @brief 对当前设备开始自动曝光（切换为手动曝光并读取当前曝光时间及增益）
+	 *
+	 * @param controlHelper [in] 当前设备的控制项助手
+	 * @param timePerFrame [in] 驱动实际生效的帧间隔
+	 */
+	void Start(Becamv4l2ControlHelper& controlHelper, const v4l2_fract& timePerFrame);
+
+	/**
+	 * @brief 按调节范围及当前值开始自动曝光（不访问设备，由上面的Start读取设备后调用）
+	 *
+	 * @param input [in] 设备控制项的调节范围（曝光时间上限再按帧间隔及配置修正）
+	 * @param timePerFrame [in] 驱动实际生效的帧间隔
+	 * @param exposureTime [in && out] 当前曝光时间（修正到允许范围内）
+	 * @param gain [in && out] 当前增益（修正到允许范围内）
+	 */
+	void Start(const Becamv4l2ExposureRange& input, const v4l2_fract& timePerFrame, int64_t& exposureTime, int64_t& gain);
+
+	/**
+	 * @brief 根据亮度直方图计算新的曝光时间及增益（不访问设备）
+	 *
+	 * @param histogram [in] 视频帧的亮度直方图
+	 * @param exposureTime [out] 新的曝光时间
+	 * @param gain [out] 新的增益
+	 * @return 是否需要写入设备（写入后调用Commit）
+	 */
+	bool Update(const LumaHistogram& histogram, int64_t& exposureTime, int64_t& gain);
+
+	/**
+	 * @brief 记录写入设备的结果
+	 *
+	 * @param success [in] 是否写入成功
+	 * @param exposureTime [in] 写入的曝光时间
+	 * @param gain [in] 写入的增益
+	 */
+	void Commit(const bool success, const int64_t exposureTime, const int64_t gain);
+
+	/**
+	 * @brief 根据视频帧亮度调整曝光
+	 *
+	 * @param controlHelper [in] 当前设备的控制项助手
+	 * @param data [in] 视频帧数据
+	 * @param size [in] 视频帧数据大小
+	 * @param format [in] 视频帧格式
+	 */
+	void OnFrame(Becamv4l2ControlHelper& controlHelper, const uint8_t* data, const size_t size, const v4l2_pix_format& format);
+
+	/**
+	 * @brief 获取自动曝光状态
+	 *
+	 * @param output [out] 自动曝光状态
+	 */
+	void GetState(AutoExposureState& output) const;
+};
+
+#endif
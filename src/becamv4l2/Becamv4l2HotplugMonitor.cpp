@@ -0,0 +1,377 @@
+#include "Becamv4l2HotplugMonitor.hpp"
+#include <arpa/inet.h>
+#include <errno.h>
+#include <linux/netlink.h>
+#include <pkg/LogOutput.hpp>
+#include <poll.h>
+#include <string.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+/**
+ * @implements 实现析构函数
+ */
+Becamv4l2HotplugMonitor::~Becamv4l2HotplugMonitor() {
+	this->Stop();
+}
+
+/**
+ * @implements 实现打开netlink uevent套接字
+ */
+int Becamv4l2HotplugMonitor::OpenNetlinkSource(const Becamv4l2UeventSource source) {
+	int fd = socket(AF_NETLINK, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, NETLINK_KOBJECT_UEVENT);
+	if (fd == -1) {
+		DEBUG_LOG("Becamv4l2HotplugMonitor::OpenNetlinkSource -> socket(NETLINK_KOBJECT_UEVENT) Failed");
+		return -1;
+	}
+	// udev广播由用户态进程发出，需接收发送方凭据以校验来源
+	if (source == Becamv4l2UeventSource::UDEV) {
+		int enable = 1;
+		if (setsockopt(fd, SOL_SOCKET, SO_PASSCRED, &enable, sizeof(enable)) == -1) {
+			DEBUG_LOG("Becamv4l2HotplugMonitor::OpenNetlinkSource -> setsockopt(SO_PASSCRED) Failed");
+			close(fd);
+			return -1;
+		}
+	}
+	// 订阅广播组，端口号由内核分配
+	sockaddr_nl addr;
+	memset(&addr, 0, sizeof(addr));
+	addr.nl_family = AF_NETLINK;
+	addr.nl_groups = uint32_t(source);
+	if (bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == -1) {
+		DEBUG_LOG("Becamv4l2HotplugMonitor::OpenNetlinkSource -> bind() Failed");
+		close(fd);
+		return -1;
+	}
+	return fd;
+}
+
+/**
+ * @implements 实现打开inotify句柄
+ */
+int Becamv4l2HotplugMonitor::OpenInotifySource() {
+	int fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	if (fd == -1) {
+		DEBUG_LOG("Becamv4l2HotplugMonitor::OpenInotifySource -> inotify_init1() Failed");
+		return -1;
+	}
+	if (inotify_add_watch(fd, "/dev", IN_CREATE | IN_ATTRIB | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO) == -1) {
+		DEBUG_LOG("Becamv4l2HotplugMonitor::OpenInotifySource -> inotify_add_watch(/dev) Failed");
+		close(fd);
+		return -1;
+	}
+	return fd;
+}
+
+/**
+ * @implements 实现开始监听
+ */
+StatusCode Becamv4l2HotplugMonitor::Start(const Becamv4l2HotplugListener& listener) {
+	// 加个锁先
+	std::unique_lock<std::mutex> lock(this->mtx);
+
+	// 已在监听时先停止
+	this->StopLocked();
+
+	// 优先使用netlink，不可用时（如受限的网络命名空间）退化为inotify
+	// 运行udev时（与libudev相同，以其控制套接字是否存在判断）只有udev转发的事件保证设备节点已可访问
+	this->sourceIsNetlink = true;
+	this->ueventSource = access("/run/udev/control", F_OK) == 0 ? Becamv4l2UeventSource::UDEV : Becamv4l2UeventSource::KERNEL;
+	this->sourceFd = OpenNetlinkSource(this->ueventSource);
+	if (this->sourceFd == -1) {
+		this->sourceIsNetlink = false;
+		this->sourceFd = OpenInotifySource();
+	}
+	if (this->sourceFd == -1) {
+		return StatusCode::STATUS_CODE_V4L2_ERR_HOTPLUG;
+	}
+	this->wakeupFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+	if (this->wakeupFd == -1) {
+		DEBUG_LOG("Becamv4l2HotplugMonitor::Start -> eventfd() Failed");
+		close(this->sourceFd);
+		this->sourceFd = -1;
+		return StatusCode::STATUS_CODE_V4L2_ERR_HOTPLUG;
+	}
+
+	// 启动监听线程
+	this->listener = listener;
+	this->worker = std::thread(&Becamv4l2HotplugMonitor::Run, this);
+	return StatusCode::STATUS_CODE_SUCCESS;
+}
+
+/**
+ * @implements 实现停止监听
+ */
+void Becamv4l2HotplugMonitor::Stop() {
+	// 加个锁先
+	std::unique_lock<std::mutex> lock(this->mtx);
+	// 执行停止
+	this->StopLocked();
+}
+
+/**
+ * @implements 实现只设置事件监听函数
+ */
+bool Becamv4l2HotplugMonitor::SetListener(const Becamv4l2HotplugListener& listener, const Becamv4l2UeventSource source) {
+	// 加个锁先
+	std::unique_lock<std::mutex> lock(this->mtx);
+	// 监听线程运行时会并发调用监听函数
+	if (this->worker.joinable()) {
+		return false;
+	}
+	this->listener = listener;
+	this->ueventSource = source;
+	return true;
+}
+
+/**
+ * @implements 实现停止监听（调用方需持有锁）
+ */
+void Becamv4l2HotplugMonitor::StopLocked() {
+	// 唤醒监听线程并等待其退出
+	if (this->worker.joinable()) {
+		uint64_t value = 1;
+		if (write(this->wakeupFd, &value, sizeof(value)) != sizeof(value)) {
+			DEBUG_LOG("Becamv4l2HotplugMonitor::StopLocked -> write(eventfd) Failed");
+		}
+		this->worker.join();
+	}
+	if (this->wakeupFd != -1) {
+		close(this->wakeupFd);
+		this->wakeupFd = -1;
+	}
+	if (this->sourceFd != -1) {
+		close(this->sourceFd);
+		this->sourceFd = -1;
+	}
+	this->listener = nullptr;
+	this->pendingAdds.clear();
+}
+
+/**
+ * @implements 实现监听线程主循环
+ */
+void Becamv4l2HotplugMonitor::Run() {
+	pollfd fds[2];
+	fds[0].fd = this->sourceFd;
+	fds[0].events = POLLIN;
+	fds[1].fd = this->wakeupFd;
+	fds[1].events = POLLIN;
+	while (true) {
+		fds[0].revents = 0;
+		fds[1].revents = 0;
+		if (poll(fds, 2, -1) == -1) {
+			if (errno == EINTR) {
+				continue;
+			}
+			DEBUG_LOG("Becamv4l2HotplugMonitor::Run -> poll() Failed");
+			return;
+		}
+		// 收到退出信号
+		if (fds[1].revents != 0) {
+			return;
+		}
+		if (fds[0].revents & (POLLERR | POLLHUP | POLLNVAL)) {
+			DEBUG_LOG("Becamv4l2HotplugMonitor::Run -> Event Source Closed");
+			return;
+		}
+		if (fds[0].revents & POLLIN) {
+			if (this->sourceIsNetlink) {
+				this->ReadNetlink();
+			} else {
+				this->ReadInotify();
+			}
+		}
+	}
+}
+
+/**
+ * @implements 实现读取并分发netlink消息
+ */
+void Becamv4l2HotplugMonitor::ReadNetlink() {
+	char buffer[8192];
+	while (true) {
+		// 记录发送方及其凭据
+		sockaddr_nl sender;
+		memset(&sender, 0, sizeof(sender));
+		iovec iov = {buffer, sizeof(buffer)};
+		alignas(cmsghdr) char control[CMSG_SPACE(sizeof(ucred))];
+		msghdr msg;
+		memset(&msg, 0, sizeof(msg));
+		msg.msg_name = &sender;
+		msg.msg_namelen = sizeof(sender);
+		msg.msg_iov = &iov;
+		msg.msg_iovlen = 1;
+		msg.msg_control = control;
+		msg.msg_controllen = sizeof(control);
+		auto length = recvmsg(this->sourceFd, &msg, 0);
+		if (length <= 0) {
+			// 无更多消息（EAGAIN）或接收缓冲区溢出（ENOBUFS，丢失的事件无法恢复）
+			if (length == -1 && errno == ENOBUFS) {
+				DEBUG_LOG("Becamv4l2HotplugMonitor::ReadNetlink -> recvmsg() Overflow");
+				continue;
+			}
+			return;
+		}
+		if (msg.msg_flags & MSG_TRUNC) {
+			continue;
+		}
+		if (this->ueventSource == Becamv4l2UeventSource::KERNEL) {
+			// 内核消息的端口号为0
+			if (sender.nl_pid != 0) {
+				continue;
+			}
+		} else {
+			// udev消息来自以root运行的udevd
+			auto cmsg = CMSG_FIRSTHDR(&msg);
+			if (sender.nl_pid == 0 || cmsg == nullptr || cmsg->cmsg_level != SOL_SOCKET || cmsg->cmsg_type != SCM_CREDENTIALS) {
+				continue;
+			}
+			ucred cred;
+			memcpy(&cred, CMSG_DATA(cmsg), sizeof(cred));
+			if (cred.uid != 0) {
+				continue;
+			}
+		}
+		this->Dispatch(buffer, size_t(length));
+	}
+}
+
+/**
+ * @implements 实现读取并分发inotify事件
+ */
+void Becamv4l2HotplugMonitor::ReadInotify() {
+	// 按inotify事件的对齐要求声明缓冲区
+	alignas(inotify_event) char buffer[4096];
+	while (true) {
+		auto length = read(this->sourceFd, buffer, sizeof(buffer));
+		if (length <= 0) {
+			// 无更多事件（EAGAIN）
+			return;
+		}
+		for (ssize_t offset = 0; offset < length;) {
+			auto event = reinterpret_cast<const inotify_event*>(buffer + offset);
+			offset += sizeof(inotify_event) + event->len;
+			if (event->len == 0 || strncmp(event->name, "video", 5) != 0) {
+				continue;
+			}
+			auto devicePath = std::string("/dev/") + event->name;
+			auto action = HotplugAction::HOTPLUG_ACTION_REMOVE;
+			if (event->mask & (IN_CREATE | IN_MOVED_TO | IN_ATTRIB)) {
+				// 节点创建后udev才设置权限，可访问后再通知接入
+				if (event->mask & IN_ATTRIB && this->pendingAdds.count(devicePath) == 0) {
+					continue;
+				}
+				if (access(devicePath.c_str(), R_OK | W_OK) != 0) {
+					this->pendingAdds.insert(devicePath);
+					continue;
+				}
+				this->pendingAdds.erase(devicePath);
+				action = HotplugAction::HOTPLUG_ACTION_ADD;
+			} else if (this->pendingAdds.erase(devicePath) > 0) {
+				// 未通知接入的节点被移除时不通知
+				continue;
+			}
+			if (this->listener) {
+				this->listener(action, devicePath);
+			}
+		}
+	}
+}
+
+/**
+ * @implements 实现解析内核uevent消息
+ */
+bool Becamv4l2HotplugMonitor::ParseUevent(const char* buffer, const size_t size, const Becamv4l2UeventSource source, HotplugAction& action,
+										  std::string& devicePath) {
+	if (buffer == nullptr || size == 0) {
+		return false;
+	}
+
+	// 定位属性区间
+	size_t begin = 0, end = size;
+	if (source == Becamv4l2UeventSource::KERNEL) {
+		// 内核消息以`action@devpath`开头（libudev转发的消息不以此开头，直接忽略）
+		auto headerLength = strnlen(buffer, size);
+		if (memchr(buffer, '@', headerLength) == nullptr) {
+			return false;
+		}
+		begin = headerLength + 1;
+	} else {
+		// udev消息以libudev消息头开头（内核消息先于udev处理到达，直接忽略）
+		Becamv4l2UdevMessageHeader header;
+		if (size < sizeof(header)) {
+			return false;
+		}
+		memcpy(&header, buffer, sizeof(header));
+		if (memcmp(header.prefix, "libudev", 8) != 0 || ntohl(header.magic) != BECAMV4L2_UDEV_MESSAGE_MAGIC ||
+			header.propertiesOffset < sizeof(header) || header.propertiesOffset > size ||
+			header.propertiesLength > size - header.propertiesOffset) {
+			return false;
+		}
+		begin = header.propertiesOffset;
+		end = begin + header.propertiesLength;
+	}
+
+	// 逐个解析`KEY=VALUE`
+	std::string actionValue, subsystem, devName, devPath;
+	for (size_t offset = begin; offset < end;) {
+		auto length = strnlen(buffer + offset, end - offset);
+		std::string field(buffer + offset, length);
+		offset += length + 1;
+		auto pos = field.find('=');
+		if (pos == std::string::npos) {
+			continue;
+		}
+		auto key = field.substr(0, pos);
+		auto value = field.substr(pos + 1);
+		if (key == "ACTION") {
+			actionValue = value;
+		} else if (key == "SUBSYSTEM") {
+			subsystem = value;
+		} else if (key == "DEVNAME") {
+			devName = value;
+		} else if (key == "DEVPATH") {
+			devPath = value;
+		}
+	}
+
+	// 仅处理video4linux子系统的接入和移除
+	if (subsystem != "video4linux") {
+		return false;
+	}
+	if (actionValue == "add") {
+		action = HotplugAction::HOTPLUG_ACTION_ADD;
+	} else if (actionValue == "remove") {
+		action = HotplugAction::HOTPLUG_ACTION_REMOVE;
+	} else {
+		return false;
+	}
+	// 缺少DEVNAME时取DEVPATH的最后一级作为节点名
+	if (devName.empty()) {
+		auto pos = devPath.rfind('/');
+		devName = pos == std::string::npos ? devPath : devPath.substr(pos + 1);
+	}
+	if (devName.empty()) {
+		return false;
+	}
+	devicePath = devName[0] == '/' ? devName : "/dev/" + devName;
+	return true;
+}
+
+/**
+ * @implements 实现解析并通知
+ */
+bool Becamv4l2HotplugMonitor::Dispatch(const char* buffer, const size_t size) {
+	HotplugAction action;
+	std::string devicePath;
+	if (!ParseUevent(buffer, size, this->ueventSource, action, devicePath)) {
+		return false;
+	}
+	if (this->listener) {
+		this->listener(action, devicePath);
+	}
+	return true;
+}
@@ -0,0 +1,166 @@
+#pragma once
+
+#include <becam/becam.h>
+#include <functional>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+
+#ifndef _BECAMV4L2_HOTPLUG_MONITOR_H_
+#define _BECAMV4L2_HOTPLUG_MONITOR_H_
+
+// 热插拔事件监听函数
+typedef std::function<void(HotplugAction action, const std::string& devicePath)> Becamv4l2HotplugListener;
+
+/**
+ * @brief uevent来源
+ */
+enum class Becamv4l2UeventSource {
+	// 内核广播（组1），接入事件先于udev创建节点及设置权限
+	KERNEL = 1,
+	// udev广播（组2），udev处理完规则后转发，此时设备节点已可访问
+	UDEV = 2,
+};
+
+/**
+ * @brief libudev转发消息的消息头（与libudev的udev_monitor_netlink_header一致）
+ */
+struct Becamv4l2UdevMessageHeader {
+	// 固定前缀"libudev"
+	char prefix[8];
+	// 魔数（网络字节序）
+	uint32_t magic;
+	// 消息头长度
+	uint32_t headerSize;
+	// 属性（以'\0'分隔的`KEY=VALUE`）偏移
+	uint32_t propertiesOffset;
+	// 属性长度
+	uint32_t propertiesLength;
+	// 子系统过滤哈希
+	uint32_t filterSubsystemHash;
+	// 设备类型过滤哈希
+	uint32_t filterDevtypeHash;
+	// 标签布隆过滤器高位
+	uint32_t filterTagBloomHi;
+	// 标签布隆过滤器低位
+	uint32_t filterTagBloomLo;
+};
+
+// libudev消息魔数
+#define BECAMV4L2_UDEV_MESSAGE_MAGIC 0xfeedcafe
+
+/**
+ * @brief V4L2 设备热插拔监听
+ *
+ * 优先通过netlink接收uevent（仅处理video4linux子系统），netlink不可用时退化为inotify监听`/dev`。
+ * 系统运行udev时订阅udev广播，保证接入事件通知时设备节点已创建且权限已生效；
+ * 未运行udev时节点由devtmpfs在内核发出uevent前创建，直接订阅内核广播；
+ * 退化为inotify时节点可读写后才通知接入
+ */
+class Becamv4l2HotplugMonitor {
+private:
+	// 互斥锁（保护启动与停止）
+	std::mutex mtx;
+	// 监听线程
+	std::thread worker;
+	// 事件来源句柄（netlink套接字或inotify句柄）
+	int sourceFd = -1;
+	// 事件来源是否为netlink
+	bool sourceIsNetlink = false;
+	// netlink消息来源
+	Becamv4l2UeventSource ueventSource = Becamv4l2UeventSource::KERNEL;
+	// 用于唤醒监听线程退出的eventfd
+	int wakeupFd = -1;
+	// 事件监听函数
+	Becamv4l2HotplugListener listener;
+	// 已创建但尚不可访问、等待权限生效后通知接入的节点（仅inotify）
+	std::set<std::string> pendingAdds;
+
+	/**
+	 * @brief 打开netlink uevent套接字
+	 *
+	 * @param source [in] 订阅的uevent来源
+	 * @return 套接字句柄（失败时为-1）
+	 */
+	static int OpenNetlinkSource(const Becamv4l2UeventSource source);
+
+	/**
+	 * @brief 打开inotify句柄并监听`/dev`
+	 *
+	 * @return inotify句柄（失败时为-1）
+	 */
+	static int OpenInotifySource();
+
+	/**
+	 * @brief 监听线程主循环
+	 */
+	void Run();
+
+	/**
+	 * @brief 读取并分发netlink消息
+	 */
+	void ReadNetlink();
+
+	/**
+	 * @brief 读取并分发inotify事件
+	 */
+	void ReadInotify();
+
+	/**
+	 * @brief 停止监听（调用方需持有锁）
+	 */
+	void StopLocked();
+
+public:
+	/**
+	 * @brief 析构函数
+	 */
+	~Becamv4l2HotplugMonitor();
+
+	/**
+	 * @brief 开始监听（已在监听时先停止）
+	 *
+	 * @param listener [in] 事件监听函数（在监听线程中调用）
+	 * @return 状态码
+	 */
+	StatusCode Start(const Becamv4l2HotplugListener& listener);
+
+	/**
+	 * @brief 停止监听（不可在监听函数中调用）
+	 */
+	void Stop();
+
+	/**
+	 * @brief 只设置事件监听函数而不启动监听线程（用于在没有并发事件的情况下注入模拟事件）
+	 *
+	 * @param listener [in] 事件监听函数（在调用Dispatch的线程中调用）
+	 * @param source [in] 接受的uevent来源
+	 * @return 是否设置成功（正在监听时失败）
+	 */
+	bool SetListener(const Becamv4l2HotplugListener& listener, const Becamv4l2UeventSource source = Becamv4l2UeventSource::KERNEL);
+
+	/**
+	 * @brief 解析uevent消息
+	 *
+	 * @param buffer [in] 消息内容（内核消息为`action@devpath`后跟以'\0'分隔的`KEY=VALUE`，udev消息为libudev消息头后跟属性）
+	 * @param size [in] 消息长度
+	 * @param source [in] 消息来源（与消息格式不符的消息被忽略）
+	 * @param action [out] 热插拔动作
+	 * @param devicePath [out] 设备路径
+	 * @return 是否为video4linux设备的接入或移除事件
+	 */
+	static bool ParseUevent(const char* buffer, const size_t size, const Becamv4l2UeventSource source, HotplugAction& action,
+							std::string& devicePath);
+
+	/**
+	 * @brief 按当前订阅的来源解析uevent消息并通知监听函数（也可用于注入模拟事件）
+	 *
+	 * @param buffer [in] 消息内容
+	 * @param size [in] 消息长度
+	 * @return 是否已通知
+	 */
+	bool Dispatch(const char* buffer, const size_t size);
+};
+
+#endif
@@ -0,0 +1,259 @@
+#include "Becamv4l2SysfsHelper.hpp"
+#include <fstream>
+#include <glob.h>
+#include <limits.h>
+#include <pkg/StringConvert.hpp>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/utsname.h>
+#include <unistd.h>
+
+/**
+ * @implements 实现读取sysfs属性文件内容
+ */
+bool Becamv4l2SysfsHelper::ReadAttribute(const std::string& path, std::string& value) {
+	// 打开属性文件
+	std::ifstream ifs(path);
+	if (!ifs.is_open()) {
+		return false;
+	}
+	// 属性文件只有一行有效内容
+	std::string line;
+	std::getline(ifs, line);
+	value = TrimSpace(line);
+	return true;
+}
+
+/**
+ * @implements 实现获取设备节点在sysfs中的目录
+ */
+std::string Becamv4l2SysfsHelper::GetVideoNodeDir(const std::string& devicePath) {
+	// 提取设备节点名称
+	auto pos = devicePath.find_last_of('/');
+	auto nodeName = pos == std::string::npos ? devicePath : devicePath.substr(pos + 1);
+	// 拼接sysfs目录
+	return "/sys/class/video4linux/" + nodeName;
+}
+
+/**
+ * @implements 实现获取设备节点所属USB设备的拓扑信息
+ */
+bool Becamv4l2SysfsHelper::GetUsbTopology(const std::string& devicePath, Becamv4l2UsbTopology& topology) {
+	// 重置
+	topology = Becamv4l2UsbTopology();
+
+	// 解析设备节点指向的物理设备（通常为USB接口目录，例如：.../usb1/1-2/1-2:1.0）
+	char resolved[PATH_MAX] = {0};
+	auto deviceLink = Becamv4l2SysfsHelper::GetVideoNodeDir(devicePath) + "/device";
+	if (realpath(deviceLink.c_str(), resolved) == nullptr) {
+		return false;
+	}
+
+	// 向上查找USB设备目录
+	topology.usbDeviceDir = Becamv4l2SysfsHelper::FindUsbDeviceDir(resolved);
+	std::string value;
+	if (topology.usbDeviceDir.empty() || !Becamv4l2SysfsHelper::ReadAttribute(topology.usbDeviceDir + "/busnum", value)) {
+		return false;
+	}
+
+	// 读取总线编号和设备链路速率
+	topology.busNumber = strtoul(value.c_str(), nullptr, 10);
+	if (Becamv4l2SysfsHelper::ReadAttribute(topology.usbDeviceDir + "/speed", value)) {
+		topology.deviceSpeed = uint32_t(atof(value.c_str()));
+	}
+	// 读取根集线器链路速率（同一总线上的设备共享该带宽）
+	topology.busSpeed = topology.deviceSpeed;
+	if (Becamv4l2SysfsHelper::ReadAttribute("/sys/bus/usb/devices/usb" + std::to_string(topology.busNumber) + "/speed", value)) {
+		topology.busSpeed = uint32_t(atof(value.c_str()));
+	}
+
+	// OK
+	return true;
+}
+
+/**
+ * @implements 实现查找所属的USB设备目录
+ */
+std::string Becamv4l2SysfsHelper::FindUsbDeviceDir(const std::string& physicalDir) {
+	// 包含busnum属性的目录即USB设备目录
+	std::string dir = physicalDir;
+	std::string value;
+	while (dir.size() > 1) {
+		if (Becamv4l2SysfsHelper::ReadAttribute(dir + "/busnum", value)) {
+			return dir;
+		}
+		dir = dir.substr(0, dir.find_last_of('/'));
+	}
+	return "";
+}
+
+/**
+ * @implements 实现构建设备稳定标识
+ */
+std::string Becamv4l2SysfsHelper::BuildDeviceId(const std::string& physicalDir, const int index) {
+	auto suffix = "-" + std::to_string(index < 0 ? 0 : index);
+	// USB设备使用VID:PID和序列号
+	auto usbDeviceDir = Becamv4l2SysfsHelper::FindUsbDeviceDir(physicalDir);
+	if (!usbDeviceDir.empty()) {
+		std::string vendor, product, serial;
+		Becamv4l2SysfsHelper::ReadAttribute(usbDeviceDir + "/idVendor", vendor);
+		Becamv4l2SysfsHelper::ReadAttribute(usbDeviceDir + "/idProduct", product);
+		// 没有序列号的设备只能以所在端口区分（例如：1-2.3）
+		if (!Becamv4l2SysfsHelper::ReadAttribute(usbDeviceDir + "/serial", serial) || serial.empty()) {
+			serial = "port" + usbDeviceDir.substr(usbDeviceDir.find_last_of('/') + 1);
+		}
+		return "usb-" + vendor + ":" + product + "-" + serial + suffix;
+	}
+	// 其它设备使用设备目录
+	std::string prefix = "/sys/devices/";
+	auto relative = physicalDir.compare(0, prefix.size(), prefix) == 0 ? physicalDir.substr(prefix.size()) : physicalDir;
+	return "sysfs-" + relative + suffix;
+}
+
+/**
+ * @implements 实现从sysfs枚举video节点
+ */
+bool Becamv4l2SysfsHelper::EnumVideoNodes(std::vector<Becamv4l2SysfsNode>& nodes) {
+	// 重置
+	nodes.clear();
+
+	// 查找sysfs中的video节点（与遍历`/dev/video*`的顺序一致）
+	glob_t globResult;
+	if (glob("/sys/class/video4linux/video*", 0, nullptr, &globResult) != 0) {
+		return false;
+	}
+
+	// 遍历匹配结果
+	for (size_t i = 0; i < globResult.gl_pathc; i++) {
+		std::string dir = globResult.gl_pathv[i];
+		Becamv4l2SysfsNode node;
+		node.devicePath = "/dev/" + dir.substr(dir.find_last_of('/') + 1);
+		// 容器等环境中sysfs可能包含未映射到`/dev`的节点
+		if (access(node.devicePath.c_str(), F_OK) != 0) {
+			continue;
+		}
+		Becamv4l2SysfsHelper::ReadAttribute(dir + "/name", node.name);
+		std::string value;
+		if (Becamv4l2SysfsHelper::ReadAttribute(dir + "/index", value) && !value.empty()) {
+			node.index = atoi(value.c_str());
+		}
+		// 驱动名称为`device/driver`链接的最后一级
+		char resolved[PATH_MAX] = {0};
+		if (realpath((dir + "/device/driver").c_str(), resolved) != nullptr) {
+			std::string driver = resolved;
+			node.driver = driver.substr(driver.find_last_of('/') + 1);
+		}
+		// 物理设备目录及稳定标识
+		if (realpath((dir + "/device").c_str(), resolved) != nullptr) {
+			auto usbDeviceDir = Becamv4l2SysfsHelper::FindUsbDeviceDir(resolved);
+			node.physicalDir = usbDeviceDir.empty() ? std::string(resolved) : usbDeviceDir;
+			if (!usbDeviceDir.empty()) {
+				node.streamCount = Becamv4l2SysfsHelper::CountVideoStreamingInterfaces(usbDeviceDir);
+			}
+			node.deviceId = Becamv4l2SysfsHelper::BuildDeviceId(resolved, node.index);
+		}
+		nodes.push_back(node);
+	}
+
+	// 释放泛匹配结果
+	globfree(&globResult);
+	return true;
+}
+
+/**
+ * @implements 实现统计USB设备的UVC视频流接口数
+ */
+int Becamv4l2SysfsHelper::CountVideoStreamingInterfaces(const std::string& usbDeviceDir) {
+	// 接口目录形如`1-2:1.1`
+	glob_t globResult;
+	if (glob((usbDeviceDir + "/*:*.*").c_str(), 0, nullptr, &globResult) != 0) {
+		return -1;
+	}
+	int count = 0;
+	for (size_t i = 0; i < globResult.gl_pathc; i++) {
+		std::string dir = globResult.gl_pathv[i];
+		std::string interfaceClass, interfaceSubClass;
+		// 视频类（0x0E）的视频流子类（0x02）
+		if (Becamv4l2SysfsHelper::ReadAttribute(dir + "/bInterfaceClass", interfaceClass) &&
+			Becamv4l2SysfsHelper::ReadAttribute(dir + "/bInterfaceSubClass", interfaceSubClass) && interfaceClass == "0e" &&
+			interfaceSubClass == "02") {
+			count++;
+		}
+	}
+	globfree(&globResult);
+	return count;
+}
+
+/**
+ * @implements 实现根据sysfs信息推断节点是否为视频捕获节点
+ */
+bool Becamv4l2SysfsHelper::InferVideoCapture(const Becamv4l2SysfsNode& node, const std::vector<Becamv4l2SysfsNode>& nodes, bool& capture) {
+	// 仅能推断uvcvideo驱动的USB节点，且需要名称完整及已知视频流接口数
+	if (node.driver != "uvcvideo" || node.index < 0 || node.name.empty() || node.physicalDir.empty() || node.streamCount <= 0) {
+		return false;
+	}
+	// 统计同一物理设备的节点数
+	int nodeCount = 0;
+	for (auto& item : nodes) {
+		if (item.physicalDir == node.physicalDir) {
+			nodeCount++;
+		}
+	}
+	if (node.index >= nodeCount) {
+		return false;
+	}
+	// 没有元数据节点，全部为捕获节点
+	if (nodeCount == node.streamCount) {
+		capture = true;
+		return true;
+	}
+	// 捕获节点和元数据节点交替注册，偶数序号为捕获节点
+	if (nodeCount == node.streamCount * 2) {
+		capture = node.index % 2 == 0;
+		return true;
+	}
+	return false;
+}
+
+/**
+ * @implements 实现获取设备节点的稳定标识及驱动指纹
+ */
+bool Becamv4l2SysfsHelper::GetNodeIdentity(const std::string& devicePath, std::string& deviceId, std::string& fingerprint) {
+	auto dir = Becamv4l2SysfsHelper::GetVideoNodeDir(devicePath);
+	// 解析物理设备目录
+	char resolved[PATH_MAX] = {0};
+	if (realpath((dir + "/device").c_str(), resolved) == nullptr) {
+		return false;
+	}
+	std::string physicalDir = resolved;
+	// 节点序号
+	std::string value;
+	int index = -1;
+	if (Becamv4l2SysfsHelper::ReadAttribute(dir + "/index", value) && !value.empty()) {
+		index = atoi(value.c_str());
+	}
+	deviceId = Becamv4l2SysfsHelper::BuildDeviceId(physicalDir, index);
+
+	// 驱动名称
+	std::string driver;
+	if (realpath((dir + "/device/driver").c_str(), resolved) != nullptr) {
+		driver = resolved;
+		driver = driver.substr(driver.find_last_of('/') + 1);
+	}
+	// 驱动版本（内置于内核的驱动没有模块版本，以内核版本代替）
+	std::string version;
+	if (driver.empty() || !Becamv4l2SysfsHelper::ReadAttribute("/sys/module/" + driver + "/version", version)) {
+		utsname name;
+		if (uname(&name) == 0) {
+			version = name.release;
+		}
+	}
+	// USB设备固件版本
+	std::string firmware;
+	auto usbDeviceDir = Becamv4l2SysfsHelper::FindUsbDeviceDir(physicalDir);
+	if (!usbDeviceDir.empty()) {
+		Becamv4l2SysfsHelper::ReadAttribute(usbDeviceDir + "/bcdDevice", firmware);
+	}
+	fingerprint = driver + "@" + version + "#" + firmware;
+	return true;
+}
@@ -0,0 +1,137 @@
+#pragma once
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#ifndef _BECAMV4L2_SYSFS_HELPER_H_
+#define _BECAMV4L2_SYSFS_HELPER_H_
+
+/**
+ * @brief V4L2 设备在sysfs中的USB拓扑信息
+ */
+struct Becamv4l2UsbTopology {
+	// USB总线编号（非USB设备为0）
+	uint32_t busNumber = 0;
+	// 设备链路速率（Mbit/s）
+	uint32_t deviceSpeed = 0;
+	// 总线（根集线器）链路速率（Mbit/s）
+	uint32_t busSpeed = 0;
+	// USB设备在sysfs中的目录
+	std::string usbDeviceDir;
+};
+
+/**
+ * @brief V4L2 设备节点在sysfs中的信息
+ */
+struct Becamv4l2SysfsNode {
+	// 设备路径（例如：/dev/video0）
+	std::string devicePath;
+	// 设备名称（未处理）
+	std::string name;
+	// 节点在所属物理设备中的序号（未知时为-1）
+	int index = -1;
+	// 驱动名称（未知时为空）
+	std::string driver;
+	// 所属物理设备在sysfs中的目录（USB设备为USB设备目录，用于关联同一设备的多个节点）
+	std::string physicalDir;
+	// 所属USB设备的UVC视频流接口数（非USB设备或未知时为-1）
+	int streamCount = -1;
+	// 设备稳定标识
+	std::string deviceId;
+};
+
+/**
+ * @brief V4L2 sysfs 读取助手类
+ */
+class Becamv4l2SysfsHelper {
+public:
+	/**
+	 * @brief 读取sysfs属性文件内容（移除首尾空白）
+	 *
+	 * @param path [in] 属性文件路径
+	 * @param value [out] 属性值
+	 * @return 是否读取成功
+	 */
+	static bool ReadAttribute(const std::string& path, std::string& value);
+
+	/**
+	 * @brief 获取设备节点在sysfs中的目录（例如：/dev/video0 -> /sys/class/video4linux/video0）
+	 *
+	 * @param devicePath [in] 设备路径
+	 * @return sysfs目录
+	 */
+	static std::string GetVideoNodeDir(const std::string& devicePath);
+
+	/**
+	 * @brief 获取设备节点所属USB设备的拓扑信息
+	 *
+	 * @param devicePath [in] 设备路径
+	 * @param topology [out] USB拓扑信息
+	 * @return 是否为USB设备
+	 */
+	static bool GetUsbTopology(const std::string& devicePath, Becamv4l2UsbTopology& topology);
+
+	/**
+	 * @brief 从物理设备目录向上查找所属的USB设备目录
+	 *
+	 * @param physicalDir [in] 物理设备目录（例如USB接口目录）
+	 * @return USB设备目录（非USB设备为空）
+	 */
+	static std::string FindUsbDeviceDir(const std::string& physicalDir);
+
+	/**
+	 * @brief 构建设备稳定标识
+	 *
+	 * USB设备为`usb-VID:PID-序列号-序号`（无序列号时以端口路径代替），其它设备为`sysfs-设备目录-序号`
+	 *
+	 * @param physicalDir [in] 节点所属的物理设备目录
+	 * @param index [in] 节点在物理设备中的序号
+	 * @return 设备稳定标识
+	 */
+	static std::string BuildDeviceId(const std::string& physicalDir, const int index);
+
+	/**
+	 * @brief 获取设备节点的稳定标识及驱动指纹（不打开设备节点）
+	 *
+	 * 驱动指纹由驱动名称、驱动版本（无模块版本时取内核版本）及USB设备固件版本构成，任一变化时设备能力可能随之变化
+	 *
+	 * @param devicePath [in] 设备路径
+	 * @param deviceId [out] 设备稳定标识
+	 * @param fingerprint [out] 驱动指纹
+	 * @return 是否获取成功
+	 */
+	static bool GetNodeIdentity(const std::string& devicePath, std::string& deviceId, std::string& fingerprint);
+
+	/**
+	 * @brief 从sysfs枚举video节点（不打开设备节点）
+	 *
+	 * @param nodes [out] 节点列表（按节点名称排序，仅包含`/dev`下存在的节点）
+	 * @return sysfs中是否有video节点（否时调用方需退化为遍历`/dev`）
+	 */
+	static bool EnumVideoNodes(std::vector<Becamv4l2SysfsNode>& nodes);
+
+	/**
+	 * @brief 根据sysfs信息推断节点是否为视频捕获节点
+	 *
+	 * uvcvideo驱动为每个视频流接口依次注册捕获节点，支持元数据时紧接着注册元数据节点，节点序号按注册顺序分配；
+	 * 同一设备的节点数等于视频流接口数时全部为捕获节点，等于其两倍时偶数序号为捕获节点，其它情况（如输出流、
+	 * 部分节点未映射）以及其它驱动无法从sysfs得知节点能力
+	 *
+	 * @param node [in] 节点信息
+	 * @param nodes [in] 全部节点（用于统计同一物理设备的节点数）
+	 * @param capture [out] 是否为视频捕获节点
+	 * @return 能否推断（否时需打开节点查询能力）
+	 */
+	static bool InferVideoCapture(const Becamv4l2SysfsNode& node, const std::vector<Becamv4l2SysfsNode>& nodes, bool& capture);
+
+	/**
+	 * @brief 统计USB设备的UVC视频流接口数
+	 *
+	 * @param usbDeviceDir [in] USB设备目录
+	 * @return 视频流接口数（读取失败时为-1）
+	 */
+	static int CountVideoStreamingInterfaces(const std::string& usbDeviceDir);
+};
+
+#endif
@@ -0,0 +1,258 @@
+#pragma once
+
+#ifndef _BECAM_DEVICE_LIST_ARENA_H_
+#define _BECAM_DEVICE_LIST_ARENA_H_
+
+#include "LogOutput.hpp"
+#include <becam/becam.h>
+#include <map>
+#include <new>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+/**
+ * @brief 设备列表构建项（供没有专用设备结构的后端使用）
+ */
+struct DeviceListArenaEntry {
+	// 设备友好名称
+	std::string name;
+	// 设备路径
+	std::string devicePath;
+	// 设备稳定标识
+	std::string deviceId;
+	// 同一物理设备的其它节点路径
+	std::vector<std::string> siblingPaths;
+};
+
+/**
+ * @brief 设备列表内存块头（位于设备信息列表之前）
+ *
+ * 内存块布局：块头 | DeviceInfo数组 | DeviceInfoExtension数组 | 兄弟节点路径指针数组 | 去重后的字符串；
+ * 其中的指针均指向块内，整块拷贝到其它地址（例如共享内存）后需调用RebaseDeviceListArena修正
+ */
+struct DeviceListArenaHeader {
+	// 魔数（调试校验，用于发现损坏的内存块，不能识别其它来源的列表）
+	uint32_t magic;
+	// 设备数量
+	uint32_t entryCount;
+	// 内存块总字节数（包含块头）
+	size_t totalSize;
+};
+
+// 设备列表内存块魔数
+static const uint32_t DEVICE_LIST_ARENA_MAGIC = 0x4C444542; // "BEDL"
+
+/**
+ * @brief 计算按指针大小对齐后的长度
+ */
+static size_t AlignDeviceListArenaLength(const size_t length) {
+	return (length + sizeof(void*) - 1) & ~(sizeof(void*) - 1);
+}
+
+/**
+ * @brief 计算内存块中DeviceInfoExtension数组的偏移
+ */
+static size_t GetDeviceListArenaExtensionsOffset(const size_t entryCount) {
+	return AlignDeviceListArenaLength(sizeof(DeviceListArenaHeader)) + AlignDeviceListArenaLength(entryCount * sizeof(DeviceInfo));
+}
+
+/**
+ * @brief 在单个内存块中构建设备信息列表（相同的字符串只保存一份）
+ *
+ * @param devices [in] 设备列表（元素需包含name、devicePath、deviceId、siblingPaths字段）
+ * @param reply [out] 设备信息列表（无设备时为空）
+ * @param replySize [out] 设备信息数量
+ */
+template <typename Entry> static void BuildDeviceListArena(const std::vector<Entry>& devices, DeviceInfo*& reply, size_t& replySize) {
+	// 重置
+	reply = nullptr;
+	replySize = 0;
+	if (devices.empty()) {
+		return;
+	}
+
+	// 统计指针数组长度，并为去重后的字符串分配偏移
+	size_t siblingCount = 0;
+	size_t stringsLength = 0;
+	std::map<std::string, size_t> stringOffsets;
+	auto intern = [&](const std::string& value) {
+		if (stringOffsets.emplace(value, stringsLength).second) {
+			stringsLength += value.length() + 1;
+		}
+	};
+	for (auto& device : devices) {
+		intern(device.name);
+		intern(device.devicePath);
+		intern(device.deviceId);
+		for (auto& siblingPath : device.siblingPaths) {
+			intern(siblingPath);
+		}
+		siblingCount += device.siblingPaths.size();
+	}
+
+	// 一次性分配
+	auto entriesOffset = AlignDeviceListArenaLength(sizeof(DeviceListArenaHeader));
+	auto extensionsOffset = GetDeviceListArenaExtensionsOffset(devices.size());
+	auto siblingsOffset = extensionsOffset + devices.size() * sizeof(DeviceInfoExtension);
+	auto stringsOffset = siblingsOffset + siblingCount * sizeof(char*);
+	auto totalSize = stringsOffset + stringsLength;
+	auto block = static_cast<uint8_t*>(::operator new(totalSize));
+	auto header = reinterpret_cast<DeviceListArenaHeader*>(block);
+	header->magic = DEVICE_LIST_ARENA_MAGIC;
+	header->entryCount = uint32_t(devices.size());
+	header->totalSize = totalSize;
+
+	// 写入字符串
+	auto strings = reinterpret_cast<char*>(block + stringsOffset);
+	for (auto& item : stringOffsets) {
+		memcpy(strings + item.second, item.first.c_str(), item.first.length() + 1);
+	}
+
+	// 写入设备信息
+	auto entries = reinterpret_cast<DeviceInfo*>(block + entriesOffset);
+	auto extensions = reinterpret_cast<DeviceInfoExtension*>(block + extensionsOffset);
+	auto siblings = reinterpret_cast<char**>(block + siblingsOffset);
+	for (size_t i = 0; i < devices.size(); i++) {
+		auto& device = devices[i];
+		DeviceInfo deviceInfo = {0};
+		deviceInfo.name = strings + stringOffsets[device.name];
+		deviceInfo.devicePath = strings + stringOffsets[device.devicePath];
+		entries[i] = deviceInfo;
+		// 扩展信息
+		DeviceInfoExtension extension = {0};
+		extension.structSize = sizeof(DeviceInfoExtension);
+		extension.deviceId = strings + stringOffsets[device.deviceId];
+		extension.siblingPathListSize = device.siblingPaths.size();
+		if (!device.siblingPaths.empty()) {
+			extension.siblingPathList = siblings;
+			for (auto& siblingPath : device.siblingPaths) {
+				*siblings++ = strings + stringOffsets[siblingPath];
+			}
+		}
+		extensions[i] = extension;
+	}
+
+	reply = entries;
+	replySize = devices.size();
+}
+
+/**
+ * @brief 获取设备信息列表所在内存块的块头
+ *
+ * 块头位于列表之前，传入其它来源的指针或已释放的列表时读取块头本身即为未定义行为，
+ * 因此无法据此识别这类列表；魔数只用于发现内存块被越界写入等损坏
+ *
+ * @param list [in] 由BuildDeviceListArena构建且尚未释放的设备信息列表
+ * @return 块头（魔数不匹配时为空）
+ */
+static DeviceListArenaHeader* GetDeviceListArenaHeader(const DeviceInfo* list) {
+	if (list == nullptr) {
+		return nullptr;
+	}
+	auto block = reinterpret_cast<const uint8_t*>(list) - AlignDeviceListArenaLength(sizeof(DeviceListArenaHeader));
+	auto header = reinterpret_cast<DeviceListArenaHeader*>(const_cast<uint8_t*>(block));
+	return header->magic == DEVICE_LIST_ARENA_MAGIC ? header : nullptr;
+}
+
+/**
+ * @brief 修正整块拷贝后内存块中的指针
+ *
+ * @param block [in && out] 拷贝后的内存块（从块头开始，长度为块头中的totalSize）
+ * @param previousBase [in] 拷贝前内存块的首地址
+ * @return 拷贝后的设备信息列表（块头无效或指针越界时为空，此时内存块可能已被部分修正，不应再使用）
+ */
+static DeviceInfo* RebaseDeviceListArena(uint8_t* block, const uint8_t* previousBase) {
+	if (block == nullptr || previousBase == nullptr) {
+		return nullptr;
+	}
+	auto header = reinterpret_cast<DeviceListArenaHeader*>(block);
+	if (header->magic != DEVICE_LIST_ARENA_MAGIC) {
+		DEBUG_LOG("RebaseDeviceListArena -> magic mismatch: " << header->magic);
+		return nullptr;
+	}
+	auto totalSize = header->totalSize;
+	auto oldBase = uintptr_t(previousBase);
+	auto newBase = uintptr_t(block);
+	// 以整数运算换算地址，块外的指针视为损坏
+	bool valid = true;
+	auto rebase = [&](const void* pointer) -> uintptr_t {
+		auto address = uintptr_t(pointer);
+		if (address < oldBase || address >= oldBase + totalSize) {
+			valid = false;
+			return 0;
+		}
+		return newBase + (address - oldBase);
+	};
+	auto entries = reinterpret_cast<DeviceInfo*>(block + AlignDeviceListArenaLength(sizeof(DeviceListArenaHeader)));
+	auto extensions = reinterpret_cast<DeviceInfoExtension*>(block + GetDeviceListArenaExtensionsOffset(header->entryCount));
+	for (uint32_t i = 0; i < header->entryCount && valid; i++) {
+		auto& entry = entries[i];
+		entry.name = reinterpret_cast<char*>(rebase(entry.name));
+		entry.devicePath = reinterpret_cast<char*>(rebase(entry.devicePath));
+		auto& extension = extensions[i];
+		extension.deviceId = reinterpret_cast<char*>(rebase(extension.deviceId));
+		if (extension.siblingPathListSize > 0) {
+			extension.siblingPathList = reinterpret_cast<char**>(rebase(extension.siblingPathList));
+			for (size_t j = 0; j < extension.siblingPathListSize && valid; j++) {
+				extension.siblingPathList[j] = reinterpret_cast<char*>(rebase(extension.siblingPathList[j]));
+			}
+		}
+	}
+	if (!valid) {
+		DEBUG_LOG("RebaseDeviceListArena -> pointer outside of arena");
+		return nullptr;
+	}
+	return entries;
+}
+
+/**
+ * @brief 获取设备扩展信息（只写入调用方structSize以内的字段）
+ *
+ * @param list [in] 由BuildDeviceListArena构建的设备信息列表
+ * @param listSize [in] 设备信息数量
+ * @param index [in] 设备序号
+ * @param extension [in && out] 设备扩展信息（structSize为调用方结构体大小，返回时为实际写入的大小）
+ * @return 状态码
+ */
+static StatusCode GetDeviceListArenaExtension(const DeviceInfo* list, const size_t listSize, const size_t index, DeviceInfoExtension& extension) {
+	// 调用方结构体至少需要包含structSize之后的第一个字段
+	if (list == nullptr || index >= listSize || extension.structSize <= offsetof(DeviceInfoExtension, deviceId)) {
+		return StatusCode::STATUS_CODE_ERR_INPUT_PARAM;
+	}
+	auto header = GetDeviceListArenaHeader(list);
+	if (header == nullptr || index >= header->entryCount) {
+		return StatusCode::STATUS_CODE_ERR_INPUT_PARAM;
+	}
+	auto extensions = reinterpret_cast<const DeviceInfoExtension*>(reinterpret_cast<const uint8_t*>(header) +
+																   GetDeviceListArenaExtensionsOffset(header->entryCount));
+	auto size = extension.structSize < sizeof(DeviceInfoExtension) ? extension.structSize : sizeof(DeviceInfoExtension);
+	memcpy(&extension, &extensions[index], size);
+	extension.structSize = size;
+	return StatusCode::STATUS_CODE_SUCCESS;
+}
+
+/**
+ * @brief 释放由BuildDeviceListArena构建的设备信息列表
+ *
+ * @param input [in && out] 由BuildDeviceListArena构建且尚未释放的设备信息列表（可为空）
+ * @param inputSize [in && out] 设备信息数量
+ */
+static void FreeDeviceListArena(DeviceInfo*& input, size_t& inputSize) {
+	if (input != nullptr) {
+		auto header = GetDeviceListArenaHeader(input);
+		if (header != nullptr) {
+			header->magic = 0;
+			::operator delete(header);
+		} else {
+			// 内存块已损坏，不再释放以免破坏堆
+			DEBUG_LOG("FreeDeviceListArena -> magic mismatch, arena corrupted: " << static_cast<const void*>(input));
+		}
+	}
+	input = nullptr;
+	inputSize = 0;
+}
+
+#endif
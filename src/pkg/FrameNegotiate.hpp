@@ -0,0 +1,174 @@
+#pragma once
+
+#ifndef _BECAM_FRAME_NEGOTIATE_H_
+#define _BECAM_FRAME_NEGOTIATE_H_
+
+#include <algorithm>
+#include <becam/becam.h>
+#include <vector>
+
+/**
+ * @brief 判断格式是否为压缩格式
+ *
+ * @param format 格式（FOURCC表示）
+ * @return 是否为压缩格式
+ */
+static bool IsCompressedFourcc(const uint32_t format) {
+	switch (format) {
+		case BECAM_FOURCC('M', 'J', 'P', 'G'):
+		case BECAM_FOURCC('J', 'P', 'E', 'G'):
+		case BECAM_FOURCC('H', '2', '6', '4'):
+		case BECAM_FOURCC('A', 'V', 'C', '1'):
+		case BECAM_FOURCC('H', 'E', 'V', 'C'):
+		case BECAM_FOURCC('H', '2', '6', '5'):
+			return true;
+		default:
+			return false;
+	}
+}
+
+/**
+ * @brief 估算格式每个像素在总线上占用的比特数（压缩格式取经验值）
+ *
+ * @param format 格式（FOURCC表示）
+ * @return 每像素比特数
+ */
+static double FourccBitsPerPixel(const uint32_t format) {
+	switch (format) {
+		case BECAM_FOURCC('G', 'R', 'E', 'Y'):
+		case BECAM_FOURCC('Y', '8', '0', '0'):
+			return 8;
+		case BECAM_FOURCC('N', 'V', '1', '2'):
+		case BECAM_FOURCC('N', 'V', '2', '1'):
+		case BECAM_FOURCC('Y', 'U', '1', '2'):
+		case BECAM_FOURCC('Y', 'V', '1', '2'):
+		case BECAM_FOURCC('I', '4', '2', '0'):
+		case BECAM_FOURCC('I', 'Y', 'U', 'V'):
+			return 12;
+		case BECAM_FOURCC('R', 'G', 'B', '3'):
+		case BECAM_FOURCC('B', 'G', 'R', '3'):
+			return 24;
+		case BECAM_FOURCC('A', 'B', '2', '4'):
+		case BECAM_FOURCC('A', 'R', '2', '4'):
+		case BECAM_FOURCC('X', 'B', '2', '4'):
+		case BECAM_FOURCC('X', 'R', '2', '4'):
+			return 32;
+		case BECAM_FOURCC('M', 'J', 'P', 'G'):
+		case BECAM_FOURCC('J', 'P', 'E', 'G'):
+			return 2;
+		case BECAM_FOURCC('H', '2', '6', '4'):
+		case BECAM_FOURCC('A', 'V', 'C', '1'):
+		case BECAM_FOURCC('H', 'E', 'V', 'C'):
+		case BECAM_FOURCC('H', '2', '6', '5'):
+			return 0.2;
+		default:
+			// YUYV、UYVY、RGB565等打包格式均为16位
+			return 16;
+	}
+}
+
+/**
+ * @brief 估算格式解码单个像素的开销（与搬运1比特的开销同量纲）
+ *
+ * @param format 格式（FOURCC表示）
+ * @return 解码开销系数
+ */
+static double FourccDecodeCostPerPixel(const uint32_t format) {
+	switch (format) {
+		case BECAM_FOURCC('M', 'J', 'P', 'G'):
+		case BECAM_FOURCC('J', 'P', 'E', 'G'):
+			return 16;
+		case BECAM_FOURCC('H', '2', '6', '4'):
+		case BECAM_FOURCC('A', 'V', 'C', '1'):
+		case BECAM_FOURCC('H', 'E', 'V', 'C'):
+		case BECAM_FOURCC('H', '2', '6', '5'):
+			return 24;
+		default:
+			return 0;
+	}
+}
+
+/**
+ * @brief 估算视频帧信息的综合开销
+ *
+ * @param frameInfo 视频帧信息
+ * @param policy 协商策略
+ * @return 综合开销（越小越好）
+ */
+static double EstimateFrameInfoCost(const VideoFrameInfo& frameInfo, const NegotiatePolicy& policy) {
+	// 每秒像素数（百万）
+	double megaPixelRate = double(frameInfo.width) * double(frameInfo.height) * double(frameInfo.fps) / 1e6;
+	// USB带宽开销（Mbit/s）
+	double bandwidthCost = FourccBitsPerPixel(frameInfo.format) * megaPixelRate;
+	// 解码开销
+	double decodeCost = FourccDecodeCostPerPixel(frameInfo.format) * megaPixelRate;
+	// 下游格式转换开销（输出格式未指定或与源格式一致时无需转换）
+	double convertCost = 0;
+	if (policy.outputFormat != 0 && policy.outputFormat != frameInfo.format) {
+		convertCost = 4 * megaPixelRate;
+	}
+	// 加权求和
+	return policy.bandwidthWeight * bandwidthCost + policy.decodeWeight * decodeCost + policy.convertWeight * convertCost;
+}
+
+/**
+ * @brief 按协商策略筛选并排序视频帧信息列表
+ *
+ * @param list 设备支持的视频帧信息列表
+ * @param listSize 视频帧信息数量
+ * @param desired 期望的最低视频帧信息（宽、高、帧率为下限）
+ * @param policy 协商策略（可为空，为空时使用等权重）
+ * @return 满足条件的视频帧信息，按开销由低到高排序
+ */
+static std::vector<VideoFrameInfo> RankFrameInfoList(const VideoFrameInfo* list, const size_t listSize, const VideoFrameInfo& desired,
+													 const NegotiatePolicy* policy) {
+	// 补全默认策略
+	NegotiatePolicy effective = {0};
+	effective.bandwidthWeight = 1;
+	effective.decodeWeight = 1;
+	effective.convertWeight = 1;
+	if (policy != nullptr) {
+		effective = *policy;
+	}
+	// 未指定允许的格式时，使用期望格式作为唯一允许的格式
+	auto isAllowedFormat = [&](const uint32_t format) {
+		if (effective.formatList != nullptr && effective.formatListSize > 0) {
+			return std::find(effective.formatList, effective.formatList + effective.formatListSize, format) !=
+				   effective.formatList + effective.formatListSize;
+		}
+		return desired.format == 0 || desired.format == format;
+	};
+
+	// 筛选满足条件的视频帧信息
+	std::vector<std::pair<double, VideoFrameInfo>> candidates;
+	for (size_t i = 0; i < listSize; i++) {
+		auto item = list[i];
+		if (item.width < desired.width || item.height < desired.height || item.fps < desired.fps || !isAllowedFormat(item.format)) {
+			continue;
+		}
+		candidates.push_back(std::make_pair(EstimateFrameInfoCost(item, effective), item));
+	}
+
+	// 按开销排序，开销相同时优先选择像素更少、帧率更低的（保持原有顺序稳定）
+	std::stable_sort(candidates.begin(), candidates.end(),
+					 [](const std::pair<double, VideoFrameInfo>& a, const std::pair<double, VideoFrameInfo>& b) {
+						 if (a.first != b.first) {
+							 return a.first < b.first;
+						 }
+						 auto aPixels = uint64_t(a.second.width) * a.second.height;
+						 auto bPixels = uint64_t(b.second.width) * b.second.height;
+						 if (aPixels != bPixels) {
+							 return aPixels < bPixels;
+						 }
+						 return a.second.fps < b.second.fps;
+					 });
+
+	// 提取结果
+	std::vector<VideoFrameInfo> ranked;
+	for (auto& item : candidates) {
+		ranked.push_back(item.second);
+	}
+	return ranked;
+}
+
+#endif
@@ -0,0 +1,992 @@
+#pragma once
+
+#ifndef _BECAM_IMAGE_RESIZE_H_
+#define _BECAM_IMAGE_RESIZE_H_
+
+#include "PixelConvert.hpp"
+#include "SimdDispatch.hpp"
+#include <algorithm>
+#include <becam/becam.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <vector>
+
+/**
+ * 图像缩放（源、目标格式相同）：逐平面先垂直后水平重采样，打包YUV 4:2:2的亮度与两个色度、交织色度的两个分量各自独立采样；
+ * 盒式、区域滤波在整数比例1/2、1/3、1/4（双线性在1/2）下走求和快速路径：N行求和、水平N合1、除以N*N后四舍五入；
+ * 其余比例按14位定点权重表重采样：垂直加权得到带7位小数的中间行，再水平加权后四舍五入；
+ * 垂直求和、垂直加权、水平两两合并及归一化提供SSE2、AVX2、NEON实现（结果与标量实现逐位一致），水平加权为标量实现
+ */
+
+// 定点权重的小数位数（每个目标采样的权重之和为1 << 14）
+static const int RESIZE_WEIGHT_BITS = 14;
+// 垂直加权后中间行保留的小数位数（中间值不超过255 << 7，可用int16表示）
+static const int RESIZE_ROW_BITS = 7;
+// 求和快速路径的最大缩小倍数
+static const uint32_t RESIZE_MAX_SUM_FACTOR = 4;
+
+/**
+ * @brief 平面的缩放布局
+ */
+struct ResizePlaneLayout {
+	// 是否为打包YUV 4:2:2（否则每个采样位置连续存放bytesPerPixel个通道）
+	bool packedYuv;
+	// 打包YUV亮度是否位于每组的第0、2字节
+	bool lumaFirst;
+	// 每个采样位置的字节数（打包YUV为2）
+	uint32_t bytesPerPixel;
+	// 源平面每行采样位置数
+	uint32_t srcWidth;
+	// 源平面行数
+	uint32_t srcHeight;
+	// 目标平面每行采样位置数
+	uint32_t dstWidth;
+	// 目标平面行数
+	uint32_t dstHeight;
+};
+
+/**
+ * @brief 平面中独立采样的一个通道
+ */
+struct ResizeChannel {
+	// 首个采样在行内的字节偏移
+	uint32_t offset;
+	// 相邻采样的字节距离
+	uint32_t step;
+	// 源行采样数
+	uint32_t srcCount;
+	// 目标行采样数
+	uint32_t dstCount;
+};
+
+/**
+ * @brief 一维重采样权重表
+ */
+struct ResizeTaps {
+	// 每个目标采样的首个源采样序号
+	std::vector<uint32_t> first;
+	// 每个目标采样的权重个数
+	std::vector<uint32_t> count;
+	// 权重（每个目标采样占maxTaps个，定点表示，均为非负数）
+	std::vector<int16_t> weights;
+	// 单个目标采样的最大权重个数
+	uint32_t maxTaps;
+};
+
+/**
+ * @brief 判断格式是否支持缩放
+ *
+ * @param format [in] 格式（FOURCC表示）
+ * @return 是否支持
+ */
+static bool CanResizeImage(const uint32_t format) {
+	return GetImagePlaneCount(format) > 0;
+}
+
+/**
+ * @brief 判断滤波方式是否有效
+ *
+ * @param filter [in] 滤波方式
+ * @return 是否有效
+ */
+static bool IsResizeFilterValid(const ResizeFilter filter) {
+	return filter == ResizeFilter::RESIZE_FILTER_BOX || filter == ResizeFilter::RESIZE_FILTER_BILINEAR || filter == ResizeFilter::RESIZE_FILTER_AREA;
+}
+
+/**
+ * @brief 获取平面的缩放布局
+ *
+ * @param format [in] 格式（FOURCC表示）
+ * @param plane [in] 平面序号
+ * @param src [in] 源图像
+ * @param dst [in] 目标图像
+ * @param layout [out] 缩放布局
+ */
+static void GetResizePlaneLayout(const uint32_t format, const uint32_t plane, const ImageBuffer& src, const ImageBuffer& dst,
+								 ResizePlaneLayout& layout) {
+	bool first = true;
+	bool second = true;
+	uint32_t bytesPerPixel = 0;
+	layout.lumaFirst = true;
+	layout.packedYuv = GetPackedYuvOrder(format, layout.lumaFirst, second);
+	if (layout.packedYuv) {
+		layout.bytesPerPixel = 2;
+	} else if (GetRgbOrder(format, first, bytesPerPixel)) {
+		layout.bytesPerPixel = bytesPerPixel;
+	} else {
+		// 半平面格式的色度平面每个采样位置为交织的两个色度
+		layout.bytesPerPixel = plane > 0 && GetSemiPlanarOrder(format, second) ? 2 : 1;
+	}
+	// 4:2:0的色度平面宽高减半（向上取整）
+	layout.srcWidth = plane > 0 ? (src.width + 1) / 2 : src.width;
+	layout.dstWidth = plane > 0 ? (dst.width + 1) / 2 : dst.width;
+	layout.srcHeight = GetImagePlaneHeight(format, src.height, plane);
+	layout.dstHeight = GetImagePlaneHeight(format, dst.height, plane);
+}
+
+/**
+ * @brief 获取平面中独立采样的通道
+ *
+ * @param layout [in] 缩放布局
+ * @param channels [out] 通道列表
+ */
+static void GetResizeChannels(const ResizePlaneLayout& layout, std::vector<ResizeChannel>& channels) {
+	channels.clear();
+	if (layout.packedYuv) {
+		// 亮度每2字节一个采样，两个色度每4字节一个采样
+		auto lumaOffset = layout.lumaFirst ? 0u : 1u;
+		auto chromaOffset = layout.lumaFirst ? 1u : 0u;
+		channels.push_back({lumaOffset, 2, layout.srcWidth, layout.dstWidth});
+		channels.push_back({chromaOffset, 4, (layout.srcWidth + 1) / 2, (layout.dstWidth + 1) / 2});
+		channels.push_back({chromaOffset + 2, 4, (layout.srcWidth + 1) / 2, (layout.dstWidth + 1) / 2});
+		return;
+	}
+	for (uint32_t i = 0; i < layout.bytesPerPixel; i++) {
+		channels.push_back({i, layout.bytesPerPixel, layout.srcWidth, layout.dstWidth});
+	}
+}
+
+/**
+ * @brief 获取求和快速路径的缩小倍数
+ *
+ * @param layout [in] 缩放布局
+ * @param filter [in] 滤波方式
+ * @return 缩小倍数（为1时不适用）
+ */
+static uint32_t GetResizeSumFactor(const ResizePlaneLayout& layout, const ResizeFilter filter) {
+	for (uint32_t factor = 2; factor <= RESIZE_MAX_SUM_FACTOR; factor++) {
+		// 双线性只在1/2时恰好等于2x2平均
+		if (filter == ResizeFilter::RESIZE_FILTER_BILINEAR && factor != 2) {
+			continue;
+		}
+		// 打包YUV的目标宽度需为偶数（每组色度恰好由factor组合并而来）
+		if (layout.srcWidth == layout.dstWidth * factor && layout.srcHeight == layout.dstHeight * factor &&
+			(!layout.packedYuv || layout.dstWidth % 2 == 0)) {
+			return factor;
+		}
+	}
+	return 1;
+}
+
+/**
+ * @brief 生成一维重采样权重表（整数运算，与平台无关）
+ *
+ * @param srcCount [in] 源采样数
+ * @param dstCount [in] 目标采样数
+ * @param filter [in] 滤波方式
+ * @param taps [out] 权重表
+ */
+static void BuildResizeTaps(const uint32_t srcCount, const uint32_t dstCount, const ResizeFilter filter, ResizeTaps& taps) {
+	const int32_t one = 1 << RESIZE_WEIGHT_BITS;
+	switch (filter) {
+		case ResizeFilter::RESIZE_FILTER_BILINEAR:
+			taps.maxTaps = 2;
+			break;
+		case ResizeFilter::RESIZE_FILTER_BOX:
+			taps.maxTaps = (srcCount + dstCount - 1) / dstCount;
+			break;
+		default:
+			taps.maxTaps = (srcCount + dstCount - 1) / dstCount + 1;
+			break;
+	}
+	taps.first.assign(dstCount, 0);
+	taps.count.assign(dstCount, 0);
+	taps.weights.assign(size_t(dstCount) * taps.maxTaps, 0);
+	for (uint32_t i = 0; i < dstCount; i++) {
+		auto weights = taps.weights.data() + size_t(i) * taps.maxTaps;
+		if (filter == ResizeFilter::RESIZE_FILTER_BILINEAR) {
+			// 像素中心对齐：源坐标为(i + 0.5) * src / dst - 0.5，以1 / (2 * dst)为单位计算
+			auto unit = int64_t(dstCount) * 2;
+			auto center = int64_t(i * 2 + 1) * srcCount - dstCount;
+			auto index = center > 0 ? uint32_t(center / unit) : 0;
+			if (center <= 0 || index + 1 >= srcCount) {
+				// 超出边界时取最近的边缘采样
+				taps.first[i] = center <= 0 ? 0 : srcCount - 1;
+				taps.count[i] = 1;
+				weights[0] = int16_t(one);
+				continue;
+			}
+			auto next = int32_t(((center % unit) * one + unit / 2) / unit);
+			taps.first[i] = index;
+			taps.count[i] = 2;
+			weights[0] = int16_t(one - next);
+			weights[1] = int16_t(next);
+		} else if (filter == ResizeFilter::RESIZE_FILTER_BOX) {
+			// 等权平均映射区间内的源采样（放大时取左侧最近的采样）
+			auto begin = uint32_t(uint64_t(i) * srcCount / dstCount);
+			auto end = std::max(begin + 1, uint32_t(uint64_t(i + 1) * srcCount / dstCount));
+			auto count = end - begin;
+			taps.first[i] = begin;
+			taps.count[i] = count;
+			for (uint32_t t = 0; t < count; t++) {
+				weights[t] = int16_t(one / count + (t < one % count ? 1 : 0));
+			}
+		} else {
+			// 按覆盖面积加权：目标采样覆盖[i * src, (i + 1) * src)，源采样覆盖[s * dst, (s + 1) * dst)，以1 / dst为单位
+			auto footBegin = uint64_t(i) * srcCount;
+			auto footEnd = uint64_t(i + 1) * srcCount;
+			auto begin = uint32_t(footBegin / dstCount);
+			auto end = uint32_t((footEnd + dstCount - 1) / dstCount);
+			taps.first[i] = begin;
+			taps.count[i] = end - begin;
+			int32_t total = 0;
+			uint32_t largest = 0;
+			for (uint32_t s = begin; s < end; s++) {
+				auto overlap = std::min(uint64_t(s + 1) * dstCount, footEnd) - std::max(uint64_t(s) * dstCount, footBegin);
+				weights[s - begin] = int16_t(overlap * one / srcCount);
+				total += weights[s - begin];
+				if (weights[s - begin] > weights[largest]) {
+					largest = s - begin;
+				}
+			}
+			// 截断误差补到最大的权重上，保证权重之和恰好为1
+			weights[largest] = int16_t(weights[largest] + one - total);
+		}
+	}
+}
+
+/**
+ * @brief 逐字节累加多行（求和快速路径的垂直合并）
+ *
+ * @param rows [in] 源行（不超过RESIZE_MAX_SUM_FACTOR行）
+ * @param rowCount [in] 行数
+ * @param dst [out] 各字节之和
+ * @param size [in] 每行字节数
+ */
+static void SumResizeRowsScalar(const uint8_t* const* rows, const uint32_t rowCount, uint16_t* dst, const size_t size) {
+	for (size_t i = 0; i < size; i++) {
+		uint16_t sum = 0;
+		for (uint32_t k = 0; k < rowCount; k++) {
+			sum = uint16_t(sum + rows[k][i]);
+		}
+		dst[i] = sum;
+	}
+}
+
+/**
+ * @brief 逐字节对多行加权（通用路径的垂直重采样）
+ *
+ * @param rows [in] 源行
+ * @param weights [in] 各行的权重（之和为1 << RESIZE_WEIGHT_BITS）
+ * @param rowCount [in] 行数
+ * @param dst [out] 加权结果（带RESIZE_ROW_BITS位小数）
+ * @param size [in] 每行字节数
+ */
+static void BlendResizeRowsScalar(const uint8_t* const* rows, const int16_t* weights, const uint32_t rowCount, int16_t* dst, const size_t size) {
+	for (size_t i = 0; i < size; i++) {
+		int32_t sum = 1 << (RESIZE_WEIGHT_BITS - RESIZE_ROW_BITS - 1);
+		for (uint32_t k = 0; k < rowCount; k++) {
+			sum += weights[k] * rows[k][i];
+		}
+		dst[i] = int16_t(sum >> (RESIZE_WEIGHT_BITS - RESIZE_ROW_BITS));
+	}
+}
+
+/**
+ * @brief 水平方向每两个采样合并为一个（求和快速路径）
+ *
+ * @param src [in] 源行各字节之和（2 * width个采样位置）
+ * @param dst [out] 合并结果（width个采样位置）
+ * @param width [in] 目标采样位置数（打包YUV为偶数）
+ * @param bytesPerPixel [in] 每个采样位置的字节数
+ * @param packedYuv [in] 是否为打包YUV 4:2:2（色度按组合并）
+ * @param lumaFirst [in] 打包YUV亮度是否位于每组的第0、2字节
+ */
+static void ReduceResizePairsScalar(const uint16_t* src, uint16_t* dst, const size_t width, const uint32_t bytesPerPixel, const bool packedYuv,
+									const bool lumaFirst) {
+	if (packedYuv) {
+		// 输出的每组由输入的相邻两组合并：亮度两两相加，色度与下一组的同名色度相加
+		auto lumaOffset = lumaFirst ? 0 : 1;
+		auto chromaOffset = lumaFirst ? 1 : 0;
+		for (size_t x = 0; x < width; x += 2) {
+			auto in = src + x * 4;
+			auto out = dst + x * 2;
+			out[lumaOffset] = uint16_t(in[lumaOffset] + in[lumaOffset + 2]);
+			out[lumaOffset + 2] = uint16_t(in[lumaOffset + 4] + in[lumaOffset + 6]);
+			out[chromaOffset] = uint16_t(in[chromaOffset] + in[chromaOffset + 4]);
+			out[chromaOffset + 2] = uint16_t(in[chromaOffset + 2] + in[chromaOffset + 6]);
+		}
+		return;
+	}
+	for (size_t x = 0; x < width; x++) {
+		for (uint32_t c = 0; c < bytesPerPixel; c++) {
+			dst[x * bytesPerPixel + c] = uint16_t(src[x * 2 * bytesPerPixel + c] + src[(x * 2 + 1) * bytesPerPixel + c]);
+		}
+	}
+}
+
+/**
+ * @brief 水平方向每factor个采样合并为一个（适用于任意倍数，用于1/3）
+ *
+ * @param src [in] 源行各字节之和
+ * @param dst [out] 合并结果
+ * @param channels [in] 通道列表
+ * @param factor [in] 缩小倍数
+ */
+static void ReduceResizeSamplesScalar(const uint16_t* src, uint16_t* dst, const std::vector<ResizeChannel>& channels, const uint32_t factor) {
+	for (auto& channel : channels) {
+		for (size_t i = 0; i < channel.dstCount; i++) {
+			auto sample = src + channel.offset + i * factor * channel.step;
+			uint16_t sum = 0;
+			for (uint32_t k = 0; k < factor; k++) {
+				sum = uint16_t(sum + sample[k * channel.step]);
+			}
+			dst[channel.offset + i * channel.step] = sum;
+		}
+	}
+}
+
+/**
+ * @brief 将factor * factor个像素之和除以个数并四舍五入
+ *
+ * @param src [in] 各字节之和
+ * @param dst [out] 平均值
+ * @param size [in] 字节数
+ * @param factor [in] 缩小倍数
+ */
+static void NormalizeResizeRowScalar(const uint16_t* src, uint8_t* dst, const size_t size, const uint32_t factor) {
+	auto count = factor * factor;
+	for (size_t i = 0; i < size; i++) {
+		dst[i] = uint8_t((src[i] + count / 2) / count);
+	}
+}
+
+/**
+ * @brief 按权重表水平重采样一个通道
+ *
+ * @param src [in] 垂直加权后的中间行
+ * @param dst [out] 目标行
+ * @param channel [in] 通道
+ * @param taps [in] 权重表
+ */
+static void ResampleResizeRowScalar(const int16_t* src, uint8_t* dst, const ResizeChannel& channel, const ResizeTaps& taps) {
+	for (size_t i = 0; i < channel.dstCount; i++) {
+		auto weights = taps.weights.data() + i * taps.maxTaps;
+		auto sample = src + channel.offset + size_t(taps.first[i]) * channel.step;
+		int32_t sum = 1 << (RESIZE_WEIGHT_BITS + RESIZE_ROW_BITS - 1);
+		for (uint32_t t = 0; t < taps.count[i]; t++) {
+			sum += weights[t] * sample[t * channel.step];
+		}
+		dst[channel.offset + i * channel.step] = uint8_t(sum >> (RESIZE_WEIGHT_BITS + RESIZE_ROW_BITS));
+	}
+}
+
+#if defined(BECAM_SIMD_X86)
+/**
+ * @brief 逐字节累加多行（SSE2，每次16字节）
+ */
+static void SumResizeRowsSse2(const uint8_t* const* rows, const uint32_t rowCount, uint16_t* dst, const size_t size) {
+	auto zero = _mm_setzero_si128();
+	size_t i = 0;
+	for (; i + 16 <= size; i += 16) {
+		auto lo = _mm_setzero_si128();
+		auto hi = _mm_setzero_si128();
+		for (uint32_t k = 0; k < rowCount; k++) {
+			auto value = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rows[k] + i));
+			lo = _mm_add_epi16(lo, _mm_unpacklo_epi8(value, zero));
+			hi = _mm_add_epi16(hi, _mm_unpackhi_epi8(value, zero));
+		}
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), lo);
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i + 8), hi);
+	}
+	const uint8_t* rest[RESIZE_MAX_SUM_FACTOR];
+	for (uint32_t k = 0; k < rowCount; k++) {
+		rest[k] = rows[k] + i;
+	}
+	SumResizeRowsScalar(rest, rowCount, dst + i, size - i);
+}
+
+/**
+ * @brief 逐字节对多行加权（SSE2，每次16字节，相邻两行交织后与成对的权重乘加）
+ */
+static void BlendResizeRowsSse2(const uint8_t* const* rows, const int16_t* weights, const uint32_t rowCount, int16_t* dst, const size_t size) {
+	auto zero = _mm_setzero_si128();
+	auto round = _mm_set1_epi32(1 << (RESIZE_WEIGHT_BITS - RESIZE_ROW_BITS - 1));
+	size_t i = 0;
+	for (; i + 16 <= size; i += 16) {
+		__m128i acc[4] = {round, round, round, round};
+		for (uint32_t k = 0; k < rowCount; k += 2) {
+			auto second = k + 1 < rowCount;
+			auto a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rows[k] + i));
+			auto b = second ? _mm_loadu_si128(reinterpret_cast<const __m128i*>(rows[k + 1] + i)) : zero;
+			auto weight = _mm_set1_epi32(int32_t(uint32_t(uint16_t(weights[k])) | (uint32_t(uint16_t(second ? weights[k + 1] : 0)) << 16)));
+			auto lo = _mm_unpacklo_epi8(a, b);
+			auto hi = _mm_unpackhi_epi8(a, b);
+			acc[0] = _mm_add_epi32(acc[0], _mm_madd_epi16(_mm_unpacklo_epi8(lo, zero), weight));
+			acc[1] = _mm_add_epi32(acc[1], _mm_madd_epi16(_mm_unpackhi_epi8(lo, zero), weight));
+			acc[2] = _mm_add_epi32(acc[2], _mm_madd_epi16(_mm_unpacklo_epi8(hi, zero), weight));
+			acc[3] = _mm_add_epi32(acc[3], _mm_madd_epi16(_mm_unpackhi_epi8(hi, zero), weight));
+		}
+		for (int j = 0; j < 4; j++) {
+			acc[j] = _mm_srai_epi32(acc[j], RESIZE_WEIGHT_BITS - RESIZE_ROW_BITS);
+		}
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_packs_epi32(acc[0], acc[1]));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i + 8), _mm_packs_epi32(acc[2], acc[3]));
+	}
+	std::vector<const uint8_t*> rest(rows, rows + rowCount);
+	for (auto& row : rest) {
+		row += i;
+	}
+	BlendResizeRowsScalar(rest.data(), weights, rowCount, dst + i, size - i);
+}
+
+/**
+ * @brief 打包YUV 4:2:2相邻两组合并为一组（结果位于低64位）
+ */
+static inline __m128i ReducePackedYuvPairSse2(const __m128i value, const __m128i evenMask, const bool lumaFirst) {
+	// 亮度与相隔2个采样的亮度相加，色度与相隔4个采样（下一组）的同名色度相加
+	auto luma = _mm_add_epi16(value, _mm_srli_si128(value, 4));
+	auto chroma = _mm_add_epi16(value, _mm_srli_si128(value, 8));
+	// 第二组的亮度之和位于第4、5个采样，移到第2、3个采样
+	luma = _mm_shuffle_epi32(luma, _MM_SHUFFLE(3, 3, 2, 0));
+	if (lumaFirst) {
+		return _mm_or_si128(_mm_and_si128(luma, evenMask), _mm_andnot_si128(evenMask, chroma));
+	}
+	return _mm_or_si128(_mm_and_si128(chroma, evenMask), _mm_andnot_si128(evenMask, luma));
+}
+
+/**
+ * @brief 水平方向每两个采样合并为一个（SSE2，每次8个输出，每像素3字节时使用标量实现）
+ */
+static void ReduceResizePairsSse2(const uint16_t* src, uint16_t* dst, const size_t width, const uint32_t bytesPerPixel, const bool packedYuv,
+								  const bool lumaFirst) {
+	if (!packedYuv && bytesPerPixel == 3) {
+		return ReduceResizePairsScalar(src, dst, width, bytesPerPixel, packedYuv, lumaFirst);
+	}
+	auto size = width * bytesPerPixel;
+	auto ones = _mm_set1_epi16(1);
+	auto evenMask = _mm_set1_epi32(0x0000FFFF);
+	size_t i = 0;
+	for (; i + 8 <= size; i += 8) {
+		auto v0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 2));
+		auto v1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 2 + 8));
+		__m128i sum;
+		if (packedYuv) {
+			sum = _mm_unpacklo_epi64(ReducePackedYuvPairSse2(v0, evenMask, lumaFirst), ReducePackedYuvPairSse2(v1, evenMask, lumaFirst));
+		} else if (bytesPerPixel == 1) {
+			// 和不超过4080，有符号乘加及收窄不会溢出
+			sum = _mm_packs_epi32(_mm_madd_epi16(v0, ones), _mm_madd_epi16(v1, ones));
+		} else {
+			// 每像素2字节时先把偶数、奇数像素分别集中到低、高64位
+			if (bytesPerPixel == 2) {
+				v0 = _mm_shuffle_epi32(v0, _MM_SHUFFLE(3, 1, 2, 0));
+				v1 = _mm_shuffle_epi32(v1, _MM_SHUFFLE(3, 1, 2, 0));
+			}
+			sum = _mm_add_epi16(_mm_unpacklo_epi64(v0, v1), _mm_unpackhi_epi64(v0, v1));
+		}
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), sum);
+	}
+	ReduceResizePairsScalar(src + i * 2, dst + i, width - i / bytesPerPixel, bytesPerPixel, packedYuv, lumaFirst);
+}
+
+/**
+ * @brief 将像素之和除以个数并四舍五入（SSE2，每次16字节，用无符号高16位乘法代替除法，在和的取值范围内结果精确）
+ */
+static void NormalizeResizeRowSse2(const uint16_t* src, uint8_t* dst, const size_t size, const uint32_t factor) {
+	auto count = factor * factor;
+	auto half = _mm_set1_epi16(int16_t(count / 2));
+	auto reciprocal = _mm_set1_epi16(int16_t((65536 + count - 1) / count));
+	size_t i = 0;
+	for (; i + 16 <= size; i += 16) {
+		auto a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+		auto b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + 8));
+		a = _mm_mulhi_epu16(_mm_add_epi16(a, half), reciprocal);
+		b = _mm_mulhi_epu16(_mm_add_epi16(b, half), reciprocal);
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_packus_epi16(a, b));
+	}
+	NormalizeResizeRowScalar(src + i, dst + i, size - i, factor);
+}
+
+/**
+ * @brief 逐字节累加多行（AVX2，每次32字节）
+ */
+BECAM_TARGET_AVX2 static void SumResizeRowsAvx2(const uint8_t* const* rows, const uint32_t rowCount, uint16_t* dst, const size_t size) {
+	size_t i = 0;
+	for (; i + 32 <= size; i += 32) {
+		auto lo = _mm256_setzero_si256();
+		auto hi = _mm256_setzero_si256();
+		for (uint32_t k = 0; k < rowCount; k++) {
+			auto value = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rows[k] + i));
+			lo = _mm256_add_epi16(lo, _mm256_cvtepu8_epi16(_mm256_castsi256_si128(value)));
+			hi = _mm256_add_epi16(hi, _mm256_cvtepu8_epi16(_mm256_extracti128_si256(value, 1)));
+		}
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), lo);
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i + 16), hi);
+	}
+	const uint8_t* rest[RESIZE_MAX_SUM_FACTOR];
+	for (uint32_t k = 0; k < rowCount; k++) {
+		rest[k] = rows[k] + i;
+	}
+	SumResizeRowsSse2(rest, rowCount, dst + i, size - i);
+}
+
+/**
+ * @brief 逐字节对多行加权（AVX2，每次32字节，通道内交织及收窄后顺序不变）
+ */
+BECAM_TARGET_AVX2 static void BlendResizeRowsAvx2(const uint8_t* const* rows, const int16_t* weights, const uint32_t rowCount, int16_t* dst,
+												  const size_t size) {
+	auto zero = _mm256_setzero_si256();
+	auto round = _mm256_set1_epi32(1 << (RESIZE_WEIGHT_BITS - RESIZE_ROW_BITS - 1));
+	size_t i = 0;
+	for (; i + 32 <= size; i += 32) {
+		__m256i acc[4] = {round, round, round, round};
+		for (uint32_t k = 0; k < rowCount; k += 2) {
+			auto second = k + 1 < rowCount;
+			auto a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rows[k] + i));
+			auto b = second ? _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rows[k + 1] + i)) : zero;
+			auto weight = _mm256_set1_epi32(int32_t(uint32_t(uint16_t(weights[k])) | (uint32_t(uint16_t(second ? weights[k + 1] : 0)) << 16)));
+			auto aLo = _mm256_cvtepu8_epi16(_mm256_castsi256_si128(a));
+			auto aHi = _mm256_cvtepu8_epi16(_mm256_extracti128_si256(a, 1));
+			auto bLo = _mm256_cvtepu8_epi16(_mm256_castsi256_si128(b));
+			auto bHi = _mm256_cvtepu8_epi16(_mm256_extracti128_si256(b, 1));
+			acc[0] = _mm256_add_epi32(acc[0], _mm256_madd_epi16(_mm256_unpacklo_epi16(aLo, bLo), weight));
+			acc[1] = _mm256_add_epi32(acc[1], _mm256_madd_epi16(_mm256_unpackhi_epi16(aLo, bLo), weight));
+			acc[2] = _mm256_add_epi32(acc[2], _mm256_madd_epi16(_mm256_unpacklo_epi16(aHi, bHi), weight));
+			acc[3] = _mm256_add_epi32(acc[3], _mm256_madd_epi16(_mm256_unpackhi_epi16(aHi, bHi), weight));
+		}
+		for (int j = 0; j < 4; j++) {
+			acc[j] = _mm256_srai_epi32(acc[j], RESIZE_WEIGHT_BITS - RESIZE_ROW_BITS);
+		}
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_packs_epi32(acc[0], acc[1]));
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i + 16), _mm256_packs_epi32(acc[2], acc[3]));
+	}
+	std::vector<const uint8_t*> rest(rows, rows + rowCount);
+	for (auto& row : rest) {
+		row += i;
+	}
+	BlendResizeRowsSse2(rest.data(), weights, rowCount, dst + i, size - i);
+}
+
+/**
+ * @brief 打包YUV 4:2:2相邻两组合并为一组（AVX2，每个128位通道的结果位于低64位）
+ */
+BECAM_TARGET_AVX2 static inline __m256i ReducePackedYuvPairAvx2(const __m256i value, const __m256i evenMask, const bool lumaFirst) {
+	auto luma = _mm256_add_epi16(value, _mm256_srli_si256(value, 4));
+	auto chroma = _mm256_add_epi16(value, _mm256_srli_si256(value, 8));
+	luma = _mm256_shuffle_epi32(luma, _MM_SHUFFLE(3, 3, 2, 0));
+	if (lumaFirst) {
+		return _mm256_or_si256(_mm256_and_si256(luma, evenMask), _mm256_andnot_si256(evenMask, chroma));
+	}
+	return _mm256_or_si256(_mm256_and_si256(chroma, evenMask), _mm256_andnot_si256(evenMask, luma));
+}
+
+/**
+ * @brief 水平方向每两个采样合并为一个（AVX2，每次16个输出，通道内合并后64位块顺序为[0, 2, 1, 3]）
+ */
+BECAM_TARGET_AVX2 static void ReduceResizePairsAvx2(const uint16_t* src, uint16_t* dst, const size_t width, const uint32_t bytesPerPixel,
+													const bool packedYuv, const bool lumaFirst) {
+	if (!packedYuv && bytesPerPixel == 3) {
+		return ReduceResizePairsScalar(src, dst, width, bytesPerPixel, packedYuv, lumaFirst);
+	}
+	auto size = width * bytesPerPixel;
+	auto ones = _mm256_set1_epi16(1);
+	auto evenMask = _mm256_set1_epi32(0x0000FFFF);
+	size_t i = 0;
+	for (; i + 16 <= size; i += 16) {
+		auto v0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i * 2));
+		auto v1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i * 2 + 16));
+		__m256i sum;
+		if (packedYuv) {
+			sum = _mm256_unpacklo_epi64(ReducePackedYuvPairAvx2(v0, evenMask, lumaFirst), ReducePackedYuvPairAvx2(v1, evenMask, lumaFirst));
+		} else if (bytesPerPixel == 1) {
+			sum = _mm256_packs_epi32(_mm256_madd_epi16(v0, ones), _mm256_madd_epi16(v1, ones));
+		} else {
+			if (bytesPerPixel == 2) {
+				v0 = _mm256_shuffle_epi32(v0, _MM_SHUFFLE(3, 1, 2, 0));
+				v1 = _mm256_shuffle_epi32(v1, _MM_SHUFFLE(3, 1, 2, 0));
+			}
+			sum = _mm256_add_epi16(_mm256_unpacklo_epi64(v0, v1), _mm256_unpackhi_epi64(v0, v1));
+		}
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_permute4x64_epi64(sum, 0xD8));
+	}
+	ReduceResizePairsSse2(src + i * 2, dst + i, width - i / bytesPerPixel, bytesPerPixel, packedYuv, lumaFirst);
+}
+
+/**
+ * @brief 将像素之和除以个数并四舍五入（AVX2，每次32字节）
+ */
+BECAM_TARGET_AVX2 static void NormalizeResizeRowAvx2(const uint16_t* src, uint8_t* dst, const size_t size, const uint32_t factor) {
+	auto count = factor * factor;
+	auto half = _mm256_set1_epi16(int16_t(count / 2));
+	auto reciprocal = _mm256_set1_epi16(int16_t((65536 + count - 1) / count));
+	size_t i = 0;
+	for (; i + 32 <= size; i += 32) {
+		auto a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+		auto b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i + 16));
+		a = _mm256_mulhi_epu16(_mm256_add_epi16(a, half), reciprocal);
+		b = _mm256_mulhi_epu16(_mm256_add_epi16(b, half), reciprocal);
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_permute4x64_epi64(_mm256_packus_epi16(a, b), 0xD8));
+	}
+	NormalizeResizeRowSse2(src + i, dst + i, size - i, factor);
+}
+#endif
+
+#if defined(BECAM_SIMD_NEON)
+/**
+ * @brief 逐字节累加多行（NEON，每次16字节）
+ */
+static void SumResizeRowsNeon(const uint8_t* const* rows, const uint32_t rowCount, uint16_t* dst, const size_t size) {
+	size_t i = 0;
+	for (; i + 16 <= size; i += 16) {
+		auto lo = vdupq_n_u16(0);
+		auto hi = vdupq_n_u16(0);
+		for (uint32_t k = 0; k < rowCount; k++) {
+			auto value = vld1q_u8(rows[k] + i);
+			lo = vaddw_u8(lo, vget_low_u8(value));
+			hi = vaddw_u8(hi, vget_high_u8(value));
+		}
+		vst1q_u16(dst + i, lo);
+		vst1q_u16(dst + i + 8, hi);
+	}
+	const uint8_t* rest[RESIZE_MAX_SUM_FACTOR];
+	for (uint32_t k = 0; k < rowCount; k++) {
+		rest[k] = rows[k] + i;
+	}
+	SumResizeRowsScalar(rest, rowCount, dst + i, size - i);
+}
+
+/**
+ * @brief 逐字节对多行加权（NEON，每次16字节）
+ */
+static void BlendResizeRowsNeon(const uint8_t* const* rows, const int16_t* weights, const uint32_t rowCount, int16_t* dst, const size_t size) {
+	auto round = vdupq_n_s32(1 << (RESIZE_WEIGHT_BITS - RESIZE_ROW_BITS - 1));
+	size_t i = 0;
+	for (; i + 16 <= size; i += 16) {
+		int32x4_t acc[4] = {round, round, round, round};
+		for (uint32_t k = 0; k < rowCount; k++) {
+			auto value = vld1q_u8(rows[k] + i);
+			auto lo = vreinterpretq_s16_u16(vmovl_u8(vget_low_u8(value)));
+			auto hi = vreinterpretq_s16_u16(vmovl_u8(vget_high_u8(value)));
+			acc[0] = vmlal_n_s16(acc[0], vget_low_s16(lo), weights[k]);
+			acc[1] = vmlal_n_s16(acc[1], vget_high_s16(lo), weights[k]);
+			acc[2] = vmlal_n_s16(acc[2], vget_low_s16(hi), weights[k]);
+			acc[3] = vmlal_n_s16(acc[3], vget_high_s16(hi), weights[k]);
+		}
+		vst1q_s16(dst + i, vcombine_s16(vshrn_n_s32(acc[0], RESIZE_WEIGHT_BITS - RESIZE_ROW_BITS), vshrn_n_s32(acc[1], RESIZE_WEIGHT_BITS - RESIZE_ROW_BITS)));
+		vst1q_s16(dst + i + 8,
+				  vcombine_s16(vshrn_n_s32(acc[2], RESIZE_WEIGHT_BITS - RESIZE_ROW_BITS), vshrn_n_s32(acc[3], RESIZE_WEIGHT_BITS - RESIZE_ROW_BITS)));
+	}
+	std::vector<const uint8_t*> rest(rows, rows + rowCount);
+	for (auto& row : rest) {
+		row += i;
+	}
+	BlendResizeRowsScalar(rest.data(), weights, rowCount, dst + i, size - i);
+}
+
+/**
+ * @brief 水平方向每两个采样合并为一个（NEON，每次8或16个输出，每像素3字节时使用标量实现）
+ */
+static void ReduceResizePairsNeon(const uint16_t* src, uint16_t* dst, const size_t width, const uint32_t bytesPerPixel, const bool packedYuv,
+								  const bool lumaFirst) {
+	if (!packedYuv && bytesPerPixel == 3) {
+		return ReduceResizePairsScalar(src, dst, width, bytesPerPixel, packedYuv, lumaFirst);
+	}
+	auto size = width * bytesPerPixel;
+	size_t i = 0;
+	if (packedYuv) {
+		// 按组内位置解交织8组，亮度先组内相加再按奇偶分给输出的两个亮度，色度相邻两组相加
+		auto lumaIndex = lumaFirst ? 0 : 1;
+		auto chromaIndex = lumaFirst ? 1 : 0;
+		for (; i + 16 <= size; i += 16) {
+			auto value = vld4q_u16(src + i * 2);
+			auto luma = vaddq_u16(value.val[lumaIndex], value.val[lumaIndex + 2]);
+			uint16x4x4_t out;
+			out.val[lumaIndex] = vget_low_u16(vuzp1q_u16(luma, luma));
+			out.val[lumaIndex + 2] = vget_low_u16(vuzp2q_u16(luma, luma));
+			out.val[chromaIndex] = vget_low_u16(vpaddq_u16(value.val[chromaIndex], value.val[chromaIndex]));
+			out.val[chromaIndex + 2] = vget_low_u16(vpaddq_u16(value.val[chromaIndex + 2], value.val[chromaIndex + 2]));
+			vst4_u16(dst + i, out);
+		}
+	} else {
+		for (; i + 8 <= size; i += 8) {
+			auto v0 = vld1q_u16(src + i * 2);
+			auto v1 = vld1q_u16(src + i * 2 + 8);
+			uint16x8_t sum;
+			if (bytesPerPixel == 1) {
+				sum = vpaddq_u16(v0, v1);
+			} else if (bytesPerPixel == 2) {
+				auto a = vreinterpretq_u32_u16(v0);
+				auto b = vreinterpretq_u32_u16(v1);
+				sum = vaddq_u16(vreinterpretq_u16_u32(vuzp1q_u32(a, b)), vreinterpretq_u16_u32(vuzp2q_u32(a, b)));
+			} else {
+				auto a = vreinterpretq_u64_u16(v0);
+				auto b = vreinterpretq_u64_u16(v1);
+				sum = vaddq_u16(vreinterpretq_u16_u64(vuzp1q_u64(a, b)), vreinterpretq_u16_u64(vuzp2q_u64(a, b)));
+			}
+			vst1q_u16(dst + i, sum);
+		}
+	}
+	ReduceResizePairsScalar(src + i * 2, dst + i, width - i / bytesPerPixel, bytesPerPixel, packedYuv, lumaFirst);
+}
+
+/**
+ * @brief 将像素之和除以个数并四舍五入（NEON，每次8字节）
+ */
+static void NormalizeResizeRowNeon(const uint16_t* src, uint8_t* dst, const size_t size, const uint32_t factor) {
+	auto count = factor * factor;
+	auto half = vdupq_n_u16(uint16_t(count / 2));
+	auto reciprocal = vdup_n_u16(uint16_t((65536 + count - 1) / count));
+	size_t i = 0;
+	for (; i + 8 <= size; i += 8) {
+		auto value = vaddq_u16(vld1q_u16(src + i), half);
+		auto lo = vshrn_n_u32(vmull_u16(vget_low_u16(value), reciprocal), 16);
+		auto hi = vshrn_n_u32(vmull_u16(vget_high_u16(value), reciprocal), 16);
+		vst1_u8(dst + i, vmovn_u16(vcombine_u16(lo, hi)));
+	}
+	NormalizeResizeRowScalar(src + i, dst + i, size - i, factor);
+}
+#endif
+
+/**
+ * @brief 逐字节累加多行
+ */
+static void SumResizeRows(const uint8_t* const* rows, const uint32_t rowCount, uint16_t* dst, const size_t size, const SimdLevel level) {
+	switch (level) {
+#if defined(BECAM_SIMD_X86)
+		case SimdLevel::AVX2:
+			return SumResizeRowsAvx2(rows, rowCount, dst, size);
+		case SimdLevel::SSE2:
+			return SumResizeRowsSse2(rows, rowCount, dst, size);
+#endif
+#if defined(BECAM_SIMD_NEON)
+		case SimdLevel::NEON:
+			return SumResizeRowsNeon(rows, rowCount, dst, size);
+#endif
+		default:
+			return SumResizeRowsScalar(rows, rowCount, dst, size);
+	}
+}
+
+/**
+ * @brief 逐字节对多行加权
+ */
+static void BlendResizeRows(const uint8_t* const* rows, const int16_t* weights, const uint32_t rowCount, int16_t* dst, const size_t size,
+							const SimdLevel level) {
+	switch (level) {
+#if defined(BECAM_SIMD_X86)
+		case SimdLevel::AVX2:
+			return BlendResizeRowsAvx2(rows, weights, rowCount, dst, size);
+		case SimdLevel::SSE2:
+			return BlendResizeRowsSse2(rows, weights, rowCount, dst, size);
+#endif
+#if defined(BECAM_SIMD_NEON)
+		case SimdLevel::NEON:
+			return BlendResizeRowsNeon(rows, weights, rowCount, dst, size);
+#endif
+		default:
+			return BlendResizeRowsScalar(rows, weights, rowCount, dst, size);
+	}
+}
+
+/**
+ * @brief 水平方向每两个采样合并为一个
+ */
+static void ReduceResizePairs(const uint16_t* src, uint16_t* dst, const size_t width, const uint32_t bytesPerPixel, const bool packedYuv,
+							  const bool lumaFirst, const SimdLevel level) {
+	switch (level) {
+#if defined(BECAM_SIMD_X86)
+		case SimdLevel::AVX2:
+			return ReduceResizePairsAvx2(src, dst, width, bytesPerPixel, packedYuv, lumaFirst);
+		case SimdLevel::SSE2:
+			return ReduceResizePairsSse2(src, dst, width, bytesPerPixel, packedYuv, lumaFirst);
+#endif
+#if defined(BECAM_SIMD_NEON)
+		case SimdLevel::NEON:
+			return ReduceResizePairsNeon(src, dst, width, bytesPerPixel, packedYuv, lumaFirst);
+#endif
+		default:
+			return ReduceResizePairsScalar(src, dst, width, bytesPerPixel, packedYuv, lumaFirst);
+	}
+}
+
+/**
+ * @brief 将像素之和除以个数并四舍五入
+ */
+static void NormalizeResizeRow(const uint16_t* src, uint8_t* dst, const size_t size, const uint32_t factor, const SimdLevel level) {
+	switch (level) {
+#if defined(BECAM_SIMD_X86)
+		case SimdLevel::AVX2:
+			return NormalizeResizeRowAvx2(src, dst, size, factor);
+		case SimdLevel::SSE2:
+			return NormalizeResizeRowSse2(src, dst, size, factor);
+#endif
+#if defined(BECAM_SIMD_NEON)
+		case SimdLevel::NEON:
+			return NormalizeResizeRowNeon(src, dst, size, factor);
+#endif
+		default:
+			return NormalizeResizeRowScalar(src, dst, size, factor);
+	}
+}
+
+/**
+ * @brief 按整数倍数缩小平面（求和快速路径）
+ *
+ * @param src [in] 源平面首地址
+ * @param srcStride [in] 源平面每行字节数
+ * @param dst [out] 目标平面首地址
+ * @param dstStride [in] 目标平面每行字节数
+ * @param layout [in] 缩放布局
+ * @param factor [in] 缩小倍数（2、3、4）
+ * @param rowBegin [in] 目标起始行
+ * @param rowEnd [in] 目标结束行（不含）
+ * @param level [in] 指令集级别
+ */
+static void ResizePlaneBySum(const uint8_t* src, const uint32_t srcStride, uint8_t* dst, const uint32_t dstStride, const ResizePlaneLayout& layout,
+							 const uint32_t factor, const uint32_t rowBegin, const uint32_t rowEnd, const SimdLevel level) {
+	auto srcRowSize = size_t(layout.srcWidth) * layout.bytesPerPixel;
+	auto dstRowSize = size_t(layout.dstWidth) * layout.bytesPerPixel;
+	std::vector<uint16_t> sum(srcRowSize);
+	std::vector<uint16_t> half(srcRowSize / 2);
+	std::vector<ResizeChannel> channels;
+	GetResizeChannels(layout, channels);
+	const uint8_t* rows[RESIZE_MAX_SUM_FACTOR];
+	for (uint32_t y = rowBegin; y < rowEnd; y++) {
+		for (uint32_t k = 0; k < factor; k++) {
+			rows[k] = src + (size_t(y) * factor + k) * srcStride;
+		}
+		SumResizeRows(rows, factor, sum.data(), srcRowSize, level);
+		auto dstRow = dst + size_t(y) * dstStride;
+		if (factor == 2) {
+			ReduceResizePairs(sum.data(), half.data(), layout.dstWidth, layout.bytesPerPixel, layout.packedYuv, layout.lumaFirst, level);
+			NormalizeResizeRow(half.data(), dstRow, dstRowSize, factor, level);
+		} else if (factor == 4) {
+			// 两次两两合并
+			ReduceResizePairs(sum.data(), half.data(), size_t(layout.dstWidth) * 2, layout.bytesPerPixel, layout.packedYuv, layout.lumaFirst, level);
+			ReduceResizePairs(half.data(), sum.data(), layout.dstWidth, layout.bytesPerPixel, layout.packedYuv, layout.lumaFirst, level);
+			NormalizeResizeRow(sum.data(), dstRow, dstRowSize, factor, level);
+		} else {
+			ReduceResizeSamplesScalar(sum.data(), half.data(), channels, factor);
+			NormalizeResizeRow(half.data(), dstRow, dstRowSize, factor, level);
+		}
+	}
+}
+
+/**
+ * @brief 按权重表缩放平面（通用路径）
+ *
+ * @param src [in] 源平面首地址
+ * @param srcStride [in] 源平面每行字节数
+ * @param dst [out] 目标平面首地址
+ * @param dstStride [in] 目标平面每行字节数
+ * @param layout [in] 缩放布局
+ * @param filter [in] 滤波方式
+ * @param rowBegin [in] 目标起始行
+ * @param rowEnd [in] 目标结束行（不含）
+ * @param level [in] 指令集级别
+ */
+static void ResizePlaneByTaps(const uint8_t* src, const uint32_t srcStride, uint8_t* dst, const uint32_t dstStride, const ResizePlaneLayout& layout,
+							  const ResizeFilter filter, const uint32_t rowBegin, const uint32_t rowEnd, const SimdLevel level) {
+	std::vector<ResizeChannel> channels;
+	GetResizeChannels(layout, channels);
+	// 打包YUV奇数宽度时最后一组仍完整占用4字节
+	auto srcRowSize = layout.packedYuv ? size_t(layout.srcWidth + 1) / 2 * 4 : size_t(layout.srcWidth) * layout.bytesPerPixel;
+	ResizeTaps verticalTaps;
+	BuildResizeTaps(layout.srcHeight, layout.dstHeight, filter, verticalTaps);
+	// 同一采样网格的通道共用权重表
+	std::vector<ResizeTaps> horizontalTaps(channels.size());
+	for (size_t i = 0; i < channels.size(); i++) {
+		if (i > 0 && channels[i].srcCount == channels[i - 1].srcCount && channels[i].dstCount == channels[i - 1].dstCount) {
+			horizontalTaps[i] = horizontalTaps[i - 1];
+		} else {
+			BuildResizeTaps(channels[i].srcCount, channels[i].dstCount, filter, horizontalTaps[i]);
+		}
+	}
+	std::vector<int16_t> row(srcRowSize);
+	std::vector<const uint8_t*> rows(verticalTaps.maxTaps);
+	for (uint32_t y = rowBegin; y < rowEnd; y++) {
+		auto count = verticalTaps.count[y];
+		for (uint32_t k = 0; k < count; k++) {
+			rows[k] = src + size_t(verticalTaps.first[y] + k) * srcStride;
+		}
+		BlendResizeRows(rows.data(), verticalTaps.weights.data() + size_t(y) * verticalTaps.maxTaps, count, row.data(), srcRowSize, level);
+		auto dstRow = dst + size_t(y) * dstStride;
+		for (size_t i = 0; i < channels.size(); i++) {
+			ResampleResizeRowScalar(row.data(), dstRow, channels[i], horizontalTaps[i]);
+		}
+		// 打包YUV奇数宽度时最后一组的第二个亮度重复第一个
+		if (layout.packedYuv && layout.dstWidth % 2 != 0) {
+			auto luma = dstRow + size_t(layout.dstWidth - 1) * 2 + channels[0].offset;
+			luma[2] = luma[0];
+		}
+	}
+}
+
+/**
+ * @brief 缩放图像（格式需一致，目标缓冲区由调用方分配）
+ *
+ * @param src [in] 源图像
+ * @param dst [in && out] 目标图像（需已填写宽高）
+ * @param filter [in] 滤波方式
+ * @param level [in] 指令集级别
+ * @param policy [in] 行带并行策略
+ * @return 状态码
+ */
+static StatusCode ResizeImage(const ImageBuffer& src, ImageBuffer& dst, const ResizeFilter filter, const SimdLevel level, const RowBandPolicy& policy) {
+	// 检查入参
+	if (src.width == 0 || src.height == 0 || dst.width == 0 || dst.height == 0 || src.format != dst.format) {
+		return StatusCode::STATUS_CODE_ERR_INPUT_PARAM;
+	}
+	if (!IsResizeFilterValid(filter)) {
+		return StatusCode::STATUS_CODE_ERR_INPUT_PARAM;
+	}
+	if (!CanResizeImage(src.format)) {
+		return StatusCode::STATUS_CODE_ERR_NOT_SUPPORTED;
+	}
+	for (uint32_t i = 0; i < GetImagePlaneCount(src.format); i++) {
+		if (src.plane[i] == nullptr || dst.plane[i] == nullptr) {
+			return StatusCode::STATUS_CODE_ERR_INPUT_PARAM;
+		}
+	}
+
+	// 补全每行字节数
+	auto source = src;
+	NormalizeImageStrides(source);
+	NormalizeImageStrides(dst);
+
+	// 逐平面缩放
+	if (source.width == dst.width && source.height == dst.height) {
+		CopyImage(source, dst);
+		return StatusCode::STATUS_CODE_SUCCESS;
+	}
+	// 按目标行带缩放（4:2:0时行带起始行为偶数，色度平面取对应的半行范围）
+	RunRowBands(policy, dst.height, GetImageRowAlignment(dst.format), [&](uint32_t begin, uint32_t end) {
+		for (uint32_t i = 0; i < GetImagePlaneCount(source.format); i++) {
+			ResizePlaneLayout layout;
+			GetResizePlaneLayout(source.format, i, source, dst, layout);
+			auto rowBegin = GetImagePlaneHeight(source.format, begin, i);
+			auto rowEnd = GetImagePlaneHeight(source.format, end, i);
+			auto factor = GetResizeSumFactor(layout, filter);
+			if (factor > 1) {
+				ResizePlaneBySum(source.plane[i], source.stride[i], dst.plane[i], dst.stride[i], layout, factor, rowBegin, rowEnd, level);
+			} else {
+				ResizePlaneByTaps(source.plane[i], source.stride[i], dst.plane[i], dst.stride[i], layout, filter, rowBegin, rowEnd, level);
+			}
+		}
+	});
+	return StatusCode::STATUS_CODE_SUCCESS;
+}
+
+/**
+ * @brief 缩放图像（串行执行）
+ */
+static StatusCode ResizeImage(const ImageBuffer& src, ImageBuffer& dst, const ResizeFilter filter, const SimdLevel level) {
+	return ResizeImage(src, dst, filter, level, SERIAL_ROW_BANDS);
+}
+
+/**
+ * @brief 缩放图像（使用CPU支持的最高指令集）
+ */
+static StatusCode ResizeImage(const ImageBuffer& src, ImageBuffer& dst, const ResizeFilter filter) {
+	return ResizeImage(src, dst, filter, GetSimdLevel(), SERIAL_ROW_BANDS);
+}
+
+/**
+ * @brief 按行带并行缩放图像（使用CPU支持的最高指令集）
+ */
+static StatusCode ResizeImage(const ImageBuffer& src, ImageBuffer& dst, const ResizeFilter filter, const RowBandPolicy& policy) {
+	return ResizeImage(src, dst, filter, GetSimdLevel(), policy);
+}
+
+#endif
@@ -0,0 +1,986 @@
+#pragma once
+
+#ifndef _BECAM_IMAGE_TENSOR_H_
+#define _BECAM_IMAGE_TENSOR_H_
+
+#include "PixelConvert.hpp"
+#include "SimdDispatch.hpp"
+#include <algorithm>
+#include <becam/becam.h>
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <vector>
+
+/**
+ * 图像转张量：格式转换、双线性缩放、归一化及布局重排合并为一次逐行处理，源图像每行最多读取一次：
+ * 每个源通道（YUV为Y、U、V，RGB为R、G、B）按各自的采样网格水平插值为浮点行并缓存两行，
+ * 再逐个目标行完成垂直插值、YUV转RGB（BT.601有限范围，与PixelConvert相同的系数）、截断到0~255、乘加归一化并按布局写出；
+ * 水平插值、垂直插值至写出的部分及半精度转换提供SSE2、AVX2、NEON实现（x86上与标量实现逐位一致）；
+ * 水平插值按预先计算的字节偏移取源采样（AVX2使用gather指令），可覆盖全部格式的采样步长
+ */
+
+// YUV转RGB系数（BT.601有限范围）
+static const float TENSOR_LUMA_SCALE = 1.164383f;
+static const float TENSOR_V_TO_R = 1.596027f;
+static const float TENSOR_U_TO_G = 0.391762f;
+static const float TENSOR_V_TO_G = 0.812968f;
+static const float TENSOR_U_TO_B = 2.017232f;
+
+/**
+ * @brief 源图像中独立采样的一个通道
+ */
+struct TensorChannel {
+	// 所在平面
+	uint32_t plane;
+	// 首个采样在行内的字节偏移
+	uint32_t offset;
+	// 相邻采样的字节距离
+	uint32_t step;
+	// 每行采样数
+	uint32_t count;
+	// 行数
+	uint32_t rows;
+};
+
+/**
+ * @brief 一维双线性插值表
+ */
+struct TensorTaps {
+	// 每个目标采样的左侧（上方）源采样序号
+	std::vector<uint32_t> first;
+	// 每个目标采样的右侧（下方）源采样序号
+	std::vector<uint32_t> second;
+	// 右侧（下方）源采样的权重
+	std::vector<float> weight;
+	// 左侧源采样相对通道首个采样的字节偏移（仅水平插值表）
+	std::vector<int32_t> firstOffset;
+	// 右侧源采样相对通道首个采样的字节偏移（仅水平插值表）
+	std::vector<int32_t> secondOffset;
+	// 按4字节读取源采样不会越过通道最后一个采样的目标采样数（仅水平插值表，从行首起连续）
+	size_t gatherCount;
+};
+
+/**
+ * @brief 逐像素的合成参数（按张量通道顺序）
+ */
+struct TensorCompose {
+	// 是否需要YUV转RGB
+	bool yuv;
+	// 张量通道是否为B、G、R顺序
+	bool bgr;
+	// 归一化乘数（1 / std）
+	float scale[3];
+	// 归一化偏移（-mean / std）
+	float bias[3];
+};
+
+/**
+ * @brief 单个目标行的合成输入
+ */
+struct TensorRowArgs {
+	// 各源通道的上方插值行（GREY三个通道相同）
+	const float* top[3];
+	// 各源通道的下方插值行
+	const float* bottom[3];
+	// 各源通道下方行的权重
+	float weight[3];
+	// 目标行中图像区域的起始地址
+	float* dst;
+	// 通道优先布局中相邻通道的距离（元素数）
+	size_t channelStride;
+	// 是否为通道交错布局
+	bool interleaved;
+};
+
+/**
+ * @brief 图像转张量的上下文（由源图像及配置构建，只读，可供多个行区间共用）
+ */
+struct TensorContext {
+	// 源图像（已补全每行字节数）
+	ImageBuffer src;
+	// 配置
+	TensorConfig config;
+	// 图像在张量中的位置
+	TensorPlacement placement;
+	// 源通道（GREY为1个，其余为3个）
+	std::vector<TensorChannel> channels;
+	// 各源通道的水平插值表
+	std::vector<TensorTaps> taps;
+	// 各源通道的垂直插值表
+	std::vector<TensorTaps> rowTaps;
+	// 合成参数
+	TensorCompose compose;
+	// 归一化后的填充值（按张量通道顺序）
+	float padding[3];
+};
+
+/**
+ * @brief 获取张量元素的字节数
+ *
+ * @param dataType [in] 元素类型
+ * @return 字节数（类型无效时为0）
+ */
+static size_t GetTensorElementSize(const TensorDataType dataType) {
+	switch (dataType) {
+		case TensorDataType::TENSOR_DATA_FLOAT32:
+			return 4;
+		case TensorDataType::TENSOR_DATA_FLOAT16:
+			return 2;
+		default:
+			return 0;
+	}
+}
+
+/**
+ * @brief 检查图像转张量配置
+ *
+ * @param config [in] 配置
+ * @return 是否有效
+ */
+static bool IsTensorConfigValid(const TensorConfig& config) {
+	if (config.width == 0 || config.height == 0 || GetTensorElementSize(config.dataType) == 0) {
+		return false;
+	}
+	if (config.layout != TensorLayout::TENSOR_LAYOUT_NCHW && config.layout != TensorLayout::TENSOR_LAYOUT_NHWC) {
+		return false;
+	}
+	if (config.channelOrder != TensorChannelOrder::TENSOR_CHANNEL_RGB && config.channelOrder != TensorChannelOrder::TENSOR_CHANNEL_BGR) {
+		return false;
+	}
+	if (config.resizeMode != TensorResizeMode::TENSOR_RESIZE_STRETCH && config.resizeMode != TensorResizeMode::TENSOR_RESIZE_LETTERBOX) {
+		return false;
+	}
+	for (int i = 0; i < 3; i++) {
+		// 同时排除NaN及无穷大
+		if (!(fabsf(config.std[i]) > 0) || !isfinite(config.std[i]) || !isfinite(config.mean[i]) || !isfinite(config.padValue[i])) {
+			return false;
+		}
+	}
+	return true;
+}
+
+/**
+ * @brief 计算张量所需的字节数
+ *
+ * @param config [in] 配置
+ * @return 字节数（配置无效时为0）
+ */
+static size_t GetTensorSize(const TensorConfig& config) {
+	if (!IsTensorConfigValid(config)) {
+		return 0;
+	}
+	return size_t(config.width) * config.height * 3 * GetTensorElementSize(config.dataType);
+}
+
+/**
+ * @brief 计算图像在张量中的位置
+ *
+ * @param srcWidth [in] 源图像宽度
+ * @param srcHeight [in] 源图像高度
+ * @param config [in] 配置
+ * @param placement [out] 位置
+ */
+static void GetTensorPlacement(const uint32_t srcWidth, const uint32_t srcHeight, const TensorConfig& config, TensorPlacement& placement) {
+	placement = {0};
+	placement.width = config.width;
+	placement.height = config.height;
+	if (config.resizeMode == TensorResizeMode::TENSOR_RESIZE_LETTERBOX) {
+		// 按较小的比例缩放，另一个方向四舍五入后居中
+		auto scale = std::min(double(config.width) / srcWidth, double(config.height) / srcHeight);
+		placement.width = std::min(config.width, std::max(1u, uint32_t(srcWidth * scale + 0.5)));
+		placement.height = std::min(config.height, std::max(1u, uint32_t(srcHeight * scale + 0.5)));
+		placement.left = (config.width - placement.width) / 2;
+		placement.top = (config.height - placement.height) / 2;
+	}
+	placement.scaleX = float(placement.width) / srcWidth;
+	placement.scaleY = float(placement.height) / srcHeight;
+}
+
+/**
+ * @brief 获取源图像格式的通道描述
+ *
+ * @param image [in] 源图像
+ * @param channels [out] 通道（GREY为Y，YUV为Y、U、V，RGB为R、G、B）
+ * @param yuv [out] 是否为YUV
+ * @return 是否支持该格式
+ */
+static bool GetTensorChannels(const ImageBuffer& image, std::vector<TensorChannel>& channels, bool& yuv) {
+	channels.clear();
+	auto chromaCount = (image.width + 1) / 2;
+	auto chromaRows = (image.height + 1) / 2;
+	bool bgr = false;
+	uint32_t bytesPerPixel = 0;
+	YuvLayout layout;
+	if (GetYuvLayout(image.format, layout)) {
+		yuv = true;
+		if (layout.planeCount == 1) {
+			// 打包格式每组4字节，色度水平减半、垂直不减半
+			auto lumaOffset = layout.lumaFirst ? 0u : 1u;
+			auto chromaOffset = layout.lumaFirst ? 1u : 0u;
+			channels.push_back({0, lumaOffset, 2, image.width, image.height});
+			channels.push_back({0, chromaOffset + (layout.uFirst ? 0u : 2u), 4, chromaCount, image.height});
+			channels.push_back({0, chromaOffset + (layout.uFirst ? 2u : 0u), 4, chromaCount, image.height});
+		} else if (layout.planeCount == 2) {
+			channels.push_back({0, 0, 1, image.width, image.height});
+			channels.push_back({1, layout.uFirst ? 0u : 1u, 2, chromaCount, chromaRows});
+			channels.push_back({1, layout.uFirst ? 1u : 0u, 2, chromaCount, chromaRows});
+		} else {
+			// ImageBuffer中总是plane[1]为U、plane[2]为V
+			channels.push_back({0, 0, 1, image.width, image.height});
+			channels.push_back({1, 0, 1, chromaCount, chromaRows});
+			channels.push_back({2, 0, 1, chromaCount, chromaRows});
+		}
+		return true;
+	}
+	yuv = false;
+	if (GetRgbOrder(image.format, bgr, bytesPerPixel)) {
+		channels.push_back({0, bgr ? 2u : 0u, bytesPerPixel, image.width, image.height});
+		channels.push_back({0, 1, bytesPerPixel, image.width, image.height});
+		channels.push_back({0, bgr ? 0u : 2u, bytesPerPixel, image.width, image.height});
+		return true;
+	}
+	if (image.format == BECAM_FOURCC('G', 'R', 'E', 'Y')) {
+		channels.push_back({0, 0, 1, image.width, image.height});
+		return true;
+	}
+	return false;
+}
+
+/**
+ * @brief 构建一维双线性插值表（像素中心对齐，边缘复制）
+ *
+ * @param srcCount [in] 源采样数
+ * @param dstCount [in] 目标采样数
+ * @param taps [out] 插值表
+ */
+static void BuildTensorTaps(const uint32_t srcCount, const uint32_t dstCount, TensorTaps& taps) {
+	taps.first.resize(dstCount);
+	taps.second.resize(dstCount);
+	taps.weight.resize(dstCount);
+	auto scale = double(srcCount) / dstCount;
+	for (uint32_t i = 0; i < dstCount; i++) {
+		auto position = std::max((i + 0.5) * scale - 0.5, 0.0);
+		auto first = std::min(uint32_t(position), srcCount - 1);
+		taps.first[i] = first;
+		taps.second[i] = std::min(first + 1, srcCount - 1);
+		taps.weight[i] = first + 1 < srcCount ? float(position - first) : 0.0f;
+	}
+}
+
+/**
+ * @brief 构建水平插值表的字节偏移（供向量化的水平插值按偏移取源采样）
+ *
+ * @param channel [in] 通道
+ * @param taps [in && out] 水平插值表
+ */
+static void BuildTensorGatherOffsets(const TensorChannel& channel, TensorTaps& taps) {
+	auto count = taps.first.size();
+	taps.firstOffset.resize(count);
+	taps.secondOffset.resize(count);
+	for (size_t i = 0; i < count; i++) {
+		taps.firstOffset[i] = int32_t(taps.first[i] * channel.step);
+		taps.secondOffset[i] = int32_t(taps.second[i] * channel.step);
+	}
+	// 插值表单调递增，从行尾向前排除按4字节读取会越过最后一个采样的目标采样
+	auto lastOffset = int64_t(channel.count - 1) * channel.step;
+	taps.gatherCount = count;
+	while (taps.gatherCount > 0 && int64_t(taps.secondOffset[taps.gatherCount - 1]) + 3 > lastOffset) {
+		taps.gatherCount--;
+	}
+}
+
+/**
+ * @brief 构建图像转张量的上下文
+ *
+ * @param src [in] 源图像
+ * @param config [in] 配置
+ * @param context [out] 上下文
+ * @return 状态码
+ */
+static StatusCode BuildTensorContext(const ImageBuffer& src, const TensorConfig& config, TensorContext& context) {
+	// 检查入参
+	if (src.width == 0 || src.height == 0 || !IsTensorConfigValid(config)) {
+		return StatusCode::STATUS_CODE_ERR_INPUT_PARAM;
+	}
+	bool yuv = false;
+	if (!GetTensorChannels(src, context.channels, yuv)) {
+		return StatusCode::STATUS_CODE_ERR_NOT_SUPPORTED;
+	}
+	for (uint32_t i = 0; i < GetImagePlaneCount(src.format); i++) {
+		if (src.plane[i] == nullptr) {
+			return StatusCode::STATUS_CODE_ERR_INPUT_PARAM;
+		}
+	}
+
+	context.src = src;
+	NormalizeImageStrides(context.src);
+	context.config = config;
+	GetTensorPlacement(src.width, src.height, config, context.placement);
+
+	// 插值表
+	context.taps.resize(context.channels.size());
+	context.rowTaps.resize(context.channels.size());
+	for (size_t i = 0; i < context.channels.size(); i++) {
+		BuildTensorTaps(context.channels[i].count, context.placement.width, context.taps[i]);
+		BuildTensorGatherOffsets(context.channels[i], context.taps[i]);
+		BuildTensorTaps(context.channels[i].rows, context.placement.height, context.rowTaps[i]);
+	}
+
+	// 合成参数
+	context.compose.yuv = yuv;
+	context.compose.bgr = config.channelOrder == TensorChannelOrder::TENSOR_CHANNEL_BGR;
+	for (int i = 0; i < 3; i++) {
+		context.compose.scale[i] = 1.0f / config.std[i];
+		context.compose.bias[i] = -config.mean[i] / config.std[i];
+		context.padding[i] = config.padValue[i] * context.compose.scale[i] + context.compose.bias[i];
+	}
+	return StatusCode::STATUS_CODE_SUCCESS;
+}
+
+/**
+ * @brief 水平插值一个源通道的一行（标量参考实现）
+ *
+ * @param base [in] 通道首个采样的地址
+ * @param taps [in] 水平插值表
+ * @param dst [out] 插值结果（像素值范围0~255）
+ * @param begin [in] 起始目标采样
+ * @param count [in] 结束目标采样（不含）
+ */
+static void ResampleTensorRowScalar(const uint8_t* base, const TensorTaps& taps, float* dst, const size_t begin, const size_t count) {
+	for (size_t i = begin; i < count; i++) {
+		auto a = float(base[taps.firstOffset[i]]);
+		auto b = float(base[taps.secondOffset[i]]);
+		dst[i] = a + (b - a) * taps.weight[i];
+	}
+}
+
+/**
+ * @brief 合成目标行中的像素（标量参考实现）
+ *
+ * @param args [in] 合成输入
+ * @param compose [in] 合成参数
+ * @param begin [in] 起始像素
+ * @param count [in] 结束像素（不含）
+ */
+static void ComposeTensorRowScalar(const TensorRowArgs& args, const TensorCompose& compose, const size_t begin, const size_t count) {
+	for (size_t x = begin; x < count; x++) {
+		float value[3];
+		for (int i = 0; i < 3; i++) {
+			auto top = args.top[i][x];
+			value[i] = top + (args.bottom[i][x] - top) * args.weight[i];
+		}
+		if (compose.yuv) {
+			auto yc = (value[0] - 16.0f) * TENSOR_LUMA_SCALE;
+			auto d = value[1] - 128.0f;
+			auto e = value[2] - 128.0f;
+			// 参数顺序与向量化的max、min指令一致（0与-0、NaN时的结果相同）
+			value[0] = std::min(std::max(0.0f, yc + TENSOR_V_TO_R * e), 255.0f);
+			value[1] = std::min(std::max(0.0f, yc - TENSOR_U_TO_G * d - TENSOR_V_TO_G * e), 255.0f);
+			value[2] = std::min(std::max(0.0f, yc + TENSOR_U_TO_B * d), 255.0f);
+		}
+		for (int i = 0; i < 3; i++) {
+			auto result = value[compose.bgr ? 2 - i : i] * compose.scale[i] + compose.bias[i];
+			if (args.interleaved) {
+				args.dst[x * 3 + i] = result;
+			} else {
+				args.dst[i * args.channelStride + x] = result;
+			}
+		}
+	}
+}
+
+/**
+ * @brief 单精度转半精度（标量参考实现，向最近偶数舍入，NaN统一为0x7E00）
+ */
+static inline uint16_t FloatToHalfScalar(const float value) {
+	uint32_t bits = 0;
+	memcpy(&bits, &value, sizeof(bits));
+	auto sign = bits & 0x80000000u;
+	bits ^= sign;
+	uint32_t result = 0;
+	if (bits >= 0x47800000u) {
+		// 超出范围为无穷大
+		result = bits > 0x7F800000u ? 0x7E00u : 0x7C00u;
+	} else if (bits < 0x38800000u) {
+		// 非规格化数：加0.5使尾数对齐到半精度的最低位，由浮点加法完成舍入
+		float magnitude = 0;
+		memcpy(&magnitude, &bits, sizeof(bits));
+		magnitude += 0.5f;
+		memcpy(&bits, &magnitude, sizeof(bits));
+		result = bits - 0x3F000000u;
+	} else {
+		// 规格化数：调整指数偏移，加上0xFFF及尾数奇偶位实现向最近偶数舍入
+		auto odd = (bits >> 13) & 1;
+		bits += 0xC8000FFFu + odd;
+		result = bits >> 13;
+	}
+	return uint16_t(result | (sign >> 16));
+}
+
+/**
+ * @brief 单精度行转半精度行（标量参考实现）
+ */
+static void FloatToHalfRowScalar(const float* src, uint16_t* dst, const size_t count) {
+	for (size_t i = 0; i < count; i++) {
+		dst[i] = FloatToHalfScalar(src[i]);
+	}
+}
+
+#if defined(BECAM_SIMD_X86)
+/**
+ * @brief 水平插值一个源通道的一行（SSE2，每次4个，逐个取源采样后向量化插值）
+ */
+static void ResampleTensorRowSse2(const uint8_t* base, const TensorTaps& taps, float* dst, const size_t begin, const size_t count) {
+	auto first = taps.firstOffset.data();
+	auto second = taps.secondOffset.data();
+	size_t i = begin;
+	for (; i + 4 <= count; i += 4) {
+		auto a = _mm_cvtepi32_ps(_mm_setr_epi32(base[first[i]], base[first[i + 1]], base[first[i + 2]], base[first[i + 3]]));
+		auto b = _mm_cvtepi32_ps(_mm_setr_epi32(base[second[i]], base[second[i + 1]], base[second[i + 2]], base[second[i + 3]]));
+		_mm_storeu_ps(dst + i, _mm_add_ps(a, _mm_mul_ps(_mm_sub_ps(b, a), _mm_loadu_ps(taps.weight.data() + i))));
+	}
+	ResampleTensorRowScalar(base, taps, dst, i, count);
+}
+
+/**
+ * @brief 水平插值一个源通道的一行（AVX2，每次8个，按字节偏移gather读取4字节后取最低字节）
+ */
+BECAM_TARGET_AVX2 static void ResampleTensorRowAvx2(const uint8_t* base, const TensorTaps& taps, float* dst, const size_t begin, const size_t count) {
+	auto mask = _mm256_set1_epi32(0xFF);
+	auto source = reinterpret_cast<const int*>(base);
+	auto gatherCount = std::min(count, taps.gatherCount);
+	size_t i = begin;
+	for (; i + 8 <= gatherCount; i += 8) {
+		auto firstIndex = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(taps.firstOffset.data() + i));
+		auto secondIndex = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(taps.secondOffset.data() + i));
+		auto a = _mm256_cvtepi32_ps(_mm256_and_si256(_mm256_i32gather_epi32(source, firstIndex, 1), mask));
+		auto b = _mm256_cvtepi32_ps(_mm256_and_si256(_mm256_i32gather_epi32(source, secondIndex, 1), mask));
+		_mm256_storeu_ps(dst + i, _mm256_add_ps(a, _mm256_mul_ps(_mm256_sub_ps(b, a), _mm256_loadu_ps(taps.weight.data() + i))));
+	}
+	ResampleTensorRowSse2(base, taps, dst, i, count);
+}
+
+/**
+ * @brief 交错写出4个像素的3个通道（SSE2）
+ */
+static inline void StoreTensorInterleavedSse2(float* dst, const __m128 a, const __m128 b, const __m128 c) {
+	auto abLow = _mm_unpacklo_ps(a, b);
+	auto abHigh = _mm_unpackhi_ps(a, b);
+	// a0 b0 c0 a1 | b1 c1 a2 b2 | c2 a3 b3 c3
+	auto first = _mm_shuffle_ps(c, abLow, _MM_SHUFFLE(2, 2, 0, 0));
+	auto second = _mm_shuffle_ps(abLow, c, _MM_SHUFFLE(1, 1, 3, 3));
+	auto third = _mm_shuffle_ps(c, abHigh, _MM_SHUFFLE(3, 2, 3, 2));
+	_mm_storeu_ps(dst, _mm_shuffle_ps(abLow, first, _MM_SHUFFLE(2, 0, 1, 0)));
+	_mm_storeu_ps(dst + 4, _mm_shuffle_ps(second, abHigh, _MM_SHUFFLE(1, 0, 2, 0)));
+	_mm_storeu_ps(dst + 8, _mm_shuffle_ps(third, third, _MM_SHUFFLE(1, 3, 2, 0)));
+}
+
+/**
+ * @brief 合成目标行中的像素（SSE2，每次4个像素）
+ */
+static void ComposeTensorRowSse2(const TensorRowArgs& args, const TensorCompose& compose, const size_t begin, const size_t count) {
+	// 常量及逐行参数在循环外展开
+	auto zero = _mm_setzero_ps();
+	auto maximum = _mm_set1_ps(255.0f);
+	auto lumaBias = _mm_set1_ps(16.0f);
+	auto chromaBias = _mm_set1_ps(128.0f);
+	auto lumaScale = _mm_set1_ps(TENSOR_LUMA_SCALE);
+	auto vToR = _mm_set1_ps(TENSOR_V_TO_R);
+	auto uToG = _mm_set1_ps(TENSOR_U_TO_G);
+	auto vToG = _mm_set1_ps(TENSOR_V_TO_G);
+	auto uToB = _mm_set1_ps(TENSOR_U_TO_B);
+	__m128 weight[3], scale[3], bias[3];
+	for (int i = 0; i < 3; i++) {
+		weight[i] = _mm_set1_ps(args.weight[i]);
+		scale[i] = _mm_set1_ps(compose.scale[i]);
+		bias[i] = _mm_set1_ps(compose.bias[i]);
+	}
+	size_t x = begin;
+	for (; x + 4 <= count; x += 4) {
+		__m128 value[3];
+		for (int i = 0; i < 3; i++) {
+			auto top = _mm_loadu_ps(args.top[i] + x);
+			auto bottom = _mm_loadu_ps(args.bottom[i] + x);
+			value[i] = _mm_add_ps(top, _mm_mul_ps(_mm_sub_ps(bottom, top), weight[i]));
+		}
+		if (compose.yuv) {
+			auto yc = _mm_mul_ps(_mm_sub_ps(value[0], lumaBias), lumaScale);
+			auto d = _mm_sub_ps(value[1], chromaBias);
+			auto e = _mm_sub_ps(value[2], chromaBias);
+			auto r = _mm_add_ps(yc, _mm_mul_ps(vToR, e));
+			auto g = _mm_sub_ps(_mm_sub_ps(yc, _mm_mul_ps(uToG, d)), _mm_mul_ps(vToG, e));
+			auto b = _mm_add_ps(yc, _mm_mul_ps(uToB, d));
+			value[0] = _mm_min_ps(_mm_max_ps(r, zero), maximum);
+			value[1] = _mm_min_ps(_mm_max_ps(g, zero), maximum);
+			value[2] = _mm_min_ps(_mm_max_ps(b, zero), maximum);
+		}
+		__m128 result[3];
+		for (int i = 0; i < 3; i++) {
+			result[i] = _mm_add_ps(_mm_mul_ps(value[compose.bgr ? 2 - i : i], scale[i]), bias[i]);
+		}
+		if (args.interleaved) {
+			StoreTensorInterleavedSse2(args.dst + x * 3, result[0], result[1], result[2]);
+		} else {
+			for (int i = 0; i < 3; i++) {
+				_mm_storeu_ps(args.dst + i * args.channelStride + x, result[i]);
+			}
+		}
+	}
+	ComposeTensorRowScalar(args, compose, x, count);
+}
+
+/**
+ * @brief 单精度行转半精度行（SSE2，每次8个，与标量实现逐位一致）
+ */
+static void FloatToHalfRowSse2(const float* src, uint16_t* dst, const size_t count) {
+	// 常量在循环外展开
+	auto signMask = _mm_set1_epi32(int(0x80000000u));
+	auto infinityBits = _mm_set1_epi32(0x7F800000);
+	auto overflowBits = _mm_set1_epi32(0x47800000);
+	auto subnormalBits = _mm_set1_epi32(0x38800000);
+	auto quietBit = _mm_set1_epi32(0x200);
+	auto halfInfinity = _mm_set1_epi32(0x7C00);
+	auto half = _mm_set1_ps(0.5f);
+	auto halfBits = _mm_set1_epi32(0x3F000000);
+	auto one = _mm_set1_epi32(1);
+	auto rebias = _mm_set1_epi32(int(0xC8000FFFu));
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8) {
+		__m128i halves[2];
+		for (int j = 0; j < 2; j++) {
+			auto bits = _mm_castps_si128(_mm_loadu_ps(src + i + j * 4));
+			auto sign = _mm_and_si128(bits, signMask);
+			auto magnitude = _mm_xor_si128(bits, sign);
+			// 符号位已清除，可以使用有符号比较
+			auto isNan = _mm_cmpgt_epi32(magnitude, infinityBits);
+			auto isRegular = _mm_cmpgt_epi32(overflowBits, magnitude);
+			auto isSubnormal = _mm_cmpgt_epi32(subnormalBits, magnitude);
+			auto infinity = _mm_or_si128(_mm_and_si128(isNan, quietBit), halfInfinity);
+			auto subnormal = _mm_sub_epi32(_mm_castps_si128(_mm_add_ps(_mm_castsi128_ps(magnitude), half)), halfBits);
+			auto odd = _mm_and_si128(_mm_srli_epi32(magnitude, 13), one);
+			auto normal = _mm_srli_epi32(_mm_add_epi32(_mm_add_epi32(magnitude, rebias), odd), 13);
+			auto finite = _mm_or_si128(_mm_and_si128(isSubnormal, subnormal), _mm_andnot_si128(isSubnormal, normal));
+			auto result = _mm_or_si128(_mm_and_si128(isRegular, finite), _mm_andnot_si128(isRegular, infinity));
+			// SSE2没有无符号32位收窄，先符号扩展低16位再有符号收窄
+			result = _mm_or_si128(result, _mm_srli_epi32(sign, 16));
+			halves[j] = _mm_srai_epi32(_mm_slli_epi32(result, 16), 16);
+		}
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_packs_epi32(halves[0], halves[1]));
+	}
+	FloatToHalfRowScalar(src + i, dst + i, count - i);
+}
+
+/**
+ * @brief 合成目标行中的像素（AVX2，每次8个像素）
+ */
+BECAM_TARGET_AVX2 static void ComposeTensorRowAvx2(const TensorRowArgs& args, const TensorCompose& compose, const size_t begin, const size_t count) {
+	// 常量及逐行参数在循环外展开
+	auto zero = _mm256_setzero_ps();
+	auto maximum = _mm256_set1_ps(255.0f);
+	auto lumaBias = _mm256_set1_ps(16.0f);
+	auto chromaBias = _mm256_set1_ps(128.0f);
+	auto lumaScale = _mm256_set1_ps(TENSOR_LUMA_SCALE);
+	auto vToR = _mm256_set1_ps(TENSOR_V_TO_R);
+	auto uToG = _mm256_set1_ps(TENSOR_U_TO_G);
+	auto vToG = _mm256_set1_ps(TENSOR_V_TO_G);
+	auto uToB = _mm256_set1_ps(TENSOR_U_TO_B);
+	__m256 weight[3], scale[3], bias[3];
+	for (int i = 0; i < 3; i++) {
+		weight[i] = _mm256_set1_ps(args.weight[i]);
+		scale[i] = _mm256_set1_ps(compose.scale[i]);
+		bias[i] = _mm256_set1_ps(compose.bias[i]);
+	}
+	size_t x = begin;
+	for (; x + 8 <= count; x += 8) {
+		__m256 value[3];
+		for (int i = 0; i < 3; i++) {
+			auto top = _mm256_loadu_ps(args.top[i] + x);
+			auto bottom = _mm256_loadu_ps(args.bottom[i] + x);
+			value[i] = _mm256_add_ps(top, _mm256_mul_ps(_mm256_sub_ps(bottom, top), weight[i]));
+		}
+		if (compose.yuv) {
+			auto yc = _mm256_mul_ps(_mm256_sub_ps(value[0], lumaBias), lumaScale);
+			auto d = _mm256_sub_ps(value[1], chromaBias);
+			auto e = _mm256_sub_ps(value[2], chromaBias);
+			auto r = _mm256_add_ps(yc, _mm256_mul_ps(vToR, e));
+			auto g = _mm256_sub_ps(_mm256_sub_ps(yc, _mm256_mul_ps(uToG, d)), _mm256_mul_ps(vToG, e));
+			auto b = _mm256_add_ps(yc, _mm256_mul_ps(uToB, d));
+			value[0] = _mm256_min_ps(_mm256_max_ps(r, zero), maximum);
+			value[1] = _mm256_min_ps(_mm256_max_ps(g, zero), maximum);
+			value[2] = _mm256_min_ps(_mm256_max_ps(b, zero), maximum);
+		}
+		__m256 result[3];
+		for (int i = 0; i < 3; i++) {
+			result[i] = _mm256_add_ps(_mm256_mul_ps(value[compose.bgr ? 2 - i : i], scale[i]), bias[i]);
+		}
+		if (args.interleaved) {
+			// 按256位交错写出：先在128位通道内交错，再重排128位块
+			auto rg = _mm256_unpacklo_ps(result[0], result[1]);
+			auto rgHigh = _mm256_unpackhi_ps(result[0], result[1]);
+			auto bb = _mm256_unpacklo_ps(result[2], result[2]);
+			auto bbHigh = _mm256_unpackhi_ps(result[2], result[2]);
+			// 每个128位通道：p0 = r0 g0 b0 r1, p1 = g1 b1 r2 g2, p2 = b2 r3 g3 b3
+			auto p0 = _mm256_shuffle_ps(rg, bb, _MM_SHUFFLE(2, 0, 1, 0));
+			p0 = _mm256_blend_ps(p0, _mm256_permute_ps(rg, _MM_SHUFFLE(2, 2, 1, 0)), 0x88);
+			auto p1 = _mm256_shuffle_ps(rg, rgHigh, _MM_SHUFFLE(1, 0, 3, 3));
+			p1 = _mm256_blend_ps(p1, _mm256_permute_ps(bb, _MM_SHUFFLE(3, 3, 3, 3)), 0x22);
+			auto p2 = _mm256_permute_ps(_mm256_shuffle_ps(rgHigh, bbHigh, _MM_SHUFFLE(2, 0, 3, 2)), _MM_SHUFFLE(3, 1, 0, 2));
+			// 低128位为像素0~3，高128位为像素4~7
+			_mm256_storeu_ps(args.dst + x * 3, _mm256_permute2f128_ps(p0, p1, 0x20));
+			_mm256_storeu_ps(args.dst + x * 3 + 8, _mm256_permute2f128_ps(p2, p0, 0x30));
+			_mm256_storeu_ps(args.dst + x * 3 + 16, _mm256_permute2f128_ps(p1, p2, 0x31));
+		} else {
+			for (int i = 0; i < 3; i++) {
+				_mm256_storeu_ps(args.dst + i * args.channelStride + x, result[i]);
+			}
+		}
+	}
+	ComposeTensorRowSse2(args, compose, x, count);
+}
+
+/**
+ * @brief 单精度行转半精度行（AVX2，每次16个）
+ */
+BECAM_TARGET_AVX2 static void FloatToHalfRowAvx2(const float* src, uint16_t* dst, const size_t count) {
+	// 常量在循环外展开
+	auto signMask = _mm256_set1_epi32(int(0x80000000u));
+	auto infinityBits = _mm256_set1_epi32(0x7F800000);
+	auto overflowBits = _mm256_set1_epi32(0x47800000);
+	auto subnormalBits = _mm256_set1_epi32(0x38800000);
+	auto quietBit = _mm256_set1_epi32(0x200);
+	auto halfInfinity = _mm256_set1_epi32(0x7C00);
+	auto half = _mm256_set1_ps(0.5f);
+	auto halfBits = _mm256_set1_epi32(0x3F000000);
+	auto one = _mm256_set1_epi32(1);
+	auto rebias = _mm256_set1_epi32(int(0xC8000FFFu));
+	size_t i = 0;
+	for (; i + 16 <= count; i += 16) {
+		__m256i halves[2];
+		for (int j = 0; j < 2; j++) {
+			auto bits = _mm256_castps_si256(_mm256_loadu_ps(src + i + j * 8));
+			auto sign = _mm256_and_si256(bits, signMask);
+			auto magnitude = _mm256_xor_si256(bits, sign);
+			auto isNan = _mm256_cmpgt_epi32(magnitude, infinityBits);
+			auto isRegular = _mm256_cmpgt_epi32(overflowBits, magnitude);
+			auto isSubnormal = _mm256_cmpgt_epi32(subnormalBits, magnitude);
+			auto infinity = _mm256_or_si256(_mm256_and_si256(isNan, quietBit), halfInfinity);
+			auto subnormal = _mm256_sub_epi32(_mm256_castps_si256(_mm256_add_ps(_mm256_castsi256_ps(magnitude), half)), halfBits);
+			auto odd = _mm256_and_si256(_mm256_srli_epi32(magnitude, 13), one);
+			auto normal = _mm256_srli_epi32(_mm256_add_epi32(_mm256_add_epi32(magnitude, rebias), odd), 13);
+			auto finite = _mm256_blendv_epi8(normal, subnormal, isSubnormal);
+			auto result = _mm256_blendv_epi8(infinity, finite, isRegular);
+			halves[j] = _mm256_or_si256(result, _mm256_srli_epi32(sign, 16));
+		}
+		// 结果不超过0xFFFF，可以使用无符号收窄；收窄按128位通道交错，需重排64位块
+		auto packed = _mm256_packus_epi32(halves[0], halves[1]);
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_permute4x64_epi64(packed, 0xD8));
+	}
+	FloatToHalfRowSse2(src + i, dst + i, count - i);
+}
+#endif
+
+#if defined(BECAM_SIMD_NEON)
+/**
+ * @brief 水平插值一个源通道的一行（NEON，每次4个，逐个取源采样后向量化插值）
+ */
+static void ResampleTensorRowNeon(const uint8_t* base, const TensorTaps& taps, float* dst, const size_t begin, const size_t count) {
+	auto first = taps.firstOffset.data();
+	auto second = taps.secondOffset.data();
+	size_t i = begin;
+	for (; i + 4 <= count; i += 4) {
+		uint32_t a[4] = {base[first[i]], base[first[i + 1]], base[first[i + 2]], base[first[i + 3]]};
+		uint32_t b[4] = {base[second[i]], base[second[i + 1]], base[second[i + 2]], base[second[i + 3]]};
+		auto left = vcvtq_f32_u32(vld1q_u32(a));
+		auto right = vcvtq_f32_u32(vld1q_u32(b));
+		// 乘、加分开执行，与标量实现的运算顺序一致
+		vst1q_f32(dst + i, vaddq_f32(left, vmulq_f32(vsubq_f32(right, left), vld1q_f32(taps.weight.data() + i))));
+	}
+	ResampleTensorRowScalar(base, taps, dst, i, count);
+}
+
+/**
+ * @brief 合成目标行中的像素（NEON，每次4个像素）
+ */
+static void ComposeTensorRowNeon(const TensorRowArgs& args, const TensorCompose& compose, const size_t begin, const size_t count) {
+	auto zero = vdupq_n_f32(0.0f);
+	auto maximum = vdupq_n_f32(255.0f);
+	size_t x = begin;
+	for (; x + 4 <= count; x += 4) {
+		float32x4_t value[3];
+		for (int i = 0; i < 3; i++) {
+			auto top = vld1q_f32(args.top[i] + x);
+			auto bottom = vld1q_f32(args.bottom[i] + x);
+			// 乘、加分开执行，与标量实现的运算顺序一致
+			value[i] = vaddq_f32(top, vmulq_n_f32(vsubq_f32(bottom, top), args.weight[i]));
+		}
+		if (compose.yuv) {
+			auto yc = vmulq_n_f32(vsubq_f32(value[0], vdupq_n_f32(16.0f)), TENSOR_LUMA_SCALE);
+			auto d = vsubq_f32(value[1], vdupq_n_f32(128.0f));
+			auto e = vsubq_f32(value[2], vdupq_n_f32(128.0f));
+			auto r = vaddq_f32(yc, vmulq_n_f32(e, TENSOR_V_TO_R));
+			auto g = vsubq_f32(vsubq_f32(yc, vmulq_n_f32(d, TENSOR_U_TO_G)), vmulq_n_f32(e, TENSOR_V_TO_G));
+			auto b = vaddq_f32(yc, vmulq_n_f32(d, TENSOR_U_TO_B));
+			value[0] = vminq_f32(vmaxq_f32(r, zero), maximum);
+			value[1] = vminq_f32(vmaxq_f32(g, zero), maximum);
+			value[2] = vminq_f32(vmaxq_f32(b, zero), maximum);
+		}
+		float32x4x3_t result;
+		for (int i = 0; i < 3; i++) {
+			result.val[i] = vaddq_f32(vmulq_n_f32(value[compose.bgr ? 2 - i : i], compose.scale[i]), vdupq_n_f32(compose.bias[i]));
+		}
+		if (args.interleaved) {
+			vst3q_f32(args.dst + x * 3, result);
+		} else {
+			for (int i = 0; i < 3; i++) {
+				vst1q_f32(args.dst + i * args.channelStride + x, result.val[i]);
+			}
+		}
+	}
+	ComposeTensorRowScalar(args, compose, x, count);
+}
+
+/**
+ * @brief 单精度行转半精度行（NEON，每次8个，硬件转换按默认的向最近偶数舍入）
+ */
+static void FloatToHalfRowNeon(const float* src, uint16_t* dst, const size_t count) {
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8) {
+		auto low = vreinterpret_u16_f16(vcvt_f16_f32(vld1q_f32(src + i)));
+		auto high = vreinterpret_u16_f16(vcvt_f16_f32(vld1q_f32(src + i + 4)));
+		vst1q_u16(dst + i, vcombine_u16(low, high));
+	}
+	FloatToHalfRowScalar(src + i, dst + i, count - i);
+}
+#endif
+
+/**
+ * @brief 水平插值一个源通道的一行（按指令集分派）
+ *
+ * @param row [in] 源行
+ * @param channel [in] 通道
+ * @param taps [in] 水平插值表
+ * @param dst [out] 插值结果（像素值范围0~255）
+ * @param level [in] 指令集级别
+ */
+static void ResampleTensorRow(const uint8_t* row, const TensorChannel& channel, const TensorTaps& taps, float* dst, const SimdLevel level) {
+	auto base = row + channel.offset;
+	auto count = taps.weight.size();
+	switch (level) {
+#if defined(BECAM_SIMD_X86)
+		case SimdLevel::AVX2:
+			return ResampleTensorRowAvx2(base, taps, dst, 0, count);
+		case SimdLevel::SSE2:
+			return ResampleTensorRowSse2(base, taps, dst, 0, count);
+#endif
+#if defined(BECAM_SIMD_NEON)
+		case SimdLevel::NEON:
+			return ResampleTensorRowNeon(base, taps, dst, 0, count);
+#endif
+		default:
+			return ResampleTensorRowScalar(base, taps, dst, 0, count);
+	}
+}
+
+/**
+ * @brief 合成目标行中的像素（按指令集分派）
+ */
+static void ComposeTensorRow(const TensorRowArgs& args, const TensorCompose& compose, const size_t count, const SimdLevel level) {
+	switch (level) {
+#if defined(BECAM_SIMD_X86)
+		case SimdLevel::AVX2:
+			return ComposeTensorRowAvx2(args, compose, 0, count);
+		case SimdLevel::SSE2:
+			return ComposeTensorRowSse2(args, compose, 0, count);
+#endif
+#if defined(BECAM_SIMD_NEON)
+		case SimdLevel::NEON:
+			return ComposeTensorRowNeon(args, compose, 0, count);
+#endif
+		default:
+			return ComposeTensorRowScalar(args, compose, 0, count);
+	}
+}
+
+/**
+ * @brief 单精度行转半精度行（按指令集分派）
+ */
+static void FloatToHalfRow(const float* src, uint16_t* dst, const size_t count, const SimdLevel level) {
+	switch (level) {
+#if defined(BECAM_SIMD_X86)
+		case SimdLevel::AVX2:
+			return FloatToHalfRowAvx2(src, dst, count);
+		case SimdLevel::SSE2:
+			return FloatToHalfRowSse2(src, dst, count);
+#endif
+#if defined(BECAM_SIMD_NEON)
+		case SimdLevel::NEON:
+			return FloatToHalfRowNeon(src, dst, count);
+#endif
+		default:
+			return FloatToHalfRowScalar(src, dst, count);
+	}
+}
+
+/**
+ * @brief 用填充值填写目标行中的一段像素
+ *
+ * @param row [in && out] 目标行（通道优先布局时为第一个通道）
+ * @param channelStride [in] 通道优先布局中相邻通道的距离（元素数）
+ * @param interleaved [in] 是否为通道交错布局
+ * @param padding [in] 归一化后的填充值
+ * @param begin [in] 起始像素
+ * @param end [in] 结束像素（不含）
+ */
+static void FillTensorRow(float* row, const size_t channelStride, const bool interleaved, const float* padding, const size_t begin, const size_t end) {
+	for (size_t x = begin; x < end; x++) {
+		for (int i = 0; i < 3; i++) {
+			if (interleaved) {
+				row[x * 3 + i] = padding[i];
+			} else {
+				row[i * channelStride + x] = padding[i];
+			}
+		}
+	}
+}
+
+/**
+ * @brief 写出张量中的一段行（各段可并行执行，每段独立缓存源通道的插值行）
+ *
+ * @param context [in] 上下文
+ * @param dst [out] 张量缓冲区
+ * @param rowBegin [in] 起始行
+ * @param rowEnd [in] 结束行（不含）
+ * @param level [in] 指令集级别
+ */
+static void WriteTensorRows(const TensorContext& context, void* dst, const uint32_t rowBegin, const uint32_t rowEnd, const SimdLevel level) {
+	auto& config = context.config;
+	auto& placement = context.placement;
+	auto interleaved = config.layout == TensorLayout::TENSOR_LAYOUT_NHWC;
+	auto half = config.dataType == TensorDataType::TENSOR_DATA_FLOAT16;
+	auto width = size_t(config.width);
+	auto planeSize = width * config.height;
+	auto rowSize = interleaved ? width * 3 : width;
+	auto channelCount = context.channels.size();
+
+	// 每个源通道缓存两行水平插值结果，记录对应的源行号
+	std::vector<float> cache(channelCount * 2 * placement.width);
+	int64_t cachedRows[3][2] = {{-1, -1}, {-1, -1}, {-1, -1}};
+	auto fetch = [&](const size_t channel, const uint32_t row, const uint32_t keep) -> const float* {
+		for (size_t slot = 0; slot < 2; slot++) {
+			if (cachedRows[channel][slot] == row) {
+				return cache.data() + (channel * 2 + slot) * placement.width;
+			}
+		}
+		// 替换不是另一个所需行的槽位
+		size_t slot = cachedRows[channel][0] == keep ? 1 : 0;
+		auto buffer = cache.data() + (channel * 2 + slot) * placement.width;
+		auto& info = context.channels[channel];
+		ResampleTensorRow(context.src.plane[info.plane] + size_t(row) * context.src.stride[info.plane], info, context.taps[channel], buffer, level);
+		cachedRows[channel][slot] = row;
+		return buffer;
+	};
+
+	// 半精度先写到单精度暂存行再转换
+	std::vector<float> staging(half ? width * 3 : 0);
+	for (uint32_t y = rowBegin; y < rowEnd; y++) {
+		float* row = nullptr;
+		size_t channelStride = 0;
+		if (half) {
+			row = staging.data();
+			channelStride = width;
+		} else {
+			row = reinterpret_cast<float*>(dst) + y * rowSize;
+			channelStride = planeSize;
+		}
+
+		if (y < placement.top || y >= placement.top + placement.height) {
+			FillTensorRow(row, channelStride, interleaved, context.padding, 0, width);
+		} else {
+			FillTensorRow(row, channelStride, interleaved, context.padding, 0, placement.left);
+			FillTensorRow(row, channelStride, interleaved, context.padding, placement.left + placement.width, width);
+			auto outputRow = y - placement.top;
+			TensorRowArgs args;
+			for (size_t i = 0; i < 3; i++) {
+				// GREY的三个通道共用同一个源通道
+				auto channel = channelCount == 1 ? 0 : i;
+				auto& rowTaps = context.rowTaps[channel];
+				auto first = rowTaps.first[outputRow];
+				auto second = rowTaps.second[outputRow];
+				args.top[i] = fetch(channel, first, second);
+				args.bottom[i] = fetch(channel, second, first);
+				args.weight[i] = rowTaps.weight[outputRow];
+			}
+			args.dst = row + (interleaved ? size_t(placement.left) * 3 : placement.left);
+			args.channelStride = channelStride;
+			args.interleaved = interleaved;
+			ComposeTensorRow(args, context.compose, placement.width, level);
+		}
+
+		if (half) {
+			auto output = reinterpret_cast<uint16_t*>(dst);
+			if (interleaved) {
+				FloatToHalfRow(staging.data(), output + y * rowSize, rowSize, level);
+			} else {
+				for (size_t i = 0; i < 3; i++) {
+					FloatToHalfRow(staging.data() + i * width, output + i * planeSize + y * width, width, level);
+				}
+			}
+		}
+	}
+}
+
+/**
+ * @brief 图像转张量（张量缓冲区由调用方分配）
+ *
+ * @param src [in] 源图像
+ * @param config [in] 配置
+ * @param dst [out] 张量缓冲区
+ * @param dstSize [in] 张量缓冲区大小
+ * @param placement [out] 图像在张量中的位置
+ * @param level [in] 指令集级别
+ * @param policy [in] 行带并行策略
+ * @return 状态码
+ */
+static StatusCode ImageToTensor(const ImageBuffer& src, const TensorConfig& config, void* dst, const size_t dstSize, TensorPlacement& placement,
+								const SimdLevel level, const RowBandPolicy& policy) {
+	// 检查入参
+	if (dst == nullptr || dstSize < GetTensorSize(config)) {
+		return StatusCode::STATUS_CODE_ERR_INPUT_PARAM;
+	}
+	TensorContext context;
+	auto code = BuildTensorContext(src, config, context);
+	if (code != StatusCode::STATUS_CODE_SUCCESS) {
+		return code;
+	}
+	// 按张量行带执行（行带边界处的源行各自重新插值）
+	RunRowBands(policy, config.height, 1, [&](uint32_t begin, uint32_t end) { WriteTensorRows(context, dst, begin, end, level); });
+	placement = context.placement;
+	return StatusCode::STATUS_CODE_SUCCESS;
+}
+
+/**
+ * @brief 图像转张量（串行执行）
+ */
+static StatusCode ImageToTensor(const ImageBuffer& src, const TensorConfig& config, void* dst, const size_t dstSize, TensorPlacement& placement,
+								const SimdLevel level) {
+	return ImageToTensor(src, config, dst, dstSize, placement, level, SERIAL_ROW_BANDS);
+}
+
+/**
+ * @brief 图像转张量（使用CPU支持的最高指令集）
+ */
+static StatusCode ImageToTensor(const ImageBuffer& src, const TensorConfig& config, void* dst, const size_t dstSize, TensorPlacement& placement) {
+	return ImageToTensor(src, config, dst, dstSize, placement, GetSimdLevel(), SERIAL_ROW_BANDS);
+}
+
+/**
+ * @brief 按行带并行图像转张量（使用CPU支持的最高指令集）
+ */
+static StatusCode ImageToTensor(const ImageBuffer& src, const TensorConfig& config, void* dst, const size_t dstSize, TensorPlacement& placement,
+								const RowBandPolicy& policy) {
+	return ImageToTensor(src, config, dst, dstSize, placement, GetSimdLevel(), policy);
+}
+
+#endif
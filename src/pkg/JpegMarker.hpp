@@ -0,0 +1,366 @@
+#pragma once
+
+#ifndef _BECAM_JPEG_MARKER_H_
+#define _BECAM_JPEG_MARKER_H_
+
+#include <algorithm>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <vector>
+
+/**
+ * JPEG标记段解析（不解码）：用于按重启标记（RST）把熵编码数据切分为可独立解码的分条，
+ * 以及为省略霍夫曼表（DHT）的UVC MJPEG帧补齐标准表，使其成为可独立使用的JPEG文件
+ */
+
+/**
+ * @brief 标准霍夫曼表（ITU-T T.81 附录K.3，亮度/色度的DC及AC表，含DHT标记及长度）
+ */
+static const uint8_t JPEG_STANDARD_HUFFMAN_TABLES[420] = {
+	0xFF, 0xC4, 0x01, 0xA2, 0x00, 0x00, 0x01, 0x05, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A,
+	0x0B, 0x10, 0x00, 0x02, 0x01, 0x03, 0x03, 0x02, 0x04, 0x03, 0x05, 0x05, 0x04, 0x04, 0x00, 0x00,
+	0x01, 0x7D, 0x01, 0x02, 0x03, 0x00, 0x04, 0x11, 0x05, 0x12, 0x21, 0x31, 0x41, 0x06, 0x13, 0x51,
+	0x61, 0x07, 0x22, 0x71, 0x14, 0x32, 0x81, 0x91, 0xA1, 0x08, 0x23, 0x42, 0xB1, 0xC1, 0x15, 0x52,
+	0xD1, 0xF0, 0x24, 0x33, 0x62, 0x72, 0x82, 0x09, 0x0A, 0x16, 0x17, 0x18, 0x19, 0x1A, 0x25, 0x26,
+	0x27, 0x28, 0x29, 0x2A, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3A, 0x43, 0x44, 0x45, 0x46, 0x47,
+	0x48, 0x49, 0x4A, 0x53, 0x54, 0x55, 0x56, 0x57, 0x58, 0x59, 0x5A, 0x63, 0x64, 0x65, 0x66, 0x67,
+	0x68, 0x69, 0x6A, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7A, 0x83, 0x84, 0x85, 0x86, 0x87,
+	0x88, 0x89, 0x8A, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99, 0x9A, 0xA2, 0xA3, 0xA4, 0xA5,
+	0xA6, 0xA7, 0xA8, 0xA9, 0xAA, 0xB2, 0xB3, 0xB4, 0xB5, 0xB6, 0xB7, 0xB8, 0xB9, 0xBA, 0xC2, 0xC3,
+	0xC4, 0xC5, 0xC6, 0xC7, 0xC8, 0xC9, 0xCA, 0xD2, 0xD3, 0xD4, 0xD5, 0xD6, 0xD7, 0xD8, 0xD9, 0xDA,
+	0xE1, 0xE2, 0xE3, 0xE4, 0xE5, 0xE6, 0xE7, 0xE8, 0xE9, 0xEA, 0xF1, 0xF2, 0xF3, 0xF4, 0xF5, 0xF6,
+	0xF7, 0xF8, 0xF9, 0xFA, 0x01, 0x00, 0x03, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A,
+	0x0B, 0x11, 0x00, 0x02, 0x01, 0x02, 0x04, 0x04, 0x03, 0x04, 0x07, 0x05, 0x04, 0x04, 0x00, 0x01,
+	0x02, 0x77, 0x00, 0x01, 0x02, 0x03, 0x11, 0x04, 0x05, 0x21, 0x31, 0x06, 0x12, 0x41, 0x51, 0x07,
+	0x61, 0x71, 0x13, 0x22, 0x32, 0x81, 0x08, 0x14, 0x42, 0x91, 0xA1, 0xB1, 0xC1, 0x09, 0x23, 0x33,
+	0x52, 0xF0, 0x15, 0x62, 0x72, 0xD1, 0x0A, 0x16, 0x24, 0x34, 0xE1, 0x25, 0xF1, 0x17, 0x18, 0x19,
+	0x1A, 0x26, 0x27, 0x28, 0x29, 0x2A, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3A, 0x43, 0x44, 0x45, 0x46,
+	0x47, 0x48, 0x49, 0x4A, 0x53, 0x54, 0x55, 0x56, 0x57, 0x58, 0x59, 0x5A, 0x63, 0x64, 0x65, 0x66,
+	0x67, 0x68, 0x69, 0x6A, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7A, 0x82, 0x83, 0x84, 0x85,
+	0x86, 0x87, 0x88, 0x89, 0x8A, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99, 0x9A, 0xA2, 0xA3,
+	0xA4, 0xA5, 0xA6, 0xA7, 0xA8, 0xA9, 0xAA, 0xB2, 0xB3, 0xB4, 0xB5, 0xB6, 0xB7, 0xB8, 0xB9, 0xBA,
+	0xC2, 0xC3, 0xC4, 0xC5, 0xC6, 0xC7, 0xC8, 0xC9, 0xCA, 0xD2, 0xD3, 0xD4, 0xD5, 0xD6, 0xD7, 0xD8,
+	0xD9, 0xDA, 0xE2, 0xE3, 0xE4, 0xE5, 0xE6, 0xE7, 0xE8, 0xE9, 0xEA, 0xF2, 0xF3, 0xF4, 0xF5, 0xF6,
+	0xF7, 0xF8, 0xF9, 0xFA,
+};
+
+/**
+ * @brief 按重启间隔划分的JPEG帧布局（仅支持单次扫描的基线/扩展顺序Huffman编码）
+ */
+struct JpegRestartLayout {
+	// 图像宽度
+	uint32_t width;
+	// 图像高度
+	uint32_t height;
+	// MCU宽度（像素）
+	uint32_t mcuWidth;
+	// MCU高度（像素）
+	uint32_t mcuHeight;
+	// 每行MCU数
+	uint32_t mcusPerRow;
+	// MCU行数
+	uint32_t mcuRows;
+	// 是否存在垂直方向的色度下采样（分条边界处的色度插值需要相邻MCU行）
+	bool verticalSubsampled;
+	// 重启间隔（MCU数）
+	uint32_t restartInterval;
+	// SOF段中图像高度字段的偏移
+	size_t sofHeightOffset;
+	// 帧头大小（熵编码数据起始偏移）
+	size_t headerSize;
+	// 每个重启间隔熵编码数据的起始偏移
+	std::vector<size_t> intervalStarts;
+	// 每个重启间隔熵编码数据的结束偏移（不含RST标记）
+	std::vector<size_t> intervalEnds;
+};
+
+/**
+ * @brief 读取大端16位整数
+ */
+static uint32_t ReadJpegUint16(const uint8_t* data) {
+	return (uint32_t(data[0]) << 8) | data[1];
+}
+
+/**
+ * @brief 解析JPEG帧的重启间隔布局
+ *
+ * @param data [in] JPEG帧数据
+ * @param size [in] JPEG帧数据大小
+ * @param layout [out] 布局
+ * @return 是否可按重启间隔切分（无重启标记、渐进式编码、多次扫描或数据不完整时返回false）
+ */
+static bool ParseJpegRestartLayout(const uint8_t* data, const size_t size, JpegRestartLayout& layout) {
+	layout.width = 0;
+	layout.height = 0;
+	layout.restartInterval = 0;
+	layout.headerSize = 0;
+	layout.intervalStarts.clear();
+	layout.intervalEnds.clear();
+	if (data == nullptr || size < 4 || data[0] != 0xFF || data[1] != 0xD8) {
+		return false;
+	}
+	uint32_t componentCount = 0;
+	uint32_t maxH = 1;
+	uint32_t maxV = 1;
+	uint32_t minV = 4;
+	size_t pos = 2;
+	while (layout.headerSize == 0) {
+		// 跳过填充字节
+		if (pos + 1 >= size || data[pos] != 0xFF) {
+			return false;
+		}
+		while (pos + 1 < size && data[pos + 1] == 0xFF) {
+			pos++;
+		}
+		if (pos + 1 >= size) {
+			return false;
+		}
+		auto marker = data[pos + 1];
+		pos += 2;
+		// 无长度的标记
+		if (marker == 0x01 || (marker >= 0xD0 && marker <= 0xD8)) {
+			continue;
+		}
+		if (marker == 0xD9 || pos + 2 > size) {
+			return false;
+		}
+		auto length = ReadJpegUint16(data + pos);
+		if (length < 2 || pos + length > size) {
+			return false;
+		}
+		auto segment = data + pos;
+		switch (marker) {
+			case 0xC0:
+			case 0xC1:
+				// 基线/扩展顺序Huffman编码
+				if (length < 8 || segment[2] != 8) {
+					return false;
+				}
+				layout.sofHeightOffset = pos + 3;
+				layout.height = ReadJpegUint16(segment + 3);
+				layout.width = ReadJpegUint16(segment + 5);
+				componentCount = segment[7];
+				if (componentCount == 0 || length < 8 + componentCount * 3) {
+					return false;
+				}
+				for (uint32_t i = 0; i < componentCount; i++) {
+					auto h = uint32_t(segment[8 + i * 3 + 1] >> 4);
+					auto v = uint32_t(segment[8 + i * 3 + 1] & 0x0F);
+					if (h == 0 || v == 0) {
+						return false;
+					}
+					maxH = std::max(maxH, h);
+					maxV = std::max(maxV, v);
+					minV = std::min(minV, v);
+				}
+				break;
+			case 0xC2:
+			case 0xC3:
+			case 0xC5:
+			case 0xC6:
+			case 0xC7:
+			case 0xC9:
+			case 0xCA:
+			case 0xCB:
+			case 0xCD:
+			case 0xCE:
+			case 0xCF:
+				// 渐进式、无损及算术编码不支持切分
+				return false;
+			case 0xDD:
+				if (length < 4) {
+					return false;
+				}
+				layout.restartInterval = ReadJpegUint16(segment + 2);
+				break;
+			case 0xDA:
+				// 仅支持包含全部分量的单次交错扫描
+				if (componentCount == 0 || length < 3 || segment[2] != componentCount) {
+					return false;
+				}
+				layout.headerSize = pos + length;
+				break;
+			default:
+				break;
+		}
+		pos += length;
+	}
+	if (layout.width == 0 || layout.height == 0 || layout.restartInterval == 0) {
+		return false;
+	}
+	// 单分量扫描的MCU为一个8x8块
+	layout.mcuWidth = componentCount == 1 ? 8 : maxH * 8;
+	layout.mcuHeight = componentCount == 1 ? 8 : maxV * 8;
+	layout.mcusPerRow = (layout.width + layout.mcuWidth - 1) / layout.mcuWidth;
+	layout.mcuRows = (layout.height + layout.mcuHeight - 1) / layout.mcuHeight;
+	layout.verticalSubsampled = componentCount > 1 && minV < maxV;
+
+	// 扫描熵编码数据中的重启标记
+	pos = layout.headerSize;
+	layout.intervalStarts.push_back(pos);
+	while (pos < size) {
+		auto found = static_cast<const uint8_t*>(memchr(data + pos, 0xFF, size - pos));
+		if (found == nullptr || size_t(found - data) + 1 >= size) {
+			pos = size;
+			break;
+		}
+		pos = size_t(found - data);
+		auto next = data[pos + 1];
+		if (next == 0x00) {
+			// 字节填充
+			pos += 2;
+		} else if (next == 0xFF) {
+			// 标记前的填充字节
+			pos++;
+		} else if (next >= 0xD0 && next <= 0xD7) {
+			layout.intervalEnds.push_back(pos);
+			pos += 2;
+			layout.intervalStarts.push_back(pos);
+		} else if (next == 0xD9) {
+			break;
+		} else {
+			// 其它标记（例如DNL或后续扫描）不支持切分
+			return false;
+		}
+	}
+	layout.intervalEnds.push_back(pos);
+	// 重启间隔数量需与MCU数量一致（否则数据不完整或标记缺失）
+	auto mcuCount = size_t(layout.mcusPerRow) * layout.mcuRows;
+	return layout.intervalStarts.size() == (mcuCount + layout.restartInterval - 1) / layout.restartInterval;
+}
+
+/**
+ * @brief 计算分条边界的对齐步长（分条需从MCU行首开始，且恰好位于重启间隔边界）
+ *
+ * @param layout [in] 布局
+ * @return 步长（MCU行数）
+ */
+static uint32_t GetJpegStripRowStep(const JpegRestartLayout& layout) {
+	// 最小的m使得 m * mcusPerRow 为重启间隔的整数倍
+	uint32_t a = layout.restartInterval;
+	uint32_t b = layout.mcusPerRow;
+	while (b != 0) {
+		auto t = a % b;
+		a = b;
+		b = t;
+	}
+	return layout.restartInterval / a;
+}
+
+/**
+ * @brief 生成只包含指定MCU行的独立JPEG数据（修改帧头中的图像高度，重启标记从RST0重新编号）
+ *
+ * @param data [in] JPEG帧数据
+ * @param layout [in] 布局
+ * @param firstRow [in] 起始MCU行（需按对齐步长对齐）
+ * @param rowCount [in] MCU行数
+ * @param strip [out] 分条数据
+ */
+static void BuildJpegStrip(const uint8_t* data, const JpegRestartLayout& layout, const uint32_t firstRow, const uint32_t rowCount,
+						   std::vector<uint8_t>& strip) {
+	auto firstInterval = size_t(firstRow) * layout.mcusPerRow / layout.restartInterval;
+	auto lastInterval = std::min(layout.intervalStarts.size(),
+								 (size_t(firstRow + rowCount) * layout.mcusPerRow + layout.restartInterval - 1) / layout.restartInterval);
+	// 预估大小
+	size_t total = layout.headerSize + 2;
+	for (auto i = firstInterval; i < lastInterval; i++) {
+		total += layout.intervalEnds[i] - layout.intervalStarts[i] + 2;
+	}
+	strip.resize(total);
+	auto dst = strip.data();
+	memcpy(dst, data, layout.headerSize);
+	auto height = std::min(layout.height - firstRow * layout.mcuHeight, rowCount * layout.mcuHeight);
+	dst[layout.sofHeightOffset] = uint8_t(height >> 8);
+	dst[layout.sofHeightOffset + 1] = uint8_t(height);
+	dst += layout.headerSize;
+	for (auto i = firstInterval; i < lastInterval; i++) {
+		if (i > firstInterval) {
+			*dst++ = 0xFF;
+			*dst++ = uint8_t(0xD0 + (i - firstInterval - 1) % 8);
+		}
+		auto length = layout.intervalEnds[i] - layout.intervalStarts[i];
+		memcpy(dst, data + layout.intervalStarts[i], length);
+		dst += length;
+	}
+	*dst++ = 0xFF;
+	*dst++ = 0xD9;
+	strip.resize(size_t(dst - strip.data()));
+}
+
+/**
+ * @brief 查找需要插入标准霍夫曼表的位置
+ *
+ * @param data [in] JPEG帧数据
+ * @param size [in] JPEG帧数据大小
+ * @return 插入位置（SOS标记的偏移，帧内已有霍夫曼表或不是有效的JPEG帧时为0）
+ */
+static size_t FindJpegHuffmanInsertOffset(const uint8_t* data, const size_t size) {
+	if (data == nullptr || size < 4 || data[0] != 0xFF || data[1] != 0xD8) {
+		return 0;
+	}
+	size_t pos = 2;
+	while (pos + 4 <= size) {
+		if (data[pos] != 0xFF) {
+			return 0;
+		}
+		auto marker = data[pos + 1];
+		// 填充字节及无长度的标记
+		if (marker == 0xFF) {
+			pos++;
+			continue;
+		}
+		if (marker == 0x01 || (marker >= 0xD0 && marker <= 0xD8)) {
+			pos += 2;
+			continue;
+		}
+		switch (marker) {
+			case 0xC4:
+				// 已有霍夫曼表
+				return 0;
+			case 0xDA:
+				return pos;
+			case 0xD9:
+				return 0;
+			default:
+				break;
+		}
+		pos += 2 + ReadJpegUint16(data + pos + 2);
+	}
+	return 0;
+}
+
+/**
+ * @brief 计算补齐霍夫曼表后的JPEG帧大小
+ *
+ * @param data [in] JPEG帧数据
+ * @param size [in] JPEG帧数据大小
+ * @return 补齐后的大小（无需补齐时与原大小相同）
+ */
+static size_t GetCompleteJpegSize(const uint8_t* data, const size_t size) {
+	return FindJpegHuffmanInsertOffset(data, size) > 0 ? size + sizeof(JPEG_STANDARD_HUFFMAN_TABLES) : size;
+}
+
+/**
+ * @brief 拷贝JPEG帧，缺少霍夫曼表时在SOS之前插入标准表（不解码，开销与直接拷贝相当）
+ *
+ * @param src [in] JPEG帧数据
+ * @param size [in] JPEG帧数据大小
+ * @param dst [out] 目标缓冲区（大小不小于GetCompleteJpegSize的返回值）
+ * @return 写入的字节数
+ */
+static size_t CopyCompleteJpeg(const uint8_t* src, const size_t size, uint8_t* dst) {
+	auto offset = FindJpegHuffmanInsertOffset(src, size);
+	if (offset == 0) {
+		memcpy(dst, src, size);
+		return size;
+	}
+	memcpy(dst, src, offset);
+	memcpy(dst + offset, JPEG_STANDARD_HUFFMAN_TABLES, sizeof(JPEG_STANDARD_HUFFMAN_TABLES));
+	memcpy(dst + offset + sizeof(JPEG_STANDARD_HUFFMAN_TABLES), src + offset, size - offset);
+	return size + sizeof(JPEG_STANDARD_HUFFMAN_TABLES);
+}
+
+#endif
@@ -0,0 +1,327 @@
+#pragma once
+
+#ifndef _BECAM_LUMA_HISTOGRAM_H_
+#define _BECAM_LUMA_HISTOGRAM_H_
+
+#include "SimdDispatch.hpp"
+#include <becam/becam.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <vector>
+
+/**
+ * @brief 亮度直方图
+ */
+struct LumaHistogram {
+	// 各亮度级别的采样数
+	uint32_t bins[256];
+	// 总采样数
+	uint32_t sampleCount;
+	// 亮度总和
+	uint64_t sum;
+};
+
+/**
+ * @brief 获取格式中亮度分量在每行中的布局
+ *
+ * @param format [in] 格式（FOURCC表示）
+ * @param offset [out] 每行第一个亮度采样的字节偏移
+ * @param pitch [out] 相邻亮度采样的字节间距
+ * @return 是否支持（压缩格式及RGB格式不支持）
+ */
+static bool GetLumaLayout(const uint32_t format, uint32_t& offset, uint32_t& pitch) {
+	switch (format) {
+		case BECAM_FOURCC('Y', 'U', 'Y', 'V'):
+		case BECAM_FOURCC('Y', 'U', 'Y', '2'):
+		case BECAM_FOURCC('Y', 'V', 'Y', 'U'):
+			offset = 0;
+			pitch = 2;
+			return true;
+		case BECAM_FOURCC('U', 'Y', 'V', 'Y'):
+		case BECAM_FOURCC('V', 'Y', 'U', 'Y'):
+			offset = 1;
+			pitch = 2;
+			return true;
+		case BECAM_FOURCC('G', 'R', 'E', 'Y'):
+		case BECAM_FOURCC('Y', '8', '0', '0'):
+		case BECAM_FOURCC('N', 'V', '1', '2'):
+		case BECAM_FOURCC('N', 'V', '2', '1'):
+		case BECAM_FOURCC('N', 'V', '1', '6'):
+		case BECAM_FOURCC('N', 'V', '6', '1'):
+		case BECAM_FOURCC('Y', 'U', '1', '2'):
+		case BECAM_FOURCC('Y', 'V', '1', '2'):
+		case BECAM_FOURCC('I', '4', '2', '0'):
+		case BECAM_FOURCC('I', 'Y', 'U', 'V'):
+			// 平面格式的亮度平面位于最前面
+			offset = 0;
+			pitch = 1;
+			return true;
+		default:
+			return false;
+	}
+}
+
+/**
+ * @brief 按固定间距抽取亮度采样（标量参考实现）
+ *
+ * @param src [in] 第一个采样的地址
+ * @param step [in] 相邻采样的字节间距
+ * @param count [in] 采样数
+ * @param dst [out] 抽取结果
+ * @return 采样值总和
+ */
+static uint64_t ExtractLumaScalar(const uint8_t* src, const size_t step, const size_t count, uint8_t* dst) {
+	uint64_t sum = 0;
+	for (size_t i = 0; i < count; i++) {
+		dst[i] = src[i * step];
+		sum += dst[i];
+	}
+	return sum;
+}
+
+#if defined(BECAM_SIMD_X86)
+/**
+ * @brief 按固定间距抽取亮度采样（SSE2实现，间距为1、2、4字节时向量化）
+ */
+static uint64_t ExtractLumaSse2(const uint8_t* src, const size_t step, const size_t count, uint8_t* dst) {
+	size_t i = 0;
+	auto zero = _mm_setzero_si128();
+	auto acc = _mm_setzero_si128();
+	if (step == 1) {
+		for (; i + 16 <= count; i += 16) {
+			auto v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), v);
+			acc = _mm_add_epi64(acc, _mm_sad_epu8(v, zero));
+		}
+	} else if (step == 2) {
+		// 保留每个16位中的低字节后收窄
+		auto mask = _mm_set1_epi16(0x00FF);
+		for (; i + 16 <= count; i += 16) {
+			auto p = src + i * 2;
+			auto a = _mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)), mask);
+			auto b = _mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 16)), mask);
+			auto v = _mm_packus_epi16(a, b);
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), v);
+			acc = _mm_add_epi64(acc, _mm_sad_epu8(v, zero));
+		}
+	} else if (step == 4) {
+		// 保留每个32位中的低字节后两次收窄
+		auto mask = _mm_set1_epi32(0x000000FF);
+		for (; i + 16 <= count; i += 16) {
+			auto p = src + i * 4;
+			auto a = _mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)), mask);
+			auto b = _mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 16)), mask);
+			auto c = _mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 32)), mask);
+			auto d = _mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 48)), mask);
+			auto v = _mm_packus_epi16(_mm_packs_epi32(a, b), _mm_packs_epi32(c, d));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), v);
+			acc = _mm_add_epi64(acc, _mm_sad_epu8(v, zero));
+		}
+	}
+	uint64_t sums[2];
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(sums), acc);
+	return sums[0] + sums[1] + ExtractLumaScalar(src + i * step, step, count - i, dst + i);
+}
+
+/**
+ * @brief 按固定间距抽取亮度采样（AVX2实现，间距为1、2、4字节时向量化）
+ */
+BECAM_TARGET_AVX2 static uint64_t ExtractLumaAvx2(const uint8_t* src, const size_t step, const size_t count, uint8_t* dst) {
+	size_t i = 0;
+	auto zero = _mm256_setzero_si256();
+	auto acc = _mm256_setzero_si256();
+	if (step == 1) {
+		for (; i + 32 <= count; i += 32) {
+			auto v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), v);
+			acc = _mm256_add_epi64(acc, _mm256_sad_epu8(v, zero));
+		}
+	} else if (step == 2) {
+		auto mask = _mm256_set1_epi16(0x00FF);
+		for (; i + 32 <= count; i += 32) {
+			auto p = src + i * 2;
+			auto a = _mm256_and_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)), mask);
+			auto b = _mm256_and_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + 32)), mask);
+			// 收窄指令按128位通道交错，需重排64位块恢复顺序
+			auto v = _mm256_permute4x64_epi64(_mm256_packus_epi16(a, b), 0xD8);
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), v);
+			acc = _mm256_add_epi64(acc, _mm256_sad_epu8(v, zero));
+		}
+	} else if (step == 4) {
+		auto mask = _mm256_set1_epi32(0x000000FF);
+		auto order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+		for (; i + 32 <= count; i += 32) {
+			auto p = src + i * 4;
+			auto a = _mm256_and_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)), mask);
+			auto b = _mm256_and_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + 32)), mask);
+			auto c = _mm256_and_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + 64)), mask);
+			auto d = _mm256_and_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + 96)), mask);
+			// 两次收窄后每个128位通道内为4组32位块，需重排32位块恢复顺序
+			auto v = _mm256_packus_epi16(_mm256_packs_epi32(a, b), _mm256_packs_epi32(c, d));
+			v = _mm256_permutevar8x32_epi32(v, order);
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), v);
+			acc = _mm256_add_epi64(acc, _mm256_sad_epu8(v, zero));
+		}
+	}
+	uint64_t sums[4];
+	_mm256_storeu_si256(reinterpret_cast<__m256i*>(sums), acc);
+	return sums[0] + sums[1] + sums[2] + sums[3] + ExtractLumaSse2(src + i * step, step, count - i, dst + i);
+}
+#endif
+
+#if defined(BECAM_SIMD_NEON)
+/**
+ * @brief 按固定间距抽取亮度采样（NEON实现，间距为1、2、4字节时向量化）
+ */
+static uint64_t ExtractLumaNeon(const uint8_t* src, const size_t step, const size_t count, uint8_t* dst) {
+	size_t i = 0;
+	uint64_t sum = 0;
+	if (step == 1 || step == 2 || step == 4) {
+		for (; i + 16 <= count; i += 16) {
+			// 交错加载直接完成解交织
+			uint8x16_t v;
+			if (step == 1) {
+				v = vld1q_u8(src + i);
+			} else if (step == 2) {
+				v = vld2q_u8(src + i * 2).val[0];
+			} else {
+				v = vld4q_u8(src + i * 4).val[0];
+			}
+			vst1q_u8(dst + i, v);
+			sum += vaddlvq_u8(v);
+		}
+	}
+	return sum + ExtractLumaScalar(src + i * step, step, count - i, dst + i);
+}
+#endif
+
+/**
+ * @brief 按固定间距抽取亮度采样（按CPU支持的指令集分派）
+ *
+ * @param src [in] 第一个采样的地址（需保证`(count - 1) * step`以内可读）
+ * @param step [in] 相邻采样的字节间距
+ * @param count [in] 采样数
+ * @param dst [out] 抽取结果
+ * @param level [in] 指令集级别
+ * @return 采样值总和
+ */
+static uint64_t ExtractLuma(const uint8_t* src, const size_t step, const size_t count, uint8_t* dst, const SimdLevel level) {
+	if (count == 0) {
+		return 0;
+	}
+	// 向量化实现会整块读取，最后一个采样之后的字节不一定可读，最后一块留给标量处理
+	auto vectorCount = count - 1;
+	uint64_t sum = 0;
+	switch (level) {
+#if defined(BECAM_SIMD_X86)
+		case SimdLevel::AVX2:
+			sum = ExtractLumaAvx2(src, step, vectorCount, dst);
+			break;
+		case SimdLevel::SSE2:
+			sum = ExtractLumaSse2(src, step, vectorCount, dst);
+			break;
+#endif
+#if defined(BECAM_SIMD_NEON)
+		case SimdLevel::NEON:
+			sum = ExtractLumaNeon(src, step, vectorCount, dst);
+			break;
+#endif
+		default:
+			sum = ExtractLumaScalar(src, step, vectorCount, dst);
+			break;
+	}
+	dst[vectorCount] = src[vectorCount * step];
+	return sum + dst[vectorCount];
+}
+
+/**
+ * @brief 亮度直方图统计使用的临时缓冲（每帧统计时复用，避免反复分配）
+ */
+struct LumaHistogramScratch {
+	// 单行抽取的亮度采样
+	std::vector<uint8_t> samples;
+	// 交替累加的4组直方图
+	std::vector<uint32_t> bins;
+};
+
+/**
+ * @brief 计算视频帧的亮度直方图（按采样步长隔行、隔列采样）
+ *
+ * @param data [in] 视频帧数据
+ * @param dataSize [in] 视频帧数据大小
+ * @param format [in] 视频帧格式（FOURCC表示）
+ * @param width [in] 视频帧宽度
+ * @param height [in] 视频帧高度
+ * @param bytesPerLine [in] 每行字节数（为0时按紧凑排列计算）
+ * @param sampleStep [in] 采样步长（每隔多少行、多少列采样一次，为0时按1处理）
+ * @param histogram [out] 亮度直方图
+ * @param scratch [in && out] 临时缓冲
+ * @param level [in] 指令集级别
+ * @return 是否支持该格式
+ */
+static bool ComputeLumaHistogram(const uint8_t* data, const size_t dataSize, const uint32_t format, const uint32_t width, const uint32_t height,
+								 const uint32_t bytesPerLine, const uint32_t sampleStep, LumaHistogram& histogram, LumaHistogramScratch& scratch,
+								 const SimdLevel level) {
+	memset(&histogram, 0, sizeof(histogram));
+	uint32_t offset = 0;
+	uint32_t pitch = 0;
+	if (data == nullptr || width == 0 || height == 0 || !GetLumaLayout(format, offset, pitch)) {
+		return false;
+	}
+	size_t step = sampleStep > 0 ? sampleStep : 1;
+	size_t lineSize = bytesPerLine > 0 ? bytesPerLine : size_t(width) * pitch;
+	size_t count = (width + step - 1) / step;
+	// 最后一个采样在行内的位置
+	size_t lastByte = offset + (count - 1) * step * pitch;
+
+	// 采样的字节间距只有1、2、4字节时可以直接向量化抽取，其余间距（如YUYV默认步长4对应8字节）
+	// 先按像素间距整段抽取，再在累加时隔列取样
+	size_t stride = step * pitch;
+	bool direct = stride == 1 || stride == 2 || stride == 4;
+	size_t extractStride = direct ? stride : pitch;
+	size_t extractCount = direct ? count : (count - 1) * step + 1;
+	size_t sampleStride = direct ? 1 : step;
+
+	// 分成4组直方图交替累加，减少对同一计数器的连续写入
+	scratch.samples.resize(extractCount);
+	scratch.bins.assign(256 * 4, 0);
+	auto samples = scratch.samples.data();
+	auto bins = scratch.bins.data();
+	for (size_t y = 0; y < height; y += step) {
+		auto row = y * lineSize;
+		// 不完整的视频帧只统计完整的行
+		if (row + lastByte >= dataSize) {
+			break;
+		}
+		ExtractLuma(data + row + offset, extractStride, extractCount, samples, level);
+		size_t i = 0;
+		for (; i + 4 <= count; i += 4) {
+			auto p = samples + i * sampleStride;
+			bins[p[0]]++;
+			bins[256 + p[sampleStride]]++;
+			bins[512 + p[sampleStride * 2]]++;
+			bins[768 + p[sampleStride * 3]]++;
+		}
+		for (auto p = samples + i * sampleStride; i < count; i++, p += sampleStride) {
+			bins[*p]++;
+		}
+		histogram.sampleCount += uint32_t(count);
+	}
+	for (size_t i = 0; i < 256; i++) {
+		histogram.bins[i] = bins[i] + bins[256 + i] + bins[512 + i] + bins[768 + i];
+		histogram.sum += uint64_t(i) * histogram.bins[i];
+	}
+	return histogram.sampleCount > 0;
+}
+
+/**
+ * @brief 计算视频帧的亮度直方图（使用临时缓冲，按CPU支持的指令集分派）
+ */
+static bool ComputeLumaHistogram(const uint8_t* data, const size_t dataSize, const uint32_t format, const uint32_t width, const uint32_t height,
+								 const uint32_t bytesPerLine, const uint32_t sampleStep, LumaHistogram& histogram) {
+	LumaHistogramScratch scratch;
+	return ComputeLumaHistogram(data, dataSize, format, width, height, bytesPerLine, sampleStep, histogram, scratch, GetSimdLevel());
+}
+
+#endif
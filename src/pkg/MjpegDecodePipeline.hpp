@@ -0,0 +1,266 @@
+#pragma once
+
+#ifndef _BECAM_MJPEG_DECODE_PIPELINE_H_
+#define _BECAM_MJPEG_DECODE_PIPELINE_H_
+
+#include "MjpegDecoder.hpp"
+#include <algorithm>
+#include <becam/becam.h>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <thread>
+#include <vector>
+
+/**
+ * 帧级并行MJPEG解码：相邻的视频帧分发到多个解码线程（每个线程一个解码器），按提交顺序输出；
+ * 在途帧数不超过窗口大小，额外延迟上限为（窗口大小-1）个帧间隔加单帧解码耗时
+ */
+
+/**
+ * @brief 在途的视频帧
+ */
+struct MjpegPipelineFrame {
+	// MJPEG帧数据（从驱动缓冲区拷贝，提交后即可归还驱动缓冲区）
+	std::vector<uint8_t> data;
+	// 目标格式
+	uint32_t format;
+	// 缩放分母
+	uint32_t scaleDenom;
+	// 视频帧元数据（宽高及每行字节数在解码完成后填充）
+	VideoFrameMeta meta;
+	// 解码结果（使用new[]分配，由调用方释放）
+	uint8_t* reply;
+	// 解码结果大小
+	size_t replySize;
+	// 解码状态码
+	StatusCode code;
+	// 是否已解码完成
+	bool done;
+	// 提交时间
+	std::chrono::steady_clock::time_point submitTime;
+};
+
+/**
+ * @brief 帧级并行MJPEG解码流水线（提交和取出需在同一个线程中调用）
+ */
+struct MjpegDecodePipeline {
+	// 互斥锁
+	std::mutex mtx;
+	// 等待解码的视频帧通知
+	std::condition_variable taskCondition;
+	// 视频帧解码完成通知
+	std::condition_variable doneCondition;
+	// 解码线程
+	std::vector<std::thread> workers;
+	// 等待解码的视频帧
+	std::deque<MjpegPipelineFrame*> pendingFrames;
+	// 在途的视频帧（按提交顺序）
+	std::deque<MjpegPipelineFrame*> orderedFrames;
+	// 在途帧数上限
+	uint32_t maxInFlight;
+	// 是否正在停止
+	bool stopping;
+	// 累计输出帧数
+	uint64_t frameCount;
+	// 累计延迟（微秒）
+	uint64_t totalLatency;
+	// 最大延迟（微秒）
+	uint64_t maxLatency;
+	// 最近一帧延迟（微秒）
+	uint64_t lastLatency;
+};
+
+/**
+ * @brief 解码线程入口
+ *
+ * @param pipeline [in] 流水线
+ */
+static void RunMjpegPipelineWorker(MjpegDecodePipeline* pipeline) {
+	// 每个解码线程独占一个解码器
+	auto decoder = CreateMjpegDecoder();
+	std::unique_lock<std::mutex> lock(pipeline->mtx);
+	while (true) {
+		pipeline->taskCondition.wait(lock, [pipeline] { return pipeline->stopping || !pipeline->pendingFrames.empty(); });
+		if (pipeline->stopping) {
+			break;
+		}
+		auto frame = pipeline->pendingFrames.front();
+		pipeline->pendingFrames.pop_front();
+		lock.unlock();
+
+		// 解码（不持有锁）
+		ImageBuffer dst = {0};
+		dst.format = frame->format;
+		frame->code = StartMjpegDecode(decoder, frame->data.data(), frame->data.size(), frame->scaleDenom, dst.format, dst.width, dst.height);
+		if (frame->code == StatusCode::STATUS_CODE_SUCCESS) {
+			frame->replySize = GetImageSize(dst.format, dst.width, dst.height);
+			frame->reply = new uint8_t[frame->replySize];
+			FillImageBuffer(dst, frame->reply, frame->replySize, 0);
+			frame->code = FinishMjpegDecode(decoder, dst);
+			frame->meta.width = dst.width;
+			frame->meta.height = dst.height;
+			frame->meta.bytesPerLine = dst.stride[0];
+		}
+		if (frame->code != StatusCode::STATUS_CODE_SUCCESS && frame->reply != nullptr) {
+			delete[] frame->reply;
+			frame->reply = nullptr;
+			frame->replySize = 0;
+		}
+
+		lock.lock();
+		frame->done = true;
+		pipeline->doneCondition.notify_all();
+	}
+	lock.unlock();
+	DestroyMjpegDecoder(decoder);
+}
+
+/**
+ * @brief 创建解码流水线
+ *
+ * @param threadCount [in] 解码线程数（为0时取处理器核心数）
+ * @param maxInFlight [in] 在途帧数上限（为0时取解码线程数加1）
+ * @return 流水线
+ */
+static MjpegDecodePipeline* CreateMjpegDecodePipeline(uint32_t threadCount, uint32_t maxInFlight) {
+	if (threadCount == 0) {
+		threadCount = std::max(1u, std::thread::hardware_concurrency());
+	}
+	if (maxInFlight == 0) {
+		maxInFlight = threadCount + 1;
+	}
+	auto pipeline = new MjpegDecodePipeline();
+	pipeline->maxInFlight = maxInFlight;
+	pipeline->stopping = false;
+	pipeline->frameCount = 0;
+	pipeline->totalLatency = 0;
+	pipeline->maxLatency = 0;
+	pipeline->lastLatency = 0;
+	for (uint32_t i = 0; i < threadCount; i++) {
+		pipeline->workers.emplace_back(RunMjpegPipelineWorker, pipeline);
+	}
+	return pipeline;
+}
+
+/**
+ * @brief 销毁解码流水线（丢弃在途的视频帧）
+ *
+ * @param pipeline [in && out] 流水线
+ */
+static void DestroyMjpegDecodePipeline(MjpegDecodePipeline*& pipeline) {
+	if (pipeline == nullptr) {
+		return;
+	}
+	{
+		std::unique_lock<std::mutex> lock(pipeline->mtx);
+		pipeline->stopping = true;
+		pipeline->taskCondition.notify_all();
+	}
+	for (auto& worker : pipeline->workers) {
+		worker.join();
+	}
+	for (auto frame : pipeline->orderedFrames) {
+		delete[] frame->reply;
+		delete frame;
+	}
+	delete pipeline;
+	pipeline = nullptr;
+}
+
+/**
+ * @brief 获取在途帧数
+ *
+ * @param pipeline [in] 流水线
+ * @return 在途帧数
+ */
+static uint32_t GetMjpegPipelineInFlight(MjpegDecodePipeline* pipeline) {
+	std::unique_lock<std::mutex> lock(pipeline->mtx);
+	return uint32_t(pipeline->orderedFrames.size());
+}
+
+/**
+ * @brief 提交一帧MJPEG（拷贝帧数据，不等待解码）
+ *
+ * @param pipeline [in] 流水线
+ * @param data [in] MJPEG帧数据
+ * @param size [in] MJPEG帧数据大小
+ * @param format [in] 目标格式
+ * @param scaleDenom [in] 缩放分母
+ * @param meta [in] 视频帧元数据
+ */
+static void SubmitMjpegPipelineFrame(MjpegDecodePipeline* pipeline, const uint8_t* data, const size_t size, const uint32_t format,
+									 const uint32_t scaleDenom, const VideoFrameMeta& meta) {
+	auto frame = new MjpegPipelineFrame();
+	frame->data.assign(data, data + size);
+	frame->format = format;
+	frame->scaleDenom = scaleDenom;
+	frame->meta = meta;
+	frame->reply = nullptr;
+	frame->replySize = 0;
+	frame->code = StatusCode::STATUS_CODE_SUCCESS;
+	frame->done = false;
+	frame->submitTime = std::chrono::steady_clock::now();
+	std::unique_lock<std::mutex> lock(pipeline->mtx);
+	pipeline->orderedFrames.push_back(frame);
+	pipeline->pendingFrames.push_back(frame);
+	pipeline->taskCondition.notify_one();
+}
+
+/**
+ * @brief 按提交顺序取出最早的一帧（等待其解码完成）
+ *
+ * @param pipeline [in] 流水线
+ * @param reply [out] 视频帧数据（使用new[]分配）
+ * @param replySize [out] 视频帧数据大小
+ * @param meta [out] 视频帧元数据
+ * @return 状态码
+ */
+static StatusCode ReceiveMjpegPipelineFrame(MjpegDecodePipeline* pipeline, uint8_t*& reply, size_t& replySize, VideoFrameMeta& meta) {
+	reply = nullptr;
+	replySize = 0;
+	std::unique_lock<std::mutex> lock(pipeline->mtx);
+	if (pipeline->orderedFrames.empty()) {
+		return StatusCode::STATUS_CODE_ERR_GET_FRAME_EMPTY;
+	}
+	auto frame = pipeline->orderedFrames.front();
+	pipeline->doneCondition.wait(lock, [frame] { return frame->done; });
+	pipeline->orderedFrames.pop_front();
+	// 统计从提交到取出的延迟
+	auto latency = uint64_t(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - frame->submitTime).count());
+	pipeline->frameCount++;
+	pipeline->totalLatency += latency;
+	pipeline->maxLatency = std::max(pipeline->maxLatency, latency);
+	pipeline->lastLatency = latency;
+	lock.unlock();
+
+	auto code = frame->code;
+	reply = frame->reply;
+	replySize = frame->replySize;
+	meta = frame->meta;
+	delete frame;
+	return code;
+}
+
+/**
+ * @brief 获取流水线状态
+ *
+ * @param pipeline [in] 流水线
+ * @param state [out] 流水线状态
+ */
+static void GetMjpegPipelineState(MjpegDecodePipeline* pipeline, DecodePipelineState& state) {
+	std::unique_lock<std::mutex> lock(pipeline->mtx);
+	state.threadCount = uint32_t(pipeline->workers.size());
+	state.maxInFlight = pipeline->maxInFlight;
+	state.inFlight = uint32_t(pipeline->orderedFrames.size());
+	state.frameCount = pipeline->frameCount;
+	state.averageLatency = pipeline->frameCount > 0 ? pipeline->totalLatency / pipeline->frameCount : 0;
+	state.maxLatency = pipeline->maxLatency;
+	state.lastLatency = pipeline->lastLatency;
+}
+
+#endif
@@ -0,0 +1,503 @@
+#pragma once
+
+#ifndef _BECAM_MJPEG_DECODER_H_
+#define _BECAM_MJPEG_DECODER_H_
+
+#include "JpegMarker.hpp"
+#include "PixelConvert.hpp"
+#include "WorkerPool.hpp"
+#include <becam/becam.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <vector>
+
+#if defined(BECAM_WITH_JPEG)
+	// jpeglib.h依赖stdio.h中的FILE声明
+	#include <jpeglib.h>
+	#include <setjmp.h>
+#endif
+
+/**
+ * MJPEG解码基于libjpeg（推荐libjpeg-turbo），编译时未找到库则所有解码接口返回STATUS_CODE_ERR_NOT_SUPPORTED；
+ * 省略霍夫曼表（DHT）的UVC帧在读取帧头前先补齐标准表（IJG libjpeg不会自动使用标准表，libjpeg-turbo则会）；
+ * 解码器在多帧之间复用同一个解压对象，避免每帧重复分配内存；缩放在DCT域完成（只做1/2、1/4、1/8的反变换），开销随缩放比例下降；
+ * 启用分条并行解码后，带重启标记（DRI/RST）的帧在重启间隔边界处切分为多个分条在多个线程中解码，没有重启标记时串行解码
+ */
+
+#if defined(BECAM_WITH_JPEG)
+/**
+ * @brief libjpeg错误处理（出错时跳回解码入口，而不是退出进程）
+ */
+struct MjpegErrorManager {
+	// libjpeg错误处理对象（必须为第一个成员）
+	jpeg_error_mgr pub;
+	// 出错时的跳转位置
+	jmp_buf jump;
+};
+
+/**
+ * @brief libjpeg致命错误回调
+ */
+static void MjpegErrorExit(j_common_ptr cinfo) {
+	auto err = reinterpret_cast<MjpegErrorManager*>(cinfo->err);
+	longjmp(err->jump, 1);
+}
+
+/**
+ * @brief libjpeg警告输出回调（摄像头数据常见的截断告警不输出到stderr）
+ */
+static void MjpegOutputMessage(j_common_ptr cinfo) {
+	(void)cinfo;
+}
+#endif
+
+/**
+ * @brief MJPEG解码器（每路视频流一个，非线程安全）
+ */
+struct MjpegDecoder {
+#if defined(BECAM_WITH_JPEG)
+	// 解压对象
+	jpeg_decompress_struct cinfo;
+	// 错误处理
+	MjpegErrorManager err;
+#endif
+	// 是否已读取帧头（等待解码扫描行）
+	bool headerRead;
+	// 当前帧数据（读取帧头时记录，分条解码时使用）
+	const uint8_t* data;
+	// 当前帧数据大小
+	size_t size;
+	// 当前帧缩放分母
+	uint32_t scaleDenom;
+	// 分条并行解码线程池（为空时串行解码）
+	WorkerPool* stripPool;
+	// 分条解码器（每个分条一个）
+	std::vector<MjpegDecoder*> stripDecoders;
+	// 分条数据（多帧之间复用）
+	std::vector<std::vector<uint8_t>> stripData;
+	// 当前帧的重启间隔布局
+	JpegRestartLayout layout;
+	// 丢弃的重叠行缓冲区
+	std::vector<uint8_t> rowScratch;
+	// 补齐霍夫曼表后的帧数据（多帧之间复用）
+	std::vector<uint8_t> completeData;
+};
+
+/**
+ * @brief 判断格式是否为MJPEG
+ *
+ * @param format [in] 格式（FOURCC表示）
+ * @return 是否为MJPEG
+ */
+static bool IsMjpegFormat(const uint32_t format) {
+	return format == BECAM_FORMAT_MJPG || format == BECAM_FOURCC('J', 'P', 'E', 'G');
+}
+
+/**
+ * @brief 判断缩放分母是否有效
+ *
+ * @param scaleDenom [in] 缩放分母（1、2、4、8）
+ * @return 是否有效
+ */
+static bool IsMjpegScaleValid(const uint32_t scaleDenom) {
+	return scaleDenom == 1 || scaleDenom == 2 || scaleDenom == 4 || scaleDenom == 8;
+}
+
+/**
+ * @brief 计算缩放后的边长（与libjpeg一致，向上取整）
+ *
+ * @param length [in] 原始边长
+ * @param scaleDenom [in] 缩放分母
+ * @return 缩放后的边长
+ */
+static uint32_t GetMjpegScaledLength(const uint32_t length, const uint32_t scaleDenom) {
+	return scaleDenom > 0 ? (length + scaleDenom - 1) / scaleDenom : length;
+}
+
+/**
+ * @brief 判断是否支持解码为目标格式
+ *
+ * @param format [in] 目标格式（FOURCC表示）
+ * @return 是否支持
+ */
+static bool CanDecodeMjpegTo(const uint32_t format) {
+#if defined(BECAM_WITH_JPEG)
+	switch (format) {
+		case BECAM_FORMAT_RGB24:
+	#if defined(JCS_EXTENSIONS)
+		case BECAM_FORMAT_BGR24:
+	#endif
+	#if defined(JCS_ALPHA_EXTENSIONS)
+		case BECAM_FORMAT_RGBA32:
+		case BECAM_FORMAT_BGRA32:
+	#endif
+		case BECAM_FOURCC('G', 'R', 'E', 'Y'):
+			return true;
+		default:
+			return false;
+	}
+#else
+	(void)format;
+	return false;
+#endif
+}
+
+/**
+ * @brief 判断视频帧能否转换（或解码）为目标格式
+ *
+ * @param srcFormat [in] 视频帧格式（FOURCC表示）
+ * @param dstFormat [in] 目标格式（FOURCC表示）
+ * @return 是否支持
+ */
+static bool CanConvertFrame(const uint32_t srcFormat, const uint32_t dstFormat) {
+	if (IsMjpegFormat(srcFormat)) {
+		return CanDecodeMjpegTo(dstFormat);
+	}
+	return CanConvertImage(srcFormat, dstFormat);
+}
+
+/**
+ * @brief 创建MJPEG解码器
+ *
+ * @return 解码器（未编译libjpeg支持时为空）
+ */
+static MjpegDecoder* CreateMjpegDecoder() {
+#if defined(BECAM_WITH_JPEG)
+	auto decoder = new MjpegDecoder();
+	decoder->cinfo.err = jpeg_std_error(&decoder->err.pub);
+	decoder->err.pub.error_exit = MjpegErrorExit;
+	decoder->err.pub.output_message = MjpegOutputMessage;
+	if (setjmp(decoder->err.jump)) {
+		delete decoder;
+		return nullptr;
+	}
+	jpeg_create_decompress(&decoder->cinfo);
+	decoder->headerRead = false;
+	decoder->data = nullptr;
+	decoder->size = 0;
+	decoder->scaleDenom = 1;
+	decoder->stripPool = nullptr;
+	return decoder;
+#else
+	return nullptr;
+#endif
+}
+
+/**
+ * @brief 销毁MJPEG解码器
+ *
+ * @param decoder [in && out] 解码器
+ */
+static void DestroyMjpegDecoder(MjpegDecoder*& decoder) {
+	if (decoder == nullptr) {
+		return;
+	}
+	DestroyWorkerPool(decoder->stripPool);
+	for (auto& stripDecoder : decoder->stripDecoders) {
+		DestroyMjpegDecoder(stripDecoder);
+	}
+#if defined(BECAM_WITH_JPEG)
+	jpeg_destroy_decompress(&decoder->cinfo);
+#endif
+	delete decoder;
+	decoder = nullptr;
+}
+
+/**
+ * @brief 设置分条并行解码线程数
+ *
+ * @param decoder [in] 解码器
+ * @param threadCount [in] 线程数（为0时取处理器核心数，为1时串行解码）
+ * @return 状态码
+ */
+static StatusCode SetMjpegDecoderThreads(MjpegDecoder* decoder, uint32_t threadCount) {
+	if (decoder == nullptr) {
+		return StatusCode::STATUS_CODE_ERR_INPUT_PARAM;
+	}
+	if (threadCount == 0) {
+		threadCount = std::max(1u, std::thread::hardware_concurrency());
+	}
+	if (GetWorkerPoolSize(decoder->stripPool) == threadCount) {
+		return StatusCode::STATUS_CODE_SUCCESS;
+	}
+	DestroyWorkerPool(decoder->stripPool);
+	if (threadCount > 1) {
+		decoder->stripPool = CreateWorkerPool(threadCount);
+	}
+	return StatusCode::STATUS_CODE_SUCCESS;
+}
+
+/**
+ * @brief 读取帧头并计算输出尺寸（之后需调用FinishMjpegDecode或AbortMjpegDecode）
+ *
+ * @param decoder [in] 解码器
+ * @param data [in] MJPEG帧数据（在FinishMjpegDecode完成前需保持有效，缺少霍夫曼表时解码补齐后的副本）
+ * @param size [in] MJPEG帧数据大小
+ * @param scaleDenom [in] 缩放分母（1、2、4、8）
+ * @param format [in] 目标格式
+ * @param width [out] 输出宽度
+ * @param height [out] 输出高度
+ * @return 状态码
+ */
+static StatusCode StartMjpegDecode(MjpegDecoder* decoder, const uint8_t* data, const size_t size, const uint32_t scaleDenom, const uint32_t format,
+								   uint32_t& width, uint32_t& height) {
+	width = 0;
+	height = 0;
+#if defined(BECAM_WITH_JPEG)
+	if (decoder == nullptr || data == nullptr || size == 0 || !IsMjpegScaleValid(scaleDenom)) {
+		return StatusCode::STATUS_CODE_ERR_INPUT_PARAM;
+	}
+	if (!CanDecodeMjpegTo(format)) {
+		return StatusCode::STATUS_CODE_ERR_NOT_SUPPORTED;
+	}
+	auto cinfo = &decoder->cinfo;
+	// 丢弃上一帧未完成的解码状态
+	jpeg_abort_decompress(cinfo);
+	decoder->headerRead = false;
+	if (setjmp(decoder->err.jump)) {
+		jpeg_abort_decompress(cinfo);
+		return StatusCode::STATUS_CODE_ERR_DECODE_FAILED;
+	}
+	// 缺少霍夫曼表（DHT）的UVC帧先补齐标准表，不依赖libjpeg-turbo的隐式默认表
+	auto source = data;
+	auto sourceSize = size;
+	if (FindJpegHuffmanInsertOffset(data, size) > 0) {
+		decoder->completeData.resize(GetCompleteJpegSize(data, size));
+		sourceSize = CopyCompleteJpeg(data, size, decoder->completeData.data());
+		source = decoder->completeData.data();
+	}
+	jpeg_mem_src(cinfo, const_cast<uint8_t*>(source), static_cast<unsigned long>(sourceSize));
+	if (jpeg_read_header(cinfo, TRUE) != JPEG_HEADER_OK) {
+		jpeg_abort_decompress(cinfo);
+		return StatusCode::STATUS_CODE_ERR_DECODE_FAILED;
+	}
+	switch (format) {
+		case BECAM_FOURCC('G', 'R', 'E', 'Y'):
+			cinfo->out_color_space = JCS_GRAYSCALE;
+			break;
+	#if defined(JCS_EXTENSIONS)
+		case BECAM_FORMAT_BGR24:
+			cinfo->out_color_space = JCS_EXT_BGR;
+			break;
+	#endif
+	#if defined(JCS_ALPHA_EXTENSIONS)
+		case BECAM_FORMAT_RGBA32:
+			cinfo->out_color_space = JCS_EXT_RGBA;
+			break;
+		case BECAM_FORMAT_BGRA32:
+			cinfo->out_color_space = JCS_EXT_BGRA;
+			break;
+	#endif
+		default:
+			cinfo->out_color_space = JCS_RGB;
+			break;
+	}
+	cinfo->scale_num = 1;
+	cinfo->scale_denom = scaleDenom;
+	jpeg_calc_output_dimensions(cinfo);
+	width = cinfo->output_width;
+	height = cinfo->output_height;
+	decoder->headerRead = true;
+	decoder->data = source;
+	decoder->size = sourceSize;
+	decoder->scaleDenom = scaleDenom;
+	return StatusCode::STATUS_CODE_SUCCESS;
+#else
+	(void)decoder;
+	(void)data;
+	(void)size;
+	(void)scaleDenom;
+	(void)format;
+	return StatusCode::STATUS_CODE_ERR_NOT_SUPPORTED;
+#endif
+}
+
+/**
+ * @brief 放弃已读取帧头的解码
+ *
+ * @param decoder [in] 解码器
+ */
+static void AbortMjpegDecode(MjpegDecoder* decoder) {
+	if (decoder == nullptr) {
+		return;
+	}
+#if defined(BECAM_WITH_JPEG)
+	jpeg_abort_decompress(&decoder->cinfo);
+#endif
+	decoder->headerRead = false;
+}
+
+#if defined(BECAM_WITH_JPEG)
+/**
+ * @brief 解码一个分条（跳过上方重叠的行，只输出指定行数）
+ *
+ * @param decoder [in] 分条解码器
+ * @param strip [in] 分条数据
+ * @param scaleDenom [in] 缩放分母
+ * @param dst [in && out] 目标图像（分条输出区域）
+ * @param skipRows [in] 跳过的行数
+ * @return 状态码
+ */
+static StatusCode DecodeMjpegStrip(MjpegDecoder* decoder, const std::vector<uint8_t>& strip, const uint32_t scaleDenom, ImageBuffer& dst,
+								   const uint32_t skipRows) {
+	uint32_t width = 0;
+	uint32_t height = 0;
+	auto code = StartMjpegDecode(decoder, strip.data(), strip.size(), scaleDenom, dst.format, width, height);
+	if (code != StatusCode::STATUS_CODE_SUCCESS) {
+		return code;
+	}
+	auto cinfo = &decoder->cinfo;
+	if (width != dst.width || height < skipRows + dst.height) {
+		AbortMjpegDecode(decoder);
+		return StatusCode::STATUS_CODE_ERR_DECODE_FAILED;
+	}
+	decoder->rowScratch.resize(dst.stride[0]);
+	decoder->headerRead = false;
+	if (setjmp(decoder->err.jump)) {
+		jpeg_abort_decompress(cinfo);
+		return StatusCode::STATUS_CODE_ERR_DECODE_FAILED;
+	}
+	jpeg_start_decompress(cinfo);
+	JSAMPROW rows[16];
+	while (cinfo->output_scanline < skipRows) {
+		rows[0] = decoder->rowScratch.data();
+		jpeg_read_scanlines(cinfo, rows, 1);
+	}
+	auto end = skipRows + dst.height;
+	while (cinfo->output_scanline < end) {
+		JDIMENSION count = 0;
+		while (count < 16 && cinfo->output_scanline + count < end) {
+			rows[count] = dst.plane[0] + size_t(cinfo->output_scanline + count - skipRows) * dst.stride[0];
+			count++;
+		}
+		jpeg_read_scanlines(cinfo, rows, count);
+	}
+	// 下方重叠的行不需要输出
+	jpeg_abort_decompress(cinfo);
+	return StatusCode::STATUS_CODE_SUCCESS;
+}
+
+/**
+ * @brief 按重启间隔切分为多个分条并行解码
+ *
+ * @param decoder [in] 解码器（已解析当前帧的重启间隔布局）
+ * @param stripCount [in] 分条数
+ * @param rowStep [in] 分条边界的对齐步长（MCU行数）
+ * @param dst [in && out] 目标图像
+ * @return 状态码
+ */
+static StatusCode DecodeMjpegStrips(MjpegDecoder* decoder, const uint32_t stripCount, const uint32_t rowStep, ImageBuffer& dst) {
+	while (decoder->stripDecoders.size() < stripCount) {
+		auto stripDecoder = CreateMjpegDecoder();
+		if (stripDecoder == nullptr) {
+			return StatusCode::STATUS_CODE_ERR_DECODE_FAILED;
+		}
+		decoder->stripDecoders.push_back(stripDecoder);
+	}
+	decoder->stripData.resize(std::max(decoder->stripData.size(), size_t(stripCount)));
+	const auto& layout = decoder->layout;
+	auto scale = decoder->scaleDenom;
+	auto stepCount = (layout.mcuRows + rowStep - 1) / rowStep;
+	std::vector<StatusCode> codes(stripCount, StatusCode::STATUS_CODE_SUCCESS);
+	RunWorkerTasks(decoder->stripPool, stripCount, [&](size_t i) {
+		// 按对齐步长均分MCU行
+		auto firstRow = uint32_t(size_t(stepCount) * i / stripCount) * rowStep;
+		auto lastRow = std::min(layout.mcuRows, uint32_t(size_t(stepCount) * (i + 1) / stripCount) * rowStep);
+		// 存在垂直色度下采样时上下各多解码一个步长，保证边界处的色度插值与整帧解码一致
+		auto overlap = layout.verticalSubsampled ? rowStep : 0;
+		auto decodeFirst = firstRow > overlap ? firstRow - overlap : 0;
+		auto decodeLast = std::min(layout.mcuRows, lastRow + overlap);
+		BuildJpegStrip(decoder->data, layout, decodeFirst, decodeLast - decodeFirst, decoder->stripData[i]);
+		// 输出区域
+		auto outFirst = firstRow * layout.mcuHeight / scale;
+		auto outLast = lastRow == layout.mcuRows ? dst.height : lastRow * layout.mcuHeight / scale;
+		ImageBuffer view = dst;
+		view.plane[0] = dst.plane[0] + size_t(outFirst) * dst.stride[0];
+		view.height = outLast - outFirst;
+		auto skipRows = (firstRow - decodeFirst) * layout.mcuHeight / scale;
+		codes[i] = DecodeMjpegStrip(decoder->stripDecoders[i], decoder->stripData[i], scale, view, skipRows);
+	});
+	for (auto code : codes) {
+		if (code != StatusCode::STATUS_CODE_SUCCESS) {
+			return StatusCode::STATUS_CODE_ERR_DECODE_FAILED;
+		}
+	}
+	return StatusCode::STATUS_CODE_SUCCESS;
+}
+#endif
+
+/**
+ * @brief 解码扫描行到目标图像（尺寸需与StartMjpegDecode输出一致）
+ *
+ * @param decoder [in] 解码器
+ * @param dst [in && out] 目标图像（格式需与StartMjpegDecode一致，缓冲区由调用方分配）
+ * @return 状态码
+ */
+static StatusCode FinishMjpegDecode(MjpegDecoder* decoder, ImageBuffer& dst) {
+#if defined(BECAM_WITH_JPEG)
+	if (decoder == nullptr || !decoder->headerRead) {
+		return StatusCode::STATUS_CODE_ERR_INPUT_PARAM;
+	}
+	auto cinfo = &decoder->cinfo;
+	if (dst.plane[0] == nullptr || dst.width != cinfo->output_width || dst.height != cinfo->output_height) {
+		AbortMjpegDecode(decoder);
+		return StatusCode::STATUS_CODE_ERR_INPUT_PARAM;
+	}
+	NormalizeImageStrides(dst);
+	// 启用分条并行解码且帧内有可用的重启间隔时切分解码
+	if (decoder->stripPool != nullptr && ParseJpegRestartLayout(decoder->data, decoder->size, decoder->layout) &&
+		decoder->layout.width == cinfo->image_width && decoder->layout.height == cinfo->image_height) {
+		auto rowStep = GetJpegStripRowStep(decoder->layout);
+		auto stripCount = std::min(GetWorkerPoolSize(decoder->stripPool), (decoder->layout.mcuRows + rowStep - 1) / rowStep);
+		if (stripCount > 1) {
+			AbortMjpegDecode(decoder);
+			return DecodeMjpegStrips(decoder, stripCount, rowStep, dst);
+		}
+	}
+	decoder->headerRead = false;
+	if (setjmp(decoder->err.jump)) {
+		jpeg_abort_decompress(cinfo);
+		return StatusCode::STATUS_CODE_ERR_DECODE_FAILED;
+	}
+	jpeg_start_decompress(cinfo);
+	// 每次按解码器的最佳批量行数直接写入目标图像（遵循目标每行字节数）
+	JSAMPROW rows[16];
+	while (cinfo->output_scanline < cinfo->output_height) {
+		JDIMENSION count = 0;
+		while (count < 16 && cinfo->output_scanline + count < cinfo->output_height) {
+			rows[count] = dst.plane[0] + size_t(cinfo->output_scanline + count) * dst.stride[0];
+			count++;
+		}
+		jpeg_read_scanlines(cinfo, rows, count);
+	}
+	jpeg_finish_decompress(cinfo);
+	return StatusCode::STATUS_CODE_SUCCESS;
+#else
+	(void)decoder;
+	(void)dst;
+	return StatusCode::STATUS_CODE_ERR_NOT_SUPPORTED;
+#endif
+}
+
+/**
+ * @brief 解码一帧MJPEG（目标图像尺寸需为缩放后的尺寸）
+ *
+ * @param decoder [in] 解码器
+ * @param data [in] MJPEG帧数据
+ * @param size [in] MJPEG帧数据大小
+ * @param scaleDenom [in] 缩放分母（1、2、4、8）
+ * @param dst [in && out] 目标图像
+ * @return 状态码
+ */
+static StatusCode DecodeMjpeg(MjpegDecoder* decoder, const uint8_t* data, const size_t size, const uint32_t scaleDenom, ImageBuffer& dst) {
+	uint32_t width = 0;
+	uint32_t height = 0;
+	auto code = StartMjpegDecode(decoder, data, size, scaleDenom, dst.format, width, height);
+	if (code != StatusCode::STATUS_CODE_SUCCESS) {
+		return code;
+	}
+	return FinishMjpegDecode(decoder, dst);
+}
+
+#endif
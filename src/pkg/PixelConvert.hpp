@@ -0,0 +1,950 @@
+#pragma once
+
+#ifndef _BECAM_PIXEL_CONVERT_H_
+#define _BECAM_PIXEL_CONVERT_H_
+
+#include "LumaHistogram.hpp"
+#include "SimdDispatch.hpp"
+#include "WorkerPool.hpp"
+#include "YuvRepack.hpp"
+#include <becam/becam.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <vector>
+
+/**
+ * YUV转RGB采用BT.601有限范围（与UVC设备默认一致）的6位定点系数：
+ * yc = ((Y * 257 * 19003) >> 16) - 1192（即(Y - 16) * 1.164 * 64，与SIMD的无符号高16位乘法一致），d = U - 128, e = V - 128,
+ * R = (yc + 102e + 32) >> 6, G = (yc - 25d - 52e + 32) >> 6, B = (yc + 129d + 32) >> 6，结果截断到0~255；
+ * 中间值仅在结果必然截断为255时才会超出int16范围，因此向量化实现（饱和加法）与标量实现逐位一致
+ */
+
+/**
+ * @brief 判断格式是否为打包YUV 4:2:2
+ *
+ * @param format [in] 格式（FOURCC表示）
+ * @param lumaFirst [out] 亮度是否位于每组的第0、2字节
+ * @param uFirst [out] U是否先于V
+ * @return 是否为打包YUV 4:2:2
+ */
+static bool GetPackedYuvOrder(const uint32_t format, bool& lumaFirst, bool& uFirst) {
+	switch (format) {
+		case BECAM_FOURCC('Y', 'U', 'Y', 'V'):
+		case BECAM_FOURCC('Y', 'U', 'Y', '2'):
+			lumaFirst = true;
+			uFirst = true;
+			return true;
+		case BECAM_FOURCC('Y', 'V', 'Y', 'U'):
+			lumaFirst = true;
+			uFirst = false;
+			return true;
+		case BECAM_FOURCC('U', 'Y', 'V', 'Y'):
+			lumaFirst = false;
+			uFirst = true;
+			return true;
+		case BECAM_FOURCC('V', 'Y', 'U', 'Y'):
+			lumaFirst = false;
+			uFirst = false;
+			return true;
+		default:
+			return false;
+	}
+}
+
+/**
+ * @brief 判断格式是否为RGB
+ *
+ * @param format [in] 格式（FOURCC表示）
+ * @param bgr [out] 是否为B、G、R字节顺序
+ * @param bytesPerPixel [out] 每像素字节数
+ * @return 是否为RGB
+ */
+static bool GetRgbOrder(const uint32_t format, bool& bgr, uint32_t& bytesPerPixel) {
+	switch (format) {
+		case BECAM_FORMAT_RGB24:
+			bgr = false;
+			bytesPerPixel = 3;
+			return true;
+		case BECAM_FORMAT_BGR24:
+			bgr = true;
+			bytesPerPixel = 3;
+			return true;
+		case BECAM_FORMAT_RGBA32:
+			bgr = false;
+			bytesPerPixel = 4;
+			return true;
+		case BECAM_FORMAT_BGRA32:
+			bgr = true;
+			bytesPerPixel = 4;
+			return true;
+		default:
+			return false;
+	}
+}
+
+/**
+ * @brief 判断格式是否为半平面YUV 4:2:0
+ *
+ * @param format [in] 格式（FOURCC表示）
+ * @param uFirst [out] 交织色度中U是否先于V
+ * @return 是否为半平面YUV 4:2:0
+ */
+static bool GetSemiPlanarOrder(const uint32_t format, bool& uFirst) {
+	switch (format) {
+		case BECAM_FORMAT_NV12:
+			uFirst = true;
+			return true;
+		case BECAM_FORMAT_NV21:
+			uFirst = false;
+			return true;
+		default:
+			return false;
+	}
+}
+
+/**
+ * @brief 判断格式是否为平面YUV 4:2:0
+ *
+ * @param format [in] 格式（FOURCC表示）
+ * @param uFirst [out] 内存中U平面是否先于V平面（ImageBuffer中总是plane[1]为U、plane[2]为V）
+ * @return 是否为平面YUV 4:2:0
+ */
+static bool GetPlanarOrder(const uint32_t format, bool& uFirst) {
+	switch (format) {
+		case BECAM_FORMAT_I420:
+		case BECAM_FOURCC('I', '4', '2', '0'):
+		case BECAM_FOURCC('I', 'Y', 'U', 'V'):
+			uFirst = true;
+			return true;
+		case BECAM_FORMAT_YV12:
+			uFirst = false;
+			return true;
+		default:
+			return false;
+	}
+}
+
+/**
+ * @brief 获取格式的平面数量
+ *
+ * @param format [in] 格式（FOURCC表示）
+ * @return 平面数量（不支持的格式为0）
+ */
+static uint32_t GetImagePlaneCount(const uint32_t format) {
+	bool first = false;
+	bool second = false;
+	uint32_t bytesPerPixel = 0;
+	if (GetPackedYuvOrder(format, first, second) || GetRgbOrder(format, first, bytesPerPixel)) {
+		return 1;
+	}
+	if (GetSemiPlanarOrder(format, first)) {
+		return 2;
+	}
+	if (GetPlanarOrder(format, first)) {
+		return 3;
+	}
+	switch (format) {
+		case BECAM_FOURCC('G', 'R', 'E', 'Y'):
+			return 1;
+		default:
+			return 0;
+	}
+}
+
+/**
+ * @brief 获取平面紧凑排列时的每行字节数
+ *
+ * @param format [in] 格式（FOURCC表示）
+ * @param width [in] 图像宽度
+ * @param plane [in] 平面序号
+ * @return 每行字节数
+ */
+static uint32_t GetDefaultImageStride(const uint32_t format, const uint32_t width, const uint32_t plane) {
+	bool bgr = false;
+	bool uFirst = false;
+	uint32_t bytesPerPixel = 0;
+	if (plane >= GetImagePlaneCount(format)) {
+		return 0;
+	}
+	if (GetPackedYuvOrder(format, bgr, uFirst)) {
+		// 奇数宽度时最后一组仍完整占用4字节
+		return (width + 1) / 2 * 4;
+	}
+	if (GetRgbOrder(format, bgr, bytesPerPixel)) {
+		return width * bytesPerPixel;
+	}
+	if (plane > 0 && GetSemiPlanarOrder(format, uFirst)) {
+		return (width + 1) / 2 * 2;
+	}
+	if (plane > 0) {
+		return (width + 1) / 2;
+	}
+	return width;
+}
+
+/**
+ * @brief 获取平面的行数
+ *
+ * @param format [in] 格式（FOURCC表示）
+ * @param height [in] 图像高度
+ * @param plane [in] 平面序号
+ * @return 行数
+ */
+static uint32_t GetImagePlaneHeight(const uint32_t format, const uint32_t height, const uint32_t plane) {
+	if (plane >= GetImagePlaneCount(format)) {
+		return 0;
+	}
+	// 4:2:0的色度平面行数减半
+	return plane > 0 ? (height + 1) / 2 : height;
+}
+
+/**
+ * @brief 获取按行切分图像时起始行的对齐值
+ *
+ * @param format [in] 格式（FOURCC表示）
+ * @return 对齐行数（4:2:0为2，其它为1）
+ */
+static uint32_t GetImageRowAlignment(const uint32_t format) {
+	return GetImagePlaneCount(format) > 1 ? 2 : 1;
+}
+
+/**
+ * @brief 计算图像紧凑排列时所需的字节数
+ *
+ * @param format [in] 格式（FOURCC表示）
+ * @param width [in] 图像宽度
+ * @param height [in] 图像高度
+ * @return 字节数（不支持的格式为0）
+ */
+static size_t GetImageSize(const uint32_t format, const uint32_t width, const uint32_t height) {
+	size_t size = 0;
+	for (uint32_t i = 0; i < GetImagePlaneCount(format); i++) {
+		size += size_t(GetDefaultImageStride(format, width, i)) * GetImagePlaneHeight(format, height, i);
+	}
+	return size;
+}
+
+/**
+ * @brief 按连续内存填充图像各平面的地址及每行字节数
+ *
+ * @param image [in && out] 图像（需已填写格式、宽、高）
+ * @param data [in] 图像数据
+ * @param size [in] 图像数据大小
+ * @param bytesPerLine [in] 亮度平面的每行字节数（为0时按紧凑排列，色度平面按V4L2单平面格式的约定推算）
+ * @return 数据大小是否足够
+ */
+static bool FillImageBuffer(ImageBuffer& image, uint8_t* data, const size_t size, const uint32_t bytesPerLine) {
+	auto planeCount = GetImagePlaneCount(image.format);
+	if (data == nullptr || planeCount == 0 || image.width == 0 || image.height == 0) {
+		return false;
+	}
+	if (bytesPerLine > 0 && bytesPerLine < GetDefaultImageStride(image.format, image.width, 0)) {
+		return false;
+	}
+	// 内存中平面的排列顺序（YV12的V平面在U平面之前）
+	uint32_t order[3] = {0, 1, 2};
+	bool uFirst = true;
+	if (GetPlanarOrder(image.format, uFirst) && !uFirst) {
+		order[1] = 2;
+		order[2] = 1;
+	}
+	for (uint32_t i = 0; i < 3; i++) {
+		image.plane[i] = nullptr;
+		image.stride[i] = 0;
+	}
+	size_t offset = 0;
+	for (uint32_t i = 0; i < planeCount; i++) {
+		auto plane = order[i];
+		auto stride = GetDefaultImageStride(image.format, image.width, plane);
+		if (bytesPerLine > 0) {
+			// 半平面格式色度与亮度每行字节数相同，平面格式色度为亮度的一半
+			auto derived = plane == 0 || planeCount == 2 ? bytesPerLine : bytesPerLine / 2;
+			stride = derived > stride ? derived : stride;
+		}
+		image.plane[plane] = data + offset;
+		image.stride[plane] = stride;
+		offset += size_t(stride) * GetImagePlaneHeight(image.format, image.height, plane);
+	}
+	return offset <= size;
+}
+
+/**
+ * @brief 补全图像中为0的每行字节数
+ *
+ * @param image [in && out] 图像
+ */
+static void NormalizeImageStrides(ImageBuffer& image) {
+	for (uint32_t i = 0; i < GetImagePlaneCount(image.format); i++) {
+		if (image.stride[i] == 0) {
+			image.stride[i] = GetDefaultImageStride(image.format, image.width, i);
+		}
+	}
+}
+
+/**
+ * @brief 将图像描述调整为其中的一块区域（不拷贝数据）
+ *
+ * @param image [in && out] 图像
+ * @param left [in] 区域左上角横坐标（YUV格式需为偶数）
+ * @param top [in] 区域左上角纵坐标（YUV 4:2:0需为偶数）
+ * @param width [in] 区域宽度
+ * @param height [in] 区域高度
+ * @return 区域是否有效
+ */
+static bool CropImageBuffer(ImageBuffer& image, const uint32_t left, const uint32_t top, const uint32_t width, const uint32_t height) {
+	if (width == 0 || height == 0 || left + width > image.width || top + height > image.height) {
+		return false;
+	}
+	NormalizeImageStrides(image);
+	bool first = false;
+	bool second = false;
+	uint32_t bytesPerPixel = 0;
+	auto planeCount = GetImagePlaneCount(image.format);
+	if (planeCount > 1) {
+		if (left % 2 != 0 || top % 2 != 0) {
+			return false;
+		}
+		// 半平面格式每个色度采样占2字节，平面格式占1字节
+		for (uint32_t i = 1; i < planeCount; i++) {
+			image.plane[i] += size_t(top / 2) * image.stride[i] + (planeCount == 2 ? left : left / 2);
+		}
+		bytesPerPixel = 1;
+	} else if (GetPackedYuvOrder(image.format, first, second)) {
+		if (left % 2 != 0) {
+			return false;
+		}
+		bytesPerPixel = 2;
+	} else if (!GetRgbOrder(image.format, first, bytesPerPixel)) {
+		bytesPerPixel = 1;
+	}
+	image.plane[0] += size_t(top) * image.stride[0] + size_t(left) * bytesPerPixel;
+	image.width = width;
+	image.height = height;
+	return true;
+}
+
+/**
+ * @brief 单个像素YUV转RGB（标量参考实现）
+ */
+static inline void YuvToRgbPixel(const int y, const int u, const int v, uint8_t* dst, const bool bgr, const uint32_t bytesPerPixel) {
+	auto yc = int((uint32_t(y) * 257 * 19003) >> 16) - 1192;
+	auto d = u - 128;
+	auto e = v - 128;
+	int rgb[3] = {(yc + 102 * e + 32) >> 6, (yc - 25 * d - 52 * e + 32) >> 6, (yc + 129 * d + 32) >> 6};
+	for (auto& value : rgb) {
+		value = value < 0 ? 0 : (value > 255 ? 255 : value);
+	}
+	dst[0] = uint8_t(bgr ? rgb[2] : rgb[0]);
+	dst[1] = uint8_t(rgb[1]);
+	dst[2] = uint8_t(bgr ? rgb[0] : rgb[2]);
+	if (bytesPerPixel == 4) {
+		dst[3] = 255;
+	}
+}
+
+/**
+ * @brief 打包YUV 4:2:2单行转RGB（标量参考实现）
+ *
+ * @param src [in] 源行（从第x个像素开始）
+ * @param dst [out] 目标行（从第x个像素开始）
+ * @param width [in] 像素数
+ * @param lumaFirst [in] 亮度是否位于每组的第0、2字节
+ * @param uFirst [in] U是否先于V
+ * @param bgr [in] 是否输出B、G、R字节顺序
+ * @param bytesPerPixel [in] 输出每像素字节数（3或4）
+ */
+static void PackedYuvToRgbRowScalar(const uint8_t* src, uint8_t* dst, const uint32_t width, const bool lumaFirst, const bool uFirst, const bool bgr,
+									const uint32_t bytesPerPixel) {
+	auto y0 = lumaFirst ? 0 : 1;
+	auto c0 = lumaFirst ? 1 : 0;
+	for (uint32_t x = 0; x < width; x++) {
+		auto group = src + (x / 2) * 4;
+		auto u = uFirst ? group[c0] : group[c0 + 2];
+		auto v = uFirst ? group[c0 + 2] : group[c0];
+		YuvToRgbPixel(group[y0 + (x % 2) * 2], u, v, dst + x * bytesPerPixel, bgr, bytesPerPixel);
+	}
+}
+
+#if defined(BECAM_SIMD_X86)
+/**
+ * @brief 8个像素YUV转RGB（SSE2，输入输出均为16位，亮度取值0~255）
+ */
+static inline void YuvToRgbSse2(const __m128i y, const __m128i u, const __m128i v, __m128i& r, __m128i& g, __m128i& b) {
+	auto yc = _mm_sub_epi16(_mm_mulhi_epu16(_mm_or_si128(y, _mm_slli_epi16(y, 8)), _mm_set1_epi16(19003)), _mm_set1_epi16(1192));
+	auto d = _mm_sub_epi16(u, _mm_set1_epi16(128));
+	auto e = _mm_sub_epi16(v, _mm_set1_epi16(128));
+	auto round = _mm_set1_epi16(32);
+	r = _mm_srai_epi16(_mm_adds_epi16(_mm_adds_epi16(yc, _mm_mullo_epi16(e, _mm_set1_epi16(102))), round), 6);
+	g = _mm_subs_epi16(_mm_subs_epi16(yc, _mm_mullo_epi16(d, _mm_set1_epi16(25))), _mm_mullo_epi16(e, _mm_set1_epi16(52)));
+	g = _mm_srai_epi16(_mm_adds_epi16(g, round), 6);
+	b = _mm_srai_epi16(_mm_adds_epi16(_mm_adds_epi16(yc, _mm_mullo_epi16(d, _mm_set1_epi16(129))), round), 6);
+}
+
+/**
+ * @brief 将4个RGBA像素压缩为12字节RGB（SSE2，高4字节为0）
+ */
+static inline __m128i PackRgbaToRgbSse2(const __m128i rgba) {
+	auto v = _mm_and_si128(rgba, _mm_set1_epi32(0x00FFFFFF));
+	// 每个64位内将高位像素右移1字节紧接低位像素
+	auto low32 = _mm_set_epi32(0, -1, 0, -1);
+	v = _mm_or_si128(_mm_and_si128(v, low32), _mm_srli_epi64(_mm_andnot_si128(low32, v), 8));
+	// 将高64位中的6字节右移2字节紧接低64位中的6字节
+	auto low64 = _mm_set_epi32(0, 0, -1, -1);
+	return _mm_or_si128(_mm_and_si128(v, low64), _mm_srli_si128(_mm_andnot_si128(low64, v), 2));
+}
+
+/**
+ * @brief 将4组12字节RGB拼接为48字节写入（SSE2，每组高4字节需为0）
+ */
+static inline void StoreRgb24Sse2(uint8_t* out, const __m128i a, const __m128i b, const __m128i c, const __m128i d) {
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_or_si128(a, _mm_slli_si128(b, 12)));
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(out + 16), _mm_or_si128(_mm_srli_si128(b, 4), _mm_slli_si128(c, 8)));
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(out + 32), _mm_or_si128(_mm_srli_si128(c, 8), _mm_slli_si128(d, 4)));
+}
+
+/**
+ * @brief 打包YUV 4:2:2单行转RGB（SSE2，每次16个像素）
+ */
+static void PackedYuvToRgbRowSse2(const uint8_t* src, uint8_t* dst, const uint32_t width, const bool lumaFirst, const bool uFirst, const bool bgr,
+								  const uint32_t bytesPerPixel) {
+	auto lowMask = _mm_set1_epi16(0x00FF);
+	auto wordMask = _mm_set1_epi32(0x0000FFFF);
+	auto alpha = _mm_set1_epi8(char(0xFF));
+	uint32_t x = 0;
+	for (; x + 16 <= width; x += 16) {
+		auto p = src + x * 2;
+		__m128i r8;
+		__m128i g8;
+		__m128i b8;
+		{
+			__m128i r16[2];
+			__m128i g16[2];
+			__m128i b16[2];
+			for (int half = 0; half < 2; half++) {
+				auto raw = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + half * 16));
+				// 拆分亮度和色度（均扩展为16位）
+				auto y = lumaFirst ? _mm_and_si128(raw, lowMask) : _mm_srli_epi16(raw, 8);
+				auto uv = lumaFirst ? _mm_srli_epi16(raw, 8) : _mm_and_si128(raw, lowMask);
+				// 每组的两个像素共用色度：复制32位中的低16位（第一个色度）和高16位（第二个色度）
+				auto c0 = _mm_and_si128(uv, wordMask);
+				c0 = _mm_or_si128(c0, _mm_slli_epi32(c0, 16));
+				auto c1 = _mm_srli_epi32(uv, 16);
+				c1 = _mm_or_si128(c1, _mm_slli_epi32(c1, 16));
+				YuvToRgbSse2(y, uFirst ? c0 : c1, uFirst ? c1 : c0, r16[half], g16[half], b16[half]);
+			}
+			r8 = _mm_packus_epi16(r16[0], r16[1]);
+			g8 = _mm_packus_epi16(g16[0], g16[1]);
+			b8 = _mm_packus_epi16(b16[0], b16[1]);
+		}
+		if (bgr) {
+			auto t = r8;
+			r8 = b8;
+			b8 = t;
+		}
+		// 交织为RGBA
+		auto rgLo = _mm_unpacklo_epi8(r8, g8);
+		auto rgHi = _mm_unpackhi_epi8(r8, g8);
+		auto baLo = _mm_unpacklo_epi8(b8, alpha);
+		auto baHi = _mm_unpackhi_epi8(b8, alpha);
+		__m128i pixels[4] = {
+			_mm_unpacklo_epi16(rgLo, baLo),
+			_mm_unpackhi_epi16(rgLo, baLo),
+			_mm_unpacklo_epi16(rgHi, baHi),
+			_mm_unpackhi_epi16(rgHi, baHi),
+		};
+		auto out = dst + x * bytesPerPixel;
+		if (bytesPerPixel == 4) {
+			for (int i = 0; i < 4; i++) {
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i * 16), pixels[i]);
+			}
+		} else {
+			// SSE2没有字节重排指令，以移位去掉每个像素的第4字节后拼接
+			StoreRgb24Sse2(out, PackRgbaToRgbSse2(pixels[0]), PackRgbaToRgbSse2(pixels[1]), PackRgbaToRgbSse2(pixels[2]),
+						   PackRgbaToRgbSse2(pixels[3]));
+		}
+	}
+	PackedYuvToRgbRowScalar(src + x * 2, dst + x * bytesPerPixel, width - x, lumaFirst, uFirst, bgr, bytesPerPixel);
+}
+
+/**
+ * @brief 16个像素YUV转RGB（AVX2，输入输出均为16位，亮度取值0~255）
+ */
+BECAM_TARGET_AVX2 static inline void YuvToRgbAvx2(const __m256i y, const __m256i u, const __m256i v, __m256i& r, __m256i& g, __m256i& b) {
+	auto yc = _mm256_sub_epi16(_mm256_mulhi_epu16(_mm256_or_si256(y, _mm256_slli_epi16(y, 8)), _mm256_set1_epi16(19003)), _mm256_set1_epi16(1192));
+	auto d = _mm256_sub_epi16(u, _mm256_set1_epi16(128));
+	auto e = _mm256_sub_epi16(v, _mm256_set1_epi16(128));
+	auto round = _mm256_set1_epi16(32);
+	r = _mm256_srai_epi16(_mm256_adds_epi16(_mm256_adds_epi16(yc, _mm256_mullo_epi16(e, _mm256_set1_epi16(102))), round), 6);
+	g = _mm256_subs_epi16(_mm256_subs_epi16(yc, _mm256_mullo_epi16(d, _mm256_set1_epi16(25))), _mm256_mullo_epi16(e, _mm256_set1_epi16(52)));
+	g = _mm256_srai_epi16(_mm256_adds_epi16(g, round), 6);
+	b = _mm256_srai_epi16(_mm256_adds_epi16(_mm256_adds_epi16(yc, _mm256_mullo_epi16(d, _mm256_set1_epi16(129))), round), 6);
+}
+
+/**
+ * @brief 打包YUV 4:2:2单行转RGB（AVX2，每次32个像素）
+ */
+BECAM_TARGET_AVX2 static void PackedYuvToRgbRowAvx2(const uint8_t* src, uint8_t* dst, const uint32_t width, const bool lumaFirst, const bool uFirst,
+													const bool bgr, const uint32_t bytesPerPixel) {
+	auto lowMask = _mm256_set1_epi16(0x00FF);
+	auto wordMask = _mm256_set1_epi32(0x0000FFFF);
+	auto alpha = _mm256_set1_epi8(char(0xFF));
+	// 每个128位通道内将4个RGBA像素压缩为12字节RGB（高4字节为0）
+	auto rgbShuffle = _mm256_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1, 0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1);
+	uint32_t x = 0;
+	for (; x + 32 <= width; x += 32) {
+		auto p = src + x * 2;
+		__m256i r16[2];
+		__m256i g16[2];
+		__m256i b16[2];
+		for (int half = 0; half < 2; half++) {
+			auto raw = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + half * 32));
+			auto y = lumaFirst ? _mm256_and_si256(raw, lowMask) : _mm256_srli_epi16(raw, 8);
+			auto uv = lumaFirst ? _mm256_srli_epi16(raw, 8) : _mm256_and_si256(raw, lowMask);
+			auto c0 = _mm256_and_si256(uv, wordMask);
+			c0 = _mm256_or_si256(c0, _mm256_slli_epi32(c0, 16));
+			auto c1 = _mm256_srli_epi32(uv, 16);
+			c1 = _mm256_or_si256(c1, _mm256_slli_epi32(c1, 16));
+			YuvToRgbAvx2(y, uFirst ? c0 : c1, uFirst ? c1 : c0, r16[half], g16[half], b16[half]);
+		}
+		// 收窄后像素顺序为[0-7, 16-23 | 8-15, 24-31]，在交织后统一恢复
+		auto r8 = _mm256_packus_epi16(r16[0], r16[1]);
+		auto g8 = _mm256_packus_epi16(g16[0], g16[1]);
+		auto b8 = _mm256_packus_epi16(b16[0], b16[1]);
+		if (bgr) {
+			auto t = r8;
+			r8 = b8;
+			b8 = t;
+		}
+		auto rgLo = _mm256_unpacklo_epi8(r8, g8);
+		auto rgHi = _mm256_unpackhi_epi8(r8, g8);
+		auto baLo = _mm256_unpacklo_epi8(b8, alpha);
+		auto baHi = _mm256_unpackhi_epi8(b8, alpha);
+		auto q0 = _mm256_unpacklo_epi16(rgLo, baLo); // [0-3 | 8-11]
+		auto q1 = _mm256_unpackhi_epi16(rgLo, baLo); // [4-7 | 12-15]
+		auto q2 = _mm256_unpacklo_epi16(rgHi, baHi); // [16-19 | 24-27]
+		auto q3 = _mm256_unpackhi_epi16(rgHi, baHi); // [20-23 | 28-31]
+		__m256i pixels[4] = {
+			_mm256_permute2x128_si256(q0, q1, 0x20),
+			_mm256_permute2x128_si256(q0, q1, 0x31),
+			_mm256_permute2x128_si256(q2, q3, 0x20),
+			_mm256_permute2x128_si256(q2, q3, 0x31),
+		};
+		auto out = dst + x * bytesPerPixel;
+		if (bytesPerPixel == 4) {
+			for (int i = 0; i < 4; i++) {
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i * 32), pixels[i]);
+			}
+		} else {
+			// 每个128位通道压缩为12字节后，每4组拼接为48字节写入
+			for (int i = 0; i < 4; i += 2) {
+				auto a = _mm256_shuffle_epi8(pixels[i], rgbShuffle);
+				auto b = _mm256_shuffle_epi8(pixels[i + 1], rgbShuffle);
+				StoreRgb24Sse2(out + i * 24, _mm256_castsi256_si128(a), _mm256_extracti128_si256(a, 1), _mm256_castsi256_si128(b),
+							   _mm256_extracti128_si256(b, 1));
+			}
+		}
+	}
+	PackedYuvToRgbRowSse2(src + x * 2, dst + x * bytesPerPixel, width - x, lumaFirst, uFirst, bgr, bytesPerPixel);
+}
+#endif
+
+#if defined(BECAM_SIMD_NEON)
+/**
+ * @brief 8个像素YUV转RGB（NEON，亮度为8位，色度为16位，输出为8位）
+ */
+static inline void YuvToRgbNeon(const uint8x8_t y, const int16x8_t u, const int16x8_t v, uint8x8_t& r, uint8x8_t& g, uint8x8_t& b) {
+	// Y * 257即Y与自身拼接为16位
+	auto yy = vzip_u8(y, y);
+	auto y16 = vreinterpretq_u16_u8(vcombine_u8(yy.val[0], yy.val[1]));
+	auto k = vdup_n_u16(19003);
+	auto yHigh = vcombine_u16(vshrn_n_u32(vmull_u16(vget_low_u16(y16), k), 16), vshrn_n_u32(vmull_u16(vget_high_u16(y16), k), 16));
+	auto yc = vsubq_s16(vreinterpretq_s16_u16(yHigh), vdupq_n_s16(1192));
+	auto d = vsubq_s16(u, vdupq_n_s16(128));
+	auto e = vsubq_s16(v, vdupq_n_s16(128));
+	auto round = vdupq_n_s16(32);
+	r = vqmovun_s16(vshrq_n_s16(vqaddq_s16(vqaddq_s16(yc, vmulq_s16(e, vdupq_n_s16(102))), round), 6));
+	auto g16 = vqsubq_s16(vqsubq_s16(yc, vmulq_s16(d, vdupq_n_s16(25))), vmulq_s16(e, vdupq_n_s16(52)));
+	g = vqmovun_s16(vshrq_n_s16(vqaddq_s16(g16, round), 6));
+	b = vqmovun_s16(vshrq_n_s16(vqaddq_s16(vqaddq_s16(yc, vmulq_s16(d, vdupq_n_s16(129))), round), 6));
+}
+
+/**
+ * @brief 打包YUV 4:2:2单行转RGB（NEON，每次16个像素）
+ */
+static void PackedYuvToRgbRowNeon(const uint8_t* src, uint8_t* dst, const uint32_t width, const bool lumaFirst, const bool uFirst, const bool bgr,
+								  const uint32_t bytesPerPixel) {
+	uint32_t x = 0;
+	for (; x + 16 <= width; x += 16) {
+		// 交错加载直接拆分出8组的Y0、C0、Y1、C1
+		auto raw = vld4_u8(src + x * 2);
+		auto y0 = lumaFirst ? raw.val[0] : raw.val[1];
+		auto y1 = lumaFirst ? raw.val[2] : raw.val[3];
+		auto c0 = vreinterpretq_s16_u16(vmovl_u8(lumaFirst ? raw.val[1] : raw.val[0]));
+		auto c1 = vreinterpretq_s16_u16(vmovl_u8(lumaFirst ? raw.val[3] : raw.val[2]));
+		auto u = uFirst ? c0 : c1;
+		auto v = uFirst ? c1 : c0;
+		uint8x8_t r[2];
+		uint8x8_t g[2];
+		uint8x8_t b[2];
+		YuvToRgbNeon(y0, u, v, r[0], g[0], b[0]);
+		YuvToRgbNeon(y1, u, v, r[1], g[1], b[1]);
+		// 偶数、奇数像素交织恢复顺序
+		auto rr = vzip_u8(r[0], r[1]);
+		auto gg = vzip_u8(g[0], g[1]);
+		auto bb = vzip_u8(b[0], b[1]);
+		auto first = bgr ? vcombine_u8(bb.val[0], bb.val[1]) : vcombine_u8(rr.val[0], rr.val[1]);
+		auto third = bgr ? vcombine_u8(rr.val[0], rr.val[1]) : vcombine_u8(bb.val[0], bb.val[1]);
+		auto second = vcombine_u8(gg.val[0], gg.val[1]);
+		auto out = dst + x * bytesPerPixel;
+		if (bytesPerPixel == 4) {
+			uint8x16x4_t pixels = {{first, second, third, vdupq_n_u8(255)}};
+			vst4q_u8(out, pixels);
+		} else {
+			uint8x16x3_t pixels = {{first, second, third}};
+			vst3q_u8(out, pixels);
+		}
+	}
+	PackedYuvToRgbRowScalar(src + x * 2, dst + x * bytesPerPixel, width - x, lumaFirst, uFirst, bgr, bytesPerPixel);
+}
+#endif
+
+/**
+ * @brief 打包YUV 4:2:2转RGB（按CPU支持的指令集分派）
+ */
+static void PackedYuvToRgb(const ImageBuffer& src, ImageBuffer& dst, const SimdLevel level) {
+	bool lumaFirst = false;
+	bool uFirst = false;
+	bool bgr = false;
+	uint32_t bytesPerPixel = 0;
+	GetPackedYuvOrder(src.format, lumaFirst, uFirst);
+	GetRgbOrder(dst.format, bgr, bytesPerPixel);
+	for (uint32_t y = 0; y < src.height; y++) {
+		auto srcRow = src.plane[0] + size_t(y) * src.stride[0];
+		auto dstRow = dst.plane[0] + size_t(y) * dst.stride[0];
+		switch (level) {
+#if defined(BECAM_SIMD_X86)
+			case SimdLevel::AVX2:
+				PackedYuvToRgbRowAvx2(srcRow, dstRow, src.width, lumaFirst, uFirst, bgr, bytesPerPixel);
+				break;
+			case SimdLevel::SSE2:
+				PackedYuvToRgbRowSse2(srcRow, dstRow, src.width, lumaFirst, uFirst, bgr, bytesPerPixel);
+				break;
+#endif
+#if defined(BECAM_SIMD_NEON)
+			case SimdLevel::NEON:
+				PackedYuvToRgbRowNeon(srcRow, dstRow, src.width, lumaFirst, uFirst, bgr, bytesPerPixel);
+				break;
+#endif
+			default:
+				PackedYuvToRgbRowScalar(srcRow, dstRow, src.width, lumaFirst, uFirst, bgr, bytesPerPixel);
+				break;
+		}
+	}
+}
+
+/**
+ * @brief YUV布局描述
+ */
+struct YuvLayout {
+	// 平面数量（1：打包4:2:2，2：半平面4:2:0，3：平面4:2:0）
+	uint32_t planeCount;
+	// 打包格式亮度是否位于每组的第0、2字节
+	bool lumaFirst;
+	// 交织色度中U是否先于V（平面格式总为true）
+	bool uFirst;
+};
+
+/**
+ * @brief 获取YUV格式的布局
+ *
+ * @param format [in] 格式（FOURCC表示）
+ * @param layout [out] 布局
+ * @return 是否为支持的YUV格式
+ */
+static bool GetYuvLayout(const uint32_t format, YuvLayout& layout) {
+	layout = {0, true, true};
+	if (GetPackedYuvOrder(format, layout.lumaFirst, layout.uFirst)) {
+		layout.planeCount = 1;
+		return true;
+	}
+	if (GetSemiPlanarOrder(format, layout.uFirst)) {
+		layout.planeCount = 2;
+		return true;
+	}
+	bool memoryUFirst = true;
+	if (GetPlanarOrder(format, memoryUFirst)) {
+		layout.planeCount = 3;
+		return true;
+	}
+	return false;
+}
+
+/**
+ * @brief YUV格式之间重排（4:2:2转4:2:0时色度垂直平均，4:2:0转4:2:2时色度行复制）
+ */
+static void RepackYuv(const ImageBuffer& src, ImageBuffer& dst, const SimdLevel level) {
+	YuvLayout from;
+	YuvLayout to;
+	GetYuvLayout(src.format, from);
+	GetYuvLayout(dst.format, to);
+	auto width = src.width;
+	auto height = src.height;
+	// 每行的色度采样组数
+	auto chromaWidth = size_t(width + 1) / 2;
+	std::vector<uint8_t> chroma(chromaWidth * 2);
+	std::vector<uint8_t> luma;
+
+	if (from.planeCount == 1 && to.planeCount == 1) {
+		// 只有亮度、色度位置不同时按16位交换字节，否则拆分后重新组装
+		auto rowSize = GetDefaultImageStride(src.format, width, 0);
+		if (from.uFirst == to.uFirst) {
+			for (uint32_t y = 0; y < height; y++) {
+				SwapBytes16Row(src.plane[0] + size_t(y) * src.stride[0], dst.plane[0] + size_t(y) * dst.stride[0], rowSize, level);
+			}
+			return;
+		}
+		luma.resize(width);
+		for (uint32_t y = 0; y < height; y++) {
+			auto srcRow = src.plane[0] + size_t(y) * src.stride[0];
+			UnpackYuvRowPair(srcRow, srcRow, luma.data(), nullptr, chroma.data(), width, from.lumaFirst, level);
+			SwapBytes16Row(chroma.data(), chroma.data(), chroma.size(), level);
+			PackYuvRow(luma.data(), chroma.data(), dst.plane[0] + size_t(y) * dst.stride[0], width, to.lumaFirst, level);
+		}
+		return;
+	}
+
+	if (from.planeCount == 1) {
+		// 打包4:2:2转4:2:0：每两行输出两行亮度及一行平均后的色度
+		for (uint32_t y = 0; y < height; y += 2) {
+			auto src0 = src.plane[0] + size_t(y) * src.stride[0];
+			auto src1 = y + 1 < height ? src0 + src.stride[0] : src0;
+			auto y0 = dst.plane[0] + size_t(y) * dst.stride[0];
+			auto y1 = y + 1 < height ? y0 + dst.stride[0] : nullptr;
+			if (to.planeCount == 2 && from.uFirst == to.uFirst) {
+				UnpackYuvRowPair(src0, src1, y0, y1, dst.plane[1] + size_t(y / 2) * dst.stride[1], width, from.lumaFirst, level);
+				continue;
+			}
+			UnpackYuvRowPair(src0, src1, y0, y1, chroma.data(), width, from.lumaFirst, level);
+			if (to.planeCount == 2) {
+				SwapBytes16Row(chroma.data(), dst.plane[1] + size_t(y / 2) * dst.stride[1], chroma.size(), level);
+			} else {
+				auto u = dst.plane[1] + size_t(y / 2) * dst.stride[1];
+				auto v = dst.plane[2] + size_t(y / 2) * dst.stride[2];
+				DeinterleaveRow(chroma.data(), from.uFirst ? u : v, from.uFirst ? v : u, chromaWidth, level);
+			}
+		}
+		return;
+	}
+
+	if (to.planeCount == 1) {
+		// 4:2:0转打包4:2:2：每行色度先按目标顺序交织，供两行亮度共用
+		for (uint32_t y = 0; y < height; y += 2) {
+			const uint8_t* rowChroma = chroma.data();
+			if (from.planeCount == 2 && from.uFirst == to.uFirst) {
+				rowChroma = src.plane[1] + size_t(y / 2) * src.stride[1];
+			} else if (from.planeCount == 2) {
+				SwapBytes16Row(src.plane[1] + size_t(y / 2) * src.stride[1], chroma.data(), chroma.size(), level);
+			} else {
+				auto u = src.plane[1] + size_t(y / 2) * src.stride[1];
+				auto v = src.plane[2] + size_t(y / 2) * src.stride[2];
+				InterleaveRow(to.uFirst ? u : v, to.uFirst ? v : u, chroma.data(), chromaWidth, level);
+			}
+			for (uint32_t row = y; row < y + 2 && row < height; row++) {
+				PackYuvRow(src.plane[0] + size_t(row) * src.stride[0], rowChroma, dst.plane[0] + size_t(row) * dst.stride[0], width, to.lumaFirst,
+						   level);
+			}
+		}
+		return;
+	}
+
+	// 4:2:0之间转换：亮度平面直接拷贝，只重排色度
+	for (uint32_t y = 0; y < height; y++) {
+		memcpy(dst.plane[0] + size_t(y) * dst.stride[0], src.plane[0] + size_t(y) * src.stride[0], width);
+	}
+	for (uint32_t y = 0; y < (height + 1) / 2; y++) {
+		auto srcChroma = src.plane[1] + size_t(y) * src.stride[1];
+		auto dstChroma = dst.plane[1] + size_t(y) * dst.stride[1];
+		if (from.planeCount == 2 && to.planeCount == 2) {
+			if (from.uFirst == to.uFirst) {
+				memcpy(dstChroma, srcChroma, chromaWidth * 2);
+			} else {
+				SwapBytes16Row(srcChroma, dstChroma, chromaWidth * 2, level);
+			}
+		} else if (from.planeCount == 2) {
+			auto v = dst.plane[2] + size_t(y) * dst.stride[2];
+			DeinterleaveRow(srcChroma, from.uFirst ? dstChroma : v, from.uFirst ? v : dstChroma, chromaWidth, level);
+		} else if (to.planeCount == 2) {
+			auto v = src.plane[2] + size_t(y) * src.stride[2];
+			InterleaveRow(to.uFirst ? srcChroma : v, to.uFirst ? v : srcChroma, dstChroma, chromaWidth, level);
+		} else {
+			memcpy(dstChroma, srcChroma, chromaWidth);
+			memcpy(dst.plane[2] + size_t(y) * dst.stride[2], src.plane[2] + size_t(y) * src.stride[2], chromaWidth);
+		}
+	}
+}
+
+/**
+ * @brief 获取YUV图像的亮度视图（不拷贝数据）
+ *
+ * @param image [in] 源图像
+ * @param view [out] 亮度视图
+ * @return 是否支持该格式
+ */
+static bool GetLumaView(const ImageBuffer& image, LumaView& view) {
+	view = {0};
+	YuvLayout layout;
+	uint32_t offset = 0;
+	if (GetYuvLayout(image.format, layout)) {
+		// 打包格式亮度与色度交替排列，平面及半平面格式亮度平面即plane[0]
+		offset = layout.planeCount == 1 && !layout.lumaFirst ? 1 : 0;
+		view.pixelStride = layout.planeCount == 1 ? 2 : 1;
+	} else if (image.format == BECAM_FOURCC('G', 'R', 'E', 'Y')) {
+		view.pixelStride = 1;
+	} else {
+		return false;
+	}
+	view.data = image.plane[0] + offset;
+	view.width = image.width;
+	view.height = image.height;
+	view.stride = image.stride[0] > 0 ? image.stride[0] : GetDefaultImageStride(image.format, image.width, 0);
+	return true;
+}
+
+/**
+ * @brief 抽取YUV图像的亮度到GREY图像（平面格式逐行拷贝，打包格式按2字节间距抽取，与亮度直方图共用内核）
+ */
+static void ExtractLumaImage(const ImageBuffer& src, ImageBuffer& dst, const SimdLevel level) {
+	YuvLayout layout;
+	auto packed = GetYuvLayout(src.format, layout) && layout.planeCount == 1;
+	for (uint32_t y = 0; y < src.height; y++) {
+		auto srcRow = src.plane[0] + size_t(y) * src.stride[0];
+		auto dstRow = dst.plane[0] + size_t(y) * dst.stride[0];
+		if (packed) {
+			ExtractLuma(srcRow + (layout.lumaFirst ? 0 : 1), 2, src.width, dstRow, level);
+		} else {
+			memcpy(dstRow, srcRow, src.width);
+		}
+	}
+}
+
+/**
+ * @brief 逐行拷贝相同格式的图像
+ */
+static void CopyImage(const ImageBuffer& src, ImageBuffer& dst) {
+	for (uint32_t i = 0; i < GetImagePlaneCount(src.format); i++) {
+		auto rowSize = GetDefaultImageStride(src.format, src.width, i);
+		for (uint32_t y = 0; y < GetImagePlaneHeight(src.format, src.height, i); y++) {
+			memcpy(dst.plane[i] + size_t(y) * dst.stride[i], src.plane[i] + size_t(y) * src.stride[i], rowSize);
+		}
+	}
+}
+
+/**
+ * @brief 检查是否支持两种格式之间的转换
+ *
+ * @param srcFormat [in] 源格式（FOURCC表示）
+ * @param dstFormat [in] 目标格式（FOURCC表示）
+ * @return 是否支持
+ */
+static bool CanConvertImage(const uint32_t srcFormat, const uint32_t dstFormat) {
+	if (srcFormat == dstFormat) {
+		return GetImagePlaneCount(srcFormat) > 0;
+	}
+	bool first = false;
+	bool second = false;
+	uint32_t bytesPerPixel = 0;
+	if (GetPackedYuvOrder(srcFormat, first, second) && GetRgbOrder(dstFormat, first, bytesPerPixel)) {
+		return true;
+	}
+	YuvLayout from;
+	YuvLayout to;
+	if (dstFormat == BECAM_FOURCC('G', 'R', 'E', 'Y')) {
+		return GetYuvLayout(srcFormat, from);
+	}
+	return GetYuvLayout(srcFormat, from) && GetYuvLayout(dstFormat, to);
+}
+
+/**
+ * @brief 按格式组合分派转换（行带内执行，宽高需一致且已补全每行字节数）
+ */
+static void ConvertImageRows(const ImageBuffer& src, ImageBuffer& dst, const SimdLevel level) {
+	YuvLayout layout;
+	if (src.format == dst.format) {
+		CopyImage(src, dst);
+	} else if (dst.format == BECAM_FOURCC('G', 'R', 'E', 'Y')) {
+		ExtractLumaImage(src, dst, level);
+	} else if (GetYuvLayout(dst.format, layout)) {
+		RepackYuv(src, dst, level);
+	} else {
+		PackedYuvToRgb(src, dst, level);
+	}
+}
+
+/**
+ * @brief 转换图像格式（宽高需一致，目标缓冲区由调用方分配）
+ *
+ * @param src [in] 源图像
+ * @param dst [in && out] 目标图像
+ * @param level [in] 指令集级别
+ * @param policy [in] 行带并行策略
+ * @return 状态码
+ */
+static StatusCode ConvertImage(const ImageBuffer& src, ImageBuffer& dst, const SimdLevel level, const RowBandPolicy& policy) {
+	// 检查入参
+	if (src.width == 0 || src.height == 0 || src.width != dst.width || src.height != dst.height) {
+		return StatusCode::STATUS_CODE_ERR_INPUT_PARAM;
+	}
+	for (uint32_t i = 0; i < GetImagePlaneCount(src.format); i++) {
+		if (src.plane[i] == nullptr) {
+			return StatusCode::STATUS_CODE_ERR_INPUT_PARAM;
+		}
+	}
+	for (uint32_t i = 0; i < GetImagePlaneCount(dst.format); i++) {
+		if (dst.plane[i] == nullptr) {
+			return StatusCode::STATUS_CODE_ERR_INPUT_PARAM;
+		}
+	}
+	if (!CanConvertImage(src.format, dst.format)) {
+		return StatusCode::STATUS_CODE_ERR_NOT_SUPPORTED;
+	}
+
+	// 补全每行字节数
+	auto source = src;
+	NormalizeImageStrides(source);
+	NormalizeImageStrides(dst);
+
+	// 按行带执行转换（任一侧为4:2:0时行带起始行为偶数，色度行不跨行带）
+	auto align = std::max(GetImageRowAlignment(source.format), GetImageRowAlignment(dst.format));
+	RunRowBands(policy, source.height, align, [&](uint32_t begin, uint32_t end) {
+		auto from = source;
+		auto to = dst;
+		CropImageBuffer(from, 0, begin, from.width, end - begin);
+		CropImageBuffer(to, 0, begin, to.width, end - begin);
+		ConvertImageRows(from, to, level);
+	});
+	return StatusCode::STATUS_CODE_SUCCESS;
+}
+
+/**
+ * @brief 转换图像格式（串行执行）
+ */
+static StatusCode ConvertImage(const ImageBuffer& src, ImageBuffer& dst, const SimdLevel level) {
+	return ConvertImage(src, dst, level, SERIAL_ROW_BANDS);
+}
+
+/**
+ * @brief 转换图像格式（使用CPU支持的最高指令集）
+ */
+static StatusCode ConvertImage(const ImageBuffer& src, ImageBuffer& dst) {
+	return ConvertImage(src, dst, GetSimdLevel(), SERIAL_ROW_BANDS);
+}
+
+/**
+ * @brief 按行带并行转换图像格式（使用CPU支持的最高指令集）
+ */
+static StatusCode ConvertImage(const ImageBuffer& src, ImageBuffer& dst, const RowBandPolicy& policy) {
+	return ConvertImage(src, dst, GetSimdLevel(), policy);
+}
+
+#endif
@@ -0,0 +1,104 @@
+#pragma once
+
+#ifndef _BECAM_SIMD_DISPATCH_H_
+#define _BECAM_SIMD_DISPATCH_H_
+
+#include <stdlib.h>
+#include <string.h>
+
+// 识别目标架构（x86_64保证支持SSE2，aarch64保证支持NEON，更高的指令集在运行时检测）
+#if defined(__x86_64__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__)
+	#define BECAM_SIMD_X86
+	#include <immintrin.h>
+	#if defined(_MSC_VER) && !defined(__clang__)
+		#include <intrin.h>
+	#endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+	#define BECAM_SIMD_NEON
+	#include <arm_neon.h>
+#endif
+
+// 为单个函数开启AVX2指令集（MSVC无需开启即可使用对应的内建函数）
+#if defined(BECAM_SIMD_X86) && (defined(__GNUC__) || defined(__clang__))
+	#define BECAM_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+	#define BECAM_TARGET_AVX2
+#endif
+
+/**
+ * @brief SIMD指令集级别
+ */
+enum class SimdLevel {
+	SCALAR, // 纯标量实现（参考实现）
+	SSE2,	// x86 SSE2
+	AVX2,	// x86 AVX2
+	NEON,	// ARM NEON
+};
+
+/**
+ * @brief 检测CPU及操作系统是否支持AVX2
+ *
+ * @return 是否支持
+ */
+static bool DetectSimdAvx2() {
+#if defined(BECAM_SIMD_X86) && defined(_MSC_VER) && !defined(__clang__)
+	int info[4] = {0};
+	__cpuid(info, 0);
+	if (info[0] < 7) {
+		return false;
+	}
+	// 操作系统需支持保存YMM寄存器（OSXSAVE且XCR0的第1、2位）
+	__cpuid(info, 1);
+	if ((info[2] & (1 << 27)) == 0 || (_xgetbv(0) & 0x6) != 0x6) {
+		return false;
+	}
+	__cpuidex(info, 7, 0);
+	return (info[1] & (1 << 5)) != 0;
+#elif defined(BECAM_SIMD_X86)
+	// 已包含操作系统支持检测
+	return __builtin_cpu_supports("avx2");
+#else
+	return false;
+#endif
+}
+
+/**
+ * @brief 检测当前可用的最高SIMD指令集级别
+ *
+ * 可通过环境变量`BECAM_SIMD`（scalar、sse2、avx2、neon）限制最高级别，用于对比各实现的结果及性能
+ *
+ * @return 指令集级别
+ */
+static SimdLevel DetectSimdLevel() {
+#if defined(BECAM_SIMD_X86)
+	auto level = DetectSimdAvx2() ? SimdLevel::AVX2 : SimdLevel::SSE2;
+#elif defined(BECAM_SIMD_NEON)
+	auto level = SimdLevel::NEON;
+#else
+	auto level = SimdLevel::SCALAR;
+#endif
+	// 只能降级，不能开启CPU不支持的指令集
+	auto limit = getenv("BECAM_SIMD");
+	if (limit == nullptr) {
+		return level;
+	}
+	if (strcmp(limit, "scalar") == 0) {
+		return SimdLevel::SCALAR;
+	}
+	if (strcmp(limit, "sse2") == 0 && level == SimdLevel::AVX2) {
+		return SimdLevel::SSE2;
+	}
+	return level;
+}
+
+/**
+ * @brief 获取当前可用的最高SIMD指令集级别（首次调用时检测）
+ *
+ * @return 指令集级别
+ */
+static SimdLevel GetSimdLevel() {
+	static const SimdLevel level = DetectSimdLevel();
+	return level;
+}
+
+#endif
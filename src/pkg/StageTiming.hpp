@@ -0,0 +1,52 @@
+#pragma once
+
+#ifndef _BECAM_STAGE_TIMING_H_
+#define _BECAM_STAGE_TIMING_H_
+
+#include <algorithm>
+#include <becam/becam.h>
+#include <chrono>
+#include <stdint.h>
+
+/**
+ * @brief 单个处理阶段的耗时累计
+ */
+struct StageTimingRecord {
+	// 累计执行帧数
+	uint64_t frameCount;
+	// 累计耗时（微秒）
+	uint64_t totalTime;
+	// 最大耗时（微秒）
+	uint64_t maxTime;
+	// 最近一帧耗时（微秒）
+	uint64_t lastTime;
+};
+
+/**
+ * @brief 记录一次阶段耗时
+ *
+ * @param record [in && out] 耗时累计
+ * @param start [in] 阶段开始时间
+ */
+static void RecordStageTiming(StageTimingRecord& record, const std::chrono::steady_clock::time_point start) {
+	auto elapsed = uint64_t(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
+	record.frameCount++;
+	record.totalTime += elapsed;
+	record.maxTime = std::max(record.maxTime, elapsed);
+	record.lastTime = elapsed;
+}
+
+/**
+ * @brief 导出阶段耗时统计
+ *
+ * @param record [in] 耗时累计
+ * @param timing [out] 耗时统计
+ */
+static void GetStageTiming(const StageTimingRecord& record, StageTiming& timing) {
+	timing.frameCount = record.frameCount;
+	timing.averageTime = record.frameCount > 0 ? record.totalTime / record.frameCount : 0;
+	timing.maxTime = record.maxTime;
+	timing.lastTime = record.lastTime;
+}
+
+#endif
@@ -0,0 +1,208 @@
+#pragma once
+
+#ifndef _BECAM_WORKER_POOL_H_
+#define _BECAM_WORKER_POOL_H_
+
+#include <algorithm>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <stddef.h>
+#include <stdint.h>
+#include <thread>
+#include <vector>
+
+/**
+ * 固定大小的工作线程池：一次执行一批相互独立的任务（按序号分发），调用线程同时参与执行并等待整批完成
+ */
+
+/**
+ * @brief 工作线程池
+ */
+struct WorkerPool {
+	// 互斥锁（保护任务状态）
+	std::mutex mtx;
+	// 批次锁（同一时刻只执行一批任务）
+	std::mutex batchMtx;
+	// 新批次通知
+	std::condition_variable taskCondition;
+	// 批次完成通知
+	std::condition_variable doneCondition;
+	// 工作线程（不含调用线程）
+	std::vector<std::thread> workers;
+	// 当前批次的任务
+	const std::function<void(size_t)>* task;
+	// 当前批次的任务数
+	size_t taskCount;
+	// 下一个待领取的任务序号
+	size_t nextTask;
+	// 已完成的任务数
+	size_t doneCount;
+	// 是否正在停止
+	bool stopping;
+};
+
+/**
+ * @brief 领取并执行当前批次的任务（需持有锁，执行任务时释放锁）
+ *
+ * @param pool [in] 线程池
+ * @param lock [in] 已持有的锁
+ */
+static void RunWorkerPoolTasks(WorkerPool* pool, std::unique_lock<std::mutex>& lock) {
+	while (pool->nextTask < pool->taskCount) {
+		auto index = pool->nextTask++;
+		auto task = pool->task;
+		lock.unlock();
+		(*task)(index);
+		lock.lock();
+		if (++pool->doneCount == pool->taskCount) {
+			pool->doneCondition.notify_all();
+		}
+	}
+}
+
+/**
+ * @brief 工作线程入口
+ *
+ * @param pool [in] 线程池
+ */
+static void RunWorkerPoolThread(WorkerPool* pool) {
+	std::unique_lock<std::mutex> lock(pool->mtx);
+	while (true) {
+		pool->taskCondition.wait(lock, [pool] { return pool->stopping || pool->nextTask < pool->taskCount; });
+		if (pool->stopping) {
+			break;
+		}
+		RunWorkerPoolTasks(pool, lock);
+	}
+}
+
+/**
+ * @brief 创建工作线程池
+ *
+ * @param threadCount [in] 并行度（含调用线程，为0时取处理器核心数）
+ * @return 线程池
+ */
+static WorkerPool* CreateWorkerPool(uint32_t threadCount) {
+	if (threadCount == 0) {
+		threadCount = std::max(1u, std::thread::hardware_concurrency());
+	}
+	auto pool = new WorkerPool();
+	pool->task = nullptr;
+	pool->taskCount = 0;
+	pool->nextTask = 0;
+	pool->doneCount = 0;
+	pool->stopping = false;
+	for (uint32_t i = 1; i < threadCount; i++) {
+		pool->workers.emplace_back(RunWorkerPoolThread, pool);
+	}
+	return pool;
+}
+
+/**
+ * @brief 销毁工作线程池
+ *
+ * @param pool [in && out] 线程池
+ */
+static void DestroyWorkerPool(WorkerPool*& pool) {
+	if (pool == nullptr) {
+		return;
+	}
+	{
+		std::unique_lock<std::mutex> lock(pool->mtx);
+		pool->stopping = true;
+		pool->taskCondition.notify_all();
+	}
+	for (auto& worker : pool->workers) {
+		worker.join();
+	}
+	delete pool;
+	pool = nullptr;
+}
+
+/**
+ * @brief 获取线程池并行度（含调用线程）
+ *
+ * @param pool [in] 线程池（可为空）
+ * @return 并行度
+ */
+static uint32_t GetWorkerPoolSize(const WorkerPool* pool) {
+	return pool == nullptr ? 1 : uint32_t(pool->workers.size() + 1);
+}
+
+/**
+ * @brief 并行执行一批任务并等待全部完成（线程池为空时在调用线程中依次执行）
+ *
+ * @param pool [in] 线程池（可为空）
+ * @param taskCount [in] 任务数
+ * @param task [in] 任务（参数为任务序号）
+ */
+static void RunWorkerTasks(WorkerPool* pool, const size_t taskCount, const std::function<void(size_t)>& task) {
+	if (pool == nullptr || pool->workers.empty() || taskCount <= 1) {
+		for (size_t i = 0; i < taskCount; i++) {
+			task(i);
+		}
+		return;
+	}
+	std::unique_lock<std::mutex> batchLock(pool->batchMtx);
+	std::unique_lock<std::mutex> lock(pool->mtx);
+	pool->task = &task;
+	pool->taskCount = taskCount;
+	pool->nextTask = 0;
+	pool->doneCount = 0;
+	pool->taskCondition.notify_all();
+	// 调用线程同时参与执行
+	RunWorkerPoolTasks(pool, lock);
+	pool->doneCondition.wait(lock, [pool] { return pool->doneCount == pool->taskCount; });
+	pool->task = nullptr;
+	pool->taskCount = 0;
+	pool->nextTask = 0;
+}
+
+// 自动分带时每个行带的最少行数（避免小图像的调度开销超过收益）
+static const uint32_t WORKER_BAND_MIN_ROWS = 16;
+
+/**
+ * @brief 按行带切分的并行策略
+ */
+struct RowBandPolicy {
+	// 线程池（为空时在调用线程中串行执行）
+	WorkerPool* pool;
+	// 每个行带的行数（为0时按线程池并行度均分）
+	uint32_t bandRows;
+};
+
+// 串行执行（不切分）
+static const RowBandPolicy SERIAL_ROW_BANDS = {nullptr, 0};
+
+/**
+ * @brief 将若干行切分为行带并行执行并等待全部完成（不需要切分时在调用线程中整体执行一次）
+ *
+ * @param policy [in] 分带策略
+ * @param rows [in] 总行数
+ * @param align [in] 行带行数的对齐值（保证除最后一个外的行带起始行均为其整数倍，例如4:2:0色度下采样时为2）
+ * @param band [in] 行带任务（参数为起始行和结束行，不含结束行）
+ */
+static void RunRowBands(const RowBandPolicy& policy, const uint32_t rows, const uint32_t align, const std::function<void(uint32_t, uint32_t)>& band) {
+	if (rows == 0) {
+		return;
+	}
+	auto threadCount = GetWorkerPoolSize(policy.pool);
+	auto bandRows = policy.bandRows;
+	if (bandRows == 0) {
+		bandRows = std::max((rows + threadCount - 1) / threadCount, WORKER_BAND_MIN_ROWS);
+	}
+	// 行带行数按对齐值向上取整
+	bandRows = (bandRows + align - 1) / align * align;
+	auto bandCount = (rows + bandRows - 1) / bandRows;
+	if (threadCount == 1 || bandCount <= 1) {
+		band(0, rows);
+		return;
+	}
+	RunWorkerTasks(policy.pool, bandCount, [&](size_t i) {
+		auto begin = uint32_t(i) * bandRows;
+		band(begin, std::min(rows, begin + bandRows));
+	});
+}
+
+#endif
@@ -0,0 +1,464 @@
+#pragma once
+
+#ifndef _BECAM_YUV_REPACK_H_
+#define _BECAM_YUV_REPACK_H_
+
+#include "SimdDispatch.hpp"
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * YUV 4:2:2/4:2:0布局之间重排的行级内核，均提供标量参考实现及SSE2、AVX2、NEON实现（结果逐位一致）；
+ * 色度行以“交织色度”表示：按目标（或源）格式的色度顺序依次排列c0、c1（如YUYV与NV12为U、V，NV21为V、U）
+ */
+
+/**
+ * @brief 交换每16位中的两个字节（YUYV与UYVY互转、NV12与NV21色度互转）
+ *
+ * @param src [in] 源数据
+ * @param dst [out] 目标数据（可与源数据相同）
+ * @param size [in] 字节数（为偶数）
+ */
+static void SwapBytes16RowScalar(const uint8_t* src, uint8_t* dst, const size_t size) {
+	for (size_t i = 0; i + 1 < size; i += 2) {
+		auto first = src[i];
+		dst[i] = src[i + 1];
+		dst[i + 1] = first;
+	}
+}
+
+/**
+ * @brief 将两个平面交织为一行（I420转NV12的色度、平面色度转打包格式）
+ *
+ * @param a [in] 第一个分量
+ * @param b [in] 第二个分量
+ * @param dst [out] 交织结果（a0 b0 a1 b1 ...）
+ * @param count [in] 每个分量的采样数
+ */
+static void InterleaveRowScalar(const uint8_t* a, const uint8_t* b, uint8_t* dst, const size_t count) {
+	for (size_t i = 0; i < count; i++) {
+		dst[i * 2] = a[i];
+		dst[i * 2 + 1] = b[i];
+	}
+}
+
+/**
+ * @brief 将交织的一行拆分为两个平面（NV12转I420的色度）
+ *
+ * @param src [in] 交织数据（a0 b0 a1 b1 ...）
+ * @param a [out] 第一个分量
+ * @param b [out] 第二个分量
+ * @param count [in] 每个分量的采样数
+ */
+static void DeinterleaveRowScalar(const uint8_t* src, uint8_t* a, uint8_t* b, const size_t count) {
+	for (size_t i = 0; i < count; i++) {
+		a[i] = src[i * 2];
+		b[i] = src[i * 2 + 1];
+	}
+}
+
+/**
+ * @brief 由亮度行及交织色度行组装打包YUV 4:2:2行
+ *
+ * @param y [in] 亮度行（width个采样）
+ * @param chroma [in] 交织色度行（按目标格式的色度顺序，(width + 1) / 2组）
+ * @param dst [out] 打包YUV行
+ * @param width [in] 像素数
+ * @param lumaFirst [in] 亮度是否位于每组的第0、2字节
+ */
+static void PackYuvRowScalar(const uint8_t* y, const uint8_t* chroma, uint8_t* dst, const size_t width, const bool lumaFirst) {
+	auto lumaOffset = lumaFirst ? 0 : 1;
+	auto chromaOffset = lumaFirst ? 1 : 0;
+	for (size_t x = 0; x < width; x += 2) {
+		auto group = dst + x * 2;
+		group[lumaOffset] = y[x];
+		// 奇数宽度时最后一组的第二个亮度重复第一个
+		group[lumaOffset + 2] = x + 1 < width ? y[x + 1] : y[x];
+		group[chromaOffset] = chroma[x];
+		group[chromaOffset + 2] = chroma[x + 1];
+	}
+}
+
+/**
+ * @brief 拆分相邻两行打包YUV 4:2:2，输出两行亮度及垂直平均（四舍五入）后的交织色度行
+ *
+ * @param src0 [in] 第一行
+ * @param src1 [in] 第二行（奇数高度的最后一行与第一行相同）
+ * @param y0 [out] 第一行亮度
+ * @param y1 [out] 第二行亮度（为空时不输出）
+ * @param chroma [out] 交织色度行（按源格式的色度顺序）
+ * @param width [in] 像素数
+ * @param lumaFirst [in] 亮度是否位于每组的第0、2字节
+ */
+static void UnpackYuvRowPairScalar(const uint8_t* src0, const uint8_t* src1, uint8_t* y0, uint8_t* y1, uint8_t* chroma, const size_t width,
+								   const bool lumaFirst) {
+	auto lumaOffset = lumaFirst ? 0 : 1;
+	auto chromaOffset = lumaFirst ? 1 : 0;
+	for (size_t x = 0; x < width; x++) {
+		y0[x] = src0[x * 2 + lumaOffset];
+	}
+	if (y1 != nullptr) {
+		for (size_t x = 0; x < width; x++) {
+			y1[x] = src1[x * 2 + lumaOffset];
+		}
+	}
+	for (size_t i = 0; i < (width + 1) / 2 * 2; i++) {
+		chroma[i] = uint8_t((src0[i * 2 + chromaOffset] + src1[i * 2 + chromaOffset] + 1) >> 1);
+	}
+}
+
+#if defined(BECAM_SIMD_X86)
+/**
+ * @brief 交换每16位中的两个字节（SSE2，每次16字节）
+ */
+static void SwapBytes16RowSse2(const uint8_t* src, uint8_t* dst, const size_t size) {
+	size_t i = 0;
+	for (; i + 16 <= size; i += 16) {
+		auto value = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_or_si128(_mm_slli_epi16(value, 8), _mm_srli_epi16(value, 8)));
+	}
+	SwapBytes16RowScalar(src + i, dst + i, size - i);
+}
+
+/**
+ * @brief 将两个平面交织为一行（SSE2，每次16个采样）
+ */
+static void InterleaveRowSse2(const uint8_t* a, const uint8_t* b, uint8_t* dst, const size_t count) {
+	size_t i = 0;
+	for (; i + 16 <= count; i += 16) {
+		auto va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+		auto vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 2), _mm_unpacklo_epi8(va, vb));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 2 + 16), _mm_unpackhi_epi8(va, vb));
+	}
+	InterleaveRowScalar(a + i, b + i, dst + i * 2, count - i);
+}
+
+/**
+ * @brief 将交织的一行拆分为两个平面（SSE2，每次16个采样）
+ */
+static void DeinterleaveRowSse2(const uint8_t* src, uint8_t* a, uint8_t* b, const size_t count) {
+	auto lowMask = _mm_set1_epi16(0x00FF);
+	size_t i = 0;
+	for (; i + 16 <= count; i += 16) {
+		auto v0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 2));
+		auto v1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 2 + 16));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(a + i), _mm_packus_epi16(_mm_and_si128(v0, lowMask), _mm_and_si128(v1, lowMask)));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(b + i), _mm_packus_epi16(_mm_srli_epi16(v0, 8), _mm_srli_epi16(v1, 8)));
+	}
+	DeinterleaveRowScalar(src + i * 2, a + i, b + i, count - i);
+}
+
+/**
+ * @brief 由亮度行及交织色度行组装打包YUV 4:2:2行（SSE2，每次16个像素）
+ */
+static void PackYuvRowSse2(const uint8_t* y, const uint8_t* chroma, uint8_t* dst, const size_t width, const bool lumaFirst) {
+	size_t x = 0;
+	for (; x + 16 <= width; x += 16) {
+		auto vy = _mm_loadu_si128(reinterpret_cast<const __m128i*>(y + x));
+		auto vc = _mm_loadu_si128(reinterpret_cast<const __m128i*>(chroma + x));
+		auto lo = lumaFirst ? _mm_unpacklo_epi8(vy, vc) : _mm_unpacklo_epi8(vc, vy);
+		auto hi = lumaFirst ? _mm_unpackhi_epi8(vy, vc) : _mm_unpackhi_epi8(vc, vy);
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x * 2), lo);
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x * 2 + 16), hi);
+	}
+	PackYuvRowScalar(y + x, chroma + x, dst + x * 2, width - x, lumaFirst);
+}
+
+/**
+ * @brief 拆分相邻两行打包YUV 4:2:2（SSE2，每次16个像素）
+ */
+static void UnpackYuvRowPairSse2(const uint8_t* src0, const uint8_t* src1, uint8_t* y0, uint8_t* y1, uint8_t* chroma, const size_t width,
+								 const bool lumaFirst) {
+	auto lowMask = _mm_set1_epi16(0x00FF);
+	size_t x = 0;
+	for (; x + 16 <= width; x += 16) {
+		__m128i luma[2];
+		__m128i packedChroma[2];
+		const uint8_t* rows[2] = {src0, src1};
+		for (int i = 0; i < 2; i++) {
+			auto v0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rows[i] + x * 2));
+			auto v1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rows[i] + x * 2 + 16));
+			auto l0 = lumaFirst ? _mm_and_si128(v0, lowMask) : _mm_srli_epi16(v0, 8);
+			auto l1 = lumaFirst ? _mm_and_si128(v1, lowMask) : _mm_srli_epi16(v1, 8);
+			auto c0 = lumaFirst ? _mm_srli_epi16(v0, 8) : _mm_and_si128(v0, lowMask);
+			auto c1 = lumaFirst ? _mm_srli_epi16(v1, 8) : _mm_and_si128(v1, lowMask);
+			luma[i] = _mm_packus_epi16(l0, l1);
+			packedChroma[i] = _mm_packus_epi16(c0, c1);
+		}
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(y0 + x), luma[0]);
+		if (y1 != nullptr) {
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(y1 + x), luma[1]);
+		}
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(chroma + x), _mm_avg_epu8(packedChroma[0], packedChroma[1]));
+	}
+	UnpackYuvRowPairScalar(src0 + x * 2, src1 + x * 2, y0 + x, y1 != nullptr ? y1 + x : nullptr, chroma + x, width - x, lumaFirst);
+}
+
+/**
+ * @brief 交换每16位中的两个字节（AVX2，每次32字节）
+ */
+BECAM_TARGET_AVX2 static void SwapBytes16RowAvx2(const uint8_t* src, uint8_t* dst, const size_t size) {
+	size_t i = 0;
+	for (; i + 32 <= size; i += 32) {
+		auto value = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_or_si256(_mm256_slli_epi16(value, 8), _mm256_srli_epi16(value, 8)));
+	}
+	SwapBytes16RowSse2(src + i, dst + i, size - i);
+}
+
+/**
+ * @brief 将两个平面交织为一行（AVX2，每次32个采样）
+ */
+BECAM_TARGET_AVX2 static void InterleaveRowAvx2(const uint8_t* a, const uint8_t* b, uint8_t* dst, const size_t count) {
+	size_t i = 0;
+	for (; i + 32 <= count; i += 32) {
+		auto va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+		auto vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+		// 通道内交织后为[0-7, 16-23 | 8-15, 24-31]，交换中间两个128位恢复顺序
+		auto lo = _mm256_unpacklo_epi8(va, vb);
+		auto hi = _mm256_unpackhi_epi8(va, vb);
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i * 2), _mm256_permute2x128_si256(lo, hi, 0x20));
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i * 2 + 32), _mm256_permute2x128_si256(lo, hi, 0x31));
+	}
+	InterleaveRowSse2(a + i, b + i, dst + i * 2, count - i);
+}
+
+/**
+ * @brief 将交织的一行拆分为两个平面（AVX2，每次32个采样）
+ */
+BECAM_TARGET_AVX2 static void DeinterleaveRowAvx2(const uint8_t* src, uint8_t* a, uint8_t* b, const size_t count) {
+	auto lowMask = _mm256_set1_epi16(0x00FF);
+	size_t i = 0;
+	for (; i + 32 <= count; i += 32) {
+		auto v0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i * 2));
+		auto v1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i * 2 + 32));
+		// 通道内收窄后64位块顺序为[0, 2, 1, 3]
+		auto va = _mm256_packus_epi16(_mm256_and_si256(v0, lowMask), _mm256_and_si256(v1, lowMask));
+		auto vb = _mm256_packus_epi16(_mm256_srli_epi16(v0, 8), _mm256_srli_epi16(v1, 8));
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(a + i), _mm256_permute4x64_epi64(va, 0xD8));
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(b + i), _mm256_permute4x64_epi64(vb, 0xD8));
+	}
+	DeinterleaveRowSse2(src + i * 2, a + i, b + i, count - i);
+}
+
+/**
+ * @brief 由亮度行及交织色度行组装打包YUV 4:2:2行（AVX2，每次32个像素）
+ */
+BECAM_TARGET_AVX2 static void PackYuvRowAvx2(const uint8_t* y, const uint8_t* chroma, uint8_t* dst, const size_t width, const bool lumaFirst) {
+	size_t x = 0;
+	for (; x + 32 <= width; x += 32) {
+		auto vy = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(y + x));
+		auto vc = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(chroma + x));
+		auto lo = lumaFirst ? _mm256_unpacklo_epi8(vy, vc) : _mm256_unpacklo_epi8(vc, vy);
+		auto hi = lumaFirst ? _mm256_unpackhi_epi8(vy, vc) : _mm256_unpackhi_epi8(vc, vy);
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + x * 2), _mm256_permute2x128_si256(lo, hi, 0x20));
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + x * 2 + 32), _mm256_permute2x128_si256(lo, hi, 0x31));
+	}
+	PackYuvRowSse2(y + x, chroma + x, dst + x * 2, width - x, lumaFirst);
+}
+
+/**
+ * @brief 拆分相邻两行打包YUV 4:2:2（AVX2，每次32个像素）
+ */
+BECAM_TARGET_AVX2 static void UnpackYuvRowPairAvx2(const uint8_t* src0, const uint8_t* src1, uint8_t* y0, uint8_t* y1, uint8_t* chroma,
+												   const size_t width, const bool lumaFirst) {
+	auto lowMask = _mm256_set1_epi16(0x00FF);
+	size_t x = 0;
+	for (; x + 32 <= width; x += 32) {
+		__m256i luma[2];
+		__m256i packedChroma[2];
+		const uint8_t* rows[2] = {src0, src1};
+		for (int i = 0; i < 2; i++) {
+			auto v0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rows[i] + x * 2));
+			auto v1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rows[i] + x * 2 + 32));
+			auto l0 = lumaFirst ? _mm256_and_si256(v0, lowMask) : _mm256_srli_epi16(v0, 8);
+			auto l1 = lumaFirst ? _mm256_and_si256(v1, lowMask) : _mm256_srli_epi16(v1, 8);
+			auto c0 = lumaFirst ? _mm256_srli_epi16(v0, 8) : _mm256_and_si256(v0, lowMask);
+			auto c1 = lumaFirst ? _mm256_srli_epi16(v1, 8) : _mm256_and_si256(v1, lowMask);
+			luma[i] = _mm256_permute4x64_epi64(_mm256_packus_epi16(l0, l1), 0xD8);
+			packedChroma[i] = _mm256_permute4x64_epi64(_mm256_packus_epi16(c0, c1), 0xD8);
+		}
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(y0 + x), luma[0]);
+		if (y1 != nullptr) {
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(y1 + x), luma[1]);
+		}
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(chroma + x), _mm256_avg_epu8(packedChroma[0], packedChroma[1]));
+	}
+	UnpackYuvRowPairSse2(src0 + x * 2, src1 + x * 2, y0 + x, y1 != nullptr ? y1 + x : nullptr, chroma + x, width - x, lumaFirst);
+}
+#endif
+
+#if defined(BECAM_SIMD_NEON)
+/**
+ * @brief 交换每16位中的两个字节（NEON，每次16字节）
+ */
+static void SwapBytes16RowNeon(const uint8_t* src, uint8_t* dst, const size_t size) {
+	size_t i = 0;
+	for (; i + 16 <= size; i += 16) {
+		vst1q_u8(dst + i, vrev16q_u8(vld1q_u8(src + i)));
+	}
+	SwapBytes16RowScalar(src + i, dst + i, size - i);
+}
+
+/**
+ * @brief 将两个平面交织为一行（NEON，每次16个采样）
+ */
+static void InterleaveRowNeon(const uint8_t* a, const uint8_t* b, uint8_t* dst, const size_t count) {
+	size_t i = 0;
+	for (; i + 16 <= count; i += 16) {
+		uint8x16x2_t value = {{vld1q_u8(a + i), vld1q_u8(b + i)}};
+		vst2q_u8(dst + i * 2, value);
+	}
+	InterleaveRowScalar(a + i, b + i, dst + i * 2, count - i);
+}
+
+/**
+ * @brief 将交织的一行拆分为两个平面（NEON，每次16个采样）
+ */
+static void DeinterleaveRowNeon(const uint8_t* src, uint8_t* a, uint8_t* b, const size_t count) {
+	size_t i = 0;
+	for (; i + 16 <= count; i += 16) {
+		auto value = vld2q_u8(src + i * 2);
+		vst1q_u8(a + i, value.val[0]);
+		vst1q_u8(b + i, value.val[1]);
+	}
+	DeinterleaveRowScalar(src + i * 2, a + i, b + i, count - i);
+}
+
+/**
+ * @brief 由亮度行及交织色度行组装打包YUV 4:2:2行（NEON，每次16个像素）
+ */
+static void PackYuvRowNeon(const uint8_t* y, const uint8_t* chroma, uint8_t* dst, const size_t width, const bool lumaFirst) {
+	size_t x = 0;
+	for (; x + 16 <= width; x += 16) {
+		auto vy = vld1q_u8(y + x);
+		auto vc = vld1q_u8(chroma + x);
+		uint8x16x2_t value = {{lumaFirst ? vy : vc, lumaFirst ? vc : vy}};
+		vst2q_u8(dst + x * 2, value);
+	}
+	PackYuvRowScalar(y + x, chroma + x, dst + x * 2, width - x, lumaFirst);
+}
+
+/**
+ * @brief 拆分相邻两行打包YUV 4:2:2（NEON，每次16个像素）
+ */
+static void UnpackYuvRowPairNeon(const uint8_t* src0, const uint8_t* src1, uint8_t* y0, uint8_t* y1, uint8_t* chroma, const size_t width,
+								 const bool lumaFirst) {
+	size_t x = 0;
+	for (; x + 16 <= width; x += 16) {
+		auto row0 = vld2q_u8(src0 + x * 2);
+		auto row1 = vld2q_u8(src1 + x * 2);
+		vst1q_u8(y0 + x, lumaFirst ? row0.val[0] : row0.val[1]);
+		if (y1 != nullptr) {
+			vst1q_u8(y1 + x, lumaFirst ? row1.val[0] : row1.val[1]);
+		}
+		// vrhaddq_u8即(a + b + 1) >> 1
+		vst1q_u8(chroma + x, lumaFirst ? vrhaddq_u8(row0.val[1], row1.val[1]) : vrhaddq_u8(row0.val[0], row1.val[0]));
+	}
+	UnpackYuvRowPairScalar(src0 + x * 2, src1 + x * 2, y0 + x, y1 != nullptr ? y1 + x : nullptr, chroma + x, width - x, lumaFirst);
+}
+#endif
+
+/**
+ * @brief 交换每16位中的两个字节（按指令集分派）
+ */
+static void SwapBytes16Row(const uint8_t* src, uint8_t* dst, const size_t size, const SimdLevel level) {
+	switch (level) {
+#if defined(BECAM_SIMD_X86)
+		case SimdLevel::AVX2:
+			return SwapBytes16RowAvx2(src, dst, size);
+		case SimdLevel::SSE2:
+			return SwapBytes16RowSse2(src, dst, size);
+#endif
+#if defined(BECAM_SIMD_NEON)
+		case SimdLevel::NEON:
+			return SwapBytes16RowNeon(src, dst, size);
+#endif
+		default:
+			return SwapBytes16RowScalar(src, dst, size);
+	}
+}
+
+/**
+ * @brief 将两个平面交织为一行（按指令集分派）
+ */
+static void InterleaveRow(const uint8_t* a, const uint8_t* b, uint8_t* dst, const size_t count, const SimdLevel level) {
+	switch (level) {
+#if defined(BECAM_SIMD_X86)
+		case SimdLevel::AVX2:
+			return InterleaveRowAvx2(a, b, dst, count);
+		case SimdLevel::SSE2:
+			return InterleaveRowSse2(a, b, dst, count);
+#endif
+#if defined(BECAM_SIMD_NEON)
+		case SimdLevel::NEON:
+			return InterleaveRowNeon(a, b, dst, count);
+#endif
+		default:
+			return InterleaveRowScalar(a, b, dst, count);
+	}
+}
+
+/**
+ * @brief 将交织的一行拆分为两个平面（按指令集分派）
+ */
+static void DeinterleaveRow(const uint8_t* src, uint8_t* a, uint8_t* b, const size_t count, const SimdLevel level) {
+	switch (level) {
+#if defined(BECAM_SIMD_X86)
+		case SimdLevel::AVX2:
+			return DeinterleaveRowAvx2(src, a, b, count);
+		case SimdLevel::SSE2:
+			return DeinterleaveRowSse2(src, a, b, count);
+#endif
+#if defined(BECAM_SIMD_NEON)
+		case SimdLevel::NEON:
+			return DeinterleaveRowNeon(src, a, b, count);
+#endif
+		default:
+			return DeinterleaveRowScalar(src, a, b, count);
+	}
+}
+
+/**
+ * @brief 由亮度行及交织色度行组装打包YUV 4:2:2行（按指令集分派）
+ */
+static void PackYuvRow(const uint8_t* y, const uint8_t* chroma, uint8_t* dst, const size_t width, const bool lumaFirst, const SimdLevel level) {
+	switch (level) {
+#if defined(BECAM_SIMD_X86)
+		case SimdLevel::AVX2:
+			return PackYuvRowAvx2(y, chroma, dst, width, lumaFirst);
+		case SimdLevel::SSE2:
+			return PackYuvRowSse2(y, chroma, dst, width, lumaFirst);
+#endif
+#if defined(BECAM_SIMD_NEON)
+		case SimdLevel::NEON:
+			return PackYuvRowNeon(y, chroma, dst, width, lumaFirst);
+#endif
+		default:
+			return PackYuvRowScalar(y, chroma, dst, width, lumaFirst);
+	}
+}
+
+/**
+ * @brief 拆分相邻两行打包YUV 4:2:2（按指令集分派）
+ */
+static void UnpackYuvRowPair(const uint8_t* src0, const uint8_t* src1, uint8_t* y0, uint8_t* y1, uint8_t* chroma, const size_t width,
+							 const bool lumaFirst, const SimdLevel level) {
+	switch (level) {
+#if defined(BECAM_SIMD_X86)
+		case SimdLevel::AVX2:
+			return UnpackYuvRowPairAvx2(src0, src1, y0, y1, chroma, width, lumaFirst);
+		case SimdLevel::SSE2:
+			return UnpackYuvRowPairSse2(src0, src1, y0, y1, chroma, width, lumaFirst);
+#endif
+#if defined(BECAM_SIMD_NEON)
+		case SimdLevel::NEON:
+			return UnpackYuvRowPairNeon(src0, src1, y0, y1, chroma, width, lumaFirst);
+#endif
+		default:
+			return UnpackYuvRowPairScalar(src0, src1, y0, y1, chroma, width, lumaFirst);
+	}
+}
+
+#endif
@@ -0,0 +1,142 @@
+#include <becam/becam.h>
+#include <becamv4l2/Becamv4l2BandwidthPlanner.hpp>
+#include <pkg/LogOutput.hpp>
+
+// USB 2.0总线（480Mbit/s）可用于等时传输的带宽预算
+static const uint64_t HIGH_SPEED_BUS_BUDGET = uint64_t(480) * 1000000 * 8 / 10;
+
+/**
+ * @brief 构造YUYV视频帧信息
+ */
+static VideoFrameInfo Yuyv(const uint32_t width, const uint32_t height, const uint32_t fps) {
+	return VideoFrameInfo{BECAM_FOURCC('Y', 'U', 'Y', 'V'), width, height, fps};
+}
+
+/**
+ * @brief 构造参与规划的相机
+ *
+ * @param busNumber [in] USB总线编号（为0表示非USB设备）
+ * @param deviceSpeed [in] 设备链路速率（Mbit/s）
+ * @param busSpeed [in] 总线链路速率（Mbit/s）
+ * @param candidates [in] 候选视频帧信息
+ */
+static Becamv4l2PlannedCamera MakeCamera(const uint32_t busNumber, const uint32_t deviceSpeed, const uint32_t busSpeed,
+										 const std::vector<VideoFrameInfo>& candidates) {
+	Becamv4l2PlannedCamera camera;
+	camera.topology.busNumber = busNumber;
+	camera.topology.deviceSpeed = deviceSpeed;
+	camera.topology.busSpeed = busSpeed;
+	camera.candidates = candidates;
+	return camera;
+}
+
+/**
+ * @brief 1080p YUYV相机的候选列表
+ *
+ * 高速设备等时端点上限约196.6Mbit/s：1080p@30超出上限，800x600@25（约195.8Mbit/s）为上限内像素吞吐最大的候选，
+ * 两台同时选中时合计超出USB 2.0总线384Mbit/s的预算
+ */
+static std::vector<VideoFrameInfo> FullHdCandidates() {
+	return {Yuyv(1920, 1080, 30), Yuyv(1920, 1080, 5), Yuyv(800, 600, 25), Yuyv(640, 480, 30), Yuyv(640, 480, 15)};
+}
+
+static bool Same(const VideoFrameInfo& left, const VideoFrameInfo& right) {
+	return left.format == right.format && left.width == right.width && left.height == right.height && left.fps == right.fps;
+}
+
+/**
+ * @brief 检查规划结果
+ */
+static bool CheckPlan(const std::vector<Becamv4l2PlannedCamera>& cameras, const bool expectedFits,
+					  const std::vector<VideoFrameInfo>& expected, const char* name) {
+	std::vector<VideoFrameInfo> chosen;
+	auto fits = Becamv4l2BandwidthPlanner::Plan(cameras, chosen);
+	if (fits != expectedFits || chosen.size() != expected.size()) {
+		DEBUG_LOG(name << " mismatch, fits: " << fits << ", chosen: " << chosen.size());
+		return false;
+	}
+	for (size_t i = 0; i < expected.size(); i++) {
+		if (!Same(chosen[i], expected[i])) {
+			DEBUG_LOG(name << " mismatch, camera: " << i << ", chosen: " << chosen[i].width << "x" << chosen[i].height << "@"
+						   << chosen[i].fps << ", expected: " << expected[i].width << "x" << expected[i].height << "@" << expected[i].fps);
+			return false;
+		}
+	}
+	return true;
+}
+
+int main() {
+	// 载荷速率：像素吞吐 x 每像素比特数，另加2%负载头
+	if (Becamv4l2BandwidthPlanner::EstimatePayloadRate(Yuyv(640, 480, 30)) != 150405120 ||
+		Becamv4l2BandwidthPlanner::EstimatePayloadRate(VideoFrameInfo{BECAM_FOURCC('M', 'J', 'P', 'G'), 1920, 1080, 30}) != 126904320) {
+		DEBUG_LOG("EstimatePayloadRate mismatch");
+		return 1;
+	}
+
+	// 单台相机：受设备等时端点上限约束，不选1080p@30
+	if (!CheckPlan({MakeCamera(1, 480, 480, FullHdCandidates())}, true, {Yuyv(800, 600, 25)}, "Device cap")) {
+		return 1;
+	}
+	// 全速设备（上限约8.2Mbit/s）只能选最小的候选
+	if (!CheckPlan({MakeCamera(1, 12, 480, {Yuyv(640, 480, 15), Yuyv(320, 240, 5)})}, true, {Yuyv(320, 240, 5)}, "Full speed cap")) {
+		return 1;
+	}
+	// 超高速设备在USB 3.x总线上可以直接使用1080p@30
+	if (!CheckPlan({MakeCamera(2, 5000, 5000, FullHdCandidates())}, true, {Yuyv(1920, 1080, 30)}, "Super speed")) {
+		return 1;
+	}
+	// 所有候选都超出设备上限：选载荷最小的并报告无法满足
+	if (!CheckPlan({MakeCamera(1, 480, 480, {Yuyv(1920, 1080, 30), Yuyv(1920, 1080, 15)})}, false, {Yuyv(1920, 1080, 15)},
+				   "Over device cap")) {
+		return 1;
+	}
+
+	// 同一USB 2.0总线上两台1080p相机：合计超出预算，按每节省1bit损失像素最少的方式降档一台
+	{
+		std::vector<Becamv4l2PlannedCamera> cameras = {MakeCamera(1, 480, 480, FullHdCandidates()),
+													   MakeCamera(1, 480, 480, FullHdCandidates())};
+		std::vector<VideoFrameInfo> chosen;
+		if (!Becamv4l2BandwidthPlanner::Plan(cameras, chosen) || chosen.size() != 2) {
+			DEBUG_LOG("Shared bus plan failed");
+			return 1;
+		}
+		auto total = Becamv4l2BandwidthPlanner::EstimatePayloadRate(chosen[0]) + Becamv4l2BandwidthPlanner::EstimatePayloadRate(chosen[1]);
+		// 同格式下各降档的得分相同，降档靠前的相机及候选；另一台保持不变
+		if (total > HIGH_SPEED_BUS_BUDGET || !Same(chosen[0], Yuyv(1920, 1080, 5)) || !Same(chosen[1], Yuyv(800, 600, 25))) {
+			DEBUG_LOG("Shared bus mismatch, total: " << total << ", camera 0: " << chosen[0].width << "x" << chosen[0].height << "@"
+													 << chosen[0].fps << ", camera 1: " << chosen[1].width << "x" << chosen[1].height << "@"
+													 << chosen[1].fps);
+			return 1;
+		}
+	}
+
+	// 不同总线上的相机互不影响
+	if (!CheckPlan({MakeCamera(1, 480, 480, FullHdCandidates()), MakeCamera(2, 480, 480, FullHdCandidates())}, true,
+				   {Yuyv(800, 600, 25), Yuyv(800, 600, 25)}, "Separate buses")) {
+		return 1;
+	}
+
+	// 非USB设备不受带宽限制，也不占用USB总线的预算
+	if (!CheckPlan({MakeCamera(0, 0, 0, FullHdCandidates()), MakeCamera(1, 480, 480, FullHdCandidates())}, true,
+				   {Yuyv(1920, 1080, 30), Yuyv(800, 600, 25)}, "Non-USB camera")) {
+		return 1;
+	}
+
+	// 无法满足：三台相机只有1080p@5（合计约507.6Mbit/s），无可降档的候选
+	{
+		std::vector<VideoFrameInfo> only = {Yuyv(1920, 1080, 5)};
+		if (!CheckPlan({MakeCamera(1, 480, 480, only), MakeCamera(1, 480, 480, only), MakeCamera(1, 480, 480, only)}, false,
+					   {Yuyv(1920, 1080, 5), Yuyv(1920, 1080, 5), Yuyv(1920, 1080, 5)}, "Impossible")) {
+			return 1;
+		}
+	}
+
+	// 无候选的相机输出全0并报告无法满足，不影响其他相机
+	if (!CheckPlan({MakeCamera(1, 480, 480, {}), MakeCamera(1, 480, 480, FullHdCandidates())}, false,
+				   {VideoFrameInfo{0}, Yuyv(800, 600, 25)}, "No candidates")) {
+		return 1;
+	}
+
+	std::cout << "Bandwidth planner test passed." << std::endl;
+	return 0;
+}
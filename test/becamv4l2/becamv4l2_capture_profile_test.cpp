@@ -0,0 +1,142 @@
+#include <becam/becam.h>
+#include <becamv4l2/Becamv4l2CaptureProfileHelper.hpp>
+#include <pkg/LogOutput.hpp>
+
+// 30帧/秒对应的帧间隔（微秒）
+static const uint64_t FRAME_INTERVAL_30FPS = 33333;
+
+/**
+ * @brief 按30帧/秒协商结果启用帧率校验（控制项助手未关联设备，不设置任何控制项）
+ *
+ * @param helper [in && out] 采集配置助手
+ * @param verifyFrameCount [in] 用于校验实际帧率的帧数
+ */
+static void StartVerify(Becamv4l2CaptureProfileHelper& helper, const uint32_t verifyFrameCount) {
+	CaptureProfile profile = {};
+	profile.exposureMode = ExposureMode::EXPOSURE_MODE_MANUAL;
+	profile.powerLineFrequency = PowerLineFrequency::POWER_LINE_FREQUENCY_50HZ;
+	profile.verifyFrameCount = verifyFrameCount;
+	helper.SetProfile(&profile);
+	Becamv4l2ControlHelper controlHelper;
+	v4l2_fract timePerFrame = {1, 30};
+	helper.Apply(controlHelper, timePerFrame);
+}
+
+/**
+ * @brief 模拟设备输出的视频帧并按间隔取走
+ *
+ * @param helper [in && out] 采集配置助手
+ * @param firstSequence [in] 第一帧序号
+ * @param firstTimestamp [in] 第一帧时间戳（微秒）
+ * @param interval [in] 设备输出帧间隔（微秒）
+ * @param takeEvery [in] 每隔多少帧取走一帧（其余帧被驱动丢弃，序号仍递增）
+ * @param frameCount [in] 设备输出的帧数
+ */
+static void FeedFrames(Becamv4l2CaptureProfileHelper& helper, const uint32_t firstSequence, const uint64_t firstTimestamp,
+					   const uint64_t interval, const uint32_t takeEvery, const uint32_t frameCount) {
+	for (uint32_t i = 0; i < frameCount; i += takeEvery) {
+		helper.OnFrame(firstSequence + i, firstTimestamp + i * interval);
+	}
+}
+
+/**
+ * @brief 检查应用结果
+ */
+static bool CheckReport(const Becamv4l2CaptureProfileHelper& helper, const FrameRateCheck expected, const uint32_t minRate,
+						const uint32_t maxRate, const uint32_t minCount, const char* name) {
+	CaptureProfileReport report;
+	helper.GetReport(report);
+	if (report.frameRateCheck != expected || report.measuredFrameRate < minRate || report.measuredFrameRate > maxRate ||
+		report.measuredFrameCount < minCount || report.appliedControls != 0) {
+		DEBUG_LOG(name << " mismatch, check: " << report.frameRateCheck << ", rate: " << report.measuredFrameRate
+					   << ", count: " << report.measuredFrameCount << ", controls: " << report.appliedControls);
+		return false;
+	}
+	return true;
+}
+
+int main() {
+	Becamv4l2CaptureProfileHelper helper;
+
+	// 未启用时不测量
+	helper.OnFrame(0, 1000);
+	helper.OnFrame(100, 1000000000);
+	if (helper.IsEnabled() || !CheckReport(helper, FrameRateCheck::FRAME_RATE_CHECK_DISABLED, 0, 0, 0, "Disabled")) {
+		return 1;
+	}
+
+	// 协商帧率及校验中状态
+	StartVerify(helper, 30);
+	CaptureProfileReport report;
+	helper.GetReport(report);
+	if (report.negotiatedFrameRate != 30000 || !CheckReport(helper, FrameRateCheck::FRAME_RATE_CHECK_PENDING, 0, 0, 0, "Pending")) {
+		return 1;
+	}
+	// 帧数不足时保持校验中
+	FeedFrames(helper, 0, 5000000, FRAME_INTERVAL_30FPS, 1, 30);
+	if (!CheckReport(helper, FrameRateCheck::FRAME_RATE_CHECK_PENDING, 0, 0, 0, "Not enough frames")) {
+		return 1;
+	}
+	// 第31帧完成校验（30个帧间隔）
+	helper.OnFrame(30, 5000000 + 30 * FRAME_INTERVAL_30FPS);
+	if (!CheckReport(helper, FrameRateCheck::FRAME_RATE_CHECK_MATCHED, 29990, 30010, 30, "Steady 30fps")) {
+		return 1;
+	}
+	// 完成后不再更新
+	helper.OnFrame(1000, 5000000 + 31 * FRAME_INTERVAL_30FPS);
+	if (!CheckReport(helper, FrameRateCheck::FRAME_RATE_CHECK_MATCHED, 29990, 30010, 30, "After matched")) {
+		return 1;
+	}
+
+	// 调用方取帧较慢（每3帧取1帧），按序号计入被丢弃的帧，不影响结果
+	StartVerify(helper, 30);
+	FeedFrames(helper, 100, 7000000, FRAME_INTERVAL_30FPS, 3, 40);
+	if (!CheckReport(helper, FrameRateCheck::FRAME_RATE_CHECK_MATCHED, 29990, 30010, 30, "Sequence gaps")) {
+		return 1;
+	}
+
+	// 设备为延长曝光降至15帧/秒
+	StartVerify(helper, 30);
+	FeedFrames(helper, 0, 1000, FRAME_INTERVAL_30FPS * 2, 1, 40);
+	if (!CheckReport(helper, FrameRateCheck::FRAME_RATE_CHECK_MISMATCHED, 14990, 15010, 30, "Slowed to 15fps")) {
+		return 1;
+	}
+
+	// 在容忍范围内的抖动（28帧/秒，低于协商帧率不超过10%）
+	StartVerify(helper, 30);
+	FeedFrames(helper, 0, 1000, 1000000 / 28, 1, 40);
+	if (!CheckReport(helper, FrameRateCheck::FRAME_RATE_CHECK_MATCHED, 27990, 28010, 30, "Jitter within tolerance")) {
+		return 1;
+	}
+
+	// 序号在测量期间回绕
+	StartVerify(helper, 30);
+	FeedFrames(helper, 0xFFFFFFF0u, 123456789, FRAME_INTERVAL_30FPS, 2, 40);
+	if (!CheckReport(helper, FrameRateCheck::FRAME_RATE_CHECK_MATCHED, 29990, 30010, 30, "Sequence wrap")) {
+		return 1;
+	}
+
+	// 时间戳回退（例如取流重启）时重新记录测量起点
+	StartVerify(helper, 30);
+	FeedFrames(helper, 0, 9000000, FRAME_INTERVAL_30FPS * 2, 1, 10);
+	FeedFrames(helper, 500, 1000, FRAME_INTERVAL_30FPS, 1, 31);
+	if (!CheckReport(helper, FrameRateCheck::FRAME_RATE_CHECK_MATCHED, 29990, 30010, 30, "Timestamp restart")) {
+		return 1;
+	}
+
+	// 不校验帧率
+	StartVerify(helper, 0);
+	FeedFrames(helper, 0, 1000, FRAME_INTERVAL_30FPS, 1, 40);
+	if (!CheckReport(helper, FrameRateCheck::FRAME_RATE_CHECK_DISABLED, 0, 0, 0, "Verify disabled")) {
+		return 1;
+	}
+
+	// 取消采集配置时清空结果
+	helper.SetProfile(nullptr);
+	if (helper.IsEnabled() || !CheckReport(helper, FrameRateCheck::FRAME_RATE_CHECK_DISABLED, 0, 0, 0, "Cleared")) {
+		return 1;
+	}
+
+	std::cout << "Capture profile test passed." << std::endl;
+	return 0;
+}
@@ -0,0 +1,294 @@
+#include <becam/becam.h>
+#include <becamv4l2/Becamv4l2ExposureController.hpp>
+#include <pkg/LogOutput.hpp>
+
+// 30帧/秒的帧间隔
+static const v4l2_fract TIME_PER_FRAME_30FPS = {1, 30};
+// 30帧/秒对应的曝光时间上限（单位100微秒）
+static const int64_t FRAME_INTERVAL_30FPS = 333;
+
+/**
+ * @brief 构造所有采样亮度相同的直方图
+ *
+ * @param level [in] 亮度级别
+ * @param highlights [in] 额外的过曝采样数（亮度255）
+ */
+static LumaHistogram MakeHistogram(const uint32_t level, const uint32_t highlights) {
+	LumaHistogram histogram = {};
+	histogram.bins[level] = 1000;
+	histogram.bins[255] += highlights;
+	histogram.sampleCount = 1000 + highlights;
+	histogram.sum = uint64_t(level) * 1000 + uint64_t(255) * highlights;
+	return histogram;
+}
+
+/**
+ * @brief 构造常见UVC设备的调节范围（曝光时间1~10000，增益0~100）
+ */
+static Becamv4l2ExposureRange MakeRange(const bool hasGain) {
+	Becamv4l2ExposureRange range;
+	range.exposureMin = 1;
+	range.exposureMax = 10000;
+	range.exposureStep = 1;
+	range.hasGain = hasGain;
+	range.gainMin = 0;
+	range.gainMax = 100;
+	range.gainStep = 1;
+	return range;
+}
+
+/**
+ * @brief 按配置及调节范围开始自动曝光
+ *
+ * @return 修正后的曝光时间
+ */
+static int64_t StartController(Becamv4l2ExposureController& controller, const uint32_t settleFrames, const Becamv4l2ExposureRange& range,
+							   const int64_t exposureTime, const int64_t gain) {
+	AutoExposureConfig config = {};
+	config.settleFrames = settleFrames;
+	controller.SetConfig(&config);
+	auto currentExposure = exposureTime;
+	auto currentGain = gain;
+	controller.Start(range, TIME_PER_FRAME_30FPS, currentExposure, currentGain);
+	return currentExposure;
+}
+
+/**
+ * @brief 越过生效等待后按给定亮度调整一次并检查结果
+ *
+ * @param controller [in && out] 自动曝光控制器
+ * @param histogram [in] 亮度直方图
+ * @param expectedUpdate [in] 是否期望调整
+ * @param expectedExposure [in] 期望的曝光时间
+ * @param expectedGain [in] 期望的增益
+ * @param name [in] 用例名称
+ */
+static bool CheckStep(Becamv4l2ExposureController& controller, const LumaHistogram& histogram, const bool expectedUpdate,
+					  const int64_t expectedExposure, const int64_t expectedGain, const char* name) {
+	int64_t exposureTime = 0;
+	int64_t gain = 0;
+	auto updated = controller.Update(histogram, exposureTime, gain);
+	if (updated != expectedUpdate || exposureTime != expectedExposure || gain != expectedGain) {
+		DEBUG_LOG(name << " mismatch, updated: " << updated << ", exposure: " << exposureTime << ", gain: " << gain);
+		return false;
+	}
+	if (updated) {
+		controller.Commit(true, exposureTime, gain);
+	}
+	return true;
+}
+
+/**
+ * @brief 模拟场景闭环调节，检查收敛及边界
+ *
+ * 模拟设备的平均亮度与曝光时间及增益倍数成正比（增益范围对应1~8倍），写入后立即生效
+ *
+ * @param sceneLuma [in] 曝光时间为1、增益为最低时的平均亮度
+ * @param hasGain [in] 设备是否支持增益
+ * @param expectGain [in] 收敛后是否需要用到增益
+ * @param name [in] 用例名称
+ */
+static bool CheckConvergence(const double sceneLuma, const bool hasGain, const bool expectGain, const char* name) {
+	Becamv4l2ExposureController controller;
+	auto range = MakeRange(hasGain);
+	int64_t exposureTime = StartController(controller, 1, range, 100, 0);
+	int64_t gain = 0;
+	uint32_t mean = 0;
+	for (int frame = 0; frame < 60; frame++) {
+		auto multiplier = 1.0 + double(gain - range.gainMin) / double(range.gainMax - range.gainMin) * 7.0;
+		mean = uint32_t(std::min(255.0, sceneLuma * double(exposureTime) * multiplier));
+		int64_t nextExposure = 0;
+		int64_t nextGain = 0;
+		if (controller.Update(MakeHistogram(mean, 0), nextExposure, nextGain)) {
+			// 曝光时间不超过帧间隔，增益不超出范围；变亮时曝光时间到达上限后才提高增益
+			if (nextExposure < range.exposureMin || nextExposure > FRAME_INTERVAL_30FPS || nextGain < range.gainMin ||
+				nextGain > range.gainMax || (nextGain > gain && nextExposure != FRAME_INTERVAL_30FPS) || (!hasGain && nextGain != 0)) {
+				DEBUG_LOG(name << " out of bounds, frame: " << frame << ", exposure: " << nextExposure << ", gain: " << nextGain);
+				return false;
+			}
+			controller.Commit(true, nextExposure, nextGain);
+			exposureTime = nextExposure;
+			gain = nextGain;
+		}
+	}
+	AutoExposureState state;
+	controller.GetState(state);
+	if (mean < 100 || mean > 140 || state.meanLuma != mean || state.exposureTime != uint32_t(exposureTime) || state.gain != gain ||
+		(gain > range.gainMin) != expectGain) {
+		DEBUG_LOG(name << " not converged, mean: " << mean << ", exposure: " << exposureTime << ", gain: " << gain);
+		return false;
+	}
+	return true;
+}
+
+int main() {
+	auto dark = MakeHistogram(30, 0);
+	auto bright = MakeHistogram(240, 0);
+	auto target = MakeHistogram(120, 0);
+
+	// 生效等待：开始及每次调整后等待指定帧数，期间只更新平均亮度
+	{
+		Becamv4l2ExposureController controller;
+		StartController(controller, 3, MakeRange(true), 50, 0);
+		for (int i = 0; i < 3; i++) {
+			if (!CheckStep(controller, dark, false, 50, 0, "Settle after start")) {
+				return 1;
+			}
+		}
+		AutoExposureState state;
+		controller.GetState(state);
+		if (state.active != 1 || state.meanLuma != 30 || state.adjustCount != 0) {
+			DEBUG_LOG("Settle state mismatch, active: " << state.active << ", mean: " << state.meanLuma);
+			return 1;
+		}
+		// 亮度比例4倍按开方阻尼为2倍，优先延长曝光
+		if (!CheckStep(controller, dark, true, 100, 0, "Exposure first")) {
+			return 1;
+		}
+		for (int i = 0; i < 3; i++) {
+			if (!CheckStep(controller, dark, false, 100, 0, "Settle after adjust")) {
+				return 1;
+			}
+		}
+		// 写入失败同样重新等待
+		int64_t exposureTime = 0;
+		int64_t gain = 0;
+		if (!controller.Update(dark, exposureTime, gain) || exposureTime != 200) {
+			DEBUG_LOG("Update before failed write mismatch, exposure: " << exposureTime);
+			return 1;
+		}
+		controller.Commit(false, exposureTime, gain);
+		for (int i = 0; i < 3; i++) {
+			if (!CheckStep(controller, dark, false, 100, 0, "Settle after failed write")) {
+				return 1;
+			}
+		}
+		// 亮度在目标范围内不调整
+		if (!CheckStep(controller, target, false, 100, 0, "Within target")) {
+			return 1;
+		}
+		controller.GetState(state);
+		if (state.adjustCount != 1 || state.exposureTime != 100) {
+			DEBUG_LOG("Adjust count mismatch, count: " << state.adjustCount);
+			return 1;
+		}
+	}
+
+	// 帧间隔上限：曝光时间到达帧间隔后剩余比例由增益补偿（600/333约1.8倍，对应增益11）
+	{
+		Becamv4l2ExposureController controller;
+		if (StartController(controller, 1, MakeRange(true), 5000, 0) != FRAME_INTERVAL_30FPS) {
+			DEBUG_LOG("Start exposure not capped by frame interval");
+			return 1;
+		}
+		StartController(controller, 1, MakeRange(true), 300, 0);
+		if (!CheckStep(controller, dark, false, 300, 0, "Settle") ||
+			!CheckStep(controller, dark, true, FRAME_INTERVAL_30FPS, 11, "Frame cap")) {
+			return 1;
+		}
+	}
+
+	// 变暗时优先降低增益（4.5倍按0.707缩小为3.18倍，对应增益31），增益降到最低后再缩短曝光
+	{
+		Becamv4l2ExposureController controller;
+		StartController(controller, 1, MakeRange(true), FRAME_INTERVAL_30FPS, 50);
+		if (!CheckStep(controller, bright, false, FRAME_INTERVAL_30FPS, 50, "Settle") ||
+			!CheckStep(controller, bright, true, FRAME_INTERVAL_30FPS, 31, "Gain first")) {
+			return 1;
+		}
+		StartController(controller, 1, MakeRange(true), FRAME_INTERVAL_30FPS, 0);
+		if (!CheckStep(controller, bright, false, FRAME_INTERVAL_30FPS, 0, "Settle") ||
+			!CheckStep(controller, bright, true, 235, 0, "Exposure after gain")) {
+			return 1;
+		}
+		// 过曝采样超过5%时即使平均亮度在目标范围内也要变暗（比例按0.9计）
+		StartController(controller, 1, MakeRange(false), 200, 0);
+		if (!CheckStep(controller, MakeHistogram(110, 100), false, 200, 0, "Settle") ||
+			!CheckStep(controller, MakeHistogram(110, 100), true, 190, 0, "Overexposed")) {
+			return 1;
+		}
+	}
+
+	// 步长及边界：按步长对齐到网格，取整后没有变化时至少移动一个步长，到达边界后不再调整
+	{
+		auto range = MakeRange(true);
+		range.exposureMin = 5;
+		range.exposureStep = 10;
+		range.gainStep = 10;
+		Becamv4l2ExposureController controller;
+		if (StartController(controller, 1, range, 57, 33) != 55) {
+			DEBUG_LOG("Start exposure not aligned to step");
+			return 1;
+		}
+		AutoExposureState state;
+		controller.GetState(state);
+		if (state.gain != 30) {
+			DEBUG_LOG("Start gain not aligned to step, gain: " << state.gain);
+			return 1;
+		}
+		// 平均亮度99：开方后约1.1倍，55延长为61后对齐回55，前进一个步长
+		if (!CheckStep(controller, MakeHistogram(99, 0), false, 55, 30, "Settle") ||
+			!CheckStep(controller, MakeHistogram(99, 0), true, 65, 30, "Exposure step")) {
+			return 1;
+		}
+		// 曝光时间对齐后的上限为325：再前进一个步长时提高增益
+		StartController(controller, 1, range, FRAME_INTERVAL_30FPS, 30);
+		if (!CheckStep(controller, MakeHistogram(99, 0), false, 325, 30, "Settle") ||
+			!CheckStep(controller, MakeHistogram(99, 0), true, 325, 40, "Gain step")) {
+			return 1;
+		}
+		// 平均亮度141：降低后的增益向下对齐到步长
+		if (!CheckStep(controller, MakeHistogram(141, 0), false, 325, 40, "Settle") ||
+			!CheckStep(controller, MakeHistogram(141, 0), true, 325, 30, "Gain step back")) {
+			return 1;
+		}
+		// 曝光时间及增益都在上限时无法再变亮
+		StartController(controller, 1, range, 10000, 100);
+		if (!CheckStep(controller, dark, false, 325, 100, "Settle") || !CheckStep(controller, dark, false, 325, 100, "Upper bound")) {
+			return 1;
+		}
+		// 曝光时间及增益都在下限时无法再变暗
+		StartController(controller, 1, range, 0, -10);
+		if (!CheckStep(controller, bright, false, 5, 0, "Settle") || !CheckStep(controller, bright, false, 5, 0, "Lower bound")) {
+			return 1;
+		}
+	}
+
+	// 配置的曝光时间及增益上限
+	{
+		AutoExposureConfig config = {};
+		config.settleFrames = 1;
+		config.maxExposureTime = 100;
+		config.maxGain = 20;
+		Becamv4l2ExposureController controller;
+		controller.SetConfig(&config);
+		int64_t exposureTime = 300;
+		int64_t gain = 50;
+		controller.Start(MakeRange(true), TIME_PER_FRAME_30FPS, exposureTime, gain);
+		if (exposureTime != 100 || gain != 20 || !CheckStep(controller, dark, false, 100, 20, "Settle") ||
+			!CheckStep(controller, dark, false, 100, 20, "Configured bounds")) {
+			DEBUG_LOG("Configured bounds mismatch, exposure: " << exposureTime << ", gain: " << gain);
+			return 1;
+		}
+	}
+
+	// 未启用时不调整
+	{
+		Becamv4l2ExposureController controller;
+		int64_t exposureTime = 100;
+		int64_t gain = 0;
+		controller.Start(MakeRange(true), TIME_PER_FRAME_30FPS, exposureTime, gain);
+		if (!CheckStep(controller, dark, false, 0, 0, "Disabled")) {
+			return 1;
+		}
+	}
+
+	// 闭环收敛：暗场景需要增益补偿，亮场景缩短曝光，不支持增益的设备只调曝光
+	if (!CheckConvergence(0.05, true, true, "Dark scene") || !CheckConvergence(3.0, true, false, "Bright scene") ||
+		!CheckConvergence(1.0, false, false, "No gain")) {
+		return 1;
+	}
+
+	std::cout << "Exposure controller test passed." << std::endl;
+	return 0;
+}
@@ -0,0 +1,301 @@
+#include <becam/becam.h>
+#include <pkg/LogOutput.hpp>
+#include <string>
+#include <vector>
+
+#if defined(__linux__)
+#include <becamv4l2/Becamv4l2CapabilityStore.hpp>
+#include <dirent.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/**
+ * @brief 生成模拟的设备配置列表
+ *
+ * @param seed 区分不同设备的种子
+ * @param count 配置数量
+ * @return 设备配置列表
+ */
+static std::vector<VideoFrameInfo> MakeConfigList(const uint32_t seed, const size_t count) {
+	std::vector<VideoFrameInfo> configList(count);
+	for (size_t i = 0; i < count; i++) {
+		configList[i] = {seed % 2 == 0 ? BECAM_FORMAT_YUYV : BECAM_FORMAT_MJPG, 640 + seed * 16, 480 + uint32_t(i) * 8,
+						 30 - uint32_t(i % 3) * 5};
+	}
+	return configList;
+}
+
+/**
+ * @brief 检查配置列表是否一致
+ */
+static bool SameConfigList(const std::vector<VideoFrameInfo>& a, const std::vector<VideoFrameInfo>& b) {
+	return a.size() == b.size() && (a.empty() || memcmp(a.data(), b.data(), a.size() * sizeof(VideoFrameInfo)) == 0);
+}
+
+/**
+ * @brief 读取文件全部内容
+ */
+static std::vector<uint8_t> ReadFile(const std::string& filePath) {
+	std::vector<uint8_t> content;
+	auto file = fopen(filePath.c_str(), "rb");
+	if (file == nullptr) {
+		return content;
+	}
+	uint8_t buffer[4096];
+	size_t length;
+	while ((length = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+		content.insert(content.end(), buffer, buffer + length);
+	}
+	fclose(file);
+	return content;
+}
+
+/**
+ * @brief 覆盖写入文件
+ */
+static bool WriteFile(const std::string& filePath, const std::vector<uint8_t>& content) {
+	auto file = fopen(filePath.c_str(), "wb");
+	if (file == nullptr) {
+		return false;
+	}
+	auto written = content.empty() ? 0 : fwrite(content.data(), 1, content.size(), file);
+	fclose(file);
+	return written == content.size();
+}
+
+/**
+ * @brief 以新的缓存实例读取（模拟冷启动的进程）
+ */
+static bool LoadFresh(const std::string& filePath, const std::string& deviceId, const std::string& fingerprint,
+					  std::vector<VideoFrameInfo>& configList) {
+	Becamv4l2CapabilityStore store(filePath);
+	return store.Load(deviceId, fingerprint, configList);
+}
+
+/**
+ * @brief 删除目录及其中的文件
+ */
+static void RemoveDir(const std::string& dirPath) {
+	auto dir = opendir(dirPath.c_str());
+	if (dir == nullptr) {
+		return;
+	}
+	while (auto entry = readdir(dir)) {
+		std::string name = entry->d_name;
+		if (name == "." || name == "..") {
+			continue;
+		}
+		auto path = dirPath + "/" + name;
+		if (entry->d_type == DT_DIR) {
+			RemoveDir(path);
+		} else {
+			unlink(path.c_str());
+		}
+	}
+	closedir(dir);
+	rmdir(dirPath.c_str());
+}
+
+/**
+ * @brief 统计目录中残留的临时文件
+ */
+static int CountTempFiles(const std::string& dirPath) {
+	int count = 0;
+	auto dir = opendir(dirPath.c_str());
+	if (dir == nullptr) {
+		return 0;
+	}
+	while (auto entry = readdir(dir)) {
+		if (strstr(entry->d_name, ".tmp.") != nullptr) {
+			count++;
+		}
+	}
+	closedir(dir);
+	return count;
+}
+
+/**
+ * @brief 写入并读回，验证往返、多设备合并及指纹校验
+ */
+static bool TestRoundTrip(const std::string& cacheDir) {
+	auto filePath = Becamv4l2CapabilityStore::ResolveFilePath(cacheDir);
+	auto camA = MakeConfigList(1, 24);
+	auto camB = MakeConfigList(2, 7);
+	std::vector<VideoFrameInfo> loaded;
+
+	// 没有缓存文件时不命中
+	if (LoadFresh(filePath, "usb-A", "uvcvideo-6.1", loaded)) {
+		DEBUG_LOG("Load should miss without a cache file");
+		return false;
+	}
+
+	// 写入后读回（包括同一实例及新实例）
+	Becamv4l2CapabilityStore storeA(filePath);
+	storeA.Save("usb-A", "uvcvideo-6.1", camA);
+	if (!storeA.Load("usb-A", "uvcvideo-6.1", loaded) || !SameConfigList(loaded, camA) ||
+		!LoadFresh(filePath, "usb-A", "uvcvideo-6.1", loaded) || !SameConfigList(loaded, camA)) {
+		DEBUG_LOG("Round trip mismatch");
+		return false;
+	}
+	// 写入临时文件后原子替换，不残留临时文件
+	if (CountTempFiles(cacheDir) != 0) {
+		DEBUG_LOG("Temporary file left behind");
+		return false;
+	}
+
+	// 另一进程写入其它设备时合并已有条目
+	Becamv4l2CapabilityStore storeB(filePath);
+	storeB.Save("usb-B", "uvcvideo-6.1", camB);
+	if (!LoadFresh(filePath, "usb-A", "uvcvideo-6.1", loaded) || !SameConfigList(loaded, camA) ||
+		!LoadFresh(filePath, "usb-B", "uvcvideo-6.1", loaded) || !SameConfigList(loaded, camB)) {
+		DEBUG_LOG("Merge of two device ids mismatch");
+		return false;
+	}
+	// 先前的实例再次写入时同样保留另一进程写入的条目，同一设备只保留最新的一条
+	auto camA2 = MakeConfigList(3, 5);
+	storeA.Save("usb-A", "uvcvideo-6.1", camA2);
+	if (!LoadFresh(filePath, "usb-A", "uvcvideo-6.1", loaded) || !SameConfigList(loaded, camA2) ||
+		!LoadFresh(filePath, "usb-B", "uvcvideo-6.1", loaded) || !SameConfigList(loaded, camB)) {
+		DEBUG_LOG("Second merge mismatch");
+		return false;
+	}
+
+	// 驱动指纹变化（例如升级内核或固件）时不命中
+	if (LoadFresh(filePath, "usb-A", "uvcvideo-6.2", loaded)) {
+		DEBUG_LOG("Load should miss after the fingerprint changed");
+		return false;
+	}
+	storeA.Save("usb-A", "uvcvideo-6.2", camA);
+	if (LoadFresh(filePath, "usb-A", "uvcvideo-6.1", loaded) || !LoadFresh(filePath, "usb-A", "uvcvideo-6.2", loaded) ||
+		!SameConfigList(loaded, camA)) {
+		DEBUG_LOG("Fingerprint replacement mismatch");
+		return false;
+	}
+
+	// 空配置列表同样可以缓存
+	storeA.Save("usb-C", "uvcvideo-6.1", std::vector<VideoFrameInfo>());
+	if (!LoadFresh(filePath, "usb-C", "uvcvideo-6.1", loaded) || !loaded.empty()) {
+		DEBUG_LOG("Empty config list mismatch");
+		return false;
+	}
+	return true;
+}
+
+/**
+ * @brief 验证条目数量上限（超出时丢弃最早写入的条目）
+ */
+static bool TestEntryCap(const std::string& cacheDir) {
+	auto filePath = Becamv4l2CapabilityStore::ResolveFilePath(cacheDir);
+	const size_t maxEntries = Becamv4l2CapabilityStore::MAX_CAPABILITY_ENTRIES;
+	const size_t total = maxEntries + 44;
+	Becamv4l2CapabilityStore store(filePath);
+	for (size_t i = 0; i < total; i++) {
+		store.Save("usb-" + std::to_string(i), "uvcvideo", MakeConfigList(uint32_t(i), 2));
+	}
+	std::vector<VideoFrameInfo> loaded;
+	auto oldestKept = total - maxEntries;
+	if (LoadFresh(filePath, "usb-" + std::to_string(oldestKept - 1), "uvcvideo", loaded)) {
+		DEBUG_LOG("Entry beyond the cap should be dropped");
+		return false;
+	}
+	for (auto i : {oldestKept, total - 1}) {
+		if (!LoadFresh(filePath, "usb-" + std::to_string(i), "uvcvideo", loaded) || !SameConfigList(loaded, MakeConfigList(uint32_t(i), 2))) {
+			DEBUG_LOG("Entry within the cap should be kept: " << i);
+			return false;
+		}
+	}
+	return true;
+}
+
+/**
+ * @brief 验证截断、损坏及版本不符的文件被拒绝（不越界读取）
+ */
+static bool TestCorruptFiles(const std::string& cacheDir) {
+	auto filePath = Becamv4l2CapabilityStore::ResolveFilePath(cacheDir);
+	auto camA = MakeConfigList(1, 4);
+	auto camB = MakeConfigList(2, 3);
+	{
+		Becamv4l2CapabilityStore store(filePath);
+		store.Save("usb-A", "uvcvideo", camA);
+		store.Save("usb-B", "uvcvideo", camB);
+	}
+	auto valid = ReadFile(filePath);
+	// 文件头16字节，第一条为最新写入的usb-B，条目头8字节（标识长度、指纹长度、配置数量）
+	const size_t fileHeaderSize = 16;
+	const size_t firstEntrySize = 8 + 16 + camB.size() * sizeof(VideoFrameInfo);
+	if (valid.size() != fileHeaderSize + firstEntrySize + 8 + 16 + camA.size() * sizeof(VideoFrameInfo)) {
+		DEBUG_LOG("Unexpected cache file size: " << valid.size());
+		return false;
+	}
+	std::vector<VideoFrameInfo> loaded;
+
+	// 截断：只有完整保存在文件中的条目可以命中
+	for (size_t size = 0; size < valid.size(); size++) {
+		if (!WriteFile(filePath, std::vector<uint8_t>(valid.begin(), valid.begin() + size))) {
+			return false;
+		}
+		auto hitB = LoadFresh(filePath, "usb-B", "uvcvideo", loaded);
+		if (hitB != (size >= fileHeaderSize + firstEntrySize) || (hitB && !SameConfigList(loaded, camB))) {
+			DEBUG_LOG("Truncated file at " << size << " mismatch");
+			return false;
+		}
+		if (LoadFresh(filePath, "usb-A", "uvcvideo", loaded)) {
+			DEBUG_LOG("Truncated file at " << size << " should not contain usb-A");
+			return false;
+		}
+	}
+
+	// 魔数或版本不符
+	auto corrupt = [&](const size_t offset, const uint32_t value) {
+		auto content = valid;
+		memcpy(content.data() + offset, &value, sizeof(value));
+		return WriteFile(filePath, content);
+	};
+	if (!corrupt(0, 0x12345678) || LoadFresh(filePath, "usb-B", "uvcvideo", loaded) ||
+		!corrupt(4, Becamv4l2CapabilityStore::FILE_VERSION + 1) || LoadFresh(filePath, "usb-B", "uvcvideo", loaded)) {
+		DEBUG_LOG("Wrong magic or version should be rejected");
+		return false;
+	}
+	// 条目数量、配置数量及字符串长度超出文件大小
+	if (!corrupt(8, 0xFFFFFFFF) || !LoadFresh(filePath, "usb-B", "uvcvideo", loaded) || LoadFresh(filePath, "usb-X", "uvcvideo", loaded) ||
+		!corrupt(fileHeaderSize + 4, 0xFFFFFFFF) || LoadFresh(filePath, "usb-B", "uvcvideo", loaded) ||
+		!corrupt(fileHeaderSize, 0xFFFFFFFF) || LoadFresh(filePath, "usb-B", "uvcvideo", loaded) ||
+		!corrupt(fileHeaderSize + firstEntrySize + 4, 0x10000000) || LoadFresh(filePath, "usb-A", "uvcvideo", loaded)) {
+		DEBUG_LOG("Out of range lengths should be rejected");
+		return false;
+	}
+
+	// 损坏的文件在下次写入时被整体替换
+	Becamv4l2CapabilityStore store(filePath);
+	store.Save("usb-C", "uvcvideo", camA);
+	if (!LoadFresh(filePath, "usb-C", "uvcvideo", loaded) || !SameConfigList(loaded, camA)) {
+		DEBUG_LOG("Saving over a corrupt file mismatch");
+		return false;
+	}
+	return true;
+}
+#endif
+
+int main() {
+#if defined(__linux__)
+	// 在临时目录中读写缓存文件（使用多级子目录，验证逐级创建目录）
+	char tempDir[] = "/tmp/becam_capability_XXXXXX";
+	if (mkdtemp(tempDir) == nullptr) {
+		DEBUG_LOG("Failed to create temp dir");
+		return 1;
+	}
+	std::string root = tempDir;
+	auto passed = TestRoundTrip(root + "/round/trip") && TestEntryCap(root + "/cap") && TestCorruptFiles(root + "/corrupt");
+	RemoveDir(root);
+	if (!passed) {
+		return 1;
+	}
+	std::cout << "Capability store test passed." << std::endl;
+#else
+	// 设备配置列表的持久化缓存仅在V4L2下实现
+	std::cout << "Capability store is not supported on this platform." << std::endl;
+#endif
+	return 0;
+}
@@ -0,0 +1,121 @@
+#include <becam/becam.h>
+#include <fstream>
+#include <pkg/LogOutput.hpp>
+#include <vector>
+
+int main() {
+	// 初始化句柄
+	auto handle = BecamNew();
+	if (handle == nullptr) {
+		DEBUG_LOG("Failed to initialize handle.");
+		return 1;
+	}
+
+	// 声明返回值
+	GetDeviceListReply reply;
+	// 获取设备列表
+	auto res = BecamGetDeviceList(handle, &reply);
+	if (res != StatusCode::STATUS_CODE_SUCCESS) {
+		DEBUG_LOG("Failed to get device list. errno: " << res);
+		BecamFree(&handle);
+		return 1;
+	}
+	if (reply.deviceInfoListSize == 0) {
+		DEBUG_LOG("No device found.");
+		BecamFreeDeviceList(&reply);
+		BecamFree(&handle);
+		return 0;
+	}
+
+	// 选中第一个设备的第一个配置
+	std::string devicePath = reply.deviceInfoList[0].devicePath;
+	BecamFreeDeviceList(&reply);
+	GetDeviceConfigListReply configReply = {0};
+	res = BecamGetDeviceConfigList(handle, devicePath.c_str(), &configReply);
+	if (res != StatusCode::STATUS_CODE_SUCCESS || configReply.videoFrameInfoListSize == 0) {
+		DEBUG_LOG("Failed to get device config list. errno: " << res);
+		BecamFree(&handle);
+		return 1;
+	}
+	VideoFrameInfo frameInfo = configReply.videoFrameInfoList[0];
+	BecamFreeDeviceConfigList(&configReply);
+
+	// 打开设备
+	res = BecamOpenDevice(handle, devicePath.c_str(), &frameInfo);
+	if (res != StatusCode::STATUS_CODE_SUCCESS) {
+		DEBUG_LOG("Failed to open device. errno: " << res);
+		BecamFree(&handle);
+		return 1;
+	}
+
+	// 获取控制项列表
+	GetControlListReply controlReply = {0};
+	res = BecamGetControlList(handle, &controlReply);
+	if (res != StatusCode::STATUS_CODE_SUCCESS) {
+		DEBUG_LOG("Failed to get control list. errno: " << res);
+		BecamCloseDevice(handle);
+		BecamFree(&handle);
+		return 1;
+	}
+
+	// 打印控制项，并收集可读写的控制项
+	std::vector<ControlValue> values;
+	for (size_t i = 0; i < controlReply.controlInfoListSize; i++) {
+		auto item = controlReply.controlInfoList[i];
+		std::cout << "\n" << item.name << " (0x" << std::hex << item.id << std::dec << "): type " << item.type << ", range [" << item.minimum
+				  << ", " << item.maximum << "], step " << item.step << ", default " << item.defaultValue << ", flags " << item.flags;
+		for (size_t j = 0; j < item.menuItemListSize; j++) {
+			auto menuItem = item.menuItemList[j];
+			std::cout << "\n\t" << menuItem.index << ": ";
+			if (item.type == ControlType::CONTROL_TYPE_MENU) {
+				std::cout << menuItem.name;
+			} else {
+				std::cout << menuItem.value;
+			}
+		}
+		auto unsupported = item.type == ControlType::CONTROL_TYPE_BUTTON || item.type == ControlType::CONTROL_TYPE_OTHER;
+		auto readWrite = !(item.flags & (ControlFlag::CONTROL_FLAG_READ_ONLY | ControlFlag::CONTROL_FLAG_WRITE_ONLY));
+		if (!unsupported && readWrite) {
+			values.push_back({item.id, 0});
+		}
+	}
+	std::cout << std::endl;
+	BecamFreeControlList(&controlReply);
+
+	// 批量读取
+	res = BecamGetControls(handle, values.data(), values.size());
+	if (res != StatusCode::STATUS_CODE_SUCCESS) {
+		DEBUG_LOG("Failed to get controls. errno: " << res);
+		BecamCloseDevice(handle);
+		BecamFree(&handle);
+		return 1;
+	}
+	for (auto& value : values) {
+		std::cout << "0x" << std::hex << value.id << std::dec << " = " << value.value << std::endl;
+	}
+
+	// 原样写回（一次批量设置）
+	res = BecamSetControls(handle, values.data(), values.size());
+	if (res != StatusCode::STATUS_CODE_SUCCESS) {
+		DEBUG_LOG("Failed to set controls. errno: " << res);
+	}
+
+	// 保存快照并立即恢复（一次调用写入）
+	ControlSnapshot snapshot = {0};
+	auto snapshotRes = BecamSaveControlSnapshot(handle, &snapshot);
+	if (snapshotRes == StatusCode::STATUS_CODE_SUCCESS) {
+		std::cout << "Control snapshot: " << snapshot.dataSize << " bytes" << std::endl;
+		snapshotRes = BecamSetControlSnapshot(handle, &snapshot);
+		BecamFreeControlSnapshot(&snapshot);
+	}
+	if (snapshotRes != StatusCode::STATUS_CODE_SUCCESS) {
+		DEBUG_LOG("Failed to save or restore control snapshot. errno: " << snapshotRes);
+		res = snapshotRes;
+	}
+
+	// 关闭设备
+	BecamCloseDevice(handle);
+	// 释放句柄
+	BecamFree(&handle);
+	return res == StatusCode::STATUS_CODE_SUCCESS ? 0 : 1;
+}
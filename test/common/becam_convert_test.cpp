@@ -0,0 +1,262 @@
+#include "becam_test_fixture.hpp"
+#include <becam/becam.h>
+#include <chrono>
+#include <pkg/LogOutput.hpp>
+#include <pkg/PixelConvert.hpp>
+#include <stdlib.h>
+#include <vector>
+
+int main() {
+	// 参与对比的指令集级别（不支持的级别会退化为标量实现）
+	std::vector<SimdLevel> levels = {SimdLevel::SCALAR, SimdLevel::SSE2, SimdLevel::AVX2, SimdLevel::NEON};
+	std::cout << "Detected SIMD level: " << int(GetSimdLevel()) << std::endl;
+
+	// 标准色：黑、白及中性灰
+	{
+		uint8_t yuyv[8] = {16, 128, 235, 128, 126, 128, 126, 128};
+		uint8_t rgb[6 * 3] = {0};
+		PackedYuvToRgbRowScalar(yuyv, rgb, 4, true, true, false, 3);
+		if (rgb[0] != 0 || rgb[2] != 0 || rgb[3] != 255 || rgb[5] != 255 || rgb[6] != rgb[7] || rgb[7] != rgb[8]) {
+			DEBUG_LOG("Reference conversion mismatch");
+			return 1;
+		}
+	}
+
+	// 各格式、宽度及行间距下对比各实现与标量实现（覆盖向量化的整块及标量收尾）
+	std::vector<uint32_t> srcFormats = {BECAM_FORMAT_YUYV, BECAM_FORMAT_UYVY, BECAM_FOURCC('Y', 'V', 'Y', 'U'), BECAM_FOURCC('V', 'Y', 'U', 'Y')};
+	std::vector<uint32_t> dstFormats = {BECAM_FORMAT_RGB24, BECAM_FORMAT_BGR24, BECAM_FORMAT_RGBA32, BECAM_FORMAT_BGRA32};
+	for (auto srcFormat : srcFormats) {
+		for (auto dstFormat : dstFormats) {
+			for (uint32_t width : {1, 2, 15, 16, 17, 31, 32, 33, 34, 35, 63, 64, 66, 67, 641}) {
+				std::vector<uint8_t> srcData;
+				ImageBuffer src;
+				MakeImage(srcFormat, width, 3, width % 3 * 4, srcData, src);
+				std::vector<uint8_t> expectedData;
+				ImageBuffer expected;
+				MakeImage(dstFormat, width, 3, 0, expectedData, expected);
+				ConvertImage(src, expected, SimdLevel::SCALAR);
+				for (auto level : levels) {
+					std::vector<uint8_t> actualData;
+					ImageBuffer actual;
+					MakeImage(dstFormat, width, 3, width % 5, actualData, actual);
+					auto code = ConvertImage(src, actual, level);
+					if (code != StatusCode::STATUS_CODE_SUCCESS || !SameImage(expected, actual)) {
+						DEBUG_LOG("ConvertImage mismatch, src: " << srcFormat << ", dst: " << dstFormat << ", width: " << width
+																 << ", level: " << int(level));
+						return 1;
+					}
+				}
+			}
+		}
+	}
+
+	// YUV布局之间重排
+	std::vector<uint32_t> yuvFormats = {BECAM_FORMAT_YUYV, BECAM_FORMAT_UYVY, BECAM_FOURCC('Y', 'V', 'Y', 'U'), BECAM_FORMAT_NV12,
+										BECAM_FORMAT_NV21, BECAM_FORMAT_I420, BECAM_FORMAT_YV12};
+	for (auto srcFormat : yuvFormats) {
+		for (auto dstFormat : yuvFormats) {
+			for (uint32_t width : {1, 2, 17, 32, 33, 66, 67, 130}) {
+				for (uint32_t height : {1, 2, 5}) {
+					std::vector<uint8_t> srcData;
+					ImageBuffer src;
+					MakeImage(srcFormat, width, height, width % 3 * 2, srcData, src);
+					std::vector<uint8_t> expectedData;
+					ImageBuffer expected;
+					MakeImage(dstFormat, width, height, 0, expectedData, expected);
+					ConvertImage(src, expected, SimdLevel::SCALAR);
+					for (auto level : levels) {
+						std::vector<uint8_t> actualData;
+						ImageBuffer actual;
+						MakeImage(dstFormat, width, height, 4, actualData, actual);
+						auto code = ConvertImage(src, actual, level);
+						if (code != StatusCode::STATUS_CODE_SUCCESS || !SameImage(expected, actual)) {
+							DEBUG_LOG("RepackYuv mismatch, src: " << srcFormat << ", dst: " << dstFormat << ", width: " << width
+																  << ", height: " << height << ", level: " << int(level));
+							return 1;
+						}
+					}
+				}
+			}
+		}
+	}
+
+	// 4:2:0经4:2:2往返后不变，4:2:2的色度为上下两行的平均值
+	{
+		std::vector<uint8_t> srcData;
+		ImageBuffer src;
+		MakeImage(BECAM_FORMAT_NV12, 66, 6, 2, srcData, src);
+		std::vector<uint8_t> packedData;
+		ImageBuffer packed;
+		MakeImage(BECAM_FORMAT_UYVY, 66, 6, 0, packedData, packed);
+		std::vector<uint8_t> planarData;
+		ImageBuffer planar;
+		MakeImage(BECAM_FORMAT_YV12, 66, 6, 0, planarData, planar);
+		std::vector<uint8_t> backData;
+		ImageBuffer back;
+		MakeImage(BECAM_FORMAT_NV12, 66, 6, 0, backData, back);
+		ConvertImage(src, packed);
+		ConvertImage(packed, planar);
+		ConvertImage(planar, back);
+		if (!SameImage(src, back) || packed.plane[0][0] != src.plane[1][0] || packed.plane[0][2] != src.plane[1][1] ||
+			planar.plane[1][0] != src.plane[1][0] || planar.plane[2][0] != src.plane[1][1]) {
+			DEBUG_LOG("YUV round trip mismatch");
+			return 1;
+		}
+		uint8_t rows[2][4] = {{10, 1, 20, 2}, {11, 4, 21, 7}};
+		uint8_t luma[4] = {0};
+		uint8_t chroma[2] = {0};
+		UnpackYuvRowPairScalar(rows[0], rows[1], luma, luma + 2, chroma, 2, true);
+		if (chroma[0] != 3 || chroma[1] != 5 || luma[1] != 20 || luma[2] != 11) {
+			DEBUG_LOG("Chroma average mismatch");
+			return 1;
+		}
+	}
+
+	// 裁剪视图只转换区域内的像素
+	{
+		std::vector<uint8_t> srcData;
+		ImageBuffer src;
+		MakeImage(BECAM_FORMAT_YUYV, 64, 8, 0, srcData, src);
+		std::vector<uint8_t> fullData;
+		ImageBuffer full;
+		MakeImage(BECAM_FORMAT_RGBA32, 64, 8, 0, fullData, full);
+		ConvertImage(src, full);
+		std::vector<uint8_t> cropData;
+		ImageBuffer crop;
+		MakeImage(BECAM_FORMAT_RGBA32, 34, 5, 0, cropData, crop);
+		auto view = src;
+		auto fullView = full;
+		if (!CropImageBuffer(view, 6, 2, 34, 5) || !CropImageBuffer(fullView, 6, 2, 34, 5) || ConvertImage(view, crop) != StatusCode::STATUS_CODE_SUCCESS ||
+			!SameImage(fullView, crop)) {
+			DEBUG_LOG("Cropped conversion mismatch");
+			return 1;
+		}
+		if (CropImageBuffer(view, 1, 0, 2, 2)) {
+			DEBUG_LOG("CropImageBuffer should reject odd offset for packed YUV");
+			return 1;
+		}
+	}
+
+	// 亮度视图与源图像逐像素对应，抽取为紧凑GREY后与视图一致（含裁剪视图）
+	for (auto format : yuvFormats) {
+		for (uint32_t width : {1, 2, 31, 64, 65, 130}) {
+			std::vector<uint8_t> srcData;
+			ImageBuffer src;
+			MakeImage(format, width + 2, 5, width % 3 * 2, srcData, src);
+			if (!CropImageBuffer(src, 2, 0, width, 4)) {
+				DEBUG_LOG("CropImageBuffer failed, format: " << format);
+				return 1;
+			}
+			LumaView view;
+			if (BecamGetLumaView(&src, &view) != StatusCode::STATUS_CODE_SUCCESS || view.width != width || view.height != 4) {
+				DEBUG_LOG("BecamGetLumaView failed, format: " << format);
+				return 1;
+			}
+			// 经YUYV转换得到的亮度作为参照
+			std::vector<uint8_t> packedData;
+			ImageBuffer packed;
+			MakeImage(BECAM_FORMAT_YUYV, width, 4, 0, packedData, packed);
+			ConvertImage(src, packed);
+			for (auto level : levels) {
+				std::vector<uint8_t> greyData;
+				ImageBuffer grey;
+				MakeImage(BECAM_FOURCC('G', 'R', 'E', 'Y'), width, 4, 3, greyData, grey);
+				if (ConvertImage(src, grey, level) != StatusCode::STATUS_CODE_SUCCESS) {
+					DEBUG_LOG("Luma extraction failed, format: " << format);
+					return 1;
+				}
+				for (uint32_t y = 0; y < 4; y++) {
+					for (uint32_t x = 0; x < width; x++) {
+						auto luma = view.data[size_t(y) * view.stride + size_t(x) * view.pixelStride];
+						if (luma != grey.plane[0][size_t(y) * grey.stride[0] + x] || luma != packed.plane[0][size_t(y) * packed.stride[0] + x * 2]) {
+							DEBUG_LOG("Luma mismatch, format: " << format << ", width: " << width << ", x: " << x << ", y: " << y
+																<< ", level: " << int(level));
+							return 1;
+						}
+					}
+				}
+			}
+		}
+	}
+
+	// 接口参数检查
+	{
+		std::vector<uint8_t> data(BecamGetImageSize(BECAM_FORMAT_YUYV, 33, 2));
+		ImageBuffer image = {0};
+		image.format = BECAM_FORMAT_YUYV;
+		image.width = 33;
+		image.height = 2;
+		if (data.size() != 34 * 2 * 2 || BecamFillImageBuffer(&image, data.data(), data.size(), 0) != StatusCode::STATUS_CODE_SUCCESS ||
+			BecamFillImageBuffer(&image, data.data(), data.size() - 1, 0) != StatusCode::STATUS_CODE_ERR_INPUT_PARAM) {
+			DEBUG_LOG("BecamFillImageBuffer check failed");
+			return 1;
+		}
+		ImageBuffer jpeg = image;
+		jpeg.format = BECAM_FORMAT_MJPG;
+		if (BecamConvertImage(&image, &jpeg) != StatusCode::STATUS_CODE_ERR_NOT_SUPPORTED) {
+			DEBUG_LOG("BecamConvertImage should reject unsupported format");
+			return 1;
+		}
+		LumaView view;
+		ImageBuffer rgb = image;
+		rgb.format = BECAM_FORMAT_RGB24;
+		if (BecamGetLumaView(&image, nullptr) != StatusCode::STATUS_CODE_ERR_INPUT_PARAM ||
+			BecamGetLumaView(&rgb, &view) != StatusCode::STATUS_CODE_ERR_NOT_SUPPORTED ||
+			BecamGetLumaView(&image, &view) != StatusCode::STATUS_CODE_SUCCESS || view.data != data.data() || view.pixelStride != 2 || view.stride != 68) {
+			DEBUG_LOG("BecamGetLumaView check failed");
+			return 1;
+		}
+	}
+
+	// 1080p转换耗时
+	{
+		struct Pair {
+			uint32_t src;
+			uint32_t dst;
+		};
+		std::vector<Pair> pairs = {{BECAM_FORMAT_YUYV, BECAM_FORMAT_I420}, {BECAM_FORMAT_YUYV, BECAM_FORMAT_NV12}, {BECAM_FORMAT_NV12, BECAM_FORMAT_I420},
+								   {BECAM_FORMAT_NV12, BECAM_FORMAT_YUYV}, {BECAM_FORMAT_YUYV, BECAM_FORMAT_UYVY}, {BECAM_FORMAT_YUYV, BECAM_FOURCC('G', 'R', 'E', 'Y')},
+								   {BECAM_FORMAT_UYVY, BECAM_FOURCC('G', 'R', 'E', 'Y')}};
+		for (auto& pair : pairs) {
+			std::vector<uint8_t> srcData;
+			ImageBuffer src;
+			MakeImage(pair.src, 1920, 1080, 0, srcData, src);
+			std::vector<uint8_t> dstData;
+			ImageBuffer dst;
+			MakeImage(pair.dst, 1920, 1080, 0, dstData, dst);
+			for (auto level : levels) {
+				const int rounds = 20;
+				auto begin = std::chrono::steady_clock::now();
+				for (int i = 0; i < rounds; i++) {
+					ConvertImage(src, dst, level);
+				}
+				auto cost = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - begin).count();
+				std::cout << std::string(reinterpret_cast<const char*>(&pair.src), 4) << " 1080p -> " << std::string(reinterpret_cast<const char*>(&pair.dst), 4)
+						  << ", level: " << int(level) << ", cost: " << cost / rounds << "us" << std::endl;
+			}
+		}
+	}
+	{
+		std::vector<uint8_t> srcData;
+		ImageBuffer src;
+		MakeImage(BECAM_FORMAT_YUYV, 1920, 1080, 0, srcData, src);
+		for (auto dstFormat : {BECAM_FORMAT_RGB24, BECAM_FORMAT_BGRA32}) {
+			std::vector<uint8_t> dstData;
+			ImageBuffer dst;
+			MakeImage(dstFormat, 1920, 1080, 0, dstData, dst);
+			for (auto level : levels) {
+				const int rounds = 20;
+				auto begin = std::chrono::steady_clock::now();
+				for (int i = 0; i < rounds; i++) {
+					ConvertImage(src, dst, level);
+				}
+				auto cost = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - begin).count();
+				std::cout << "YUYV 1080p -> " << std::string(reinterpret_cast<const char*>(&dstFormat), 4) << ", level: " << int(level)
+						  << ", cost: " << cost / rounds << "us" << std::endl;
+			}
+		}
+	}
+
+	std::cout << "Convert test passed." << std::endl;
+	return 0;
+}
@@ -0,0 +1,125 @@
+#include <becam/becam.h>
+#include <pkg/DeviceListArena.hpp>
+#include <pkg/LogOutput.hpp>
+#include <vector>
+
+/**
+ * @brief 检查设备信息列表与构建项一致
+ */
+static bool CheckDeviceList(const DeviceInfo* list, const size_t listSize, const std::vector<DeviceListArenaEntry>& devices) {
+	if (list == nullptr || listSize != devices.size()) {
+		return false;
+	}
+	for (size_t i = 0; i < listSize; i++) {
+		auto& info = list[i];
+		auto& device = devices[i];
+		DeviceInfoExtension extension = {0};
+		extension.structSize = sizeof(extension);
+		if (GetDeviceListArenaExtension(list, listSize, i, extension) != StatusCode::STATUS_CODE_SUCCESS ||
+			extension.structSize != sizeof(extension)) {
+			return false;
+		}
+		if (device.name != info.name || device.devicePath != info.devicePath || device.deviceId != extension.deviceId ||
+			device.siblingPaths.size() != extension.siblingPathListSize) {
+			return false;
+		}
+		for (size_t j = 0; j < extension.siblingPathListSize; j++) {
+			if (device.siblingPaths[j] != extension.siblingPathList[j]) {
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+int main() {
+	// 两个节点属于同一物理设备，互为兄弟节点
+	std::vector<DeviceListArenaEntry> devices(3);
+	devices[0] = {"USB Camera", "/dev/video0", "usb-046d:0825-ABC-0", {"/dev/video1"}};
+	devices[1] = {"USB Camera", "/dev/video2", "usb-046d:0825-ABC-2", {"/dev/video0", "/dev/video3"}};
+	devices[2] = {"Integrated Camera", "/dev/video4", "sysfs-platform-4", {}};
+
+	DeviceInfo* list = nullptr;
+	size_t listSize = 0;
+	BuildDeviceListArena(devices, list, listSize);
+	if (!CheckDeviceList(list, listSize, devices)) {
+		DEBUG_LOG("BuildDeviceListArena mismatch");
+		return 1;
+	}
+	// 相同的字符串只保存一份
+	DeviceInfoExtension extension = {0};
+	extension.structSize = sizeof(extension);
+	GetDeviceListArenaExtension(list, listSize, 1, extension);
+	if (list[0].name != list[1].name || list[0].devicePath != extension.siblingPathList[0]) {
+		DEBUG_LOG("BuildDeviceListArena should intern strings");
+		return 1;
+	}
+
+	// 较早版本的调用方结构体较小，只写入其中的字段
+	DeviceInfoExtension partial;
+	memset(&partial, 0xCD, sizeof(partial));
+	partial.structSize = offsetof(DeviceInfoExtension, siblingPathListSize);
+	if (GetDeviceListArenaExtension(list, listSize, 0, partial) != StatusCode::STATUS_CODE_SUCCESS ||
+		partial.structSize != offsetof(DeviceInfoExtension, siblingPathListSize) || devices[0].deviceId != partial.deviceId ||
+		partial.siblingPathListSize != size_t(0xCDCDCDCDCDCDCDCDull)) {
+		DEBUG_LOG("GetDeviceListArenaExtension should honor structSize");
+		return 1;
+	}
+	// 未填写structSize或序号越界
+	DeviceInfoExtension invalid = {0};
+	if (GetDeviceListArenaExtension(list, listSize, 0, invalid) != StatusCode::STATUS_CODE_ERR_INPUT_PARAM) {
+		DEBUG_LOG("GetDeviceListArenaExtension should reject an empty structSize");
+		return 1;
+	}
+	invalid.structSize = sizeof(invalid);
+	if (GetDeviceListArenaExtension(list, listSize, listSize, invalid) != StatusCode::STATUS_CODE_ERR_INPUT_PARAM) {
+		DEBUG_LOG("GetDeviceListArenaExtension should reject an out-of-range index");
+		return 1;
+	}
+
+	// 整块拷贝到其它地址后修正指针，释放原列表后仍可访问
+	auto header = GetDeviceListArenaHeader(list);
+	if (header == nullptr) {
+		DEBUG_LOG("GetDeviceListArenaHeader failed");
+		return 1;
+	}
+	std::vector<uint8_t> copy(header->totalSize);
+	memcpy(copy.data(), header, header->totalSize);
+	auto previousBase = reinterpret_cast<const uint8_t*>(header);
+	auto rebased = RebaseDeviceListArena(copy.data(), previousBase);
+	FreeDeviceListArena(list, listSize);
+	if (list != nullptr || listSize != 0 || !CheckDeviceList(rebased, devices.size(), devices)) {
+		DEBUG_LOG("RebaseDeviceListArena mismatch");
+		return 1;
+	}
+	for (size_t i = 0; i < devices.size(); i++) {
+		auto name = reinterpret_cast<const uint8_t*>(rebased[i].name);
+		if (name < copy.data() || name >= copy.data() + copy.size()) {
+			DEBUG_LOG("RebaseDeviceListArena left a pointer outside of the copy");
+			return 1;
+		}
+	}
+
+	// 再次修正时原地址已不匹配，视为损坏
+	if (RebaseDeviceListArena(copy.data(), previousBase) != nullptr) {
+		DEBUG_LOG("RebaseDeviceListArena should reject pointers outside of the arena");
+		return 1;
+	}
+
+	// 调用方提供的内存块魔数不匹配时不修正
+	std::vector<uint8_t> foreign(AlignDeviceListArenaLength(sizeof(DeviceListArenaHeader)) + sizeof(DeviceInfo), 0);
+	if (RebaseDeviceListArena(foreign.data(), foreign.data()) != nullptr) {
+		DEBUG_LOG("Foreign block should be rejected");
+		return 1;
+	}
+
+	// 空列表
+	BuildDeviceListArena(std::vector<DeviceListArenaEntry>(), list, listSize);
+	if (list != nullptr || listSize != 0) {
+		DEBUG_LOG("BuildDeviceListArena should return an empty list");
+		return 1;
+	}
+
+	std::cout << "Device list arena test passed." << std::endl;
+	return 0;
+}
@@ -83,6 +83,14 @@ int main() {
 		return 1;
 	}
 
+	// 打印实际生效的视频帧格式（当前平台不支持时跳过）
+	FrameFormat format = {0};
+	if (BecamGetCurrentFormat(handle, &format) == StatusCode::STATUS_CODE_SUCCESS) {
+		std::cout << "Current format: " << format.width << "x" << format.height << ", bytesPerLine " << format.bytesPerLine << ", sizeImage "
+				  << format.sizeImage << ", colorspace " << format.colorspace << ", interval " << format.intervalNumerator << "/"
+				  << format.intervalDenominator << std::endl;
+	}
+
 	// 来个死循环
 	while (true) {
 		// 获取一帧
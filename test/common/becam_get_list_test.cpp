@@ -32,6 +32,17 @@ int main() {
 			if (item.devicePath) {
 				std::cout << "\nDevicePath: " << item.devicePath;
 			}
+			// 获取设备扩展信息
+			DeviceInfoExtension extension = {0};
+			extension.structSize = sizeof(extension);
+			if (BecamGetDeviceInfoExtension(&reply, i, &extension) == StatusCode::STATUS_CODE_SUCCESS) {
+				if (extension.deviceId) {
+					std::cout << "\nDeviceId: " << extension.deviceId;
+				}
+				for (size_t j = 0; j < extension.siblingPathListSize; j++) {
+					std::cout << "\nSiblingPath: " << extension.siblingPathList[j];
+				}
+			}
 			std::cout << std::endl;
 
 			// 获取设备支持的视频帧信息
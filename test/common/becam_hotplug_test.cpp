@@ -0,0 +1,197 @@
+#include <becam/becam.h>
+#include <chrono>
+#include <pkg/LogOutput.hpp>
+#include <string>
+#include <thread>
+
+#if defined(__linux__)
+#include <arpa/inet.h>
+#include <becamv4l2/Becamv4l2HotplugMonitor.hpp>
+#include <string.h>
+
+/**
+ * @brief 由字符串字面量构造模拟uevent（保留内嵌的'\0'）
+ */
+template <size_t N> static std::string MakeUevent(const char (&text)[N]) {
+	return std::string(text, N - 1);
+}
+
+/**
+ * @brief 按libudev格式封装模拟的udev消息
+ *
+ * @param properties 属性（以'\0'分隔的`KEY=VALUE`）
+ * @return 模拟消息
+ */
+static std::string MakeUdevMessage(const std::string& properties) {
+	Becamv4l2UdevMessageHeader header;
+	memset(&header, 0, sizeof(header));
+	memcpy(header.prefix, "libudev", 8);
+	header.magic = htonl(BECAMV4L2_UDEV_MESSAGE_MAGIC);
+	header.headerSize = sizeof(header);
+	header.propertiesOffset = sizeof(header);
+	header.propertiesLength = uint32_t(properties.size());
+	return std::string(reinterpret_cast<const char*>(&header), sizeof(header)) + properties;
+}
+
+/**
+ * @brief 注入一条模拟uevent并检查解析结果
+ *
+ * @param monitor 热插拔监听
+ * @param message 模拟消息（字段以'\0'分隔）
+ * @param expectDispatched 是否期望被分发
+ * @return 结果是否符合预期
+ */
+static bool InjectUevent(Becamv4l2HotplugMonitor& monitor, const std::string& message, const bool expectDispatched) {
+	auto dispatched = monitor.Dispatch(message.data(), message.size());
+	if (dispatched != expectDispatched) {
+		DEBUG_LOG("Unexpected dispatch result for: " << message.c_str());
+		return false;
+	}
+	return true;
+}
+
+/**
+ * @brief 使用模拟uevent验证解析与分发（不启动监听线程，监听函数只在当前线程中被调用）
+ *
+ * @return 是否通过
+ */
+static bool TestSyntheticUevents() {
+	HotplugAction lastAction = HotplugAction::HOTPLUG_ACTION_REMOVE;
+	std::string lastDevicePath;
+	int eventCount = 0;
+	Becamv4l2HotplugMonitor monitor;
+	if (!monitor.SetListener([&](HotplugAction action, const std::string& devicePath) {
+			lastAction = action;
+			lastDevicePath = devicePath;
+			eventCount++;
+		})) {
+		DEBUG_LOG("Failed to set hotplug listener.");
+		return false;
+	}
+
+	// 接入
+	auto add = MakeUevent("add@/devices/pci0000:00/0000:00:14.0/usb1/1-1/1-1:1.0/video4linux/video2\0"
+						  "ACTION=add\0DEVPATH=/devices/pci0000:00/0000:00:14.0/usb1/1-1/1-1:1.0/video4linux/video2\0"
+						  "SUBSYSTEM=video4linux\0MAJOR=81\0MINOR=2\0DEVNAME=video2\0SEQNUM=4242\0");
+	if (!InjectUevent(monitor, add, true) || lastAction != HotplugAction::HOTPLUG_ACTION_ADD || lastDevicePath != "/dev/video2") {
+		DEBUG_LOG("Add event mismatch: " << lastDevicePath.c_str());
+		return false;
+	}
+	// 移除（缺少DEVNAME时由DEVPATH推导）
+	auto remove = MakeUevent("remove@/devices/virtual/video4linux/video7\0ACTION=remove\0DEVPATH=/devices/virtual/video4linux/video7\0"
+							 "SUBSYSTEM=video4linux\0");
+	if (!InjectUevent(monitor, remove, true) || lastAction != HotplugAction::HOTPLUG_ACTION_REMOVE || lastDevicePath != "/dev/video7") {
+		DEBUG_LOG("Remove event mismatch: " << lastDevicePath.c_str());
+		return false;
+	}
+	// 其它子系统、其它动作及畸形消息均应被忽略
+	auto usb = MakeUevent("add@/devices/pci0000:00/usb1/1-1\0ACTION=add\0SUBSYSTEM=usb\0DEVNAME=bus/usb/001/002\0");
+	auto change = MakeUevent("change@/devices/virtual/video4linux/video0\0ACTION=change\0SUBSYSTEM=video4linux\0DEVNAME=video0\0");
+	auto libudev = MakeUevent("libudev\0\xfe\xed\xca\xfe");
+	if (!InjectUevent(monitor, usb, false) || !InjectUevent(monitor, change, false) || !InjectUevent(monitor, libudev, false) ||
+		!InjectUevent(monitor, std::string(), false)) {
+		return false;
+	}
+	if (eventCount != 2) {
+		DEBUG_LOG("Unexpected event count: " << eventCount);
+		return false;
+	}
+
+	// 订阅udev广播时，先于udev处理到达的内核消息被忽略，udev转发（设备节点已可访问）后才通知接入
+	eventCount = 0;
+	if (!monitor.SetListener(
+			[&](HotplugAction action, const std::string& devicePath) {
+				lastAction = action;
+				lastDevicePath = devicePath;
+				eventCount++;
+			},
+			Becamv4l2UeventSource::UDEV)) {
+		DEBUG_LOG("Failed to set hotplug listener.");
+		return false;
+	}
+	auto properties = MakeUevent("ACTION=add\0DEVPATH=/devices/pci0000:00/0000:00:14.0/usb1/1-1/1-1:1.0/video4linux/video2\0"
+								 "SUBSYSTEM=video4linux\0DEVNAME=/dev/video2\0SEQNUM=4242\0USEC_INITIALIZED=123456\0");
+	auto udevAdd = MakeUdevMessage(properties);
+	if (!InjectUevent(monitor, add, false) || eventCount != 0) {
+		DEBUG_LOG("Kernel event dispatched before udev processed it");
+		return false;
+	}
+	if (!InjectUevent(monitor, udevAdd, true) || lastAction != HotplugAction::HOTPLUG_ACTION_ADD || lastDevicePath != "/dev/video2") {
+		DEBUG_LOG("Udev add event mismatch: " << lastDevicePath.c_str());
+		return false;
+	}
+	auto udevRemove = MakeUdevMessage(MakeUevent("ACTION=remove\0DEVPATH=/devices/virtual/video4linux/video7\0SUBSYSTEM=video4linux\0"));
+	if (!InjectUevent(monitor, udevRemove, true) || lastAction != HotplugAction::HOTPLUG_ACTION_REMOVE ||
+		lastDevicePath != "/dev/video7") {
+		DEBUG_LOG("Udev remove event mismatch: " << lastDevicePath.c_str());
+		return false;
+	}
+	// 截断、魔数错误及属性越界的udev消息均应被忽略
+	auto truncated = udevAdd.substr(0, sizeof(Becamv4l2UdevMessageHeader) - 1);
+	auto badMagic = udevAdd;
+	badMagic[8] ^= 0x01;
+	auto overflow = udevAdd;
+	Becamv4l2UdevMessageHeader header;
+	memcpy(&header, overflow.data(), sizeof(header));
+	header.propertiesLength++;
+	memcpy(&overflow[0], &header, sizeof(header));
+	if (!InjectUevent(monitor, truncated, false) || !InjectUevent(monitor, badMagic, false) || !InjectUevent(monitor, overflow, false)) {
+		return false;
+	}
+	if (eventCount != 2) {
+		DEBUG_LOG("Unexpected udev event count: " << eventCount);
+		return false;
+	}
+
+	// 监听线程运行期间不允许只设置监听函数
+	if (monitor.Start([](HotplugAction, const std::string&) {}) == StatusCode::STATUS_CODE_SUCCESS) {
+		if (monitor.SetListener([](HotplugAction, const std::string&) {})) {
+			DEBUG_LOG("SetListener should fail while the monitor is running");
+			return false;
+		}
+		monitor.Stop();
+	}
+	return true;
+}
+#endif
+
+/**
+ * @brief 公开接口的热插拔回调
+ */
+static void OnHotplug(const HotplugEvent* event, void* userData) {
+	std::cout << "Hotplug: " << (event->action == HotplugAction::HOTPLUG_ACTION_ADD ? "add " : "remove ") << event->devicePath << std::endl;
+}
+
+int main() {
+#if defined(__linux__)
+	// 使用模拟uevent验证解析与分发
+	if (!TestSyntheticUevents()) {
+		return 1;
+	}
+	std::cout << "Synthetic uevents passed." << std::endl;
+#endif
+
+	// 通过公开接口监听真实设备插拔
+	auto handle = BecamNew();
+	if (handle == nullptr) {
+		DEBUG_LOG("Failed to initialize handle.");
+		return 1;
+	}
+	auto res = BecamSetHotplugCallback(handle, OnHotplug, nullptr);
+	if (res == StatusCode::STATUS_CODE_ERR_NOT_SUPPORTED) {
+		// 当前平台暂不支持热插拔通知
+		std::cout << "Hotplug callback is not supported on this platform." << std::endl;
+		BecamFree(&handle);
+		return 0;
+	}
+	if (res != StatusCode::STATUS_CODE_SUCCESS) {
+		DEBUG_LOG("Failed to set hotplug callback. errno: " << res);
+		BecamFree(&handle);
+		return 1;
+	}
+	std::cout << "Listening for hotplug events for 5 seconds..." << std::endl;
+	std::this_thread::sleep_for(std::chrono::seconds(5));
+	BecamSetHotplugCallback(handle, nullptr, nullptr);
+	BecamFree(&handle);
+	return 0;
+}
@@ -0,0 +1,116 @@
+#include <becam/becam.h>
+#include <pkg/LogOutput.hpp>
+#include <chrono>
+#include <pkg/LumaHistogram.hpp>
+#include <stdlib.h>
+#include <vector>
+
+/**
+ * @brief 逐个采样计算直方图（对照结果）
+ */
+static void ReferenceHistogram(const std::vector<uint8_t>& frame, const uint32_t offset, const uint32_t pitch, const uint32_t width,
+							   const uint32_t height, const uint32_t bytesPerLine, const uint32_t step, LumaHistogram& histogram) {
+	memset(&histogram, 0, sizeof(histogram));
+	for (uint32_t y = 0; y < height; y += step) {
+		for (uint32_t x = 0; x < width; x += step) {
+			auto value = frame[size_t(y) * bytesPerLine + offset + size_t(x) * pitch];
+			histogram.bins[value]++;
+			histogram.sum += value;
+			histogram.sampleCount++;
+		}
+	}
+}
+
+int main() {
+	// 参与对比的指令集级别（不支持的级别会退化为标量实现）
+	std::vector<SimdLevel> levels = {SimdLevel::SCALAR, SimdLevel::SSE2, SimdLevel::AVX2, SimdLevel::NEON};
+	std::cout << "Detected SIMD level: " << int(GetSimdLevel()) << std::endl;
+
+	// 对比各实现的抽取结果（覆盖向量化的整块及标量收尾）
+	std::vector<uint8_t> src(4096 * 6 + 64);
+	for (auto& value : src) {
+		value = uint8_t(rand());
+	}
+	for (size_t step : {1, 2, 4, 6}) {
+		for (size_t count : {1, 15, 16, 17, 33, 100, 1000, 4096}) {
+			std::vector<uint8_t> expected(count);
+			auto expectedSum = ExtractLumaScalar(src.data() + 1, step, count, expected.data());
+			for (auto level : levels) {
+				std::vector<uint8_t> actual(count);
+				auto sum = ExtractLuma(src.data() + 1, step, count, actual.data(), level);
+				if (sum != expectedSum || actual != expected) {
+					DEBUG_LOG("ExtractLuma mismatch, level: " << int(level) << ", step: " << step << ", count: " << count);
+					return 1;
+				}
+			}
+		}
+	}
+
+	// 对比不同格式、行间距及采样步长下的直方图
+	struct Case {
+		uint32_t format;
+		uint32_t width;
+		uint32_t height;
+		uint32_t padding;
+	};
+	std::vector<Case> cases = {
+		{BECAM_FOURCC('Y', 'U', 'Y', 'V'), 640, 480, 0},
+		{BECAM_FOURCC('U', 'Y', 'V', 'Y'), 638, 17, 12},
+		{BECAM_FOURCC('N', 'V', '1', '2'), 1279, 9, 1},
+		{BECAM_FOURCC('G', 'R', 'E', 'Y'), 31, 31, 0},
+		// 自动曝光默认配置（1080p YUYV）
+		{BECAM_FOURCC('Y', 'U', 'Y', 'V'), 1920, 1080, 0},
+	};
+	// 各级别复用同一份临时缓冲，检查复用时结果不受上次统计影响
+	LumaHistogramScratch scratch;
+	for (auto& item : cases) {
+		uint32_t offset = 0;
+		uint32_t pitch = 0;
+		GetLumaLayout(item.format, offset, pitch);
+		auto bytesPerLine = item.width * pitch + item.padding;
+		// 最后一行不含行尾填充，检查不会越界读取
+		std::vector<uint8_t> frame(size_t(bytesPerLine) * item.height - item.padding);
+		for (auto& value : frame) {
+			value = uint8_t(rand());
+		}
+		for (uint32_t step : {1, 2, 3, 4}) {
+			LumaHistogram expected;
+			ReferenceHistogram(frame, offset, pitch, item.width, item.height, bytesPerLine, step, expected);
+			for (auto level : levels) {
+				LumaHistogram actual;
+				if (!ComputeLumaHistogram(frame.data(), frame.size(), item.format, item.width, item.height, bytesPerLine, step, actual,
+										  scratch, level) ||
+					memcmp(&expected, &actual, sizeof(expected)) != 0) {
+					DEBUG_LOG("ComputeLumaHistogram mismatch, format: " << item.format << ", step: " << step << ", level: " << int(level));
+					return 1;
+				}
+			}
+		}
+	}
+
+	// 默认配置下各级别的耗时（YUYV按步长4采样时字节间距为8，需按像素间距抽取后再隔列取样）
+	std::vector<uint8_t> frame(1920 * 2 * 1080);
+	for (auto& value : frame) {
+		value = uint8_t(rand());
+	}
+	for (auto level : {SimdLevel::SCALAR, GetSimdLevel()}) {
+		const int rounds = 200;
+		LumaHistogram result;
+		auto start = std::chrono::steady_clock::now();
+		for (int i = 0; i < rounds; i++) {
+			ComputeLumaHistogram(frame.data(), frame.size(), BECAM_FOURCC('Y', 'U', 'Y', 'V'), 1920, 1080, 0, 4, result, scratch, level);
+		}
+		auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+		std::cout << "1080p YUYV step 4, level " << int(level) << ": " << elapsed / rounds << " us/frame" << std::endl;
+	}
+
+	// 压缩格式不支持
+	LumaHistogram histogram;
+	if (ComputeLumaHistogram(src.data(), src.size(), BECAM_FOURCC('M', 'J', 'P', 'G'), 64, 64, 0, 1, histogram)) {
+		DEBUG_LOG("ComputeLumaHistogram should reject MJPG");
+		return 1;
+	}
+
+	std::cout << "Luma histogram test passed." << std::endl;
+	return 0;
+}
@@ -0,0 +1,127 @@
+#include "becam_test_fixture.hpp"
+#include <becam/becam.h>
+#include <chrono>
+#include <pkg/LogOutput.hpp>
+#include <pkg/MjpegDecodePipeline.hpp>
+#include <stdlib.h>
+#include <vector>
+
+#if defined(BECAM_WITH_JPEG)
+/**
+ * @brief 模拟取帧线程：每次提交一帧，补满在途窗口后按顺序取出，返回每帧平均耗时（微秒）
+ */
+static int64_t RunPipeline(const std::vector<std::vector<uint8_t>>& frames, const uint32_t frameCount, const uint32_t threadCount,
+						   DecodePipelineState& state) {
+	auto pipeline = CreateMjpegDecodePipeline(threadCount, 0);
+	auto begin = std::chrono::steady_clock::now();
+	uint32_t submitted = 0;
+	uint32_t received = 0;
+	while (received < frameCount) {
+		do {
+			if (submitted < frameCount) {
+				VideoFrameMeta meta = {0};
+				meta.sequence = submitted;
+				auto& frame = frames[submitted % frames.size()];
+				SubmitMjpegPipelineFrame(pipeline, frame.data(), frame.size(), BECAM_FORMAT_RGB24, 1, meta);
+				submitted++;
+			}
+		} while (submitted < frameCount && GetMjpegPipelineInFlight(pipeline) < pipeline->maxInFlight);
+		uint8_t* reply = nullptr;
+		size_t replySize = 0;
+		VideoFrameMeta meta = {0};
+		auto code = ReceiveMjpegPipelineFrame(pipeline, reply, replySize, meta);
+		delete[] reply;
+		if (code != StatusCode::STATUS_CODE_SUCCESS || meta.sequence != received) {
+			DEBUG_LOG("Pipeline output out of order, expected: " << received << ", got: " << meta.sequence);
+			DestroyMjpegDecodePipeline(pipeline);
+			return -1;
+		}
+		received++;
+	}
+	auto cost = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - begin).count();
+	GetMjpegPipelineState(pipeline, state);
+	DestroyMjpegDecodePipeline(pipeline);
+	return cost / frameCount;
+}
+#endif
+
+int main() {
+#if defined(BECAM_WITH_JPEG)
+	// 不同尺寸的视频帧按提交顺序输出（每帧宽高不同，小帧可能先解码完成）
+	{
+		std::vector<std::vector<uint8_t>> frames;
+		for (uint32_t i = 0; i < 12; i++) {
+			frames.push_back(EncodeTestFrame(i % 3 == 0 ? 640 : 64 + i * 8, 48));
+		}
+		auto pipeline = CreateMjpegDecodePipeline(4, 6);
+		for (uint32_t i = 0; i < frames.size(); i++) {
+			VideoFrameMeta meta = {0};
+			meta.sequence = i;
+			SubmitMjpegPipelineFrame(pipeline, frames[i].data(), frames[i].size(), BECAM_FORMAT_RGB24, 2, meta);
+		}
+		// 损坏的帧同样按顺序输出失败状态
+		std::vector<uint8_t> garbage(128, 0x5A);
+		VideoFrameMeta garbageMeta = {0};
+		garbageMeta.sequence = uint32_t(frames.size());
+		SubmitMjpegPipelineFrame(pipeline, garbage.data(), garbage.size(), BECAM_FORMAT_RGB24, 2, garbageMeta);
+		for (uint32_t i = 0; i <= frames.size(); i++) {
+			uint8_t* reply = nullptr;
+			size_t replySize = 0;
+			VideoFrameMeta meta = {0};
+			auto code = ReceiveMjpegPipelineFrame(pipeline, reply, replySize, meta);
+			delete[] reply;
+			auto expectedWidth = i % 3 == 0 ? 320u : (64 + i * 8) / 2;
+			auto ok = i < frames.size() ? code == StatusCode::STATUS_CODE_SUCCESS && meta.width == expectedWidth && meta.height == 24 &&
+											  replySize == size_t(expectedWidth) * 24 * 3
+										: code == StatusCode::STATUS_CODE_ERR_DECODE_FAILED && reply == nullptr;
+			if (!ok || meta.sequence != i) {
+				DEBUG_LOG("Pipeline frame mismatch, index: " << i << ", sequence: " << meta.sequence << ", width: " << meta.width);
+				DestroyMjpegDecodePipeline(pipeline);
+				return 1;
+			}
+		}
+		uint8_t* reply = nullptr;
+		size_t replySize = 0;
+		VideoFrameMeta meta = {0};
+		if (ReceiveMjpegPipelineFrame(pipeline, reply, replySize, meta) != StatusCode::STATUS_CODE_ERR_GET_FRAME_EMPTY) {
+			DEBUG_LOG("Empty pipeline should report no frame");
+			return 1;
+		}
+		// 销毁时丢弃在途的视频帧
+		for (uint32_t i = 0; i < 3; i++) {
+			SubmitMjpegPipelineFrame(pipeline, frames[0].data(), frames[0].size(), BECAM_FORMAT_RGB24, 1, meta);
+		}
+		DestroyMjpegDecodePipeline(pipeline);
+	}
+
+	// 4K吞吐量及额外延迟随线程数的变化
+	{
+		std::vector<std::vector<uint8_t>> frames = {EncodeTestFrame(3840, 2160), EncodeTestFrame(3840, 2160)};
+		const uint32_t frameCount = 24;
+		auto cores = std::max(1u, std::thread::hardware_concurrency());
+		std::vector<uint32_t> threadCounts = {1, 2, 4};
+		if (cores > 4) {
+			threadCounts.push_back(cores);
+		}
+		int64_t serialCost = 0;
+		for (auto threadCount : threadCounts) {
+			DecodePipelineState state = {0};
+			auto cost = RunPipeline(frames, frameCount, threadCount, state);
+			if (cost < 0) {
+				return 1;
+			}
+			if (threadCount == 1) {
+				serialCost = cost;
+			}
+			std::cout << "4K MJPEG -> RGB24, threads: " << threadCount << ", window: " << state.maxInFlight << ", cost per frame: " << cost
+					  << "us, fps: " << (cost > 0 ? 1000000 / cost : 0) << ", speedup: " << (cost > 0 ? double(serialCost) / cost : 0)
+					  << ", average latency: " << state.averageLatency << "us, max latency: " << state.maxLatency << "us" << std::endl;
+		}
+	}
+#else
+	std::cout << "MJPEG decoding disabled." << std::endl;
+#endif
+
+	std::cout << "MJPEG pipeline test passed." << std::endl;
+	return 0;
+}
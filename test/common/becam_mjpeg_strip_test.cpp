@@ -0,0 +1,156 @@
+#include "becam_test_fixture.hpp"
+#include <becam/becam.h>
+#include <chrono>
+#include <fstream>
+#include <iterator>
+#include <pkg/LogOutput.hpp>
+#include <pkg/MjpegDecoder.hpp>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+
+#if defined(BECAM_WITH_JPEG)
+/**
+ * @brief 解码一帧到紧凑排列的缓冲区
+ */
+static StatusCode Decode(MjpegDecoder* decoder, const std::vector<uint8_t>& frame, const uint32_t scale, const uint32_t format,
+						 std::vector<uint8_t>& data) {
+	ImageBuffer image = {0};
+	image.format = format;
+	auto code = StartMjpegDecode(decoder, frame.data(), frame.size(), scale, format, image.width, image.height);
+	if (code != StatusCode::STATUS_CODE_SUCCESS) {
+		return code;
+	}
+	data.assign(GetImageSize(format, image.width, image.height), 0);
+	FillImageBuffer(image, data.data(), data.size(), 0);
+	return FinishMjpegDecode(decoder, image);
+}
+
+/**
+ * @brief 测量平均解码耗时（微秒）
+ */
+static int64_t MeasureDecode(MjpegDecoder* decoder, const std::vector<uint8_t>& frame, const int rounds) {
+	std::vector<uint8_t> data;
+	Decode(decoder, frame, 1, BECAM_FORMAT_RGB24, data);
+	auto begin = std::chrono::steady_clock::now();
+	for (int i = 0; i < rounds; i++) {
+		Decode(decoder, frame, 1, BECAM_FORMAT_RGB24, data);
+	}
+	return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - begin).count() / rounds;
+}
+#endif
+
+int main(int argc, char** argv) {
+#if defined(BECAM_WITH_JPEG)
+	auto serial = CreateMjpegDecoder();
+	auto parallel = CreateMjpegDecoder();
+	SetMjpegDecoderThreads(parallel, 4);
+
+	// 分条解码结果与串行解码一致（覆盖4:2:2、4:2:0、重启间隔不按MCU行对齐及无重启标记的帧）
+	{
+		struct Case {
+			uint32_t width;
+			uint32_t height;
+			int verticalSampling;
+			int restartInRows;
+			unsigned int restartInterval;
+			bool splittable;
+		};
+		std::vector<Case> cases = {{640, 480, 1, 1, 0, true},  {640, 480, 2, 1, 0, true},  {100, 75, 1, 1, 0, true}, {100, 75, 2, 1, 0, true},
+								   {320, 240, 1, 0, 7, true},  {320, 240, 2, 0, 13, true}, {320, 240, 2, 2, 0, true}, {320, 240, 1, 0, 0, false},
+								   {320, 240, 1, 0, 800, false}};
+		for (auto& item : cases) {
+			auto frame = EncodeTestFrame(item.width, item.height, item.verticalSampling, item.restartInRows, item.restartInterval);
+			JpegRestartLayout layout;
+			auto splittable = ParseJpegRestartLayout(frame.data(), frame.size(), layout) && GetJpegStripRowStep(layout) < layout.mcuRows;
+			if (splittable != item.splittable) {
+				DEBUG_LOG("Restart layout mismatch, width: " << item.width << ", interval: " << item.restartInterval);
+				return 1;
+			}
+			// 每个用例使用新的并行解码器，确认可切分的帧确实走了分条解码
+			DestroyMjpegDecoder(parallel);
+			parallel = CreateMjpegDecoder();
+			SetMjpegDecoderThreads(parallel, 4);
+			for (uint32_t scale : {1, 2, 4, 8}) {
+				for (auto format : {BECAM_FORMAT_RGB24, BECAM_FORMAT_BGRA32, BECAM_FOURCC('G', 'R', 'E', 'Y')}) {
+					std::vector<uint8_t> expected;
+					std::vector<uint8_t> actual;
+					auto code = Decode(serial, frame, scale, format, expected);
+					if (code == StatusCode::STATUS_CODE_ERR_NOT_SUPPORTED) {
+						continue;
+					}
+					if (code != StatusCode::STATUS_CODE_SUCCESS || Decode(parallel, frame, scale, format, actual) != StatusCode::STATUS_CODE_SUCCESS ||
+						expected != actual) {
+						DEBUG_LOG("Strip decode mismatch, width: " << item.width << ", height: " << item.height << ", sampling: " << item.verticalSampling
+																   << ", interval: " << item.restartInterval << ", scale: " << scale);
+						return 1;
+					}
+				}
+			}
+			if (parallel->stripDecoders.empty() == item.splittable) {
+				DEBUG_LOG("Strip decode path mismatch, width: " << item.width << ", interval: " << item.restartInterval);
+				return 1;
+			}
+		}
+		// 损坏的分条返回解码失败，之后仍可继续解码
+		auto frame = EncodeTestFrame(320, 240, 1, 1, 0);
+		auto broken = frame;
+		JpegRestartLayout layout;
+		ParseJpegRestartLayout(frame.data(), frame.size(), layout);
+		broken.resize(layout.intervalStarts[layout.intervalStarts.size() / 2] + 8);
+		std::vector<uint8_t> data;
+		Decode(parallel, broken, 1, BECAM_FORMAT_RGB24, data);
+		if (Decode(parallel, frame, 1, BECAM_FORMAT_RGB24, data) != StatusCode::STATUS_CODE_SUCCESS) {
+			DEBUG_LOG("Decoder should recover after broken frame");
+			return 1;
+		}
+	}
+
+	// 单帧延迟：串行解码与分条解码对比（可通过命令行传入录制的摄像头帧）
+	{
+		std::vector<std::string> names;
+		std::vector<std::vector<uint8_t>> frames;
+		for (int i = 1; i < argc; i++) {
+			std::ifstream file(argv[i], std::ios::binary);
+			frames.emplace_back(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+			names.push_back(argv[i]);
+		}
+		if (frames.empty()) {
+			frames.push_back(EncodeTestFrame(1920, 1080, 1, 1, 0));
+			names.push_back("synthetic 1080p 4:2:2 RST/row");
+			frames.push_back(EncodeTestFrame(3840, 2160, 1, 1, 0));
+			names.push_back("synthetic 4K 4:2:2 RST/row");
+			frames.push_back(EncodeTestFrame(3840, 2160, 2, 1, 0));
+			names.push_back("synthetic 4K 4:2:0 RST/row");
+		}
+		auto cores = std::max(1u, std::thread::hardware_concurrency());
+		std::vector<uint32_t> threadCounts = {2, 4};
+		if (cores > 4) {
+			threadCounts.push_back(cores);
+		}
+		for (size_t i = 0; i < frames.size(); i++) {
+			JpegRestartLayout layout;
+			auto splittable = ParseJpegRestartLayout(frames[i].data(), frames[i].size(), layout);
+			auto serialCost = MeasureDecode(serial, frames[i], 5);
+			std::cout << names[i] << " (" << (splittable ? "restart interval " + std::to_string(layout.restartInterval) : std::string("no restart"))
+					  << "), serial: " << serialCost << "us" << std::endl;
+			for (auto threadCount : threadCounts) {
+				SetMjpegDecoderThreads(parallel, threadCount);
+				auto cost = MeasureDecode(parallel, frames[i], 5);
+				std::cout << "    strips: " << threadCount << ", latency: " << cost << "us, speedup: " << (cost > 0 ? double(serialCost) / cost : 0)
+						  << std::endl;
+			}
+		}
+	}
+
+	DestroyMjpegDecoder(serial);
+	DestroyMjpegDecoder(parallel);
+#else
+	(void)argc;
+	(void)argv;
+	std::cout << "MJPEG decoding disabled." << std::endl;
+#endif
+
+	std::cout << "MJPEG strip test passed." << std::endl;
+	return 0;
+}
@@ -0,0 +1,217 @@
+#include "becam_test_fixture.hpp"
+#include <becam/becam.h>
+#include <chrono>
+#include <pkg/LogOutput.hpp>
+#include <pkg/MjpegDecoder.hpp>
+#include <stdlib.h>
+#include <vector>
+
+#if defined(BECAM_WITH_JPEG)
+/**
+ * @brief 去掉帧头中的霍夫曼表（模拟UVC设备输出的MJPEG帧）
+ */
+static std::vector<uint8_t> StripHuffmanTables(const std::vector<uint8_t>& frame) {
+	std::vector<uint8_t> result(frame.begin(), frame.begin() + 2);
+	size_t pos = 2;
+	while (pos + 4 <= frame.size()) {
+		auto marker = frame[pos + 1];
+		if (marker == 0xDA) {
+			break;
+		}
+		auto length = size_t(2 + ((frame[pos + 2] << 8) | frame[pos + 3]));
+		if (marker != 0xC4) {
+			result.insert(result.end(), frame.begin() + pos, frame.begin() + pos + length);
+		}
+		pos += length;
+	}
+	result.insert(result.end(), frame.begin() + pos, frame.end());
+	return result;
+}
+#endif
+
+int main() {
+	auto decoder = BecamNewMjpegDecoder();
+#if defined(BECAM_WITH_JPEG)
+	if (decoder == nullptr) {
+		DEBUG_LOG("BecamNewMjpegDecoder failed");
+		return 1;
+	}
+
+	// 各缩放比例下的输出尺寸及颜色
+	{
+		auto frame = EncodeTestFrame(100, 60);
+		for (uint32_t scale : {1, 2, 4, 8}) {
+			for (auto format : {BECAM_FORMAT_RGB24, BECAM_FORMAT_BGRA32}) {
+				uint32_t width = 0;
+				uint32_t height = 0;
+				auto code = BecamGetMjpegOutputSize(decoder, frame.data(), frame.size(), scale, &width, &height);
+				if (code != StatusCode::STATUS_CODE_SUCCESS || width != GetMjpegScaledLength(100, scale) || height != GetMjpegScaledLength(60, scale)) {
+					DEBUG_LOG("BecamGetMjpegOutputSize mismatch, scale: " << scale << ", width: " << width << ", height: " << height);
+					return 1;
+				}
+				// 目标图像带行尾填充
+				ImageBuffer image = {0};
+				image.format = format;
+				image.width = width;
+				image.height = height;
+				auto bytesPerLine = GetDefaultImageStride(format, width, 0) + 7;
+				std::vector<uint8_t> data(size_t(bytesPerLine) * height);
+				BecamFillImageBuffer(&image, data.data(), data.size(), bytesPerLine);
+				code = BecamDecodeMjpeg(decoder, frame.data(), frame.size(), scale, &image);
+				if (code == StatusCode::STATUS_CODE_ERR_NOT_SUPPORTED) {
+					continue;
+				}
+				bool bgr = false;
+				uint32_t bpp = 3;
+				GetRgbOrder(format, bgr, bpp);
+				auto left = image.plane[0] + size_t(height / 2) * image.stride[0] + size_t(width / 4) * bpp;
+				auto right = image.plane[0] + size_t(height / 2) * image.stride[0] + size_t(width * 3 / 4) * bpp;
+				auto leftRed = bgr ? left[2] : left[0];
+				auto rightBlue = bgr ? right[0] : right[2];
+				if (code != StatusCode::STATUS_CODE_SUCCESS || leftRed < 180 || rightBlue < 180 || left[1] > 80 || right[1] > 80) {
+					DEBUG_LOG("BecamDecodeMjpeg mismatch, scale: " << scale << ", format: " << format << ", code: " << int(code));
+					return 1;
+				}
+			}
+		}
+	}
+
+	// 参数及损坏数据检查（解码器在出错后仍可继续使用）
+	{
+		auto frame = EncodeTestFrame(64, 32);
+		uint32_t width = 0;
+		uint32_t height = 0;
+		if (BecamGetMjpegOutputSize(decoder, frame.data(), frame.size(), 3, &width, &height) != StatusCode::STATUS_CODE_ERR_INPUT_PARAM) {
+			DEBUG_LOG("Invalid scale should be rejected");
+			return 1;
+		}
+		std::vector<uint8_t> garbage(256);
+		for (auto& value : garbage) {
+			value = uint8_t(rand());
+		}
+		if (BecamGetMjpegOutputSize(decoder, garbage.data(), garbage.size(), 1, &width, &height) != StatusCode::STATUS_CODE_ERR_DECODE_FAILED) {
+			DEBUG_LOG("Garbage data should fail to decode");
+			return 1;
+		}
+		std::vector<uint8_t> data(64 * 32 * 3);
+		ImageBuffer image = {0};
+		image.format = BECAM_FORMAT_RGB24;
+		image.width = 64;
+		image.height = 32;
+		BecamFillImageBuffer(&image, data.data(), data.size(), 0);
+		std::vector<uint8_t> truncated(frame.begin(), frame.begin() + 20);
+		if (BecamDecodeMjpeg(decoder, truncated.data(), truncated.size(), 1, &image) != StatusCode::STATUS_CODE_ERR_DECODE_FAILED) {
+			DEBUG_LOG("Truncated header should fail to decode");
+			return 1;
+		}
+		image.width = 32;
+		if (BecamDecodeMjpeg(decoder, frame.data(), frame.size(), 1, &image) != StatusCode::STATUS_CODE_ERR_INPUT_PARAM) {
+			DEBUG_LOG("Mismatched destination size should be rejected");
+			return 1;
+		}
+		image.width = 64;
+		if (BecamDecodeMjpeg(decoder, frame.data(), frame.size(), 1, &image) != StatusCode::STATUS_CODE_SUCCESS) {
+			DEBUG_LOG("Decoder should recover after errors");
+			return 1;
+		}
+	}
+
+	// 补齐霍夫曼表后的帧可独立解码，且解码结果与原始帧一致
+	{
+		auto frame = EncodeTestFrame(96, 64);
+		auto stripped = StripHuffmanTables(frame);
+		if (stripped.size() >= frame.size() || BecamGetCompleteJpegSize(frame.data(), frame.size()) != frame.size() ||
+			BecamGetCompleteJpegSize(stripped.data(), stripped.size()) != stripped.size() + sizeof(JPEG_STANDARD_HUFFMAN_TABLES)) {
+			DEBUG_LOG("BecamGetCompleteJpegSize mismatch");
+			return 1;
+		}
+		std::vector<uint8_t> complete(BecamGetCompleteJpegSize(stripped.data(), stripped.size()));
+		size_t outSize = 0;
+		if (BecamCopyCompleteJpeg(stripped.data(), stripped.size(), complete.data(), complete.size() - 1, &outSize) !=
+				StatusCode::STATUS_CODE_ERR_INPUT_PARAM ||
+			BecamCopyCompleteJpeg(stripped.data(), stripped.size(), complete.data(), complete.size(), &outSize) != StatusCode::STATUS_CODE_SUCCESS ||
+			outSize != complete.size() || FindJpegHuffmanInsertOffset(complete.data(), complete.size()) != 0) {
+			DEBUG_LOG("BecamCopyCompleteJpeg failed");
+			return 1;
+		}
+		std::vector<uint8_t> copied(frame.size());
+		BecamCopyCompleteJpeg(frame.data(), frame.size(), copied.data(), copied.size(), &outSize);
+		if (outSize != frame.size() || copied != frame) {
+			DEBUG_LOG("Frame with Huffman tables should be copied unchanged");
+			return 1;
+		}
+		std::vector<uint8_t> expected(96 * 64 * 3);
+		std::vector<uint8_t> actual(96 * 64 * 3);
+		ImageBuffer image = {0};
+		image.format = BECAM_FORMAT_RGB24;
+		image.width = 96;
+		image.height = 64;
+		BecamFillImageBuffer(&image, expected.data(), expected.size(), 0);
+		auto code = BecamDecodeMjpeg(decoder, frame.data(), frame.size(), 1, &image);
+		BecamFillImageBuffer(&image, actual.data(), actual.size(), 0);
+		if (code != StatusCode::STATUS_CODE_SUCCESS || BecamDecodeMjpeg(decoder, complete.data(), complete.size(), 1, &image) != StatusCode::STATUS_CODE_SUCCESS ||
+			expected != actual) {
+			DEBUG_LOG("Completed frame decode mismatch");
+			return 1;
+		}
+		// 缺少霍夫曼表的帧直接解码时自动补齐标准表
+		if (BecamDecodeMjpeg(decoder, stripped.data(), stripped.size(), 1, &image) != StatusCode::STATUS_CODE_SUCCESS || expected != actual) {
+			DEBUG_LOG("Frame without Huffman tables decode mismatch");
+			return 1;
+		}
+	}
+
+	// 补齐霍夫曼表与直接拷贝的耗时对比
+	{
+		auto stripped = StripHuffmanTables(EncodeTestFrame(1920, 1080));
+		std::vector<uint8_t> dst(stripped.size() + sizeof(JPEG_STANDARD_HUFFMAN_TABLES));
+		const int rounds = 200;
+		auto begin = std::chrono::steady_clock::now();
+		for (int i = 0; i < rounds; i++) {
+			memcpy(dst.data(), stripped.data(), stripped.size());
+		}
+		auto copyCost = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - begin).count() / rounds;
+		size_t outSize = 0;
+		begin = std::chrono::steady_clock::now();
+		for (int i = 0; i < rounds; i++) {
+			BecamCopyCompleteJpeg(stripped.data(), stripped.size(), dst.data(), dst.size(), &outSize);
+		}
+		auto completeCost = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - begin).count() / rounds;
+		std::cout << "1080p MJPEG (" << stripped.size() << " bytes), memcpy: " << copyCost << "ns, insert Huffman tables: " << completeCost << "ns"
+				  << std::endl;
+	}
+
+	// 1080p各缩放比例解码耗时
+	{
+		auto frame = EncodeTestFrame(1920, 1080);
+		std::cout << "1080p MJPEG frame size: " << frame.size() << " bytes" << std::endl;
+		for (uint32_t scale : {1, 2, 4, 8}) {
+			ImageBuffer image = {0};
+			image.format = BECAM_FORMAT_RGB24;
+			image.width = GetMjpegScaledLength(1920, scale);
+			image.height = GetMjpegScaledLength(1080, scale);
+			std::vector<uint8_t> data(BecamGetImageSize(image.format, image.width, image.height));
+			BecamFillImageBuffer(&image, data.data(), data.size(), 0);
+			const int rounds = 10;
+			auto begin = std::chrono::steady_clock::now();
+			for (int i = 0; i < rounds; i++) {
+				BecamDecodeMjpeg(decoder, frame.data(), frame.size(), scale, &image);
+			}
+			auto cost = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - begin).count();
+			std::cout << "MJPEG 1080p -> RGB24 1/" << scale << " (" << image.width << "x" << image.height << "), cost: " << cost / rounds << "us"
+					  << std::endl;
+		}
+	}
+#else
+	// 未编译libjpeg支持时无法创建解码器
+	if (decoder != nullptr || CanDecodeMjpegTo(BECAM_FORMAT_RGB24)) {
+		DEBUG_LOG("MJPEG decoding should be unsupported");
+		return 1;
+	}
+	std::cout << "MJPEG decoding disabled." << std::endl;
+#endif
+	BecamFreeMjpegDecoder(&decoder);
+
+	std::cout << "MJPEG test passed." << std::endl;
+	return 0;
+}
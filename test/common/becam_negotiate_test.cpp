@@ -0,0 +1,221 @@
+#include <becam/becam.h>
+#include <fstream>
+#include <pkg/FrameNegotiate.hpp>
+#include <pkg/LogOutput.hpp>
+
+static const uint32_t FORMAT_MJPG = BECAM_FOURCC('M', 'J', 'P', 'G');
+static const uint32_t FORMAT_YUYV = BECAM_FOURCC('Y', 'U', 'Y', 'V');
+static const uint32_t FORMAT_NV12 = BECAM_FOURCC('N', 'V', '1', '2');
+
+/**
+ * @brief 检查排序结果
+ *
+ * @param list [in] 合成的视频帧信息列表
+ * @param listSize [in] 视频帧信息数量
+ * @param desired [in] 期望的最低视频帧信息
+ * @param policy [in] 协商策略（可为空）
+ * @param expected [in] 期望的排序结果
+ * @param name [in] 用例名称
+ */
+static bool CheckRank(const VideoFrameInfo* list, const size_t listSize, const VideoFrameInfo& desired, const NegotiatePolicy* policy,
+					  const std::vector<VideoFrameInfo>& expected, const char* name) {
+	auto ranked = RankFrameInfoList(list, listSize, desired, policy);
+	bool same = ranked.size() == expected.size();
+	for (size_t i = 0; same && i < ranked.size(); i++) {
+		same = ranked[i].format == expected[i].format && ranked[i].width == expected[i].width && ranked[i].height == expected[i].height &&
+			   ranked[i].fps == expected[i].fps;
+	}
+	if (!same) {
+		DEBUG_LOG(name << " mismatch, ranked: " << ranked.size() << ", expected: " << expected.size());
+		for (auto& item : ranked) {
+			DEBUG_LOG(item.format << " " << item.width << "x" << item.height << "@" << item.fps);
+		}
+	}
+	return same;
+}
+
+/**
+ * @brief 在合成的视频帧信息列表上校验协商排序（不依赖设备）
+ */
+static bool CheckRankFrameInfoList() {
+	VideoFrameInfo list[] = {
+		{FORMAT_YUYV, 640, 480, 30},   {FORMAT_YUYV, 1280, 720, 10}, {FORMAT_YUYV, 1280, 720, 30}, {FORMAT_MJPG, 1280, 720, 30},
+		{FORMAT_MJPG, 1920, 1080, 30}, {FORMAT_YUYV, 1920, 1080, 60}, {FORMAT_NV12, 1280, 720, 30}, {FORMAT_MJPG, 1280, 720, 60},
+	};
+	size_t listSize = sizeof(list) / sizeof(list[0]);
+	uint32_t formatList[] = {FORMAT_MJPG, FORMAT_YUYV};
+
+	// 最低要求过滤分辨率及帧率，未指定策略时只允许期望格式
+	VideoFrameInfo desired = {FORMAT_YUYV, 1280, 720, 30};
+	if (!CheckRank(list, listSize, desired, nullptr, {{FORMAT_YUYV, 1280, 720, 30}, {FORMAT_YUYV, 1920, 1080, 60}}, "Desired format")) {
+		return false;
+	}
+	// 格式列表为空时同样只允许期望格式
+	NegotiatePolicy policy = {0};
+	policy.formatList = formatList;
+	policy.bandwidthWeight = 1;
+	policy.decodeWeight = 1;
+	policy.convertWeight = 1;
+	if (!CheckRank(list, listSize, desired, &policy, {{FORMAT_YUYV, 1280, 720, 30}, {FORMAT_YUYV, 1920, 1080, 60}}, "Empty format list")) {
+		return false;
+	}
+
+	// 期望格式为0时不限制格式：等权重下按带宽加解码开销排序（NV12 12位 < YUYV 16位 < MJPEG 2位+解码16）
+	desired.format = 0;
+	if (!CheckRank(list, listSize, desired, nullptr,
+				   {{FORMAT_NV12, 1280, 720, 30},
+					{FORMAT_YUYV, 1280, 720, 30},
+					{FORMAT_MJPG, 1280, 720, 30},
+					{FORMAT_MJPG, 1280, 720, 60},
+					{FORMAT_MJPG, 1920, 1080, 30},
+					{FORMAT_YUYV, 1920, 1080, 60}},
+				   "Any format")) {
+		return false;
+	}
+
+	// 允许MJPEG和YUYV，下游需要YUYV：过滤NV12，MJPEG另计格式转换开销
+	policy.formatListSize = sizeof(formatList) / sizeof(formatList[0]);
+	policy.outputFormat = FORMAT_YUYV;
+	if (!CheckRank(list, listSize, desired, &policy,
+				   {{FORMAT_YUYV, 1280, 720, 30},
+					{FORMAT_MJPG, 1280, 720, 30},
+					{FORMAT_MJPG, 1280, 720, 60},
+					{FORMAT_MJPG, 1920, 1080, 30},
+					{FORMAT_YUYV, 1920, 1080, 60}},
+				   "Allowed formats")) {
+		return false;
+	}
+
+	// 带宽权重较大时（多个相机共享总线）压缩格式排在前面
+	policy.bandwidthWeight = 10;
+	policy.convertWeight = 0;
+	if (!CheckRank(list, listSize, desired, &policy,
+				   {{FORMAT_MJPG, 1280, 720, 30},
+					{FORMAT_MJPG, 1280, 720, 60},
+					{FORMAT_MJPG, 1920, 1080, 30},
+					{FORMAT_YUYV, 1280, 720, 30},
+					{FORMAT_YUYV, 1920, 1080, 60}},
+				   "Bandwidth weight")) {
+		return false;
+	}
+
+	// 不满足最低要求时结果为空
+	desired = {0, 3840, 2160, 30};
+	if (!CheckRank(list, listSize, desired, nullptr, {}, "Unsatisfiable")) {
+		return false;
+	}
+
+	// 开销相同时像素少的在前（640x720@60与1280x720@30像素吞吐相同）
+	VideoFrameInfo tied[] = {{FORMAT_YUYV, 1280, 720, 30}, {FORMAT_YUYV, 640, 720, 60}};
+	desired = {FORMAT_YUYV, 0, 0, 0};
+	if (!CheckRank(tied, 2, desired, nullptr, {{FORMAT_YUYV, 640, 720, 60}, {FORMAT_YUYV, 1280, 720, 30}}, "Tie by pixels")) {
+		return false;
+	}
+	// 权重全为0时开销都相同：先按像素再按帧率，完全相同的保持原有顺序
+	VideoFrameInfo unweighted[] = {{FORMAT_YUYV, 1920, 1080, 30}, {FORMAT_MJPG, 1280, 720, 60}, {FORMAT_MJPG, 1280, 720, 30},
+							 {FORMAT_YUYV, 1280, 720, 30},	{FORMAT_YUYV, 640, 480, 30}};
+	NegotiatePolicy zero = {0};
+	if (!CheckRank(unweighted, sizeof(unweighted) / sizeof(unweighted[0]), {0, 0, 0, 0}, &zero,
+				   {{FORMAT_YUYV, 640, 480, 30},
+					{FORMAT_MJPG, 1280, 720, 30},
+					{FORMAT_YUYV, 1280, 720, 30},
+					{FORMAT_MJPG, 1280, 720, 60},
+					{FORMAT_YUYV, 1920, 1080, 30}},
+				   "Tie by fps and order")) {
+		return false;
+	}
+	return true;
+}
+
+int main() {
+	// 不依赖设备的排序校验
+	if (!CheckRankFrameInfoList()) {
+		return 1;
+	}
+	std::cout << "Rank frame info list test passed." << std::endl;
+
+	// 初始化句柄
+	auto handle = BecamNew();
+	if (handle == nullptr) {
+		DEBUG_LOG("Failed to initialize handle.");
+		return 1;
+	}
+
+	// 声明返回值
+	GetDeviceListReply reply;
+	// 获取设备列表
+	auto res = BecamGetDeviceList(handle, &reply);
+	if (res != StatusCode::STATUS_CODE_SUCCESS) {
+		DEBUG_LOG("Failed to get device list. errno: " << res);
+		BecamFree(&handle);
+		return 1;
+	}
+	if (reply.deviceInfoListSize == 0) {
+		DEBUG_LOG("No device found.");
+		BecamFreeDeviceList(&reply);
+		BecamFree(&handle);
+		return 0;
+	}
+
+	// 选中第一个设备
+	std::string devicePath = reply.deviceInfoList[0].devicePath;
+	// 释放设备列表
+	BecamFreeDeviceList(&reply);
+
+	// 期望至少1280x720@30，允许MJPEG和YUYV，下游需要YUYV
+	VideoFrameInfo desired = {0};
+	desired.width = 1280;
+	desired.height = 720;
+	desired.fps = 30;
+	uint32_t formatList[] = {BECAM_FOURCC('M', 'J', 'P', 'G'), BECAM_FOURCC('Y', 'U', 'Y', 'V')};
+	NegotiatePolicy policy = {0};
+	policy.formatList = formatList;
+	policy.formatListSize = sizeof(formatList) / sizeof(formatList[0]);
+	policy.outputFormat = BECAM_FOURCC('Y', 'U', 'Y', 'V');
+	policy.bandwidthWeight = 1;
+	policy.decodeWeight = 1;
+	policy.convertWeight = 1;
+
+	// 协商视频帧信息
+	VideoFrameInfo frameInfo = {0};
+	res = BecamNegotiate(handle, devicePath.c_str(), &desired, &policy, &frameInfo);
+	if (res != StatusCode::STATUS_CODE_SUCCESS) {
+		DEBUG_LOG("Failed to negotiate. errno: " << res);
+		BecamFree(&handle);
+		return 1;
+	}
+
+	// 当前选中的设别路径和帧信息
+	std::cout << "\n\nSelected device path: " << devicePath << std::endl;
+	std::cout << "Negotiated frame info: " << frameInfo.width << "x" << frameInfo.height << ", " << frameInfo.fps << ", " << frameInfo.format
+			  << std::endl;
+
+	// 打开设备
+	res = BecamOpenDevice(handle, devicePath.c_str(), &frameInfo);
+	if (res != StatusCode::STATUS_CODE_SUCCESS) {
+		DEBUG_LOG("Failed to open device. errno: " << res);
+		BecamFree(&handle);
+		return 1;
+	}
+
+	// 取几帧验证
+	for (size_t i = 0; i < 10; i++) {
+		uint8_t* data = nullptr;
+		size_t size = 0;
+		res = BecamGetFrame(handle, &data, &size);
+		if (res != StatusCode::STATUS_CODE_SUCCESS) {
+			std::cout << "Frame empty, Code:" << res << std::endl;
+			continue;
+		}
+		std::cout << "OK, Frame Size: " << size << std::endl;
+		// 释放帧
+		BecamFreeFrame(&data);
+	}
+
+	// 关闭设备
+	BecamCloseDevice(handle);
+	// 释放句柄
+	BecamFree(&handle);
+	// OK
+	return 0;
+}
@@ -0,0 +1,249 @@
+#include "becam_test_fixture.hpp"
+#include <becam/becam.h>
+#include <chrono>
+#include <pkg/ImageResize.hpp>
+#include <pkg/ImageTensor.hpp>
+#include <pkg/LogOutput.hpp>
+#include <pkg/WorkerPool.hpp>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+
+/**
+ * @brief 生成信箱模式的张量配置
+ */
+static TensorConfig MakeConfig(const uint32_t width, const uint32_t height, const TensorLayout layout, const TensorDataType dataType) {
+	TensorConfig config = {0};
+	config.width = width;
+	config.height = height;
+	config.layout = layout;
+	config.dataType = dataType;
+	config.channelOrder = TensorChannelOrder::TENSOR_CHANNEL_RGB;
+	config.resizeMode = TensorResizeMode::TENSOR_RESIZE_LETTERBOX;
+	for (int i = 0; i < 3; i++) {
+		config.mean[i] = 127.5f;
+		config.std[i] = 127.5f;
+		config.padValue[i] = 114.0f;
+	}
+	return config;
+}
+
+/**
+ * @brief 测量平均耗时（微秒）
+ */
+static int64_t Measure(const std::function<void()>& task, const int rounds) {
+	task();
+	auto begin = std::chrono::steady_clock::now();
+	for (int i = 0; i < rounds; i++) {
+		task();
+	}
+	return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - begin).count() / rounds;
+}
+
+int main() {
+	// 行带数多于线程数时由线程动态领取
+	auto pool = CreateWorkerPool(4);
+	std::vector<uint32_t> bandRowsList = {0, 1, 2, 3, 7, 64};
+
+	// 行带恰好覆盖全部行一次，起始行按对齐值对齐
+	{
+		for (uint32_t rows : {1u, 2u, 15u, 16u, 17u, 33u, 100u, 1081u}) {
+			for (uint32_t align : {1u, 2u}) {
+				for (auto bandRows : bandRowsList) {
+					std::vector<uint32_t> hits(rows, 0);
+					bool aligned = true;
+					std::mutex mtx;
+					RowBandPolicy policy = {pool, bandRows};
+					RunRowBands(policy, rows, align, [&](uint32_t begin, uint32_t end) {
+						std::unique_lock<std::mutex> lock(mtx);
+						aligned = aligned && begin % align == 0 && begin < end;
+						for (auto y = begin; y < end; y++) {
+							hits[y]++;
+						}
+					});
+					for (auto hit : hits) {
+						aligned = aligned && hit == 1;
+					}
+					if (!aligned) {
+						DEBUG_LOG("Row band split mismatch, rows: " << rows << ", align: " << align << ", band rows: " << bandRows);
+						return 1;
+					}
+				}
+			}
+		}
+	}
+
+	// 按行带并行转换与串行结果逐字节一致（含奇数宽高及行尾填充）
+	{
+		struct Pair {
+			uint32_t src;
+			uint32_t dst;
+		};
+		std::vector<Pair> pairs = {
+			{BECAM_FORMAT_YUYV, BECAM_FORMAT_RGB24}, {BECAM_FORMAT_UYVY, BECAM_FORMAT_BGRA32}, {BECAM_FORMAT_YUYV, BECAM_FORMAT_NV12},
+			{BECAM_FORMAT_NV12, BECAM_FORMAT_I420},	 {BECAM_FORMAT_I420, BECAM_FORMAT_YUYV},   {BECAM_FORMAT_NV21, BECAM_FOURCC('G', 'R', 'E', 'Y')},
+			{BECAM_FORMAT_YUYV, BECAM_FORMAT_YUYV},
+		};
+		std::vector<std::pair<uint32_t, uint32_t>> sizes = {{64, 48}, {37, 23}, {33, 17}, {640, 361}};
+		for (auto& pair : pairs) {
+			for (auto& size : sizes) {
+				std::vector<uint8_t> srcData;
+				ImageBuffer src;
+				MakeImage(pair.src, size.first, size.second, 3, srcData, src);
+				std::vector<uint8_t> expectedData;
+				ImageBuffer expected;
+				MakeImage(pair.dst, size.first, size.second, 0, expectedData, expected);
+				if (ConvertImage(src, expected) != StatusCode::STATUS_CODE_SUCCESS) {
+					DEBUG_LOG("ConvertImage failed, src: " << pair.src << ", dst: " << pair.dst);
+					return 1;
+				}
+				for (auto bandRows : bandRowsList) {
+					std::vector<uint8_t> actualData;
+					ImageBuffer actual;
+					MakeImage(pair.dst, size.first, size.second, 0, actualData, actual);
+					RowBandPolicy policy = {pool, bandRows};
+					if (ConvertImage(src, actual, policy) != StatusCode::STATUS_CODE_SUCCESS ||
+						memcmp(actualData.data(), expectedData.data(), GetImageSize(pair.dst, size.first, size.second)) != 0) {
+						DEBUG_LOG("Parallel convert mismatch, src: " << pair.src << ", dst: " << pair.dst << ", size: " << size.first << "x"
+																	 << size.second << ", band rows: " << bandRows);
+						return 1;
+					}
+				}
+			}
+		}
+	}
+
+	// 按行带并行缩放与串行结果逐字节一致（覆盖整数倍快速路径及通用路径）
+	{
+		std::vector<uint32_t> formats = {BECAM_FORMAT_YUYV, BECAM_FORMAT_NV12, BECAM_FORMAT_I420, BECAM_FORMAT_RGB24, BECAM_FOURCC('G', 'R', 'E', 'Y')};
+		struct Size {
+			uint32_t srcWidth;
+			uint32_t srcHeight;
+			uint32_t dstWidth;
+			uint32_t dstHeight;
+		};
+		std::vector<Size> sizes = {{128, 96, 64, 48}, {120, 90, 40, 30}, {101, 67, 37, 23}, {30, 20, 47, 33}, {640, 362, 160, 90}};
+		for (auto format : formats) {
+			for (auto& size : sizes) {
+				for (auto filter : {ResizeFilter::RESIZE_FILTER_BOX, ResizeFilter::RESIZE_FILTER_BILINEAR, ResizeFilter::RESIZE_FILTER_AREA}) {
+					std::vector<uint8_t> srcData;
+					ImageBuffer src;
+					MakeImage(format, size.srcWidth, size.srcHeight, 5, srcData, src);
+					std::vector<uint8_t> expectedData;
+					ImageBuffer expected;
+					MakeImage(format, size.dstWidth, size.dstHeight, 0, expectedData, expected);
+					if (ResizeImage(src, expected, filter) != StatusCode::STATUS_CODE_SUCCESS) {
+						DEBUG_LOG("ResizeImage failed, format: " << format);
+						return 1;
+					}
+					for (auto bandRows : bandRowsList) {
+						std::vector<uint8_t> actualData;
+						ImageBuffer actual;
+						MakeImage(format, size.dstWidth, size.dstHeight, 0, actualData, actual);
+						RowBandPolicy policy = {pool, bandRows};
+						if (ResizeImage(src, actual, filter, policy) != StatusCode::STATUS_CODE_SUCCESS ||
+							memcmp(actualData.data(), expectedData.data(), GetImageSize(format, size.dstWidth, size.dstHeight)) != 0) {
+							DEBUG_LOG("Parallel resize mismatch, format: " << format << ", src: " << size.srcWidth << "x" << size.srcHeight
+																		   << ", dst: " << size.dstWidth << "x" << size.dstHeight
+																		   << ", filter: " << int(filter) << ", band rows: " << bandRows);
+							return 1;
+						}
+					}
+				}
+			}
+		}
+	}
+
+	// 按行带并行生成张量与串行结果逐字节一致
+	{
+		std::vector<uint32_t> formats = {BECAM_FORMAT_YUYV, BECAM_FORMAT_NV12, BECAM_FORMAT_RGB24, BECAM_FOURCC('G', 'R', 'E', 'Y')};
+		for (auto format : formats) {
+			for (auto layout : {TensorLayout::TENSOR_LAYOUT_NCHW, TensorLayout::TENSOR_LAYOUT_NHWC}) {
+				for (auto dataType : {TensorDataType::TENSOR_DATA_FLOAT32, TensorDataType::TENSOR_DATA_FLOAT16}) {
+					std::vector<uint8_t> srcData;
+					ImageBuffer src;
+					MakeImage(format, 320, 181, 2, srcData, src);
+					auto config = MakeConfig(96, 96, layout, dataType);
+					std::vector<uint8_t> expected(GetTensorSize(config));
+					std::vector<uint8_t> actual(expected.size());
+					TensorPlacement placement;
+					if (ImageToTensor(src, config, expected.data(), expected.size(), placement) != StatusCode::STATUS_CODE_SUCCESS) {
+						DEBUG_LOG("ImageToTensor failed, format: " << format);
+						return 1;
+					}
+					for (auto bandRows : bandRowsList) {
+						RowBandPolicy policy = {pool, bandRows};
+						if (ImageToTensor(src, config, actual.data(), actual.size(), placement, policy) != StatusCode::STATUS_CODE_SUCCESS ||
+							actual != expected) {
+							DEBUG_LOG("Parallel tensor mismatch, format: " << format << ", layout: " << int(layout) << ", type: " << int(dataType)
+																		   << ", band rows: " << bandRows);
+							return 1;
+						}
+					}
+				}
+			}
+		}
+	}
+
+	// 接口参数检查（当前平台不支持时跳过）
+	{
+		ParallelPolicy policy = {3, 0};
+		StageTimings timings;
+		if (BecamSetParallelPolicy(nullptr, &policy) != StatusCode::STATUS_CODE_ERR_HANDLE_EMPTY ||
+			BecamGetStageTimings(nullptr, &timings) != StatusCode::STATUS_CODE_ERR_HANDLE_EMPTY) {
+			DEBUG_LOG("Parallel policy handle check failed");
+			return 1;
+		}
+		auto handle = BecamNew();
+		if (handle == nullptr) {
+			DEBUG_LOG("Failed to initialize handle.");
+			return 1;
+		}
+		if (BecamSetParallelPolicy(handle, &policy) == StatusCode::STATUS_CODE_SUCCESS) {
+			auto threadCount = BecamGetStageTimings(handle, &timings) == StatusCode::STATUS_CODE_SUCCESS ? timings.threadCount : 0;
+			BecamSetParallelPolicy(handle, nullptr);
+			auto serialCount = BecamGetStageTimings(handle, &timings) == StatusCode::STATUS_CODE_SUCCESS ? timings.threadCount : 0;
+			if (threadCount != 3 || serialCount != 1 || timings.convert.frameCount != 0 ||
+				BecamGetStageTimings(handle, nullptr) != StatusCode::STATUS_CODE_ERR_INPUT_PARAM) {
+				DEBUG_LOG("Parallel policy check failed, threads: " << threadCount << ", serial: " << serialCount);
+				BecamFree(&handle);
+				return 1;
+			}
+		}
+		BecamFree(&handle);
+	}
+
+	// 4K各阶段在不同并行度下的耗时
+	{
+		std::vector<uint8_t> yuyvData;
+		ImageBuffer yuyv;
+		MakeImage(BECAM_FORMAT_YUYV, 3840, 2160, 0, yuyvData, yuyv);
+		std::vector<uint8_t> nv12Data;
+		ImageBuffer nv12;
+		MakeImage(BECAM_FORMAT_NV12, 3840, 2160, 0, nv12Data, nv12);
+		std::vector<uint8_t> rgbData;
+		ImageBuffer rgb;
+		MakeImage(BECAM_FORMAT_RGB24, 3840, 2160, 0, rgbData, rgb);
+		std::vector<uint8_t> scaledData;
+		ImageBuffer scaled;
+		MakeImage(BECAM_FORMAT_NV12, 1920, 1080, 0, scaledData, scaled);
+		auto config = MakeConfig(640, 640, TensorLayout::TENSOR_LAYOUT_NCHW, TensorDataType::TENSOR_DATA_FLOAT32);
+		std::vector<uint8_t> tensor(GetTensorSize(config));
+		TensorPlacement placement;
+		std::cout << "Hardware concurrency: " << std::thread::hardware_concurrency() << std::endl;
+		for (uint32_t threadCount : {1u, 2u, 4u, 8u}) {
+			auto stagePool = threadCount > 1 ? CreateWorkerPool(threadCount) : nullptr;
+			RowBandPolicy policy = {stagePool, 0};
+			auto convert = Measure([&] { ConvertImage(yuyv, rgb, policy); }, 5);
+			auto resize = Measure([&] { ResizeImage(nv12, scaled, ResizeFilter::RESIZE_FILTER_BILINEAR, policy); }, 5);
+			auto toTensor = Measure([&] { ImageToTensor(nv12, config, tensor.data(), tensor.size(), placement, policy); }, 5);
+			std::cout << "4K threads: " << threadCount << ", YUYV -> RGB24: " << convert << "us, NV12 -> 1080p bilinear: " << resize
+					  << "us, NV12 -> NCHW float32 640x640: " << toTensor << "us" << std::endl;
+			DestroyWorkerPool(stagePool);
+		}
+	}
+
+	DestroyWorkerPool(pool);
+	std::cout << "Parallel test passed." << std::endl;
+	return 0;
+}
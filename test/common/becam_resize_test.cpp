@@ -0,0 +1,291 @@
+#include "becam_test_fixture.hpp"
+#include <becam/becam.h>
+#include <chrono>
+#include <math.h>
+#include <pkg/ImageResize.hpp>
+#include <pkg/LogOutput.hpp>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+
+/**
+ * @brief 将平面中的一个通道提取为紧凑的GREY图像
+ */
+static void ExtractChannel(const ImageBuffer& image, const uint32_t plane, const ResizeChannel& channel, const uint32_t count, const uint32_t rows,
+						   std::vector<uint8_t>& data, ImageBuffer& grey) {
+	grey = {0};
+	grey.format = BECAM_FOURCC('G', 'R', 'E', 'Y');
+	grey.width = count;
+	grey.height = rows;
+	data.resize(size_t(count) * rows);
+	FillImageBuffer(grey, data.data(), data.size(), 0);
+	for (uint32_t y = 0; y < rows; y++) {
+		for (uint32_t x = 0; x < count; x++) {
+			data[size_t(y) * count + x] = image.plane[plane][size_t(y) * image.stride[plane] + channel.offset + size_t(x) * channel.step];
+		}
+	}
+}
+
+/**
+ * @brief 双精度参考实现：对GREY图像按区域平均或双线性插值缩放
+ */
+static double ReferencePixel(const ImageBuffer& src, const uint32_t dstWidth, const uint32_t dstHeight, const uint32_t x, const uint32_t y,
+							 const ResizeFilter filter) {
+	auto scaleX = double(src.width) / dstWidth;
+	auto scaleY = double(src.height) / dstHeight;
+	auto at = [&src](const uint32_t sx, const uint32_t sy) { return double(src.plane[0][size_t(sy) * src.stride[0] + sx]); };
+	if (filter == ResizeFilter::RESIZE_FILTER_BILINEAR) {
+		auto fx = std::min(std::max((x + 0.5) * scaleX - 0.5, 0.0), double(src.width - 1));
+		auto fy = std::min(std::max((y + 0.5) * scaleY - 0.5, 0.0), double(src.height - 1));
+		auto x0 = uint32_t(fx);
+		auto y0 = uint32_t(fy);
+		auto x1 = std::min(x0 + 1, src.width - 1);
+		auto y1 = std::min(y0 + 1, src.height - 1);
+		auto ax = fx - x0;
+		auto ay = fy - y0;
+		return (at(x0, y0) * (1 - ax) + at(x1, y0) * ax) * (1 - ay) + (at(x0, y1) * (1 - ax) + at(x1, y1) * ax) * ay;
+	}
+	double sum = 0;
+	for (uint32_t sy = uint32_t(y * scaleY); sy < src.height && sy < (y + 1) * scaleY; sy++) {
+		auto coverY = std::min(sy + 1.0, (y + 1) * scaleY) - std::max(double(sy), y * scaleY);
+		for (uint32_t sx = uint32_t(x * scaleX); sx < src.width && sx < (x + 1) * scaleX; sx++) {
+			auto coverX = std::min(sx + 1.0, (x + 1) * scaleX) - std::max(double(sx), x * scaleX);
+			sum += at(sx, sy) * coverX * coverY;
+		}
+	}
+	return sum / (scaleX * scaleY);
+}
+
+/**
+ * @brief 测量平均缩放耗时（微秒）
+ */
+static int64_t MeasureResize(const ImageBuffer& src, ImageBuffer& dst, const ResizeFilter filter, const SimdLevel level, const int rounds) {
+	ResizeImage(src, dst, filter, level);
+	auto begin = std::chrono::steady_clock::now();
+	for (int i = 0; i < rounds; i++) {
+		ResizeImage(src, dst, filter, level);
+	}
+	return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - begin).count() / rounds;
+}
+
+int main() {
+	// 参与对比的指令集级别（不支持的级别会退化为标量实现）
+	std::vector<SimdLevel> levels = {SimdLevel::SCALAR, SimdLevel::SSE2, SimdLevel::AVX2, SimdLevel::NEON};
+	std::vector<ResizeFilter> filters = {ResizeFilter::RESIZE_FILTER_BOX, ResizeFilter::RESIZE_FILTER_BILINEAR, ResizeFilter::RESIZE_FILTER_AREA};
+	std::vector<uint32_t> formats = {BECAM_FORMAT_YUYV,	 BECAM_FORMAT_UYVY,	 BECAM_FORMAT_NV12,	  BECAM_FORMAT_NV21,	BECAM_FORMAT_I420,
+									 BECAM_FORMAT_YV12,	 BECAM_FORMAT_RGB24, BECAM_FORMAT_BGR24, BECAM_FORMAT_RGBA32, BECAM_FORMAT_BGRA32,
+									 BECAM_FOURCC('G', 'R', 'E', 'Y')};
+	std::cout << "Detected SIMD level: " << int(GetSimdLevel()) << std::endl;
+
+	// 各格式、比例及行间距下对比各实现与标量实现（覆盖整数比例快速路径、通用路径、放大及奇数尺寸）
+	struct Size {
+		uint32_t srcWidth;
+		uint32_t srcHeight;
+		uint32_t dstWidth;
+		uint32_t dstHeight;
+	};
+	std::vector<Size> sizes = {{128, 64, 64, 32}, {132, 66, 44, 22}, {136, 68, 34, 17}, {200, 40, 100, 20}, {198, 30, 66, 10}, {97, 33, 31, 11},
+							   {100, 60, 37, 23}, {64, 48, 100, 70}, {66, 6, 33, 3},	 {640, 480, 40, 30}, {30, 20, 29, 19},	{7, 5, 2, 1}};
+	for (auto format : formats) {
+		for (auto& size : sizes) {
+			for (auto filter : filters) {
+				std::vector<uint8_t> srcData;
+				ImageBuffer src;
+				MakeImage(format, size.srcWidth, size.srcHeight, size.srcWidth % 7, srcData, src);
+				std::vector<uint8_t> expectedData;
+				ImageBuffer expected;
+				MakeImage(format, size.dstWidth, size.dstHeight, 0, expectedData, expected);
+				if (ResizeImage(src, expected, filter, SimdLevel::SCALAR) != StatusCode::STATUS_CODE_SUCCESS) {
+					DEBUG_LOG("ResizeImage failed, format: " << format << ", width: " << size.srcWidth);
+					return 1;
+				}
+				for (auto level : levels) {
+					std::vector<uint8_t> actualData;
+					ImageBuffer actual;
+					MakeImage(format, size.dstWidth, size.dstHeight, 3, actualData, actual);
+					// 行尾填充不应被写入
+					auto before = actualData;
+					auto code = ResizeImage(src, actual, filter, level);
+					auto rowSize = GetDefaultImageStride(format, size.dstWidth, 0);
+					auto paddingKept = memcmp(actualData.data() + rowSize, before.data() + rowSize, 3) == 0;
+					if (code != StatusCode::STATUS_CODE_SUCCESS || !SameImage(expected, actual) || !paddingKept) {
+						DEBUG_LOG("ResizeImage mismatch, format: " << format << ", src: " << size.srcWidth << "x" << size.srcHeight << ", dst: "
+																   << size.dstWidth << "x" << size.dstHeight << ", filter: " << int(filter)
+																   << ", level: " << int(level));
+						return 1;
+					}
+				}
+
+				// 多通道格式的每个通道与单独缩放该通道的GREY图像一致（打包YUV奇数目标宽度时快速路径不适用，跳过）
+				if (format == BECAM_FOURCC('G', 'R', 'E', 'Y') || (size.dstWidth % 2 != 0 && GetImagePlaneCount(format) == 1)) {
+					continue;
+				}
+				for (uint32_t plane = 0; plane < GetImagePlaneCount(format); plane++) {
+					ResizePlaneLayout layout;
+					GetResizePlaneLayout(format, plane, src, expected, layout);
+					std::vector<ResizeChannel> channels;
+					GetResizeChannels(layout, channels);
+					for (auto& channel : channels) {
+						std::vector<uint8_t> channelData;
+						ImageBuffer channelSrc;
+						ExtractChannel(src, plane, channel, channel.srcCount, layout.srcHeight, channelData, channelSrc);
+						std::vector<uint8_t> channelExpectedData;
+						ImageBuffer channelExpected;
+						ExtractChannel(expected, plane, channel, channel.dstCount, layout.dstHeight, channelExpectedData, channelExpected);
+						std::vector<uint8_t> channelActualData;
+						ImageBuffer channelActual;
+						MakeImage(BECAM_FOURCC('G', 'R', 'E', 'Y'), channel.dstCount, layout.dstHeight, 0, channelActualData, channelActual);
+						ResizeImage(channelSrc, channelActual, filter, SimdLevel::SCALAR);
+						if (!SameImage(channelExpected, channelActual)) {
+							DEBUG_LOG("Channel resize mismatch, format: " << format << ", plane: " << plane << ", offset: " << channel.offset
+																		  << ", src width: " << size.srcWidth << ", filter: " << int(filter));
+							return 1;
+						}
+					}
+				}
+			}
+		}
+	}
+
+	// 与双精度参考实现对比（误差不超过1），纯色图像缩放后不变
+	{
+		std::vector<Size> cases = {{64, 48, 32, 24}, {60, 45, 20, 15}, {64, 64, 16, 16}, {101, 67, 37, 23}, {640, 360, 96, 54}, {30, 20, 47, 33}};
+		for (auto& size : cases) {
+			for (auto filter : {ResizeFilter::RESIZE_FILTER_BILINEAR, ResizeFilter::RESIZE_FILTER_AREA}) {
+				std::vector<uint8_t> srcData;
+				ImageBuffer src;
+				MakeImage(BECAM_FOURCC('G', 'R', 'E', 'Y'), size.srcWidth, size.srcHeight, 5, srcData, src);
+				std::vector<uint8_t> dstData;
+				ImageBuffer dst;
+				MakeImage(BECAM_FOURCC('G', 'R', 'E', 'Y'), size.dstWidth, size.dstHeight, 0, dstData, dst);
+				ResizeImage(src, dst, filter);
+				for (uint32_t y = 0; y < size.dstHeight; y++) {
+					for (uint32_t x = 0; x < size.dstWidth; x++) {
+						auto reference = ReferencePixel(src, size.dstWidth, size.dstHeight, x, y, filter);
+						if (fabs(reference - dst.plane[0][size_t(y) * dst.stride[0] + x]) > 1.0) {
+							DEBUG_LOG("Reference mismatch, src: " << size.srcWidth << ", dst: " << size.dstWidth << ", filter: " << int(filter)
+																  << ", x: " << x << ", y: " << y << ", expected: " << reference);
+							return 1;
+						}
+					}
+				}
+			}
+		}
+		for (auto format : formats) {
+			for (auto filter : filters) {
+				std::vector<uint8_t> srcData;
+				ImageBuffer src;
+				MakeImage(format, 99, 51, 0, srcData, src);
+				memset(srcData.data(), 0xB7, srcData.size());
+				std::vector<uint8_t> dstData;
+				ImageBuffer dst;
+				MakeImage(format, 40, 18, 0, dstData, dst);
+				ResizeImage(src, dst, filter);
+				auto size = GetImageSize(format, 40, 18);
+				for (size_t i = 0; i < size; i++) {
+					if (dstData[i] != 0xB7) {
+						DEBUG_LOG("Flat image changed, format: " << format << ", filter: " << int(filter));
+						return 1;
+					}
+				}
+			}
+		}
+	}
+
+	// 接口参数检查
+	{
+		std::vector<uint8_t> srcData;
+		ImageBuffer src;
+		MakeImage(BECAM_FORMAT_NV12, 64, 32, 0, srcData, src);
+		std::vector<uint8_t> dstData;
+		ImageBuffer dst;
+		MakeImage(BECAM_FORMAT_NV12, 32, 16, 0, dstData, dst);
+		auto other = dst;
+		other.format = BECAM_FORMAT_NV21;
+		auto empty = dst;
+		empty.plane[1] = nullptr;
+		auto jpeg = src;
+		jpeg.format = BECAM_FORMAT_MJPG;
+		auto jpegDst = dst;
+		jpegDst.format = BECAM_FORMAT_MJPG;
+		if (BecamResizeImage(&src, &dst, ResizeFilter::RESIZE_FILTER_AREA) != StatusCode::STATUS_CODE_SUCCESS ||
+			BecamResizeImage(nullptr, &dst, ResizeFilter::RESIZE_FILTER_AREA) != StatusCode::STATUS_CODE_ERR_INPUT_PARAM ||
+			BecamResizeImage(&src, &other, ResizeFilter::RESIZE_FILTER_AREA) != StatusCode::STATUS_CODE_ERR_INPUT_PARAM ||
+			BecamResizeImage(&src, &empty, ResizeFilter::RESIZE_FILTER_AREA) != StatusCode::STATUS_CODE_ERR_INPUT_PARAM ||
+			BecamResizeImage(&src, &dst, ResizeFilter(7)) != StatusCode::STATUS_CODE_ERR_INPUT_PARAM ||
+			BecamResizeImage(&jpeg, &jpegDst, ResizeFilter::RESIZE_FILTER_AREA) != StatusCode::STATUS_CODE_ERR_NOT_SUPPORTED) {
+			DEBUG_LOG("BecamResizeImage check failed");
+			return 1;
+		}
+	}
+
+	// 1080p/4K缩小到检测分辨率的耗时
+	{
+		struct Case {
+			uint32_t format;
+			uint32_t srcWidth;
+			uint32_t srcHeight;
+			uint32_t dstWidth;
+			uint32_t dstHeight;
+			ResizeFilter filter;
+		};
+		std::vector<Case> cases = {
+			{BECAM_FORMAT_YUYV, 1920, 1080, 960, 540, ResizeFilter::RESIZE_FILTER_AREA},
+			{BECAM_FORMAT_YUYV, 1920, 1080, 640, 360, ResizeFilter::RESIZE_FILTER_AREA},
+			{BECAM_FORMAT_YUYV, 1920, 1080, 480, 270, ResizeFilter::RESIZE_FILTER_AREA},
+			{BECAM_FORMAT_YUYV, 1920, 1080, 640, 360, ResizeFilter::RESIZE_FILTER_BILINEAR},
+			{BECAM_FORMAT_YUYV, 1920, 1080, 512, 288, ResizeFilter::RESIZE_FILTER_AREA},
+			{BECAM_FORMAT_NV12, 1920, 1080, 960, 540, ResizeFilter::RESIZE_FILTER_AREA},
+			{BECAM_FORMAT_NV12, 3840, 2160, 960, 540, ResizeFilter::RESIZE_FILTER_AREA},
+			{BECAM_FORMAT_NV12, 3840, 2160, 640, 360, ResizeFilter::RESIZE_FILTER_AREA},
+			{BECAM_FORMAT_I420, 3840, 2160, 640, 360, ResizeFilter::RESIZE_FILTER_BILINEAR},
+			{BECAM_FORMAT_RGB24, 1920, 1080, 640, 360, ResizeFilter::RESIZE_FILTER_AREA},
+			{BECAM_FORMAT_RGBA32, 1920, 1080, 960, 540, ResizeFilter::RESIZE_FILTER_AREA},
+		};
+		for (auto& item : cases) {
+			std::vector<uint8_t> srcData;
+			ImageBuffer src;
+			MakeImage(item.format, item.srcWidth, item.srcHeight, 0, srcData, src);
+			std::vector<uint8_t> dstData;
+			ImageBuffer dst;
+			MakeImage(item.format, item.dstWidth, item.dstHeight, 0, dstData, dst);
+			for (auto level : levels) {
+				std::cout << std::string(reinterpret_cast<const char*>(&item.format), 4) << " " << item.srcWidth << "x" << item.srcHeight << " -> "
+						  << item.dstWidth << "x" << item.dstHeight << ", filter: " << int(item.filter) << ", level: " << int(level)
+						  << ", cost: " << MeasureResize(src, dst, item.filter, level, 10) << "us" << std::endl;
+			}
+		}
+
+		// 先缩小再转换与先转换再缩小的对比
+		std::vector<uint8_t> srcData;
+		ImageBuffer src;
+		MakeImage(BECAM_FORMAT_YUYV, 1920, 1080, 0, srcData, src);
+		std::vector<uint8_t> scaledData;
+		ImageBuffer scaled;
+		MakeImage(BECAM_FORMAT_YUYV, 640, 360, 0, scaledData, scaled);
+		std::vector<uint8_t> fullRgbData;
+		ImageBuffer fullRgb;
+		MakeImage(BECAM_FORMAT_RGB24, 1920, 1080, 0, fullRgbData, fullRgb);
+		std::vector<uint8_t> rgbData;
+		ImageBuffer rgb;
+		MakeImage(BECAM_FORMAT_RGB24, 640, 360, 0, rgbData, rgb);
+		const int rounds = 10;
+		auto begin = std::chrono::steady_clock::now();
+		for (int i = 0; i < rounds; i++) {
+			ResizeImage(src, scaled, ResizeFilter::RESIZE_FILTER_AREA);
+			ConvertImage(scaled, rgb);
+		}
+		auto resizeFirst = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - begin).count() / rounds;
+		begin = std::chrono::steady_clock::now();
+		for (int i = 0; i < rounds; i++) {
+			ConvertImage(src, fullRgb);
+			ResizeImage(fullRgb, rgb, ResizeFilter::RESIZE_FILTER_AREA);
+		}
+		auto convertFirst = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - begin).count() / rounds;
+		std::cout << "YUYV 1080p -> RGB24 640x360, resize then convert: " << resizeFirst << "us, convert then resize: " << convertFirst << "us"
+				  << std::endl;
+	}
+
+	std::cout << "Resize test passed." << std::endl;
+	return 0;
+}
@@ -0,0 +1,388 @@
+#include "becam_test_fixture.hpp"
+#include <becam/becam.h>
+#include <chrono>
+#include <math.h>
+#include <pkg/ImageResize.hpp>
+#include <pkg/ImageTensor.hpp>
+#include <pkg/LogOutput.hpp>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+
+/**
+ * @brief 生成常用的张量配置
+ */
+static TensorConfig MakeConfig(const uint32_t width, const uint32_t height, const TensorLayout layout, const TensorDataType dataType,
+							   const TensorChannelOrder channelOrder, const TensorResizeMode resizeMode) {
+	TensorConfig config = {0};
+	config.width = width;
+	config.height = height;
+	config.layout = layout;
+	config.dataType = dataType;
+	config.channelOrder = channelOrder;
+	config.resizeMode = resizeMode;
+	// ImageNet的均值及标准差（按RGB）
+	float mean[3] = {123.675f, 116.28f, 103.53f};
+	float std[3] = {58.395f, 57.12f, 57.375f};
+	for (int i = 0; i < 3; i++) {
+		auto channel = channelOrder == TensorChannelOrder::TENSOR_CHANNEL_BGR ? 2 - i : i;
+		config.mean[i] = mean[channel];
+		config.std[i] = std[channel];
+		config.padValue[i] = 114.0f;
+	}
+	return config;
+}
+
+/**
+ * @brief 读取张量元素（转换为单精度）
+ */
+static float GetTensorValue(const std::vector<uint8_t>& tensor, const TensorConfig& config, const uint32_t channel, const uint32_t x, const uint32_t y) {
+	size_t index = config.layout == TensorLayout::TENSOR_LAYOUT_NHWC ? (size_t(y) * config.width + x) * 3 + channel
+																	 : (size_t(channel) * config.height + y) * config.width + x;
+	if (config.dataType == TensorDataType::TENSOR_DATA_FLOAT32) {
+		float value = 0;
+		memcpy(&value, tensor.data() + index * 4, 4);
+		return value;
+	}
+	uint16_t half = 0;
+	memcpy(&half, tensor.data() + index * 2, 2);
+	// 半精度转单精度（只用于校验）
+	auto exponent = (half >> 10) & 0x1F;
+	auto mantissa = half & 0x3FF;
+	auto value = exponent == 0 ? ldexp(double(mantissa), -24) : ldexp(double(mantissa | 0x400), exponent - 25);
+	return float((half & 0x8000) != 0 ? -value : value);
+}
+
+/**
+ * @brief 双精度参考实现：读取源通道在目标坐标处的双线性插值
+ */
+static double ReferenceSample(const ImageBuffer& image, const TensorChannel& channel, const uint32_t dstWidth, const uint32_t dstHeight,
+							  const uint32_t x, const uint32_t y) {
+	auto fx = std::max((x + 0.5) * channel.count / dstWidth - 0.5, 0.0);
+	auto fy = std::max((y + 0.5) * channel.rows / dstHeight - 0.5, 0.0);
+	auto x0 = std::min(uint32_t(fx), channel.count - 1);
+	auto y0 = std::min(uint32_t(fy), channel.rows - 1);
+	auto x1 = std::min(x0 + 1, channel.count - 1);
+	auto y1 = std::min(y0 + 1, channel.rows - 1);
+	auto ax = x0 + 1 < channel.count ? fx - x0 : 0.0;
+	auto ay = y0 + 1 < channel.rows ? fy - y0 : 0.0;
+	auto stride = image.stride[channel.plane] > 0 ? image.stride[channel.plane] : GetDefaultImageStride(image.format, image.width, channel.plane);
+	auto at = [&](const uint32_t sx, const uint32_t sy) {
+		return double(image.plane[channel.plane][size_t(sy) * stride + channel.offset + size_t(sx) * channel.step]);
+	};
+	return (at(x0, y0) * (1 - ax) + at(x1, y0) * ax) * (1 - ay) + (at(x0, y1) * (1 - ax) + at(x1, y1) * ax) * ay;
+}
+
+/**
+ * @brief 比较两个张量（NEON下标量实现可能被编译为乘加融合指令，允许最后一位的误差）
+ */
+static bool SameTensor(const std::vector<uint8_t>& a, const std::vector<uint8_t>& b, const TensorConfig& config, const bool exact) {
+	if (exact) {
+		return a == b;
+	}
+	for (uint32_t c = 0; c < 3; c++) {
+		for (uint32_t y = 0; y < config.height; y++) {
+			for (uint32_t x = 0; x < config.width; x++) {
+				auto expected = GetTensorValue(a, config, c, x, y);
+				if (fabs(expected - GetTensorValue(b, config, c, x, y)) > 1e-3 * std::max(1.0f, fabsf(expected))) {
+					return false;
+				}
+			}
+		}
+	}
+	return true;
+}
+
+int main() {
+	// 参与对比的指令集级别（不支持的级别会退化为标量实现）
+	std::vector<SimdLevel> levels = {SimdLevel::SCALAR, SimdLevel::SSE2, SimdLevel::AVX2, SimdLevel::NEON};
+	std::vector<uint32_t> formats = {BECAM_FORMAT_YUYV,	 BECAM_FORMAT_UYVY,	 BECAM_FORMAT_NV12,	  BECAM_FORMAT_NV21,	BECAM_FORMAT_I420,
+									 BECAM_FORMAT_YV12,	 BECAM_FORMAT_RGB24, BECAM_FORMAT_BGR24, BECAM_FORMAT_RGBA32, BECAM_FORMAT_BGRA32,
+									 BECAM_FOURCC('G', 'R', 'E', 'Y')};
+
+	// 半精度转换：典型值、舍入、溢出及非规格化数，向量化实现与标量实现逐位一致
+	{
+		struct Case {
+			float value;
+			uint16_t half;
+		};
+		std::vector<Case> cases = {{0.0f, 0x0000},		 {-0.0f, 0x8000},	 {1.0f, 0x3C00},	  {-2.0f, 0xC000},		 {65504.0f, 0x7BFF},
+								   {65520.0f, 0x7C00},	 {1e10f, 0x7C00},	 {-1e10f, 0xFC00},	  {1.0f / 3, 0x3555},	 {6.103515625e-05f, 0x0400},
+								   {5.96e-08f, 0x0001},	 {2.98e-08f, 0x0000}, {1.00048828125f, 0x3C00}, {1.00146484375f, 0x3C02}, {INFINITY, 0x7C00},
+								   {NAN, 0x7E00}};
+		for (auto& item : cases) {
+			if (FloatToHalfScalar(item.value) != item.half) {
+				DEBUG_LOG("FloatToHalf mismatch, value: " << item.value << ", expected: " << item.half << ", actual: " << FloatToHalfScalar(item.value));
+				return 1;
+			}
+		}
+		std::vector<float> values(4099);
+		for (size_t i = 0; i < values.size(); i++) {
+			uint32_t bits = uint32_t(rand()) << 16 ^ uint32_t(rand());
+			memcpy(&values[i], &bits, 4);
+			if (i % 2 == 0) {
+				// 一半取常见范围内的值
+				values[i] = float(rand() % 20000 - 10000) / float(rand() % 1000 + 1);
+			}
+		}
+		std::vector<uint16_t> expected(values.size());
+		FloatToHalfRowScalar(values.data(), expected.data(), values.size());
+		for (auto level : levels) {
+			std::vector<uint16_t> actual(values.size());
+			FloatToHalfRow(values.data(), actual.data(), values.size(), level);
+			for (size_t i = 0; i < values.size(); i++) {
+				// NEON硬件转换的NaN保留尾数，只校验非NaN的值
+				if (actual[i] != expected[i] && !isnan(values[i])) {
+					DEBUG_LOG("FloatToHalfRow mismatch, level: " << int(level) << ", value: " << values[i]);
+					return 1;
+				}
+			}
+		}
+	}
+
+	// 各格式、布局、类型及缩放方式下对比各实现与标量实现，并与双精度参考实现对比
+	{
+		struct Size {
+			uint32_t srcWidth;
+			uint32_t srcHeight;
+			uint32_t dstWidth;
+			uint32_t dstHeight;
+		};
+		std::vector<Size> sizes = {{64, 48, 32, 32}, {97, 33, 40, 24}, {30, 20, 47, 33}, {33, 17, 33, 17}, {160, 90, 64, 64}, {7, 5, 3, 9}};
+		for (auto format : formats) {
+			for (auto& size : sizes) {
+				for (auto layout : {TensorLayout::TENSOR_LAYOUT_NCHW, TensorLayout::TENSOR_LAYOUT_NHWC}) {
+					for (auto dataType : {TensorDataType::TENSOR_DATA_FLOAT32, TensorDataType::TENSOR_DATA_FLOAT16}) {
+						for (auto order : {TensorChannelOrder::TENSOR_CHANNEL_RGB, TensorChannelOrder::TENSOR_CHANNEL_BGR}) {
+							for (auto mode : {TensorResizeMode::TENSOR_RESIZE_STRETCH, TensorResizeMode::TENSOR_RESIZE_LETTERBOX}) {
+								std::vector<uint8_t> srcData;
+								ImageBuffer src;
+								MakeImage(format, size.srcWidth, size.srcHeight, size.srcWidth % 5, srcData, src);
+								auto config = MakeConfig(size.dstWidth, size.dstHeight, layout, dataType, order, mode);
+								std::vector<uint8_t> expected(GetTensorSize(config));
+								TensorPlacement placement;
+								if (ImageToTensor(src, config, expected.data(), expected.size(), placement, SimdLevel::SCALAR) !=
+									StatusCode::STATUS_CODE_SUCCESS) {
+									DEBUG_LOG("ImageToTensor failed, format: " << format);
+									return 1;
+								}
+								for (auto level : levels) {
+									std::vector<uint8_t> actual(expected.size());
+									ImageToTensor(src, config, actual.data(), actual.size(), placement, level);
+									if (!SameTensor(expected, actual, config, level != SimdLevel::NEON)) {
+										DEBUG_LOG("ImageToTensor mismatch, format: " << format << ", src: " << size.srcWidth << "x" << size.srcHeight
+																					 << ", dst: " << size.dstWidth << "x" << size.dstHeight
+																					 << ", layout: " << int(layout) << ", type: " << int(dataType)
+																					 << ", level: " << int(level));
+										return 1;
+									}
+								}
+
+								// 双精度参考实现：各源通道插值、YUV转RGB、截断、归一化，填充区域为归一化后的填充值
+								std::vector<TensorChannel> channels;
+								bool yuv = false;
+								GetTensorChannels(src, channels, yuv);
+								auto tolerance = dataType == TensorDataType::TENSOR_DATA_FLOAT32 ? 1e-3 : 4e-3;
+								for (uint32_t y = 0; y < config.height; y++) {
+									for (uint32_t x = 0; x < config.width; x++) {
+										auto inside = x >= placement.left && x < placement.left + placement.width && y >= placement.top &&
+													  y < placement.top + placement.height;
+										double rgb[3] = {114, 114, 114};
+										if (inside) {
+											double sample[3];
+											for (size_t i = 0; i < 3; i++) {
+												sample[i] = ReferenceSample(src, channels[channels.size() == 1 ? 0 : i], placement.width, placement.height,
+																			x - placement.left, y - placement.top);
+											}
+											if (yuv) {
+												auto yc = (sample[0] - 16) * 1.164383;
+												rgb[0] = yc + 1.596027 * (sample[2] - 128);
+												rgb[1] = yc - 0.391762 * (sample[1] - 128) - 0.812968 * (sample[2] - 128);
+												rgb[2] = yc + 2.017232 * (sample[1] - 128);
+												for (auto& value : rgb) {
+													value = std::min(std::max(value, 0.0), 255.0);
+												}
+											} else {
+												memcpy(rgb, sample, sizeof(rgb));
+											}
+										}
+										for (uint32_t c = 0; c < 3; c++) {
+											auto value = rgb[order == TensorChannelOrder::TENSOR_CHANNEL_BGR ? 2 - c : c];
+											auto reference = (value - config.mean[c]) / config.std[c];
+											if (fabs(reference - GetTensorValue(expected, config, c, x, y)) > tolerance * std::max(1.0, fabs(reference))) {
+												DEBUG_LOG("Reference mismatch, format: " << format << ", x: " << x << ", y: " << y << ", channel: " << c
+																						 << ", expected: " << reference
+																						 << ", actual: " << GetTensorValue(expected, config, c, x, y));
+												return 1;
+											}
+										}
+									}
+								}
+							}
+						}
+					}
+				}
+			}
+		}
+	}
+
+	// 不缩放且色度为常量时与格式转换的结果一致（定点转换误差不超过1）
+	{
+		std::vector<uint8_t> srcData;
+		ImageBuffer src;
+		MakeImage(BECAM_FORMAT_YUYV, 66, 8, 0, srcData, src);
+		for (size_t i = 1; i < srcData.size(); i += 4) {
+			srcData[i] = 90;
+			srcData[i + 2] = 170;
+		}
+		std::vector<uint8_t> rgbData;
+		ImageBuffer rgb;
+		MakeImage(BECAM_FORMAT_RGB24, 66, 8, 0, rgbData, rgb);
+		ConvertImage(src, rgb);
+		auto config = MakeConfig(66, 8, TensorLayout::TENSOR_LAYOUT_NHWC, TensorDataType::TENSOR_DATA_FLOAT32, TensorChannelOrder::TENSOR_CHANNEL_RGB,
+								 TensorResizeMode::TENSOR_RESIZE_STRETCH);
+		for (int i = 0; i < 3; i++) {
+			config.mean[i] = 0;
+			config.std[i] = 1;
+		}
+		std::vector<uint8_t> tensor(GetTensorSize(config));
+		TensorPlacement placement;
+		ImageToTensor(src, config, tensor.data(), tensor.size(), placement);
+		for (uint32_t y = 0; y < 8; y++) {
+			for (uint32_t x = 0; x < 66; x++) {
+				for (uint32_t c = 0; c < 3; c++) {
+					if (fabs(GetTensorValue(tensor, config, c, x, y) - rgb.plane[0][size_t(y) * rgb.stride[0] + x * 3 + c]) > 1.0) {
+						DEBUG_LOG("Conversion mismatch, x: " << x << ", y: " << y << ", channel: " << c);
+						return 1;
+					}
+				}
+			}
+		}
+	}
+
+	// 保持比例缩放的位置及视频帧接口
+	{
+		std::vector<uint8_t> srcData;
+		ImageBuffer src;
+		MakeImage(BECAM_FORMAT_YUYV, 1920, 1080, 64, srcData, src);
+		auto config = MakeConfig(640, 640, TensorLayout::TENSOR_LAYOUT_NCHW, TensorDataType::TENSOR_DATA_FLOAT32, TensorChannelOrder::TENSOR_CHANNEL_RGB,
+								 TensorResizeMode::TENSOR_RESIZE_LETTERBOX);
+		std::vector<uint8_t> expected(BecamGetTensorSize(&config));
+		TensorPlacement placement;
+		if (expected.size() != 640 * 640 * 3 * 4 ||
+			BecamImageToTensor(&src, &config, expected.data(), expected.size(), &placement) != StatusCode::STATUS_CODE_SUCCESS ||
+			placement.left != 0 || placement.top != 140 || placement.width != 640 || placement.height != 360 || fabsf(placement.scaleX - 1.0f / 3) > 1e-6f ||
+			fabsf(GetTensorValue(expected, config, 2, 5, 139) - (114.0f - config.mean[2]) / config.std[2]) > 1e-5f) {
+			DEBUG_LOG("Letterbox placement mismatch");
+			return 1;
+		}
+		FrameFormat format = {0};
+		format.format = BECAM_FORMAT_YUYV;
+		format.width = 1920;
+		format.height = 1080;
+		format.bytesPerLine = src.stride[0];
+		std::vector<uint8_t> actual(expected.size());
+		if (BecamFrameToTensor(&format, srcData.data(), size_t(src.stride[0]) * 1080, &config, actual.data(), actual.size(), nullptr) !=
+				StatusCode::STATUS_CODE_SUCCESS ||
+			actual != expected) {
+			DEBUG_LOG("BecamFrameToTensor mismatch");
+			return 1;
+		}
+
+		// 接口参数检查
+		auto invalid = config;
+		invalid.std[1] = 0;
+		auto jpeg = format;
+		jpeg.format = BECAM_FORMAT_MJPG;
+		if (BecamImageToTensor(nullptr, &config, actual.data(), actual.size(), nullptr) != StatusCode::STATUS_CODE_ERR_INPUT_PARAM ||
+			BecamImageToTensor(&src, &invalid, actual.data(), actual.size(), nullptr) != StatusCode::STATUS_CODE_ERR_INPUT_PARAM ||
+			BecamImageToTensor(&src, &config, actual.data(), actual.size() - 1, nullptr) != StatusCode::STATUS_CODE_ERR_INPUT_PARAM ||
+			BecamImageToTensor(&src, &config, nullptr, actual.size(), nullptr) != StatusCode::STATUS_CODE_ERR_INPUT_PARAM ||
+			BecamFrameToTensor(&format, srcData.data(), 1000, &config, actual.data(), actual.size(), nullptr) != StatusCode::STATUS_CODE_ERR_INPUT_PARAM ||
+			BecamFrameToTensor(&jpeg, srcData.data(), srcData.size(), &config, actual.data(), actual.size(), nullptr) !=
+				StatusCode::STATUS_CODE_ERR_NOT_SUPPORTED ||
+			BecamGetTensorSize(&invalid) != 0) {
+			DEBUG_LOG("Tensor interface check failed");
+			return 1;
+		}
+	}
+
+	// 耗时：合并处理与分步处理（转RGB、缩放、归一化并重排为NCHW）对比
+	{
+		struct Case {
+			uint32_t format;
+			uint32_t srcWidth;
+			uint32_t srcHeight;
+			uint32_t dstWidth;
+			uint32_t dstHeight;
+			TensorLayout layout;
+			TensorDataType dataType;
+		};
+		std::vector<Case> cases = {
+			{BECAM_FORMAT_YUYV, 1920, 1080, 640, 640, TensorLayout::TENSOR_LAYOUT_NCHW, TensorDataType::TENSOR_DATA_FLOAT32},
+			{BECAM_FORMAT_YUYV, 1920, 1080, 640, 640, TensorLayout::TENSOR_LAYOUT_NCHW, TensorDataType::TENSOR_DATA_FLOAT16},
+			{BECAM_FORMAT_YUYV, 1920, 1080, 224, 224, TensorLayout::TENSOR_LAYOUT_NHWC, TensorDataType::TENSOR_DATA_FLOAT32},
+			{BECAM_FORMAT_NV12, 3840, 2160, 640, 640, TensorLayout::TENSOR_LAYOUT_NCHW, TensorDataType::TENSOR_DATA_FLOAT32},
+			{BECAM_FORMAT_RGB24, 1920, 1080, 640, 640, TensorLayout::TENSOR_LAYOUT_NHWC, TensorDataType::TENSOR_DATA_FLOAT16},
+		};
+		const int rounds = 10;
+#if !defined(__OPTIMIZE__)
+		// 未开启优化时向量指令的中间结果逐条写回栈上，耗时不能反映各指令集的差异
+		std::cout << "Unoptimized build, use CMAKE_BUILD_TYPE=Release for representative timings." << std::endl;
+#endif
+		for (auto& item : cases) {
+			std::vector<uint8_t> srcData;
+			ImageBuffer src;
+			MakeImage(item.format, item.srcWidth, item.srcHeight, 0, srcData, src);
+			auto config = MakeConfig(item.dstWidth, item.dstHeight, item.layout, item.dataType, TensorChannelOrder::TENSOR_CHANNEL_RGB,
+									 TensorResizeMode::TENSOR_RESIZE_LETTERBOX);
+			std::vector<uint8_t> tensor(GetTensorSize(config));
+			TensorPlacement placement;
+			for (auto level : levels) {
+				// 取多轮中的最短耗时，减少调度及频率变化的干扰
+				ImageToTensor(src, config, tensor.data(), tensor.size(), placement, level);
+				int64_t cost = INT64_MAX;
+				for (int i = 0; i < rounds; i++) {
+					auto begin = std::chrono::steady_clock::now();
+					ImageToTensor(src, config, tensor.data(), tensor.size(), placement, level);
+					cost = std::min<int64_t>(cost, std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - begin).count());
+				}
+				std::cout << std::string(reinterpret_cast<const char*>(&item.format), 4) << " " << item.srcWidth << "x" << item.srcHeight << " -> "
+						  << (item.layout == TensorLayout::TENSOR_LAYOUT_NCHW ? "NCHW " : "NHWC ")
+						  << (item.dataType == TensorDataType::TENSOR_DATA_FLOAT32 ? "float32 " : "float16 ") << item.dstWidth << "x" << item.dstHeight
+						  << ", level: " << int(level) << ", cost: " << cost << "us" << std::endl;
+			}
+		}
+
+		// 分步处理
+		std::vector<uint8_t> srcData;
+		ImageBuffer src;
+		MakeImage(BECAM_FORMAT_YUYV, 1920, 1080, 0, srcData, src);
+		std::vector<uint8_t> rgbData;
+		ImageBuffer rgb;
+		MakeImage(BECAM_FORMAT_RGB24, 1920, 1080, 0, rgbData, rgb);
+		std::vector<uint8_t> scaledData;
+		ImageBuffer scaled;
+		MakeImage(BECAM_FORMAT_RGB24, 640, 360, 0, scaledData, scaled);
+		std::vector<float> tensor(640 * 640 * 3);
+		auto begin = std::chrono::steady_clock::now();
+		for (int i = 0; i < rounds; i++) {
+			ConvertImage(src, rgb);
+			ResizeImage(rgb, scaled, ResizeFilter::RESIZE_FILTER_BILINEAR);
+			for (size_t y = 0; y < 640; y++) {
+				for (size_t x = 0; x < 640; x++) {
+					for (size_t c = 0; c < 3; c++) {
+						auto inside = y >= 140 && y < 500;
+						auto value = inside ? scaled.plane[0][(y - 140) * scaled.stride[0] + x * 3 + c] : 114;
+						tensor[(c * 640 + y) * 640 + x] = (value - 127.5f) / 58.0f;
+					}
+				}
+			}
+		}
+		auto cost = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - begin).count() / rounds;
+		std::cout << "YUYV 1920x1080 -> NCHW float32 640x640, separate passes: " << cost << "us" << std::endl;
+	}
+
+	std::cout << "Tensor test passed." << std::endl;
+	return 0;
+}
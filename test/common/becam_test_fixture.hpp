@@ -0,0 +1,110 @@
+#pragma once
+
+#ifndef _BECAM_TEST_FIXTURE_H_
+#define _BECAM_TEST_FIXTURE_H_
+
+#include <becam/becam.h>
+#include <pkg/PixelConvert.hpp>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+#if defined(BECAM_WITH_JPEG)
+	#include <jpeglib.h>
+#endif
+
+/**
+ * @brief 按给定的行尾填充分配并填充随机图像
+ *
+ * @param format [in] 图像格式（FOURCC表示）
+ * @param width [in] 宽度
+ * @param height [in] 高度
+ * @param padding [in] 每行末尾的填充字节数
+ * @param data [out] 图像数据
+ * @param image [out] 指向图像数据的图像缓冲
+ */
+static void MakeImage(const uint32_t format, const uint32_t width, const uint32_t height, const uint32_t padding, std::vector<uint8_t>& data,
+					  ImageBuffer& image) {
+	image = {0};
+	image.format = format;
+	image.width = width;
+	image.height = height;
+	auto bytesPerLine = GetDefaultImageStride(format, width, 0) + padding;
+	// 色度平面按亮度平面推算，预留足够空间
+	data.resize(size_t(bytesPerLine + 2) * (height + 1) * 2);
+	for (auto& value : data) {
+		value = uint8_t(rand());
+	}
+	FillImageBuffer(image, data.data(), data.size(), bytesPerLine);
+}
+
+/**
+ * @brief 比较两幅图像的有效像素（忽略行尾填充）
+ */
+static bool SameImage(const ImageBuffer& a, const ImageBuffer& b) {
+	for (uint32_t i = 0; i < GetImagePlaneCount(a.format); i++) {
+		auto rowSize = GetDefaultImageStride(a.format, a.width, i);
+		for (uint32_t y = 0; y < GetImagePlaneHeight(a.format, a.height, i); y++) {
+			if (memcmp(a.plane[i] + size_t(y) * a.stride[i], b.plane[i] + size_t(y) * b.stride[i], rowSize) != 0) {
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+#if defined(BECAM_WITH_JPEG)
+/**
+ * @brief 编码一帧测试图像（左半红色，右半蓝色，绿色分量按行渐变，带少量噪声）
+ *
+ * @param width [in] 宽度
+ * @param height [in] 高度
+ * @param verticalSampling [in] 亮度分量垂直采样因子（1为4:2:2，2为4:2:0）
+ * @param restartInRows [in] 每隔多少MCU行插入重启标记（为0时使用restartInterval）
+ * @param restartInterval [in] 每隔多少MCU插入重启标记（均为0时不插入）
+ * @return MJPEG帧
+ */
+static std::vector<uint8_t> EncodeTestFrame(const uint32_t width, const uint32_t height, const int verticalSampling = 2,
+											const int restartInRows = 0, const unsigned int restartInterval = 0) {
+	std::vector<uint8_t> rgb(size_t(width) * height * 3);
+	for (uint32_t y = 0; y < height; y++) {
+		for (uint32_t x = 0; x < width; x++) {
+			auto pixel = rgb.data() + (size_t(y) * width + x) * 3;
+			auto noise = uint8_t(rand() % 8);
+			pixel[0] = x < width / 2 ? 220 + noise : 20 + noise;
+			pixel[1] = uint8_t(20 + y * 40 / height + noise);
+			pixel[2] = x < width / 2 ? 20 + noise : 220 + noise;
+		}
+	}
+	jpeg_compress_struct cinfo;
+	jpeg_error_mgr err;
+	cinfo.err = jpeg_std_error(&err);
+	jpeg_create_compress(&cinfo);
+	unsigned char* buffer = nullptr;
+	unsigned long size = 0;
+	jpeg_mem_dest(&cinfo, &buffer, &size);
+	cinfo.image_width = width;
+	cinfo.image_height = height;
+	cinfo.input_components = 3;
+	cinfo.in_color_space = JCS_RGB;
+	jpeg_set_defaults(&cinfo);
+	jpeg_set_quality(&cinfo, 85, TRUE);
+	cinfo.comp_info[0].h_samp_factor = 2;
+	cinfo.comp_info[0].v_samp_factor = verticalSampling;
+	cinfo.restart_in_rows = restartInRows;
+	cinfo.restart_interval = restartInterval;
+	jpeg_start_compress(&cinfo, TRUE);
+	while (cinfo.next_scanline < cinfo.image_height) {
+		JSAMPROW row = rgb.data() + size_t(cinfo.next_scanline) * width * 3;
+		jpeg_write_scanlines(&cinfo, &row, 1);
+	}
+	jpeg_finish_compress(&cinfo);
+	jpeg_destroy_compress(&cinfo);
+	std::vector<uint8_t> frame(buffer, buffer + size);
+	free(buffer);
+	return frame;
+}
+#endif
+
+#endif